@@ -16,6 +16,7 @@
 #ifndef CF_CERTIFICATE_OEPNSSL_CLASS_H
 #define CF_CERTIFICATE_OEPNSSL_CLASS_H
 
+#include "certificate_openssl_common.h"
 #include "pub_key.h"
 #include "pri_key.h"
 #include "x509_certificate_spi.h"
@@ -50,6 +51,7 @@ typedef struct {
 typedef struct {
     HcfX509CertificateSpi base;
     X509 *x509;
+    CfDerDigestCache digest;
 } HcfOpensslX509Cert;
 #define X509_CERT_OPENSSL_CLASS "X509CertOpensslClass"
 
@@ -16,9 +16,37 @@
 #ifndef CF_CERTIFICATE_OPENSSL_COMMON_H
 #define CF_CERTIFICATE_OPENSSL_COMMON_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <openssl/evp.h>
+#include <openssl/pkcs7.h>
+#include <openssl/x509.h>
+
+#include "cf_blob.h"
+#include "cf_result.h"
 
 #define CF_OPENSSL_SUCCESS 1     /* openssl return 1: success */
+#define CF_DER_DIGEST_LEN 32     /* SHA-256 */
+
+/* SHA-256 of the DER encoding of an immutable object, computed on first use and then read without a lock. */
+typedef struct {
+    int32_t state; /* only accessed with the __atomic builtins */
+    uint8_t value[CF_DER_DIGEST_LEN];
+} CfDerDigestCache;
+
+/* 1 tag byte and up to 5 length bytes of the SEQUENCE around a signed TBS */
+#define CF_SIGNED_TBS_OFFSET 6
+
+/* An issuer private key with the signature algorithm picked for it. */
+typedef struct {
+    EVP_PKEY *key;
+    const EVP_MD *md; /* NULL for Ed25519 */
+    const uint8_t *algId; /* DER AlgorithmIdentifier */
+    uint32_t algIdLen;
+} CfOpensslSigner;
+
+/* DER encodes obj like the openssl i2d functions, *der is freed by the caller with OPENSSL_free. */
+typedef int (*CfDerEncodeFunc)(const void *obj, unsigned char **der);
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +54,30 @@ extern "C" {
 
 const char *GetAlgorithmName(const char *oid);
 void CfPrintOpensslError(void);
+X509 *CfReadX509FromPem(const uint8_t *data, size_t len);
+X509_CRL *CfReadX509CrlFromPem(const uint8_t *data, size_t len);
+PKCS7 *CfReadPkcs7FromPem(const uint8_t *data, size_t len);
+
+/* Gets the digest of obj into digest, encode is called only if cache does not hold it yet. */
+CfResult CfGetDerDigest(CfDerDigestCache *cache, CfDerEncodeFunc encode, const void *obj, uint8_t *digest);
+
+/* Hash of an object from its digest, the same in every process. */
+uint32_t CfDerDigestHash(const uint8_t *digest);
+
+/* Loads a DER private key, RSA signs with SHA256 and PKCS#1 v1.5, EC with ECDSA and SHA256, Ed25519 as is. */
+CfResult CfOpensslSignerInit(const CfBlob *keyDer, CfOpensslSigner *signer);
+
+void CfOpensslSignerFree(CfOpensslSigner *signer);
+
+/* Size to allocate for a signed structure of a tbsLen bytes TBS, which is written at CF_SIGNED_TBS_OFFSET. */
+uint32_t CfOpensslSignedSize(const CfOpensslSigner *signer, uint32_t tbsLen);
+
+/*
+ * Signs the TBS at buf + CF_SIGNED_TBS_OFFSET and completes buf in place as SEQUENCE { tbs, algorithm, signature },
+ * signedDer is set to the part of buf that holds it.
+ */
+CfResult CfOpensslSignTbs(const CfOpensslSigner *signer, uint8_t *buf, uint32_t bufLen, uint32_t tbsLen,
+    CfBlob *signedDer);
 
 #ifdef __cplusplus
 }
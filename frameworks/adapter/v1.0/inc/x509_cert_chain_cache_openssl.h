@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef X509_CERT_CHAIN_CACHE_OPENSSL_H
+#define X509_CERT_CHAIN_CACHE_OPENSSL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <openssl/x509.h>
+
+#include "cf_result.h"
+
+#define CF_CHAIN_CACHE_KEY_LEN 32
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Key of the upper part of a path, from the issuer of the leaf to the self signed top, under the verify flags.
+ * The key covers the DER of every cert, so a changed anchor or intermediate never hits an old entry.
+ */
+CfResult CfChainCacheGetKey(unsigned long flags, X509 *const *upper, uint32_t count, uint8_t *key);
+
+/* Whether the upper path of key was validated up to its anchor within the TTL. */
+bool CfChainCacheContains(const uint8_t *key);
+
+void CfChainCacheAdd(const uint8_t *key);
+
+/* Seconds a path added from now on stays cached, 300 by default. */
+void CfChainCacheSetTtl(uint32_t seconds);
+
+/* Whether a validated upper path may stand in for later validations, not when a cert has name or policy constraints. */
+bool CfChainCacheIsCacheable(X509 *const *upper, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // X509_CERT_CHAIN_CACHE_OPENSSL_H
@@ -16,6 +16,8 @@
 #ifndef X509_CERTIFICATE_OEPNSSL_H
 #define X509_CERTIFICATE_OEPNSSL_H
 
+#include <openssl/x509.h>
+
 #include "x509_certificate_spi.h"
 
 #ifdef __cplusplus
@@ -24,6 +26,9 @@ extern "C" {
 
 CfResult OpensslX509CertSpiCreate(const CfEncodingBlob *inStream, HcfX509CertificateSpi **spi);
 
+/* Wraps an already decoded x509, the spi object owns it on success and the caller still does on failure. */
+CfResult OpensslX509CertSpiCreateWithX509(X509 *x509, HcfX509CertificateSpi **spi);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef X509_CRL_BUILDER_OEPNSSL_H
+#define X509_CRL_BUILDER_OEPNSSL_H
+
+#include "cf_blob.h"
+#include "cf_result.h"
+#include "x509_crl_builder.h"
+#include "x509_crl_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The TBSCertList is written in one pass into a presized buffer, spi may be NULL when only the DER is wanted. */
+CfResult OpensslX509CrlSpiBuild(const HcfX509CrlBuildParams *params, const HcfX509CrlColumns *revoked,
+    const CfBlob *signingKey, CfEncodingBlob *derOut, HcfX509CrlSpi **spi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // X509_CRL_BUILDER_OEPNSSL_H
@@ -26,7 +26,20 @@
 extern "C" {
 #endif
 
-CfResult HcfCX509CRLEntryCreate(X509_REVOKED *rev, HcfX509CrlEntry **crlEntryOut, CfBlob *certIssuer);
+/* Issuer name of a CRL, shared by reference between the CRL and all entries created from it. */
+typedef struct HcfX509CrlIssuerRef HcfX509CrlIssuerRef;
+
+CfResult HcfCX509CrlIssuerRefCreate(const CfBlob *issuer, HcfX509CrlIssuerRef **refOut);
+HcfX509CrlIssuerRef *HcfCX509CrlIssuerRefAcquire(HcfX509CrlIssuerRef *ref);
+void HcfCX509CrlIssuerRefRelease(HcfX509CrlIssuerRef *ref);
+
+CfResult HcfCX509CRLEntryCreate(X509_REVOKED *rev, HcfX509CrlEntry **crlEntryOut, HcfX509CrlIssuerRef *certIssuer);
+
+/*
+ * Create entries for all revoked certificates of the crl with a single allocation. The entries reference the
+ * revoked certificates of the crl instead of copying them, and every entry in the array must still be destroyed.
+ */
+CfResult HcfCX509CRLEntryCreateBatch(X509_CRL *crl, HcfX509CrlIssuerRef *certIssuer, CfArray *entrysOut);
 
 #ifdef __cplusplus
 }
@@ -16,6 +16,8 @@
 #ifndef X509_CRL_OEPNSSL_H
 #define X509_CRL_OEPNSSL_H
 
+#include <openssl/x509.h>
+
 #include "cf_blob.h"
 #include "crl.h"
 #include "cf_result.h"
@@ -27,6 +29,9 @@ extern "C" {
 
 CfResult HcfCX509CrlSpiCreate(const CfEncodingBlob *inStream, HcfX509CrlSpi **spi);
 
+/* Wraps an already decoded crl, the spi object owns it on success and the caller still does on failure. */
+CfResult HcfCX509CrlSpiCreateWithCrl(X509_CRL *crl, HcfX509CrlSpi **spi);
+
 #ifdef __cplusplus
 }
 #endif
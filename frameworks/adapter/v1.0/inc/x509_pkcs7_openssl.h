@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef X509_PKCS7_OEPNSSL_H
+#define X509_PKCS7_OEPNSSL_H
+
+#include "cf_blob.h"
+#include "cf_result.h"
+#include "pkcs7_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The spi objects take references to the certificates and CRLs openssl decoded, nothing is encoded again. */
+CfResult OpensslPkcs7SpiParse(const CfEncodingBlob *inStream, HcfPkcs7SpiContent *content);
+
+/* Destroys the spi objects still in content and frees its arrays. */
+void OpensslPkcs7SpiContentFree(HcfPkcs7SpiContent *content);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // X509_PKCS7_OEPNSSL_H
@@ -15,12 +15,24 @@
 
 #include "certificate_openssl_common.h"
 
+#include <stdbool.h>
 #include <string.h>
+#include "securec.h"
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
 #include "config.h"
+#include "cf_der.h"
 #include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_pem.h"
 #include "cf_result.h"
 
+#define DER_DIGEST_NONE 0
+#define DER_DIGEST_WRITING 1
+#define DER_DIGEST_READY 2
+#define BIT_STRING_UNUSED_BITS_LEN 1
+
 typedef struct {
     char *oid;
     char *algorithmName;
@@ -71,3 +83,242 @@ void CfPrintOpensslError(void)
 
     LOGE("[Openssl]: engine fail, error code = %lu, error string = %s", errCode, szErr);
 }
+
+/*
+ * Decodes the pem natively when it can, the armor forms it leaves out such as encapsulated headers go to openssl.
+ * Input without any BEGIN line is rejected here, openssl would only scan it again to the same end.
+ */
+static CfResult DecodePem(const uint8_t *data, size_t len, const char *label, CfBlob *der)
+{
+    if (len > UINT32_MAX) {
+        return CF_INVALID_PARAMS;
+    }
+    return CfPemDecode(data, (uint32_t)len, label, der, NULL);
+}
+
+X509 *CfReadX509FromPem(const uint8_t *data, size_t len)
+{
+    CfBlob der = { 0, NULL };
+    CfResult res = DecodePem(data, len, CF_PEM_LABEL_CERT, &der);
+    if (res == CF_NOT_EXIST) {
+        return NULL;
+    }
+    if (res == CF_SUCCESS) {
+        const unsigned char *tmp = der.data;
+        X509 *x509 = d2i_X509(NULL, &tmp, (long)der.size);
+        CfFree(der.data);
+        return x509;
+    }
+
+    BIO *bio = BIO_new_mem_buf(data, len);
+    if (bio == NULL) {
+        LOGE("Openssl bio new buf failed.");
+        return NULL;
+    }
+    X509 *x509 = PEM_read_bio_X509(bio, NULL, NULL, NULL);
+    BIO_free(bio);
+    return x509;
+}
+
+X509_CRL *CfReadX509CrlFromPem(const uint8_t *data, size_t len)
+{
+    CfBlob der = { 0, NULL };
+    CfResult res = DecodePem(data, len, CF_PEM_LABEL_CRL, &der);
+    if (res == CF_NOT_EXIST) {
+        return NULL;
+    }
+    if (res == CF_SUCCESS) {
+        const unsigned char *tmp = der.data;
+        X509_CRL *crl = d2i_X509_CRL(NULL, &tmp, (long)der.size);
+        CfFree(der.data);
+        return crl;
+    }
+
+    BIO *bio = BIO_new_mem_buf(data, len);
+    if (bio == NULL) {
+        LOGE("Openssl bio new buf failed.");
+        return NULL;
+    }
+    X509_CRL *crl = PEM_read_bio_X509_CRL(bio, NULL, NULL, NULL);
+    BIO_free(bio);
+    return crl;
+}
+
+PKCS7 *CfReadPkcs7FromPem(const uint8_t *data, size_t len)
+{
+    CfBlob der = { 0, NULL };
+    CfResult res = DecodePem(data, len, CF_PEM_LABEL_PKCS7, &der);
+    if (res == CF_NOT_EXIST) {
+        return NULL;
+    }
+    if (res == CF_SUCCESS) {
+        const unsigned char *tmp = der.data;
+        PKCS7 *p7 = d2i_PKCS7(NULL, &tmp, (long)der.size);
+        CfFree(der.data);
+        return p7;
+    }
+
+    BIO *bio = BIO_new_mem_buf(data, len);
+    if (bio == NULL) {
+        LOGE("Openssl bio new buf failed.");
+        return NULL;
+    }
+    PKCS7 *p7 = PEM_read_bio_PKCS7(bio, NULL, NULL, NULL);
+    BIO_free(bio);
+    return p7;
+}
+
+CfResult CfGetDerDigest(CfDerDigestCache *cache, CfDerEncodeFunc encode, const void *obj, uint8_t *digest)
+{
+    if ((cache == NULL) || (encode == NULL) || (obj == NULL) || (digest == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (__atomic_load_n(&cache->state, __ATOMIC_ACQUIRE) == DER_DIGEST_READY) {
+        (void)memcpy_s(digest, CF_DER_DIGEST_LEN, cache->value, CF_DER_DIGEST_LEN);
+        return CF_SUCCESS;
+    }
+
+    unsigned char *der = NULL;
+    int derLen = encode(obj, &der);
+    if ((derLen <= 0) || (der == NULL)) {
+        LOGE("Failed to encode der!");
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    int ret = EVP_Digest(der, (size_t)derLen, digest, NULL, EVP_sha256(), NULL);
+    OPENSSL_free(der);
+    if (ret != CF_OPENSSL_SUCCESS) {
+        LOGE("Failed to digest der!");
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+
+    /* only the first writer fills the cache, racing callers use the digest they computed */
+    int32_t expected = DER_DIGEST_NONE;
+    if (__atomic_compare_exchange_n(&cache->state, &expected, DER_DIGEST_WRITING, false, __ATOMIC_ACQUIRE,
+        __ATOMIC_RELAXED)) {
+        (void)memcpy_s(cache->value, CF_DER_DIGEST_LEN, digest, CF_DER_DIGEST_LEN);
+        __atomic_store_n(&cache->state, DER_DIGEST_READY, __ATOMIC_RELEASE);
+    }
+    return CF_SUCCESS;
+}
+
+uint32_t CfDerDigestHash(const uint8_t *digest)
+{
+    uint32_t hash = 0;
+    for (uint32_t i = 0; i < sizeof(uint32_t); i++) {
+        hash = (hash << 8) | digest[i]; /* 8: bits per byte, read big-endian so the host byte order does not matter */
+    }
+    return hash;
+}
+
+/* sha256WithRSAEncryption, ecdsa-with-SHA256 and Ed25519 */
+static const uint8_t SIG_ALG_ID_RSA_SHA256[] = {
+    0x30, 0x0D, 0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0B, 0x05, 0x00
+};
+static const uint8_t SIG_ALG_ID_ECDSA_SHA256[] = {
+    0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02
+};
+static const uint8_t SIG_ALG_ID_ED25519[] = { 0x30, 0x05, 0x06, 0x03, 0x2B, 0x65, 0x70 };
+
+CfResult CfOpensslSignerInit(const CfBlob *keyDer, CfOpensslSigner *signer)
+{
+    if ((keyDer == NULL) || (keyDer->data == NULL) || (keyDer->size == 0) || (keyDer->size > HCF_MAX_BUFFER_LEN) ||
+        (signer == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    const unsigned char *tmp = keyDer->data;
+    EVP_PKEY *key = d2i_AutoPrivateKey(NULL, &tmp, (long)keyDer->size);
+    if (key == NULL) {
+        LOGE("Failed to parse the signing key!");
+        CfPrintOpensslError();
+        return CF_INVALID_PARAMS;
+    }
+    switch (EVP_PKEY_get_base_id(key)) {
+        case EVP_PKEY_RSA:
+            signer->md = EVP_sha256();
+            signer->algId = SIG_ALG_ID_RSA_SHA256;
+            signer->algIdLen = sizeof(SIG_ALG_ID_RSA_SHA256);
+            break;
+        case EVP_PKEY_EC:
+            signer->md = EVP_sha256();
+            signer->algId = SIG_ALG_ID_ECDSA_SHA256;
+            signer->algIdLen = sizeof(SIG_ALG_ID_ECDSA_SHA256);
+            break;
+        case EVP_PKEY_ED25519:
+            signer->md = NULL;
+            signer->algId = SIG_ALG_ID_ED25519;
+            signer->algIdLen = sizeof(SIG_ALG_ID_ED25519);
+            break;
+        default:
+            LOGE("The signing key type is not supported!");
+            EVP_PKEY_free(key);
+            return CF_NOT_SUPPORT;
+    }
+    signer->key = key;
+    return CF_SUCCESS;
+}
+
+void CfOpensslSignerFree(CfOpensslSigner *signer)
+{
+    if (signer == NULL) {
+        return;
+    }
+    EVP_PKEY_free(signer->key);
+    signer->key = NULL;
+}
+
+uint32_t CfOpensslSignedSize(const CfOpensslSigner *signer, uint32_t tbsLen)
+{
+    uint32_t sigMax = (uint32_t)EVP_PKEY_get_size(signer->key);
+    return CF_SIGNED_TBS_OFFSET + tbsLen + signer->algIdLen + CfDerHeaderSize(BIT_STRING_UNUSED_BITS_LEN + sigMax) +
+        BIT_STRING_UNUSED_BITS_LEN + sigMax;
+}
+
+CfResult CfOpensslSignTbs(const CfOpensslSigner *signer, uint8_t *buf, uint32_t bufLen, uint32_t tbsLen,
+    CfBlob *signedDer)
+{
+    if (bufLen != CfOpensslSignedSize(signer, tbsLen)) {
+        LOGE("The signed buffer is not sized for the tbs!");
+        return CF_INVALID_PARAMS;
+    }
+    uint8_t *tbs = buf + CF_SIGNED_TBS_OFFSET;
+    uint8_t *alg = tbs + tbsLen;
+    (void)memcpy_s(alg, bufLen - (alg - buf), signer->algId, signer->algIdLen);
+
+    /* sign behind the largest BIT STRING header, then move up if the real header is shorter */
+    uint8_t *bitString = alg + signer->algIdLen;
+    size_t sigMax = (size_t)EVP_PKEY_get_size(signer->key);
+    uint32_t bitHeaderMax = CfDerHeaderSize(BIT_STRING_UNUSED_BITS_LEN + (uint32_t)sigMax);
+    uint8_t *sig = bitString + bitHeaderMax + BIT_STRING_UNUSED_BITS_LEN;
+    size_t sigLen = sigMax;
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx == NULL) {
+        LOGE("Failed to new md ctx!");
+        return CF_ERR_MALLOC;
+    }
+    if ((EVP_DigestSignInit(ctx, NULL, signer->md, NULL, signer->key) != CF_OPENSSL_SUCCESS) ||
+        (EVP_DigestSign(ctx, sig, &sigLen, tbs, tbsLen) != CF_OPENSSL_SUCCESS)) {
+        LOGE("Failed to sign the tbs!");
+        CfPrintOpensslError();
+        EVP_MD_CTX_free(ctx);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    EVP_MD_CTX_free(ctx);
+    uint32_t bitHeader = CfDerPutHeader(bitString, CF_DER_TAG_BIT_STRING,
+        BIT_STRING_UNUSED_BITS_LEN + (uint32_t)sigLen);
+    bitString[bitHeader] = 0; /* no unused bits */
+    if (bitHeader != bitHeaderMax) {
+        (void)memmove_s(bitString + bitHeader + BIT_STRING_UNUSED_BITS_LEN, sigMax, sig, sigLen);
+    }
+
+    uint32_t bodyLen = tbsLen + signer->algIdLen + bitHeader + BIT_STRING_UNUSED_BITS_LEN + (uint32_t)sigLen;
+    uint32_t header = CfDerHeaderSize(bodyLen);
+    uint8_t *start = tbs - header;
+    (void)CfDerPutHeader(start, CF_DER_TAG_SEQUENCE, bodyLen);
+    signedDer->data = start;
+    signedDer->size = header + bodyLen;
+    return CF_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_cert_builder_openssl.h"
+
+#include "securec.h"
+
+#include <openssl/x509.h>
+
+#include "config.h"
+#include "cf_check.h"
+#include "cf_der.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "certificate_openssl_common.h"
+#include "utils.h"
+#include "x509_certificate_openssl.h"
+
+#define X509_CERT_BUILDER_OPENSSL_CLASS "X509CertBuilderOpensslClass"
+#define MAX_SERIAL_NUMBER_LEN 20 /* RFC 5280, octets of the INTEGER value */
+#define EMPTY_NAME_LEN 2
+#define DER_TAG_EXPLICIT_3 0xA3
+
+/* [0] EXPLICIT INTEGER 2, always v3 */
+static const uint8_t TBS_VERSION_V3[] = { 0xA0, 0x03, 0x02, 0x01, 0x02 };
+/* OID 2.5.29.17 subjectAltName */
+static const uint8_t EXT_OID_SUBJECT_ALT_NAME[] = { 0x06, 0x03, 0x55, 0x1D, 0x11 };
+static const uint8_t EXT_CRITICAL[] = { 0x01, 0x01, 0xFF };
+
+/*
+ * TBSCertificate ::= SEQUENCE { version, serialNumber, signature, issuer, validity, subject,
+ * subjectPublicKeyInfo, extensions }, the parts around the serial number, validity and key are encoded once.
+ */
+typedef struct {
+    HcfX509CertBuilderSpi base;
+    CfOpensslSigner signer;
+    CfBlob signatureAndIssuer;
+    CfBlob subject;
+    CfBlob extensions; /* the whole [3] EXPLICIT Extensions, size 0 for none */
+} HcfX509CertBuilderOpensslImpl;
+
+static const char *GetClass(void)
+{
+    return X509_CERT_BUILDER_OPENSSL_CLASS;
+}
+
+static void DestroyX509CertBuilderOpenssl(CfObjectBase *self)
+{
+    if (self == NULL) {
+        return;
+    }
+    if (!IsClassMatch(self, GetClass())) {
+        LOGE("Input wrong class type!");
+        return;
+    }
+    HcfX509CertBuilderOpensslImpl *impl = (HcfX509CertBuilderOpensslImpl *)self;
+    CfOpensslSignerFree(&impl->signer);
+    CfFree(impl->signatureAndIssuer.data);
+    CfFree(impl->subject.data);
+    CfFree(impl->extensions.data);
+    CfFree(impl);
+}
+
+static bool IsOneSequence(const CfBlob *blob)
+{
+    uint32_t count = 0;
+    return (blob->data != NULL) && (blob->size <= HCF_MAX_BUFFER_LEN) &&
+        (CfCheckDerSequenceList(blob->data, blob->size, &count) == CF_SUCCESS) && (count == 1);
+}
+
+static CfResult CheckTemplate(const HcfX509CertTemplate *tmpl)
+{
+    if (!IsOneSequence(&tmpl->issuer) || !IsOneSequence(&tmpl->subject)) {
+        LOGE("The issuer or subject is not a DER name!");
+        return CF_INVALID_PARAMS;
+    }
+    if ((tmpl->subjectAltNames.size != 0) && !IsOneSequence(&tmpl->subjectAltNames)) {
+        LOGE("The subjectAltNames is not DER GeneralNames!");
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t count = 0;
+    if ((tmpl->extensions.size != 0) && ((tmpl->extensions.data == NULL) ||
+        (tmpl->extensions.size > HCF_MAX_BUFFER_LEN) ||
+        (CfCheckDerSequenceList(tmpl->extensions.data, tmpl->extensions.size, &count) != CF_SUCCESS))) {
+        LOGE("The extensions are not DER Extension entries!");
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult CopyParts(CfBlob *out, const CfBlob *first, const CfBlob *second)
+{
+    uint32_t size = first->size + second->size;
+    out->data = (uint8_t *)HcfMalloc(size, 0);
+    if (out->data == NULL) {
+        LOGE("Failed to malloc for template part!");
+        return CF_ERR_MALLOC;
+    }
+    (void)memcpy_s(out->data, size, first->data, first->size);
+    if (second->size != 0) {
+        (void)memcpy_s(out->data + first->size, size - first->size, second->data, second->size);
+    }
+    out->size = size;
+    return CF_SUCCESS;
+}
+
+static CfResult EncodeExtensions(const HcfX509CertTemplate *tmpl, CfBlob *out)
+{
+    uint32_t sanLen = 0;
+    uint32_t sanBodyLen = 0;
+    bool critical = (tmpl->subject.size == EMPTY_NAME_LEN);
+    if (tmpl->subjectAltNames.size != 0) {
+        sanBodyLen = sizeof(EXT_OID_SUBJECT_ALT_NAME) + (critical ? sizeof(EXT_CRITICAL) : 0) +
+            CfDerHeaderSize(tmpl->subjectAltNames.size) + tmpl->subjectAltNames.size;
+        sanLen = CfDerHeaderSize(sanBodyLen) + sanBodyLen;
+    }
+    uint32_t listLen = sanLen + tmpl->extensions.size;
+    if (listLen == 0) {
+        return CF_SUCCESS;
+    }
+    uint32_t seqLen = CfDerHeaderSize(listLen) + listLen;
+    uint32_t size = CfDerHeaderSize(seqLen) + seqLen;
+    uint8_t *der = (uint8_t *)HcfMalloc(size, 0);
+    if (der == NULL) {
+        LOGE("Failed to malloc for extensions!");
+        return CF_ERR_MALLOC;
+    }
+    uint32_t pos = CfDerPutHeader(der, DER_TAG_EXPLICIT_3, seqLen);
+    pos += CfDerPutHeader(der + pos, CF_DER_TAG_SEQUENCE, listLen);
+    if (sanLen != 0) {
+        pos += CfDerPutHeader(der + pos, CF_DER_TAG_SEQUENCE, sanBodyLen);
+        (void)memcpy_s(der + pos, size - pos, EXT_OID_SUBJECT_ALT_NAME, sizeof(EXT_OID_SUBJECT_ALT_NAME));
+        pos += sizeof(EXT_OID_SUBJECT_ALT_NAME);
+        if (critical) {
+            (void)memcpy_s(der + pos, size - pos, EXT_CRITICAL, sizeof(EXT_CRITICAL));
+            pos += sizeof(EXT_CRITICAL);
+        }
+        pos += CfDerPutHeader(der + pos, CF_DER_TAG_OCTET_STRING, tmpl->subjectAltNames.size);
+        (void)memcpy_s(der + pos, size - pos, tmpl->subjectAltNames.data, tmpl->subjectAltNames.size);
+        pos += tmpl->subjectAltNames.size;
+    }
+    if (tmpl->extensions.size != 0) {
+        (void)memcpy_s(der + pos, size - pos, tmpl->extensions.data, tmpl->extensions.size);
+    }
+    out->data = der;
+    out->size = size;
+    return CF_SUCCESS;
+}
+
+static CfResult CheckIssueParams(const HcfX509CertIssueParams *params)
+{
+    if ((params->serialNumber.data == NULL) || (params->serialNumber.size == 0) ||
+        (CfDerUintSize(params->serialNumber.data, params->serialNumber.size) >
+        CfDerHeaderSize(MAX_SERIAL_NUMBER_LEN) + MAX_SERIAL_NUMBER_LEN)) {
+        LOGE("The serial number is empty or too long!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!CfDerIsTimeValid(params->notBefore) || !CfDerIsTimeValid(params->notAfter) ||
+        (params->notBefore > params->notAfter)) {
+        LOGE("The validity is out of range!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsOneSequence(&params->publicKey)) {
+        LOGE("The public key is not a DER SubjectPublicKeyInfo!");
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+static uint32_t PutBlob(uint8_t *out, const CfBlob *blob)
+{
+    if (blob->size != 0) {
+        (void)memcpy_s(out, blob->size, blob->data, blob->size);
+    }
+    return blob->size;
+}
+
+static CfResult CreateCertSpi(const uint8_t *der, uint32_t len, HcfX509CertificateSpi **certSpi)
+{
+    const unsigned char *tmp = der;
+    X509 *x509 = d2i_X509(NULL, &tmp, (long)len);
+    if ((x509 == NULL) || (tmp != der + len) || (X509_get0_pubkey(x509) == NULL)) {
+        LOGE("The issued cert can not be decoded, check the template and public key!");
+        CfPrintOpensslError();
+        X509_free(x509);
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = OpensslX509CertSpiCreateWithX509(x509, certSpi);
+    if (res != CF_SUCCESS) {
+        X509_free(x509);
+    }
+    return res;
+}
+
+static CfResult Issue(HcfX509CertBuilderSpi *self, const HcfX509CertIssueParams *params,
+    HcfX509CertificateSpi **certSpi)
+{
+    if ((self == NULL) || (params == NULL) || (certSpi == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = CheckIssueParams(params);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    HcfX509CertBuilderOpensslImpl *impl = (HcfX509CertBuilderOpensslImpl *)self;
+    uint32_t validityLen = CfDerTimeSize(params->notBefore) + CfDerTimeSize(params->notAfter);
+    uint32_t tbsBodyLen = sizeof(TBS_VERSION_V3) + CfDerUintSize(params->serialNumber.data,
+        params->serialNumber.size) + impl->signatureAndIssuer.size + CfDerHeaderSize(validityLen) + validityLen +
+        impl->subject.size + params->publicKey.size + impl->extensions.size;
+    uint32_t tbsLen = CfDerHeaderSize(tbsBodyLen) + tbsBodyLen;
+    uint32_t bufLen = CfOpensslSignedSize(&impl->signer, tbsLen);
+    uint8_t *buf = (uint8_t *)HcfMalloc(bufLen, 0);
+    if (buf == NULL) {
+        LOGE("Failed to malloc for cert der!");
+        return CF_ERR_MALLOC;
+    }
+
+    uint8_t *tbs = buf + CF_SIGNED_TBS_OFFSET;
+    uint32_t pos = CfDerPutHeader(tbs, CF_DER_TAG_SEQUENCE, tbsBodyLen);
+    (void)memcpy_s(tbs + pos, tbsLen - pos, TBS_VERSION_V3, sizeof(TBS_VERSION_V3));
+    pos += sizeof(TBS_VERSION_V3);
+    pos += CfDerPutUint(tbs + pos, CF_DER_TAG_INTEGER, params->serialNumber.data, params->serialNumber.size);
+    pos += PutBlob(tbs + pos, &impl->signatureAndIssuer);
+    pos += CfDerPutHeader(tbs + pos, CF_DER_TAG_SEQUENCE, validityLen);
+    pos += CfDerPutTime(tbs + pos, params->notBefore);
+    pos += CfDerPutTime(tbs + pos, params->notAfter);
+    pos += PutBlob(tbs + pos, &impl->subject);
+    pos += PutBlob(tbs + pos, &params->publicKey);
+    (void)PutBlob(tbs + pos, &impl->extensions);
+
+    CfBlob certDer = { 0, NULL };
+    res = CfOpensslSignTbs(&impl->signer, buf, bufLen, tbsLen, &certDer);
+    if (res == CF_SUCCESS) {
+        res = CreateCertSpi(certDer.data, certDer.size, certSpi);
+    }
+    CfFree(buf);
+    return res;
+}
+
+static CfResult BuildTemplate(const HcfX509CertTemplate *tmpl, HcfX509CertBuilderOpensslImpl *impl)
+{
+    CfBlob algId = { impl->signer.algIdLen, (uint8_t *)impl->signer.algId };
+    CfBlob none = { 0, NULL };
+    CfResult res = CopyParts(&impl->signatureAndIssuer, &algId, &tmpl->issuer);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    res = CopyParts(&impl->subject, &tmpl->subject, &none);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    return EncodeExtensions(tmpl, &impl->extensions);
+}
+
+CfResult HcfX509CertBuilderSpiCreate(const HcfX509CertTemplate *tmpl, const CfBlob *signingKey,
+    HcfX509CertBuilderSpi **spi)
+{
+    if ((tmpl == NULL) || (signingKey == NULL) || (spi == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = CheckTemplate(tmpl);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    HcfX509CertBuilderOpensslImpl *impl =
+        (HcfX509CertBuilderOpensslImpl *)HcfMalloc(sizeof(HcfX509CertBuilderOpensslImpl), 0);
+    if (impl == NULL) {
+        LOGE("Failed to malloc for cert builder!");
+        return CF_ERR_MALLOC;
+    }
+    impl->base.base.getClass = GetClass;
+    impl->base.base.destroy = DestroyX509CertBuilderOpenssl;
+    impl->base.engineIssue = Issue;
+    res = CfOpensslSignerInit(signingKey, &impl->signer);
+    if (res == CF_SUCCESS) {
+        res = BuildTemplate(tmpl, impl);
+    }
+    if (res != CF_SUCCESS) {
+        DestroyX509CertBuilderOpenssl((CfObjectBase *)impl);
+        return res;
+    }
+    *spi = (HcfX509CertBuilderSpi *)impl;
+    return CF_SUCCESS;
+}
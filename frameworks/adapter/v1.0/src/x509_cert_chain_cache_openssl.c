@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_cert_chain_cache_openssl.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "securec.h"
+
+#include <openssl/evp.h>
+#include <openssl/objects.h>
+
+#include "cf_log.h"
+#include "certificate_openssl_common.h"
+
+#define CHAIN_CACHE_SIZE 64
+#define CHAIN_CACHE_TTL 300 /* seconds */
+
+typedef struct {
+    uint8_t key[CF_CHAIN_CACHE_KEY_LEN];
+    int64_t expiry; /* 0: the slot is free */
+} ChainCacheEntry;
+
+static ChainCacheEntry g_chainCache[CHAIN_CACHE_SIZE];
+static int64_t g_chainCacheTtl = CHAIN_CACHE_TTL;
+static pthread_mutex_t g_chainCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int64_t GetNow(void)
+{
+    struct timespec now = { 0 };
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return -1;
+    }
+    return (int64_t)now.tv_sec;
+}
+
+CfResult CfChainCacheGetKey(unsigned long flags, X509 *const *upper, uint32_t count, uint8_t *key)
+{
+    if ((upper == NULL) || (count == 0) || (key == NULL)) {
+        LOGE("Invalid params!");
+        return CF_INVALID_PARAMS;
+    }
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    if (ctx == NULL) {
+        LOGE("Failed to new digest ctx!");
+        return CF_ERR_MALLOC;
+    }
+    CfResult res = CF_SUCCESS;
+    if ((EVP_DigestInit_ex(ctx, EVP_sha256(), NULL) != CF_OPENSSL_SUCCESS) ||
+        (EVP_DigestUpdate(ctx, &flags, sizeof(flags)) != CF_OPENSSL_SUCCESS)) {
+        res = CF_ERR_CRYPTO_OPERATION;
+    }
+    for (uint32_t i = 0; (res == CF_SUCCESS) && (i < count); ++i) {
+        uint8_t certDigest[CF_CHAIN_CACHE_KEY_LEN] = { 0 };
+        unsigned int len = sizeof(certDigest);
+        if ((X509_digest(upper[i], EVP_sha256(), certDigest, &len) != CF_OPENSSL_SUCCESS) ||
+            (EVP_DigestUpdate(ctx, certDigest, len) != CF_OPENSSL_SUCCESS)) {
+            res = CF_ERR_CRYPTO_OPERATION;
+        }
+    }
+    unsigned int keyLen = CF_CHAIN_CACHE_KEY_LEN;
+    if ((res == CF_SUCCESS) && (EVP_DigestFinal_ex(ctx, key, &keyLen) != CF_OPENSSL_SUCCESS)) {
+        res = CF_ERR_CRYPTO_OPERATION;
+    }
+    EVP_MD_CTX_free(ctx);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to digest the chain!");
+        CfPrintOpensslError();
+    }
+    return res;
+}
+
+bool CfChainCacheContains(const uint8_t *key)
+{
+    int64_t now = GetNow();
+    if ((key == NULL) || (now < 0)) {
+        return false;
+    }
+    bool found = false;
+    (void)pthread_mutex_lock(&g_chainCacheMutex);
+    for (uint32_t i = 0; i < CHAIN_CACHE_SIZE; ++i) {
+        if ((g_chainCache[i].expiry > now) && (memcmp(g_chainCache[i].key, key, CF_CHAIN_CACHE_KEY_LEN) == 0)) {
+            found = true;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&g_chainCacheMutex);
+    return found;
+}
+
+void CfChainCacheAdd(const uint8_t *key)
+{
+    int64_t now = GetNow();
+    if ((key == NULL) || (now < 0)) {
+        return;
+    }
+    (void)pthread_mutex_lock(&g_chainCacheMutex);
+    /* the same key is refreshed in place, otherwise the entry closest to expiry is replaced */
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < CHAIN_CACHE_SIZE; ++i) {
+        if (memcmp(g_chainCache[i].key, key, CF_CHAIN_CACHE_KEY_LEN) == 0) {
+            slot = i;
+            break;
+        }
+        if (g_chainCache[i].expiry < g_chainCache[slot].expiry) {
+            slot = i;
+        }
+    }
+    (void)memcpy_s(g_chainCache[slot].key, CF_CHAIN_CACHE_KEY_LEN, key, CF_CHAIN_CACHE_KEY_LEN);
+    g_chainCache[slot].expiry = now + g_chainCacheTtl;
+    (void)pthread_mutex_unlock(&g_chainCacheMutex);
+}
+
+void CfChainCacheSetTtl(uint32_t seconds)
+{
+    (void)pthread_mutex_lock(&g_chainCacheMutex);
+    g_chainCacheTtl = (int64_t)seconds;
+    (void)pthread_mutex_unlock(&g_chainCacheMutex);
+}
+
+/*
+ * A cached upper path lets a later leaf be verified against its issuer alone. That holds for signatures, CA flags
+ * and path lengths, which do not depend on the leaf, but not for name and policy constraints, which the certs
+ * above impose on the leaf. Paths carrying those are always validated in full.
+ */
+bool CfChainCacheIsCacheable(X509 *const *upper, uint32_t count)
+{
+    static const int constraintNids[] = { NID_name_constraints, NID_policy_constraints, NID_inhibit_any_policy };
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t j = 0; j < sizeof(constraintNids) / sizeof(constraintNids[0]); ++j) {
+            if (X509_get_ext_by_NID(upper[i], constraintNids[j], -1) >= 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -15,6 +15,12 @@
 
 #include "x509_cert_chain_validator_openssl.h"
 
+#include <pthread.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+
+#include "securec.h"
+
 #include <openssl/asn1.h>
 #include <openssl/bio.h>
 #include <openssl/crypto.h>
@@ -24,16 +30,32 @@
 #include <openssl/pem.h>
 #include <openssl/x509.h>
 #include <openssl/x509_vfy.h>
+#include <openssl/x509v3.h>
 
 #include "cf_blob.h"
+#include "cf_check.h"
 #include "config.h"
 #include "cf_log.h"
 #include "cf_memory.h"
 #include "utils.h"
 #include "cf_result.h"
 #include "certificate_openssl_common.h"
+#include "x509_cert_chain_cache_openssl.h"
 
 #define X509_CERT_CHAIN_VALIDATOR_OPENSSL_CLASS "X509CertChainValidatorOpensslClass"
+/* Do not check cert validity against current time. */
+#define VERIFY_FLAGS X509_V_FLAG_NO_CHECK_TIME
+#define CHAIN_BUF_COUNT 3
+/* issuers loaded from a trust directory stay in its store, which is started afresh beyond this many */
+#define TRUST_STORE_CACHE_MAX 256
+#define TRUST_DIR_MAX_LEN 4096
+
+typedef struct {
+    HcfCertChainValidatorSpi base;
+    pthread_mutex_t mutex;
+    X509_STORE *trustStore; /* NULL: the certs of the chain after the leaf are the trusted ones */
+    char *trustDir;
+} HcfX509CertChainValidatorOpensslImpl;
 
 typedef struct {
     uint8_t *data;
@@ -58,7 +80,7 @@ static const OpensslErrorToResult ERROR_TO_RESULT_MAP[] = {
 
 static CfResult ConvertOpensslErrorMsg(int32_t errCode)
 {
-    for (uint32_t i = 0; i < sizeof(ERROR_TO_RESULT_MAP); i++) {
+    for (uint32_t i = 0; i < sizeof(ERROR_TO_RESULT_MAP) / sizeof(ERROR_TO_RESULT_MAP[0]); i++) {
         if (ERROR_TO_RESULT_MAP[i].errCode == errCode) {
             return ERROR_TO_RESULT_MAP[i].result;
         }
@@ -81,7 +103,103 @@ static void DestroyX509CertChainValidator(CfObjectBase *self)
         LOGE("Class is not match.");
         return;
     }
-    CfFree((HcfCertChainValidatorSpi *)self);
+    HcfX509CertChainValidatorOpensslImpl *impl = (HcfX509CertChainValidatorOpensslImpl *)self;
+    X509_STORE_free(impl->trustStore);
+    CfFree(impl->trustDir);
+    (void)pthread_mutex_destroy(&impl->mutex);
+    CfFree(impl);
+}
+
+/* Issuers are looked up by subject name hash in dir and parsed only when a validation needs them. */
+static X509_STORE *CreateTrustStore(const char *dir)
+{
+    X509_STORE *store = X509_STORE_new();
+    if (store == NULL) {
+        LOGE("Failed to new trust store.");
+        return NULL;
+    }
+    X509_LOOKUP *lookup = X509_STORE_add_lookup(store, X509_LOOKUP_hash_dir());
+    if ((lookup == NULL) || (X509_LOOKUP_add_dir(lookup, dir, X509_FILETYPE_PEM) != CF_OPENSSL_SUCCESS)) {
+        LOGE("Failed to add trust dir.");
+        CfPrintOpensslError();
+        X509_STORE_free(store);
+        return NULL;
+    }
+    X509_STORE_set_flags(store, VERIFY_FLAGS);
+    return store;
+}
+
+static CfResult SetTrustStore(HcfCertChainValidatorSpi *self, const char *dirPath)
+{
+    if ((self == NULL) || !IsStrValid(dirPath, TRUST_DIR_MAX_LEN)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertChainValidatorClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    struct stat st;
+    if ((stat(dirPath, &st) != 0) || !S_ISDIR(st.st_mode)) {
+        LOGE("The trust store is not a directory.");
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t dirLen = strlen(dirPath) + 1;
+    char *dir = (char *)HcfMalloc(dirLen, 0);
+    if (dir == NULL) {
+        LOGE("Failed to malloc for trust dir.");
+        return CF_ERR_MALLOC;
+    }
+    (void)memcpy_s(dir, dirLen, dirPath, dirLen);
+    X509_STORE *store = CreateTrustStore(dir);
+    if (store == NULL) {
+        CfFree(dir);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+
+    HcfX509CertChainValidatorOpensslImpl *impl = (HcfX509CertChainValidatorOpensslImpl *)self;
+    (void)pthread_mutex_lock(&impl->mutex);
+    X509_STORE *oldStore = impl->trustStore;
+    char *oldDir = impl->trustDir;
+    impl->trustStore = store;
+    impl->trustDir = dir;
+    (void)pthread_mutex_unlock(&impl->mutex);
+    X509_STORE_free(oldStore); /* validations still using it hold their own reference */
+    CfFree(oldDir);
+    return CF_SUCCESS;
+}
+
+static X509_STORE *AcquireTrustStore(HcfX509CertChainValidatorOpensslImpl *impl)
+{
+    (void)pthread_mutex_lock(&impl->mutex);
+    X509_STORE *store = impl->trustStore;
+    if ((store != NULL) && (X509_STORE_up_ref(store) != CF_OPENSSL_SUCCESS)) {
+        store = NULL;
+    }
+    (void)pthread_mutex_unlock(&impl->mutex);
+    return store;
+}
+
+/* Drops the reference of a validation, and starts the store afresh once it caches too many issuers. */
+static void ReleaseTrustStore(HcfX509CertChainValidatorOpensslImpl *impl, X509_STORE *store)
+{
+    (void)X509_STORE_lock(store);
+    int32_t cachedNum = sk_X509_OBJECT_num(X509_STORE_get0_objects(store));
+    (void)X509_STORE_unlock(store);
+    X509_STORE *oldStore = NULL;
+    if (cachedNum > TRUST_STORE_CACHE_MAX) {
+        (void)pthread_mutex_lock(&impl->mutex);
+        if (impl->trustStore == store) {
+            X509_STORE *newStore = CreateTrustStore(impl->trustDir);
+            if (newStore != NULL) {
+                oldStore = impl->trustStore;
+                impl->trustStore = newStore;
+            }
+        }
+        (void)pthread_mutex_unlock(&impl->mutex);
+    }
+    X509_STORE_free(oldStore);
+    X509_STORE_free(store);
 }
 
 static CfResult InitX509Certs(const CfArray *certsList, CertsInfo **certs)
@@ -119,6 +237,11 @@ static void FreeX509Certs(CertsInfo **certs, uint32_t certNum)
 
 static X509 *GetX509Cert(const uint8_t *data, size_t len, enum CfEncodingFormat format)
 {
+    format = CfResolveEncodingFormat(data, len, format); /* per cert, an auto chain may mix both */
+    if (format == CF_FORMAT_PEM) {
+        return CfReadX509FromPem(data, len);
+    }
+
     X509 *x509 = NULL;
     BIO *bio = BIO_new_mem_buf(data, len);
     if (bio == NULL) {
@@ -128,40 +251,81 @@ static X509 *GetX509Cert(const uint8_t *data, size_t len, enum CfEncodingFormat
 
     if (format == CF_FORMAT_DER) {
         x509 = d2i_X509_bio(bio, NULL);
-    } else if (format == CF_FORMAT_PEM) {
-        x509 = PEM_read_bio_X509(bio, NULL, NULL, NULL);
     }
 
     BIO_free(bio);
     return x509;
 }
 
-static CfResult ValidateCertChainInner(CertsInfo *certs, uint32_t certNum)
+/*
+ * Follows the path up from the leaf with X509_check_issued, which compares names, key identifiers and key usage
+ * but verifies no signature, and checks that every issuer is a CA. An unambiguous path failing here fails in
+ * X509_verify_cert the same way, so garbage chains are rejected before any store is set up or key is used.
+ * When a cert has several candidate issuers, openssl may build another path, so the decision is left to it, as
+ * it is for a missing issuer when the anchors come from a trust store.
+ * path gets the certs from the leaf to the self issued top and pathLen their number, 0 if the walk did not get
+ * there unambiguously.
+ */
+static CfResult PreflightCertChain(const CertsInfo *certs, uint32_t certNum, bool anchorsInStore, X509 **path,
+    uint32_t *pathLen)
+{
+    *pathLen = 0;
+    X509 *cur = certs[0].x509;
+    for (uint32_t depth = 0; depth < certNum; ++depth) {
+        path[depth] = cur;
+        if (X509_NAME_cmp(X509_get_subject_name(cur), X509_get_issuer_name(cur)) == 0) {
+            *pathLen = depth + 1;
+            return CF_SUCCESS; /* self issued, the top of the path is left to openssl */
+        }
+        X509 *issuer = NULL;
+        bool noCertSign = false;
+        for (uint32_t i = 1; i < certNum; ++i) { // certs[0] is the leaf, never an issuer.
+            if (certs[i].x509 == cur) {
+                continue;
+            }
+            int32_t ret = X509_check_issued(certs[i].x509, cur);
+            if ((ret == X509_V_OK) && (issuer != NULL)) {
+                return CF_SUCCESS;
+            }
+            if (ret == X509_V_OK) {
+                issuer = certs[i].x509;
+            } else if (ret == X509_V_ERR_KEYUSAGE_NO_CERTSIGN) {
+                noCertSign = true;
+            }
+        }
+        if ((issuer == NULL) && anchorsInStore) {
+            return CF_SUCCESS;
+        }
+        if (issuer == NULL) {
+            LOGE("Can not find the issuer of cert %u in the path.", depth);
+            /*
+             * openssl reports an issuer without keyCertSign as an invalid CA, and the missing issuer of the
+             * untrusted leaf as a local one
+             */
+            return ((depth == 0) && !noCertSign) ? CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY : CF_ERR_CRYPTO_OPERATION;
+        }
+        if (X509_check_ca(issuer) == 0) {
+            LOGE("The issuer of cert %u in the path is not a CA.", depth);
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        cur = issuer;
+    }
+    return CF_SUCCESS; /* a loop, leave it to openssl */
+}
+
+/* Verifies leaf against store, chain gets the path openssl built, at most chainCap certs. */
+static CfResult VerifyCertWithCtx(X509_STORE *store, X509 *leaf, STACK_OF(X509) *untrusted, X509 **chain,
+    uint32_t chainCap, uint32_t *chainLen)
 {
     CfResult res = CF_SUCCESS;
-    X509_STORE *store = X509_STORE_new();
     X509_STORE_CTX *verifyCtx = X509_STORE_CTX_new();
     do {
-        if ((store == NULL) || (verifyCtx == NULL)) {
+        if (verifyCtx == NULL) {
             LOGE("Failed to verify cert chain init.");
             res = CF_ERR_MALLOC;
             break;
         }
-
-        for (uint32_t i = certNum - 1; i > 0; i--) { // certs[certNum - 1] represents the 0th cert.
-            if (X509_STORE_add_cert(store, certs[i].x509) != CF_OPENSSL_SUCCESS) {
-                LOGE("Failed to add cert to store.");
-                CfPrintOpensslError();
-                res = CF_ERR_MALLOC;
-                break;
-            }
-        }
-        if (res != CF_SUCCESS) {
-            break;
-        }
-        /* Do not check cert validity against current time. */
-        X509_STORE_set_flags(store, X509_V_FLAG_NO_CHECK_TIME);
-        int32_t resOpenssl = X509_STORE_CTX_init(verifyCtx, store, certs[0].x509, NULL);
+        int32_t resOpenssl = X509_STORE_CTX_init(verifyCtx, store, leaf, untrusted);
         if (resOpenssl != CF_OPENSSL_SUCCESS) {
             LOGE("Failed to init verify ctx.");
             res = CF_ERR_CRYPTO_OPERATION;
@@ -176,18 +340,129 @@ static CfResult ValidateCertChainInner(CertsInfo *certs, uint32_t certNum)
             res = ConvertOpensslErrorMsg(errCode);
             break;
         }
+        /* the built chain holds the certs of store and untrusted themselves, which outlive the ctx */
+        STACK_OF(X509) *built = X509_STORE_CTX_get0_chain(verifyCtx);
+        int32_t builtNum = sk_X509_num(built);
+        *chainLen = 0;
+        for (int32_t i = 0; (i < builtNum) && (*chainLen < chainCap); ++i) {
+            chain[(*chainLen)++] = sk_X509_value(built, i);
+        }
     } while (0);
 
     if (verifyCtx != NULL) {
         X509_STORE_CTX_free(verifyCtx);
     }
-    if (store != NULL) {
-        X509_STORE_free(store);
+    return res;
+}
+
+/* Verifies leaf with the trusted certs as the only anchors. */
+static CfResult VerifyCertWithTrusted(X509 *leaf, X509 *const *trusted, uint32_t trustedNum, unsigned long flags,
+    X509 **chain, uint32_t *chainLen)
+{
+    X509_STORE *store = X509_STORE_new();
+    if (store == NULL) {
+        LOGE("Failed to verify cert chain init.");
+        return CF_ERR_MALLOC;
     }
+    for (uint32_t i = 0; i < trustedNum; i++) {
+        if (X509_STORE_add_cert(store, trusted[i]) != CF_OPENSSL_SUCCESS) {
+            LOGE("Failed to add cert to store.");
+            CfPrintOpensslError();
+            X509_STORE_free(store);
+            return CF_ERR_MALLOC;
+        }
+    }
+    X509_STORE_set_flags(store, flags);
+    CfResult res = VerifyCertWithCtx(store, leaf, NULL, chain, trustedNum + 1, chainLen);
+    X509_STORE_free(store);
     return res;
 }
 
-static CfResult ValidateCertChain(CertsInfo *certs, uint32_t certNum, enum CfEncodingFormat format)
+/* The anchors come from the trust store, the certs of the chain after the leaf are only intermediates. */
+static CfResult VerifyCertWithTrustStore(X509_STORE *store, const CertsInfo *certs, uint32_t certNum)
+{
+    STACK_OF(X509) *untrusted = sk_X509_new_null();
+    if (untrusted == NULL) {
+        LOGE("Failed to new untrusted certs.");
+        return CF_ERR_MALLOC;
+    }
+    CfResult res = CF_SUCCESS;
+    for (uint32_t i = 1; i < certNum; i++) {
+        if (sk_X509_push(untrusted, certs[i].x509) <= 0) {
+            LOGE("Failed to push untrusted cert.");
+            res = CF_ERR_MALLOC;
+            break;
+        }
+    }
+    if (res == CF_SUCCESS) {
+        X509 *leaf = NULL;
+        uint32_t chainLen = 0;
+        res = VerifyCertWithCtx(store, certs[0].x509, untrusted, &leaf, 1, &chainLen);
+    }
+    sk_X509_free(untrusted); /* the certs are owned by the caller */
+    return res;
+}
+
+/*
+ * The certs of the chain after the leaf are the anchors. Upper paths, from the issuer of the leaf to the self
+ * signed top, that were validated are cached, so a chain sharing one only has its leaf verified against the
+ * cached issuer, which is trusted as a partial chain. buf holds certNum * CHAIN_BUF_COUNT certs.
+ */
+static CfResult VerifyCertWithChainAnchors(const CertsInfo *certs, uint32_t certNum, X509 **buf, uint32_t pathLen)
+{
+    X509 **path = buf;
+    X509 **trusted = buf + certNum;
+    X509 **chain = trusted + certNum;
+    uint32_t chainLen = 0;
+    uint8_t key[CF_CHAIN_CACHE_KEY_LEN] = { 0 };
+    if ((pathLen > 1) && (CfChainCacheGetKey(VERIFY_FLAGS, path + 1, pathLen - 1, key) == CF_SUCCESS) &&
+        CfChainCacheContains(key)) {
+        return VerifyCertWithTrusted(certs[0].x509, path + 1, 1, VERIFY_FLAGS | X509_V_FLAG_PARTIAL_CHAIN, chain,
+            &chainLen);
+    }
+
+    for (uint32_t i = 1; i < certNum; i++) { // certs[certNum - 1] represents the 0th cert.
+        trusted[i - 1] = certs[certNum - i].x509;
+    }
+    CfResult res = VerifyCertWithTrusted(certs[0].x509, trusted, certNum - 1, VERIFY_FLAGS, chain, &chainLen);
+    if ((res == CF_SUCCESS) && (chainLen > 1) && CfChainCacheIsCacheable(chain + 1, chainLen - 1) &&
+        (CfChainCacheGetKey(VERIFY_FLAGS, chain + 1, chainLen - 1, key) == CF_SUCCESS)) {
+        CfChainCacheAdd(key);
+    }
+    return res;
+}
+
+static CfResult ValidateCertChainInner(HcfX509CertChainValidatorOpensslImpl *impl, const CertsInfo *certs,
+    uint32_t certNum)
+{
+    X509_STORE *trustStore = AcquireTrustStore(impl);
+    if ((trustStore == NULL) && (certNum <= 1)) {
+        LOGE("The chain has no anchor.");
+        return CF_INVALID_PARAMS;
+    }
+    /* path, trusted certs and built chain, certNum each */
+    X509 **buf = (X509 **)HcfMalloc(sizeof(X509 *) * certNum * CHAIN_BUF_COUNT, 0);
+    CfResult res = CF_ERR_MALLOC;
+    uint32_t pathLen = 0;
+    if (buf == NULL) {
+        LOGE("Failed to malloc for the path.");
+    } else {
+        res = PreflightCertChain(certs, certNum, trustStore != NULL, buf, &pathLen);
+    }
+    if (res == CF_SUCCESS) {
+        /* the path cache is not used with a trust store, the anchors of a cached path may not be in the store */
+        res = (trustStore != NULL) ? VerifyCertWithTrustStore(trustStore, certs, certNum) :
+            VerifyCertWithChainAnchors(certs, certNum, buf, pathLen);
+    }
+    if (trustStore != NULL) {
+        ReleaseTrustStore(impl, trustStore);
+    }
+    CfFree(buf);
+    return res;
+}
+
+static CfResult ValidateCertChain(HcfX509CertChainValidatorOpensslImpl *impl, CertsInfo *certs, uint32_t certNum,
+    enum CfEncodingFormat format)
 {
     for (uint32_t i = 0; i < certNum; ++i) {
         X509 *x509 = GetX509Cert(certs[i].data, certs[i].len, format);
@@ -197,12 +472,12 @@ static CfResult ValidateCertChain(CertsInfo *certs, uint32_t certNum, enum CfEnc
         }
         certs[i].x509 = x509;
     }
-    return ValidateCertChainInner(certs, certNum);
+    return ValidateCertChainInner(impl, certs, certNum);
 }
 
 static CfResult Validate(HcfCertChainValidatorSpi *self, const CfArray *certsList)
 {
-    if ((self == NULL) || (certsList == NULL) || (certsList->count <= 1)) {
+    if ((self == NULL) || (certsList == NULL) || (certsList->count == 0)) {
         LOGE("Invalid input parameter.");
         return CF_INVALID_PARAMS;
     }
@@ -216,7 +491,7 @@ static CfResult Validate(HcfCertChainValidatorSpi *self, const CfArray *certsLis
         LOGE("Failed to init certs, res = %d.", res);
         return res;
     }
-    res = ValidateCertChain(certs, certsList->count, certsList->format);
+    res = ValidateCertChain((HcfX509CertChainValidatorOpensslImpl *)self, certs, certsList->count, certsList->format);
     if (res != CF_SUCCESS) {
         LOGE("Failed to validate cert chain, res = %d.", res);
     }
@@ -230,15 +505,22 @@ CfResult HcfCertChainValidatorSpiCreate(HcfCertChainValidatorSpi **spi)
         LOGE("Invalid params, spi is null!");
         return CF_INVALID_PARAMS;
     }
-    HcfCertChainValidatorSpi *validator = (HcfCertChainValidatorSpi *)HcfMalloc(sizeof(HcfCertChainValidatorSpi), 0);
+    HcfX509CertChainValidatorOpensslImpl *validator =
+        (HcfX509CertChainValidatorOpensslImpl *)HcfMalloc(sizeof(HcfX509CertChainValidatorOpensslImpl), 0);
     if (validator == NULL) {
         LOGE("Failed to allocate certChain validator spi object memory!");
         return CF_ERR_MALLOC;
     }
-    validator->base.getClass = GetX509CertChainValidatorClass;
-    validator->base.destroy = DestroyX509CertChainValidator;
-    validator->engineValidate = Validate;
+    if (pthread_mutex_init(&validator->mutex, NULL) != 0) {
+        LOGE("Failed to init mutex!");
+        CfFree(validator);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    validator->base.base.getClass = GetX509CertChainValidatorClass;
+    validator->base.base.destroy = DestroyX509CertChainValidator;
+    validator->base.engineValidate = Validate;
+    validator->base.engineSetTrustStore = SetTrustStore;
 
-    *spi = validator;
+    *spi = (HcfCertChainValidatorSpi *)validator;
     return CF_SUCCESS;
-}
\ No newline at end of file
+}
@@ -18,12 +18,15 @@
 #include <securec.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
+#include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
 
 #include "config.h"
+#include "cf_check.h"
 #include "cf_log.h"
 #include "cf_memory.h"
+#include "cf_reject.h"
 #include "cf_result.h"
 #include "result.h"
 #include "utils.h"
@@ -740,13 +743,16 @@ static int32_t GetBasicConstraintsX509Openssl(HcfX509CertificateSpi *self)
     /* Path len is only valid for CA cert. */
     if (!constraints->ca) {
         LOGI("The cert in not a CA!");
+        BASIC_CONSTRAINTS_free(constraints);
         return INVALID_CONSTRAINTS_LEN;
     }
     if ((constraints->pathlen == NULL) || (constraints->pathlen->type == V_ASN1_NEG_INTEGER)) {
         LOGE("The cert path len is negative in openssl!");
+        BASIC_CONSTRAINTS_free(constraints);
         return INVALID_CONSTRAINTS_LEN;
     }
     long pathLen = ASN1_INTEGER_get(constraints->pathlen);
+    BASIC_CONSTRAINTS_free(constraints);
     if ((pathLen < 0) || (pathLen > INT_MAX)) {
         LOGE("Get the overflow path length in openssl!");
         return INVALID_CONSTRAINTS_LEN;
@@ -878,20 +884,102 @@ static CfResult GetIssuerAltNamesX509Openssl(HcfX509CertificateSpi *self, CfArra
 
 static X509 *CreateX509CertInner(const CfEncodingBlob *encodingBlob)
 {
-    X509 *x509 = NULL;
-    BIO *bio = BIO_new_mem_buf(encodingBlob->data, encodingBlob->len);
-    if (bio == NULL) {
-        LOGE("Openssl bio new buf failed.");
+    LOGD("The input cert format is: %d.", encodingBlob->encodingFormat);
+    enum CfEncodingFormat format = CfResolveEncodingFormat(encodingBlob->data, encodingBlob->len,
+        encodingBlob->encodingFormat);
+    if (format == CF_FORMAT_PEM) {
+        return CfReadX509FromPem(encodingBlob->data, encodingBlob->len);
+    }
+
+    if ((format != CF_FORMAT_DER) || (encodingBlob->len > INT32_MAX) ||
+        (CfCheckDerFraming(encodingBlob->data, (uint32_t)encodingBlob->len) != CF_SUCCESS)) {
         return NULL;
     }
-    LOGD("The input cert format is: %d.", encodingBlob->encodingFormat);
-    if (encodingBlob->encodingFormat == CF_FORMAT_DER) {
-        x509 = d2i_X509_bio(bio, NULL);
-    } else if (encodingBlob->encodingFormat == CF_FORMAT_PEM) {
-        x509 = PEM_read_bio_X509(bio, NULL, NULL, NULL);
+    const unsigned char *tmp = encodingBlob->data;
+    return d2i_X509(NULL, &tmp, (long)encodingBlob->len);
+}
+
+/* The duplicate shares the X509 by reference, nothing is parsed or copied. */
+static CfResult DupX509Openssl(HcfX509CertificateSpi *self, HcfX509CertificateSpi **out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("The input data is null!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
     }
-    BIO_free(bio);
-    return x509;
+    HcfOpensslX509Cert *realCert = (HcfOpensslX509Cert *)self;
+    HcfOpensslX509Cert *dupCert = (HcfOpensslX509Cert *)HcfMalloc(sizeof(HcfOpensslX509Cert), 0);
+    if (dupCert == NULL) {
+        LOGE("Failed to malloc for x509 instance!");
+        return CF_ERR_MALLOC;
+    }
+    if (X509_up_ref(realCert->x509) != CF_OPENSSL_SUCCESS) {
+        LOGE("Failed to up ref x509 cert!");
+        CfPrintOpensslError();
+        CfFree(dupCert);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    dupCert->base = realCert->base;
+    dupCert->x509 = realCert->x509;
+    *out = (HcfX509CertificateSpi *)dupCert;
+    return CF_SUCCESS;
+}
+
+static int EncodeX509(const void *obj, unsigned char **der)
+{
+    return i2d_X509((X509 *)obj, der);
+}
+
+static CfResult EqualsX509Openssl(HcfX509CertificateSpi *self, HcfX509CertificateSpi *other, bool *out)
+{
+    if ((self == NULL) || (other == NULL) || (out == NULL)) {
+        LOGE("The input data is null!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertClass()) ||
+        !IsClassMatch((CfObjectBase *)other, GetX509CertClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfOpensslX509Cert *realCert = (HcfOpensslX509Cert *)self;
+    HcfOpensslX509Cert *otherCert = (HcfOpensslX509Cert *)other;
+    if (realCert->x509 == otherCert->x509) {
+        *out = true; /* the same object or duplicates of it */
+        return CF_SUCCESS;
+    }
+    uint8_t digest[CF_DER_DIGEST_LEN] = { 0 };
+    uint8_t otherDigest[CF_DER_DIGEST_LEN] = { 0 };
+    if ((CfGetDerDigest(&realCert->digest, EncodeX509, realCert->x509, digest) == CF_SUCCESS) &&
+        (CfGetDerDigest(&otherCert->digest, EncodeX509, otherCert->x509, otherDigest) == CF_SUCCESS)) {
+        *out = (memcmp(digest, otherDigest, CF_DER_DIGEST_LEN) == 0);
+        return CF_SUCCESS;
+    }
+    *out = (X509_cmp(realCert->x509, otherCert->x509) == 0);
+    return CF_SUCCESS;
+}
+
+static CfResult HashCodeX509Openssl(HcfX509CertificateSpi *self, uint32_t *out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("The input data is null!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfOpensslX509Cert *realCert = (HcfOpensslX509Cert *)self;
+    uint8_t digest[CF_DER_DIGEST_LEN] = { 0 };
+    CfResult res = CfGetDerDigest(&realCert->digest, EncodeX509, realCert->x509, digest);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to get cert digest!");
+        return res;
+    }
+    *out = CfDerDigestHash(digest);
+    return CF_SUCCESS;
 }
 
 CfResult OpensslX509CertSpiCreate(const CfEncodingBlob *inStream, HcfX509CertificateSpi **spi)
@@ -900,17 +988,32 @@ CfResult OpensslX509CertSpiCreate(const CfEncodingBlob *inStream, HcfX509Certifi
         LOGE("The input data blob is null!");
         return CF_INVALID_PARAMS;
     }
+    /* malformed input is only counted, logging or dumping the error queue per input is too costly under a flood */
+    X509 *x509 = CreateX509CertInner(inStream);
+    if (x509 == NULL) {
+        CfCountRejectedInput(CF_REJECT_TYPE_CERT);
+        ERR_clear_error();
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = OpensslX509CertSpiCreateWithX509(x509, spi);
+    if (res != CF_SUCCESS) {
+        X509_free(x509);
+    }
+    return res;
+}
+
+CfResult OpensslX509CertSpiCreateWithX509(X509 *x509, HcfX509CertificateSpi **spi)
+{
+    if ((x509 == NULL) || (spi == NULL)) {
+        LOGE("The input data is null!");
+        return CF_INVALID_PARAMS;
+    }
     HcfOpensslX509Cert *realCert = (HcfOpensslX509Cert *)HcfMalloc(sizeof(HcfOpensslX509Cert), 0);
     if (realCert == NULL) {
         LOGE("Failed to malloc for x509 instance!");
         return CF_ERR_MALLOC;
     }
-    realCert->x509 = CreateX509CertInner(inStream);
-    if (realCert->x509 == NULL) {
-        CfFree(realCert);
-        LOGE("Failed to create x509 cert from input data!");
-        return CF_INVALID_PARAMS;
-    }
+    realCert->x509 = x509;
     realCert->base.base.getClass = GetX509CertClass;
     realCert->base.base.destroy = DestroyX509Openssl;
     realCert->base.engineVerify = VerifyX509Openssl;
@@ -932,6 +1035,9 @@ CfResult OpensslX509CertSpiCreate(const CfEncodingBlob *inStream, HcfX509Certifi
     realCert->base.engineGetBasicConstraints = GetBasicConstraintsX509Openssl;
     realCert->base.engineGetSubjectAltNames = GetSubjectAltNamesX509Openssl;
     realCert->base.engineGetIssuerAltNames = GetIssuerAltNamesX509Openssl;
+    realCert->base.engineDup = DupX509Openssl;
+    realCert->base.engineEquals = EqualsX509Openssl;
+    realCert->base.engineHashCode = HashCodeX509Openssl;
     *spi = (HcfX509CertificateSpi *)realCert;
     return CF_SUCCESS;
 }
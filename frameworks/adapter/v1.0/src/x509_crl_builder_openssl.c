@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_crl_builder_openssl.h"
+
+#include <stdlib.h>
+
+#include "securec.h"
+
+#include <openssl/x509.h>
+
+#include "config.h"
+#include "cf_check.h"
+#include "cf_der.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "certificate_openssl_common.h"
+#include "x509_crl_openssl.h"
+
+#define MAX_SERIAL_NUMBER_LEN 20 /* RFC 5280, octets of the INTEGER value */
+#define DER_TAG_EXPLICIT_0 0xA0
+#define CRL_REASON_MAX 10 /* aACompromise */
+#define CRL_REASON_UNUSED 7
+#define REASON_EXT_VALUE_POS 13
+
+/* INTEGER 1, always v2 */
+static const uint8_t TBS_VERSION_V2[] = { 0x02, 0x01, 0x01 };
+/* crlEntryExtensions with only the reasonCode extension, the last byte is the ENUMERATED value */
+static const uint8_t REASON_EXT[] = {
+    0x30, 0x0C, 0x30, 0x0A, 0x06, 0x03, 0x55, 0x1D, 0x15, 0x04, 0x03, 0x0A, 0x01, 0x00
+};
+/* OID 2.5.29.20 cRLNumber */
+static const uint8_t EXT_OID_CRL_NUMBER[] = { 0x06, 0x03, 0x55, 0x1D, 0x14 };
+
+typedef struct {
+    const uint8_t *serial; /* leading zeros dropped */
+    uint32_t serialLen;
+    uint32_t row;
+    uint32_t bodyLen; /* content of the revokedCertificates entry */
+} RevokedRow;
+
+typedef struct {
+    const HcfX509CrlColumns *revoked;
+    RevokedRow *rows;
+    uint32_t entriesLen; /* content of revokedCertificates */
+} RevokedEntries;
+
+static bool IsReasonValid(uint8_t reason)
+{
+    return (reason == HCF_CRL_REASON_ABSENT) || ((reason <= CRL_REASON_MAX) && (reason != CRL_REASON_UNUSED));
+}
+
+static bool IsOneSequence(const CfBlob *blob)
+{
+    uint32_t count = 0;
+    return (blob->data != NULL) && (blob->size <= HCF_MAX_BUFFER_LEN) &&
+        (CfCheckDerSequenceList(blob->data, blob->size, &count) == CF_SUCCESS) && (count == 1);
+}
+
+static CfResult CheckParams(const HcfX509CrlBuildParams *params)
+{
+    if (!IsOneSequence(&params->issuer)) {
+        LOGE("The issuer is not a DER name!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!CfDerIsTimeValid(params->thisUpdate) || !CfDerIsTimeValid(params->nextUpdate) ||
+        (params->thisUpdate > params->nextUpdate)) {
+        LOGE("The update times are out of range!");
+        return CF_INVALID_PARAMS;
+    }
+    if ((params->crlNumber.size != 0) && ((params->crlNumber.data == NULL) ||
+        (CfDerUintSize(params->crlNumber.data, params->crlNumber.size) >
+        CfDerHeaderSize(MAX_SERIAL_NUMBER_LEN) + MAX_SERIAL_NUMBER_LEN))) {
+        LOGE("The crl number is too long!");
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t count = 0;
+    if ((params->extensions.size != 0) && ((params->extensions.data == NULL) ||
+        (params->extensions.size > HCF_MAX_BUFFER_LEN) ||
+        (CfCheckDerSequenceList(params->extensions.data, params->extensions.size, &count) != CF_SUCCESS))) {
+        LOGE("The extensions are not DER Extension entries!");
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult CheckColumns(const HcfX509CrlColumns *revoked)
+{
+    uint32_t count = revoked->count;
+    if (count == 0) {
+        return CF_SUCCESS;
+    }
+    if ((count > HCF_MAX_CRL_BUILD_ENTRY_NUM) || (revoked->serialOffsets.data == NULL) ||
+        (revoked->serialOffsets.size != sizeof(uint32_t) * (count + 1)) || (revoked->serials.data == NULL) ||
+        (revoked->revocationDates.data == NULL) || (revoked->revocationDates.size != sizeof(int64_t) * count) ||
+        (revoked->reasons.data == NULL) || (revoked->reasons.size != count)) {
+        LOGE("The revoked columns do not match the count!");
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+static int CompareRow(const void *a, const void *b)
+{
+    const RevokedRow *left = (const RevokedRow *)a;
+    const RevokedRow *right = (const RevokedRow *)b;
+    if (left->serialLen != right->serialLen) {
+        return (left->serialLen < right->serialLen) ? -1 : 1;
+    }
+    return (left->serialLen == 0) ? 0 : memcmp(left->serial, right->serial, left->serialLen);
+}
+
+static CfResult FillRow(const HcfX509CrlColumns *revoked, uint32_t i, RevokedRow *row)
+{
+    const uint32_t *offsets = (const uint32_t *)revoked->serialOffsets.data;
+    const int64_t *dates = (const int64_t *)revoked->revocationDates.data;
+    uint8_t reason = revoked->reasons.data[i];
+    if ((offsets[i] >= offsets[i + 1]) || (offsets[i + 1] > revoked->serials.size) ||
+        !CfDerIsTimeValid(dates[i]) || !IsReasonValid(reason)) {
+        LOGE("Revoked entry %u is invalid!", i);
+        return CF_INVALID_PARAMS;
+    }
+    row->serial = revoked->serials.data + offsets[i];
+    row->serialLen = offsets[i + 1] - offsets[i];
+    while ((row->serialLen > 0) && (row->serial[0] == 0)) {
+        row->serial++;
+        row->serialLen--;
+    }
+    uint32_t serialSize = CfDerUintSize(row->serial, row->serialLen);
+    if (serialSize > CfDerHeaderSize(MAX_SERIAL_NUMBER_LEN) + MAX_SERIAL_NUMBER_LEN) {
+        LOGE("Revoked serial %u is too long!", i);
+        return CF_INVALID_PARAMS;
+    }
+    row->row = i;
+    row->bodyLen = serialSize + CfDerTimeSize(dates[i]) +
+        ((reason == HCF_CRL_REASON_ABSENT) ? 0 : sizeof(REASON_EXT));
+    return CF_SUCCESS;
+}
+
+/* Rows in ascending serial order, a caller that keeps its list sorted pays no sort. */
+static CfResult SortRows(RevokedRow *rows, uint32_t count)
+{
+    bool sorted = true;
+    for (uint32_t i = 1; sorted && (i < count); i++) {
+        sorted = (CompareRow(&rows[i - 1], &rows[i]) < 0);
+    }
+    if (sorted) {
+        return CF_SUCCESS;
+    }
+    qsort(rows, count, sizeof(RevokedRow), CompareRow);
+    for (uint32_t i = 1; i < count; i++) {
+        if (CompareRow(&rows[i - 1], &rows[i]) == 0) {
+            LOGE("Revoked serial of row %u is duplicated!", rows[i].row);
+            return CF_INVALID_PARAMS;
+        }
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult PrepareEntries(const HcfX509CrlColumns *revoked, RevokedEntries *entries)
+{
+    entries->revoked = revoked;
+    uint32_t count = revoked->count;
+    if (count == 0) {
+        return CF_SUCCESS;
+    }
+    entries->rows = (RevokedRow *)HcfMallocLarge(sizeof(RevokedRow) * count, 0);
+    if (entries->rows == NULL) {
+        LOGE("Failed to malloc for revoked rows!");
+        return CF_ERR_MALLOC;
+    }
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        CfResult res = FillRow(revoked, i, &entries->rows[i]);
+        if (res != CF_SUCCESS) {
+            return res;
+        }
+        total += CfDerHeaderSize(entries->rows[i].bodyLen) + entries->rows[i].bodyLen;
+    }
+    if (total > MAX_LARGE_MEMORY_SIZE) {
+        LOGE("The revoked entries are too large!");
+        return CF_INVALID_PARAMS;
+    }
+    entries->entriesLen = (uint32_t)total;
+    return SortRows(entries->rows, count);
+}
+
+static uint32_t PutEntries(uint8_t *out, const RevokedEntries *entries)
+{
+    const HcfX509CrlColumns *revoked = entries->revoked;
+    const int64_t *dates = (const int64_t *)revoked->revocationDates.data;
+    uint32_t pos = CfDerPutHeader(out, CF_DER_TAG_SEQUENCE, entries->entriesLen);
+    for (uint32_t i = 0; i < revoked->count; i++) {
+        const RevokedRow *row = &entries->rows[i];
+        pos += CfDerPutHeader(out + pos, CF_DER_TAG_SEQUENCE, row->bodyLen);
+        pos += CfDerPutUint(out + pos, CF_DER_TAG_INTEGER, row->serial, row->serialLen);
+        pos += CfDerPutTime(out + pos, dates[row->row]);
+        uint8_t reason = revoked->reasons.data[row->row];
+        if (reason != HCF_CRL_REASON_ABSENT) {
+            (void)memcpy_s(out + pos, sizeof(REASON_EXT), REASON_EXT, sizeof(REASON_EXT));
+            out[pos + REASON_EXT_VALUE_POS] = reason;
+            pos += sizeof(REASON_EXT);
+        }
+    }
+    return pos;
+}
+
+/* crlExtensions [0] EXPLICIT Extensions, size 0 when there are none */
+static CfResult EncodeCrlExtensions(const HcfX509CrlBuildParams *params, CfBlob *out)
+{
+    uint32_t numberLen = 0;
+    uint32_t numberBodyLen = 0;
+    uint32_t numberValueLen = 0;
+    if (params->crlNumber.size != 0) {
+        numberValueLen = CfDerUintSize(params->crlNumber.data, params->crlNumber.size);
+        numberBodyLen = sizeof(EXT_OID_CRL_NUMBER) + CfDerHeaderSize(numberValueLen) + numberValueLen;
+        numberLen = CfDerHeaderSize(numberBodyLen) + numberBodyLen;
+    }
+    uint32_t listLen = numberLen + params->extensions.size;
+    if (listLen == 0) {
+        return CF_SUCCESS;
+    }
+    uint32_t seqLen = CfDerHeaderSize(listLen) + listLen;
+    uint32_t size = CfDerHeaderSize(seqLen) + seqLen;
+    uint8_t *der = (uint8_t *)HcfMalloc(size, 0);
+    if (der == NULL) {
+        LOGE("Failed to malloc for crl extensions!");
+        return CF_ERR_MALLOC;
+    }
+    uint32_t pos = CfDerPutHeader(der, DER_TAG_EXPLICIT_0, seqLen);
+    pos += CfDerPutHeader(der + pos, CF_DER_TAG_SEQUENCE, listLen);
+    if (numberLen != 0) {
+        pos += CfDerPutHeader(der + pos, CF_DER_TAG_SEQUENCE, numberBodyLen);
+        (void)memcpy_s(der + pos, size - pos, EXT_OID_CRL_NUMBER, sizeof(EXT_OID_CRL_NUMBER));
+        pos += sizeof(EXT_OID_CRL_NUMBER);
+        pos += CfDerPutHeader(der + pos, CF_DER_TAG_OCTET_STRING, numberValueLen);
+        pos += CfDerPutUint(der + pos, CF_DER_TAG_INTEGER, params->crlNumber.data, params->crlNumber.size);
+    }
+    if (params->extensions.size != 0) {
+        (void)memcpy_s(der + pos, size - pos, params->extensions.data, params->extensions.size);
+    }
+    out->data = der;
+    out->size = size;
+    return CF_SUCCESS;
+}
+
+static CfResult EncodeAndSign(const HcfX509CrlBuildParams *params, const RevokedEntries *entries,
+    const CfBlob *crlExts, const CfOpensslSigner *signer, CfEncodingBlob *derOut)
+{
+    uint32_t entriesSize = (entries->revoked->count == 0) ? 0 :
+        (CfDerHeaderSize(entries->entriesLen) + entries->entriesLen);
+    uint32_t tbsBodyLen = sizeof(TBS_VERSION_V2) + signer->algIdLen + params->issuer.size +
+        CfDerTimeSize(params->thisUpdate) + CfDerTimeSize(params->nextUpdate) + entriesSize + crlExts->size;
+    uint32_t tbsLen = CfDerHeaderSize(tbsBodyLen) + tbsBodyLen;
+    uint32_t bufLen = CfOpensslSignedSize(signer, tbsLen);
+    uint8_t *buf = (uint8_t *)HcfMallocLarge(bufLen, 0);
+    if (buf == NULL) {
+        LOGE("Failed to malloc for crl der!");
+        return CF_ERR_MALLOC;
+    }
+
+    uint8_t *tbs = buf + CF_SIGNED_TBS_OFFSET;
+    uint32_t pos = CfDerPutHeader(tbs, CF_DER_TAG_SEQUENCE, tbsBodyLen);
+    (void)memcpy_s(tbs + pos, tbsLen - pos, TBS_VERSION_V2, sizeof(TBS_VERSION_V2));
+    pos += sizeof(TBS_VERSION_V2);
+    (void)memcpy_s(tbs + pos, tbsLen - pos, signer->algId, signer->algIdLen);
+    pos += signer->algIdLen;
+    (void)memcpy_s(tbs + pos, tbsLen - pos, params->issuer.data, params->issuer.size);
+    pos += params->issuer.size;
+    pos += CfDerPutTime(tbs + pos, params->thisUpdate);
+    pos += CfDerPutTime(tbs + pos, params->nextUpdate);
+    if (entriesSize != 0) {
+        pos += PutEntries(tbs + pos, entries);
+    }
+    if (crlExts->size != 0) {
+        (void)memcpy_s(tbs + pos, tbsLen - pos, crlExts->data, crlExts->size);
+    }
+
+    CfBlob signedDer = { 0, NULL };
+    CfResult res = CfOpensslSignTbs(signer, buf, bufLen, tbsLen, &signedDer);
+    if (res != CF_SUCCESS) {
+        CfFree(buf);
+        return res;
+    }
+    /* the signed crl starts a few bytes into buf, move it to the front so buf itself is handed out */
+    (void)memmove_s(buf, bufLen, signedDer.data, signedDer.size);
+    derOut->data = buf;
+    derOut->len = signedDer.size;
+    derOut->encodingFormat = CF_FORMAT_DER;
+    return CF_SUCCESS;
+}
+
+static CfResult CreateCrlSpi(const CfEncodingBlob *der, HcfX509CrlSpi **spi)
+{
+    const unsigned char *tmp = der->data;
+    X509_CRL *crl = d2i_X509_CRL(NULL, &tmp, (long)der->len);
+    if ((crl == NULL) || (tmp != der->data + der->len)) {
+        LOGE("The built crl can not be decoded, check the issuer and extensions!");
+        CfPrintOpensslError();
+        X509_CRL_free(crl);
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = HcfCX509CrlSpiCreateWithCrl(crl, spi);
+    if (res != CF_SUCCESS) {
+        X509_CRL_free(crl);
+    }
+    return res;
+}
+
+CfResult OpensslX509CrlSpiBuild(const HcfX509CrlBuildParams *params, const HcfX509CrlColumns *revoked,
+    const CfBlob *signingKey, CfEncodingBlob *derOut, HcfX509CrlSpi **spi)
+{
+    if ((params == NULL) || (revoked == NULL) || (signingKey == NULL) || (derOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = CheckParams(params);
+    if (res == CF_SUCCESS) {
+        res = CheckColumns(revoked);
+    }
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    RevokedEntries entries = { NULL, NULL, 0 };
+    CfBlob crlExts = { 0, NULL };
+    CfOpensslSigner signer = { NULL, NULL, NULL, 0 };
+    CfEncodingBlob der = { NULL, 0, CF_FORMAT_DER };
+    res = PrepareEntries(revoked, &entries);
+    if (res == CF_SUCCESS) {
+        res = EncodeCrlExtensions(params, &crlExts);
+    }
+    if (res == CF_SUCCESS) {
+        res = CfOpensslSignerInit(signingKey, &signer);
+    }
+    if (res == CF_SUCCESS) {
+        res = EncodeAndSign(params, &entries, &crlExts, &signer, &der);
+    }
+    CfOpensslSignerFree(&signer);
+    CfFree(crlExts.data);
+    CfFree(entries.rows);
+    if ((res == CF_SUCCESS) && (spi != NULL)) {
+        res = CreateCrlSpi(&der, spi);
+    }
+    if (res != CF_SUCCESS) {
+        CfFree(der.data);
+        return res;
+    }
+    *derOut = der;
+    return CF_SUCCESS;
+}
@@ -17,6 +17,9 @@
 
 #include "securec.h"
 
+#include <stdatomic.h>
+#include <stddef.h>
+
 #include <openssl/x509.h>
 #include <openssl/bio.h>
 
@@ -31,12 +34,29 @@
 
 #define OPENSSL_ERROR_SERIAL_NUMBER (-1)
 
+struct HcfX509CrlIssuerRef {
+    atomic_uint refCount;
+    CfBlob blob;
+    uint8_t data[];
+};
+
+typedef struct HcfX509CrlEntrySlab HcfX509CrlEntrySlab;
+
 typedef struct {
     HcfX509CrlEntry base;
     X509_REVOKED *rev;
-    CfBlob *certIssuer;
+    HcfX509CrlIssuerRef *certIssuer;
+    HcfX509CrlEntrySlab *slab; /* when set, rev and certIssuer are owned by the slab */
 } HcfX509CRLEntryOpensslImpl;
 
+/* One block holding the entries of a whole CRL, freed when the last of its entries is destroyed. */
+struct HcfX509CrlEntrySlab {
+    atomic_uint refCount;
+    X509_CRL *crl;
+    HcfX509CrlIssuerRef *certIssuer;
+    HcfX509CRLEntryOpensslImpl entries[];
+};
+
 static const char *GetClass(void)
 {
     return "HcfX509CRLEntryOpensslImpl.HcfX509CrlEntry";
@@ -130,7 +150,8 @@ static CfResult GetCertIssuer(HcfX509CrlEntry *self, CfBlob *encodedOut)
         LOGE("Input wrong class type!");
         return CF_INVALID_PARAMS;
     }
-    CfBlob *certIssuer = ((HcfX509CRLEntryOpensslImpl *)self)->certIssuer;
+    HcfX509CrlIssuerRef *issuerRef = ((HcfX509CRLEntryOpensslImpl *)self)->certIssuer;
+    CfBlob *certIssuer = (issuerRef == NULL) ? NULL : &issuerRef->blob;
     if (!IsBlobValid(certIssuer)) {
         LOGE("Get certIssuer fail! No certIssuer in CRL entry.");
         return CF_NOT_SUPPORT;
@@ -179,24 +200,53 @@ static CfResult GetRevocationDate(HcfX509CrlEntry *self, CfBlob *out)
     return CF_SUCCESS;
 }
 
-static CfResult DeepCopyCertIssuer(HcfX509CRLEntryOpensslImpl *returnCRLEntry, CfBlob *certIssuer)
+CfResult HcfCX509CrlIssuerRefCreate(const CfBlob *issuer, HcfX509CrlIssuerRef **refOut)
 {
-    returnCRLEntry->certIssuer = (CfBlob *)HcfMalloc(sizeof(CfBlob), 0);
-    if (returnCRLEntry->certIssuer == NULL) {
-        LOGE("Failed to malloc certIssuer!");
-        return CF_ERR_MALLOC;
+    if (!IsBlobValid(issuer) || (issuer->size > HCF_MAX_STR_LEN + 1) || (refOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
     }
-    size_t len = certIssuer->size;
-    returnCRLEntry->certIssuer->size = len;
-    returnCRLEntry->certIssuer->data = (uint8_t *)HcfMalloc(len, 0);
-    if (returnCRLEntry->certIssuer->data == NULL) {
-        LOGE("Failed to malloc certIssuer data!");
+    HcfX509CrlIssuerRef *ref = (HcfX509CrlIssuerRef *)HcfMalloc(sizeof(HcfX509CrlIssuerRef) + issuer->size, 0);
+    if (ref == NULL) {
+        LOGE("Failed to malloc certIssuer!");
         return CF_ERR_MALLOC;
     }
-    (void)memcpy_s(returnCRLEntry->certIssuer->data, len, certIssuer->data, len);
+    (void)memcpy_s(ref->data, issuer->size, issuer->data, issuer->size);
+    ref->blob.data = ref->data;
+    ref->blob.size = issuer->size;
+    atomic_init(&ref->refCount, 1);
+    *refOut = ref;
     return CF_SUCCESS;
 }
 
+HcfX509CrlIssuerRef *HcfCX509CrlIssuerRefAcquire(HcfX509CrlIssuerRef *ref)
+{
+    if (ref != NULL) {
+        (void)atomic_fetch_add(&ref->refCount, 1);
+    }
+    return ref;
+}
+
+void HcfCX509CrlIssuerRefRelease(HcfX509CrlIssuerRef *ref)
+{
+    if (ref == NULL) {
+        return;
+    }
+    if (atomic_fetch_sub(&ref->refCount, 1) == 1) {
+        CfFree(ref);
+    }
+}
+
+static void SlabRelease(HcfX509CrlEntrySlab *slab)
+{
+    if (atomic_fetch_sub(&slab->refCount, 1) != 1) {
+        return;
+    }
+    X509_CRL_free(slab->crl);
+    HcfCX509CrlIssuerRefRelease(slab->certIssuer);
+    CfFree(slab);
+}
+
 static void Destroy(CfObjectBase *self)
 {
     if (self == NULL) {
@@ -208,20 +258,34 @@ static void Destroy(CfObjectBase *self)
         return;
     }
     HcfX509CRLEntryOpensslImpl *realCrlEntry = (HcfX509CRLEntryOpensslImpl *)self;
+    if (realCrlEntry->slab != NULL) {
+        SlabRelease(realCrlEntry->slab);
+        return;
+    }
     if (realCrlEntry->rev != NULL) {
         X509_REVOKED_free(realCrlEntry->rev);
         realCrlEntry->rev = NULL;
     }
-    if (realCrlEntry->certIssuer != NULL) {
-        CfFree(realCrlEntry->certIssuer->data);
-        realCrlEntry->certIssuer->data = NULL;
-        CfFree(realCrlEntry->certIssuer);
-        realCrlEntry->certIssuer = NULL;
-    }
+    HcfCX509CrlIssuerRefRelease(realCrlEntry->certIssuer);
+    realCrlEntry->certIssuer = NULL;
     CfFree(realCrlEntry);
 }
 
-CfResult HcfCX509CRLEntryCreate(X509_REVOKED *rev, HcfX509CrlEntry **crlEntryOut, CfBlob *certIssuer)
+static void InitCrlEntry(HcfX509CRLEntryOpensslImpl *crlEntry, X509_REVOKED *rev, HcfX509CrlIssuerRef *certIssuer,
+    HcfX509CrlEntrySlab *slab)
+{
+    crlEntry->rev = rev;
+    crlEntry->certIssuer = certIssuer;
+    crlEntry->slab = slab;
+    crlEntry->base.base.getClass = GetClass;
+    crlEntry->base.base.destroy = Destroy;
+    crlEntry->base.getEncoded = GetEncoded;
+    crlEntry->base.getSerialNumber = GetSerialNumber;
+    crlEntry->base.getCertIssuer = GetCertIssuer;
+    crlEntry->base.getRevocationDate = GetRevocationDate;
+}
+
+CfResult HcfCX509CRLEntryCreate(X509_REVOKED *rev, HcfX509CrlEntry **crlEntryOut, HcfX509CrlIssuerRef *certIssuer)
 {
     if ((rev == NULL) || (crlEntryOut == NULL) || certIssuer == NULL) {
         LOGE("Invalid Paramas!");
@@ -240,17 +304,57 @@ CfResult HcfCX509CRLEntryCreate(X509_REVOKED *rev, HcfX509CrlEntry **crlEntryOut
         LOGE("Failed to dup x509 revoked");
         return CF_ERR_MALLOC;
     }
-    returnCRLEntry->rev = tmp;
-    returnCRLEntry->certIssuer = NULL;
-    returnCRLEntry->base.base.getClass = GetClass;
-    returnCRLEntry->base.base.destroy = Destroy;
-    returnCRLEntry->base.getEncoded = GetEncoded;
-    returnCRLEntry->base.getSerialNumber = GetSerialNumber;
-    returnCRLEntry->base.getCertIssuer = GetCertIssuer;
-    returnCRLEntry->base.getRevocationDate = GetRevocationDate;
-    if (DeepCopyCertIssuer(returnCRLEntry, certIssuer) != CF_SUCCESS) {
-        LOGI("No cert issuer find or deep copy cert issuer fail!");
-    }
+    InitCrlEntry(returnCRLEntry, tmp, HcfCX509CrlIssuerRefAcquire(certIssuer), NULL);
     *crlEntryOut = (HcfX509CrlEntry *)returnCRLEntry;
     return CF_SUCCESS;
 }
+
+CfResult HcfCX509CRLEntryCreateBatch(X509_CRL *crl, HcfX509CrlIssuerRef *certIssuer, CfArray *entrysOut)
+{
+    if ((crl == NULL) || (certIssuer == NULL) || (entrysOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    STACK_OF(X509_REVOKED) *entrys = X509_CRL_get_REVOKED(crl);
+    int32_t revokedNum = (entrys == NULL) ? 0 : sk_X509_REVOKED_num(entrys);
+    if (revokedNum <= 0) {
+        LOGE("Get revoked invalid number!");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    if ((uint32_t)revokedNum > (UINT32_MAX - sizeof(HcfX509CrlEntrySlab)) / sizeof(HcfX509CRLEntryOpensslImpl)) {
+        LOGE("Revoked number is too large!");
+        return CF_ERR_MALLOC;
+    }
+    /* a CfBlob array of more than 327k entries passes MAX_MEMORY_SIZE, the builder makes CRLs that large */
+    CfBlob *blobs = (CfBlob *)HcfMallocLarge(sizeof(CfBlob) * revokedNum, 0);
+    if (blobs == NULL) {
+        LOGE("Failed to malloc for entrysOut array!");
+        return CF_ERR_MALLOC;
+    }
+    HcfX509CrlEntrySlab *slab = (HcfX509CrlEntrySlab *)HcfMallocLarge(
+        sizeof(HcfX509CrlEntrySlab) + sizeof(HcfX509CRLEntryOpensslImpl) * revokedNum, 0);
+    if (slab == NULL) {
+        LOGE("Failed to malloc for x509 entry slab!");
+        CfFree(blobs);
+        return CF_ERR_MALLOC;
+    }
+    /* the entries point into the crl, so the slab keeps the crl alive until the last entry is destroyed */
+    if (X509_CRL_up_ref(crl) != CF_OPENSSL_SUCCESS) {
+        LOGE("Failed to up ref x509 crl!");
+        CfPrintOpensslError();
+        CfFree(slab);
+        CfFree(blobs);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    slab->crl = crl;
+    slab->certIssuer = HcfCX509CrlIssuerRefAcquire(certIssuer);
+    atomic_init(&slab->refCount, (uint32_t)revokedNum);
+    for (int32_t i = 0; i < revokedNum; i++) {
+        InitCrlEntry(&slab->entries[i], sk_X509_REVOKED_value(entrys, i), certIssuer, slab);
+        blobs[i].data = (uint8_t *)&slab->entries[i];
+        blobs[i].size = sizeof(HcfX509CrlEntry);
+    }
+    entrysOut->data = blobs;
+    entrysOut->count = (uint32_t)revokedNum;
+    return CF_SUCCESS;
+}
@@ -17,7 +17,10 @@
 
 #include "securec.h"
 
+#include <stdatomic.h>
+
 #include <openssl/bio.h>
+#include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
 #include <openssl/pkcs7.h>
@@ -26,8 +29,10 @@
 
 #include "config.h"
 #include "fwk_class.h"
+#include "cf_check.h"
 #include "cf_log.h"
 #include "cf_memory.h"
+#include "cf_reject.h"
 #include "certificate_openssl_class.h"
 #include "certificate_openssl_common.h"
 #include "utils.h"
@@ -35,18 +40,27 @@
 #include "x509_crl_entry_openssl.h"
 #include "x509_crl_spi.h"
 
+/* Revoked entries of a crl in ascending serial order, shared by reference between duplicates of the crl. */
+typedef struct {
+    atomic_uint refCount;
+    uint32_t count;
+    X509_REVOKED *items[];
+} HcfX509CrlSerialIndex;
+
 typedef struct {
     HcfX509CrlSpi base;
     X509_CRL *crl;
-    CfBlob *certIssuer;
+    HcfX509CrlIssuerRef *certIssuer;
+    HcfX509CrlSerialIndex *serialIndex; /* built on the first lookup by serial, stays NULL without revoked entries */
+    CfDerDigestCache digest;
 } HcfX509CRLOpensslImpl;
 
 #define OPENSSL_INVALID_VERSION (-1)
 #define OPENSSL_ERROR 0
 #define TYPE_NAME "X509"
 #define OID_LENGTH 128
-#define MAX_REV_NUM 256
 #define MAX_SIGNATURE_LEN 8192
+#define SECONDS_PER_DAY 86400
 
 static const char *GetClass(void)
 {
@@ -137,7 +151,7 @@ static CfResult GetEncoded(HcfX509CrlSpi *self, CfEncodingBlob *encodedOut)
         CfPrintOpensslError();
         return CF_ERR_CRYPTO_OPERATION;
     }
-    encodedOut->data = (uint8_t *)HcfMalloc(length, 0);
+    encodedOut->data = (uint8_t *)HcfMallocLarge(length, 0); /* a built crl may exceed MAX_MEMORY_SIZE */
     if (encodedOut->data == NULL) {
         LOGE("Failed to malloc for crl encoded data!");
         OPENSSL_free(out);
@@ -237,35 +251,35 @@ static CfResult GetIssuerName(HcfX509CrlSpi *self, CfBlob *out)
         CfPrintOpensslError();
         return CF_ERR_CRYPTO_OPERATION;
     }
-    const char *issuer = X509_NAME_oneline(x509Name, NULL, 0);
+    char *issuer = X509_NAME_oneline(x509Name, NULL, 0);
     if ((issuer == NULL) || (strlen(issuer) > HCF_MAX_STR_LEN)) {
         LOGE("X509Name convert char fail or issuer name is too long!");
         CfPrintOpensslError();
+        OPENSSL_free(issuer);
         return CF_ERR_CRYPTO_OPERATION;
     }
     uint32_t length = strlen(issuer) + 1;
     out->data = (uint8_t *)HcfMalloc(length, 0);
     if (out->data == NULL) {
         LOGE("Failed to malloc for crl issuer data!");
+        OPENSSL_free(issuer);
         return CF_ERR_MALLOC;
     }
     (void)memcpy_s(out->data, length, issuer, length);
     out->size = length;
+    OPENSSL_free(issuer);
     return CF_SUCCESS;
 }
 
 static CfResult SetCertIssuer(HcfX509CrlSpi *self)
 {
-    ((HcfX509CRLOpensslImpl *)self)->certIssuer = (CfBlob *)HcfMalloc(sizeof(CfBlob), 0);
-    if (((HcfX509CRLOpensslImpl *)self)->certIssuer == NULL) {
-        LOGE("Failed to malloc for certIssuer!");
-        return CF_ERR_MALLOC;
-    }
-    CfResult res = GetIssuerName(self, ((HcfX509CRLOpensslImpl *)self)->certIssuer);
+    CfBlob issuer = { 0, NULL };
+    CfResult res = GetIssuerName(self, &issuer);
     if (res != CF_SUCCESS) {
-        CfFree(((HcfX509CRLOpensslImpl *)self)->certIssuer);
-        ((HcfX509CRLOpensslImpl *)self)->certIssuer = NULL;
+        return res;
     }
+    res = HcfCX509CrlIssuerRefCreate(&issuer, &((HcfX509CRLOpensslImpl *)self)->certIssuer);
+    CfBlobDataFree(&issuer);
     return res;
 }
 
@@ -410,43 +424,183 @@ static CfResult GetRevokedCertWithCert(HcfX509CrlSpi *self, HcfX509Certificate *
     return CF_SUCCESS;
 }
 
-static CfResult DeepCopyRevokedCertificates(HcfX509CrlSpi *self, const STACK_OF(X509_REVOKED) *entrys,
-    int32_t i, CfArray *entrysOut)
+static int CompareRevokedSerial(const void *a, const void *b)
 {
-    X509_REVOKED *rev = sk_X509_REVOKED_value(entrys, i);
-    if (rev == NULL) {
-        LOGE("sk_X509_REVOKED_value fail!");
-        CfPrintOpensslError();
-        return CF_ERR_CRYPTO_OPERATION;
+    return ASN1_INTEGER_cmp(X509_REVOKED_get0_serialNumber(*(X509_REVOKED * const *)a),
+        X509_REVOKED_get0_serialNumber(*(X509_REVOKED * const *)b));
+}
+
+/*
+ * openssl sorts the revoked stack in place on its first lookup, under a lock of the crl. Make that lookup here
+ * before reading the stack, so a concurrent isRevoked cannot sort it under the reader.
+ */
+static CfResult SortOpensslRevoked(X509_CRL *crl)
+{
+    ASN1_INTEGER *serial = ASN1_INTEGER_new();
+    if (serial == NULL) {
+        LOGE("Failed to new serial!");
+        return CF_ERR_MALLOC;
     }
-    HcfX509CrlEntry *crlEntry = NULL;
-    CfResult res = HcfCX509CRLEntryCreate(rev, &crlEntry, ((HcfX509CRLOpensslImpl *)self)->certIssuer);
-    if (res != CF_SUCCESS || crlEntry == NULL) {
-        LOGE("X509 CRL entry create fail, res : %d!", res);
+    X509_REVOKED *unused = NULL;
+    (void)X509_CRL_get0_by_serial(crl, &unused, serial);
+    ASN1_INTEGER_free(serial);
+    return CF_SUCCESS;
+}
+
+/* The serial index is never modified once built, so lookups need no lock. */
+static CfResult BuildSerialIndex(X509_CRL *crl, HcfX509CrlSerialIndex **indexOut)
+{
+    if (SortOpensslRevoked(crl) != CF_SUCCESS) {
+        return CF_ERR_MALLOC;
+    }
+    STACK_OF(X509_REVOKED) *entrys = X509_CRL_get_REVOKED(crl);
+    int32_t revokedNum = (entrys == NULL) ? 0 : sk_X509_REVOKED_num(entrys);
+    if (revokedNum <= 0) {
+        *indexOut = NULL;
+        return CF_SUCCESS;
+    }
+    HcfX509CrlSerialIndex *index = (HcfX509CrlSerialIndex *)HcfMallocLarge(
+        sizeof(HcfX509CrlSerialIndex) + sizeof(X509_REVOKED *) * revokedNum, 0);
+    if (index == NULL) {
+        LOGE("Failed to malloc for serial index!");
+        return CF_ERR_MALLOC;
+    }
+    for (int32_t i = 0; i < revokedNum; i++) {
+        index->items[i] = sk_X509_REVOKED_value(entrys, i);
+        if ((index->items[i] == NULL) || (X509_REVOKED_get0_serialNumber(index->items[i]) == NULL)) {
+            LOGE("Failed to get revoked serial!");
+            CfFree(index);
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+    }
+    /* CRLs written in serial order, such as the ones HcfX509CrlBuild makes, need no sort */
+    bool sorted = true;
+    for (int32_t i = 1; sorted && (i < revokedNum); i++) {
+        sorted = (CompareRevokedSerial(&index->items[i - 1], &index->items[i]) <= 0);
+    }
+    if (!sorted) {
+        qsort(index->items, revokedNum, sizeof(X509_REVOKED *), CompareRevokedSerial);
+    }
+    atomic_init(&index->refCount, 1);
+    index->count = (uint32_t)revokedNum;
+    *indexOut = index;
+    return CF_SUCCESS;
+}
+
+/* The index is a cache of the revoked entries, racing lookups keep the first one published. */
+static CfResult GetSerialIndex(const HcfX509CRLOpensslImpl *impl, const HcfX509CrlSerialIndex **indexOut)
+{
+    HcfX509CrlSerialIndex **cache = (HcfX509CrlSerialIndex **)&impl->serialIndex;
+    HcfX509CrlSerialIndex *index = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+    if (index != NULL) {
+        *indexOut = index;
+        return CF_SUCCESS;
+    }
+    CfResult res = BuildSerialIndex(impl->crl, &index);
+    if ((res != CF_SUCCESS) || (index == NULL)) {
+        *indexOut = NULL;
         return res;
     }
-    entrysOut->data[i].data = (uint8_t *)crlEntry;
-    entrysOut->data[i].size = sizeof(HcfX509CrlEntry);
+    HcfX509CrlSerialIndex *expected = NULL;
+    if (!__atomic_compare_exchange_n(cache, &expected, index, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        CfFree(index);
+        index = expected;
+    }
+    *indexOut = index;
     return CF_SUCCESS;
 }
 
-static void DestroyCRLEntryArray(CfArray *arr)
+static HcfX509CrlSerialIndex *SerialIndexAcquire(HcfX509CrlSerialIndex *index)
 {
-    if (arr == NULL) {
-        LOGD("The input array is null, no need to free.");
-        return;
+    if (index != NULL) {
+        (void)atomic_fetch_add(&index->refCount, 1);
+    }
+    return index;
+}
+
+static void SerialIndexRelease(HcfX509CrlSerialIndex *index)
+{
+    if ((index != NULL) && (atomic_fetch_sub(&index->refCount, 1) == 1)) {
+        CfFree(index);
+    }
+}
+
+static const uint8_t *SkipLeadingZero(const uint8_t *data, uint32_t *len)
+{
+    while ((*len > 0) && (*data == 0)) {
+        data++;
+        (*len)--;
+    }
+    return data;
+}
+
+/* Orders like ASN1_INTEGER_cmp, with the key taken as a non-negative big-endian magnitude. */
+static int32_t CompareSerialWithKey(const ASN1_INTEGER *serial, const uint8_t *key, uint32_t keyLen)
+{
+    if (ASN1_STRING_type(serial) == V_ASN1_NEG_INTEGER) {
+        return -1;
     }
-    for (uint32_t i = 0; i < arr->count; ++i) {
-        if (arr->data[i].data == NULL) {
-            continue;
+    uint32_t serialLen = (uint32_t)ASN1_STRING_length(serial);
+    const uint8_t *serialData = SkipLeadingZero(ASN1_STRING_get0_data(serial), &serialLen);
+    if (serialLen != keyLen) {
+        return (serialLen < keyLen) ? -1 : 1;
+    }
+    return (keyLen == 0) ? 0 : memcmp(serialData, key, keyLen);
+}
+
+static X509_REVOKED *FindRevokedBySerial(const HcfX509CrlSerialIndex *index, const CfBlob *serial)
+{
+    uint32_t keyLen = serial->size;
+    const uint8_t *key = SkipLeadingZero(serial->data, &keyLen);
+    if (index == NULL) {
+        return NULL;
+    }
+    X509_REVOKED * const *items = index->items;
+    uint32_t low = 0;
+    uint32_t high = index->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2; /* 2: halve the search range */
+        int32_t cmp = CompareSerialWithKey(X509_REVOKED_get0_serialNumber(items[mid]), key, keyLen);
+        if (cmp == 0) {
+            return items[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
-        HcfX509CrlEntry *crlEntry = (HcfX509CrlEntry *)(arr->data[i].data);
-        crlEntry->base.destroy((CfObjectBase *)crlEntry);
-        arr->data[i].data = NULL;
-        arr->data[i].size = 0;
     }
-    CfFree(arr->data);
-    arr->data = NULL;
+    return NULL;
+}
+
+static CfResult GetRevokedCertWithSerial(HcfX509CrlSpi *self, const CfBlob *serial, HcfX509CrlEntry **entryOut)
+{
+    if ((self == NULL) || !IsBlobValid(serial) || (entryOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CRLOpensslImpl *impl = (HcfX509CRLOpensslImpl *)self;
+    const HcfX509CrlSerialIndex *index = NULL;
+    CfResult res = GetSerialIndex(impl, &index);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to build serial index!");
+        return res;
+    }
+    X509_REVOKED *rev = FindRevokedBySerial(index, serial);
+    if (rev == NULL) {
+        LOGD("Serial is not revoked by this crl.");
+        return CF_NOT_EXIST;
+    }
+    res = HcfCX509CRLEntryCreate(rev, entryOut, impl->certIssuer);
+    if (res != CF_SUCCESS) {
+        LOGE("X509 CRL entry create fail, res : %d!", res);
+        return res;
+    }
+    return CF_SUCCESS;
 }
 
 static CfResult GetRevokedCerts(HcfX509CrlSpi *self, CfArray *entrysOut)
@@ -466,29 +620,345 @@ static CfResult GetRevokedCerts(HcfX509CrlSpi *self, CfArray *entrysOut)
         CfPrintOpensslError();
         return CF_ERR_CRYPTO_OPERATION;
     }
+    /* a built CRL may list hundreds of thousands of entries, the batch allocation bounds the count */
     int32_t revokedNum = sk_X509_REVOKED_num(entrys);
-    if ((revokedNum <= 0) || (revokedNum > MAX_REV_NUM)) {
+    if (revokedNum <= 0) {
         LOGE("Get revoked invalid number!");
         CfPrintOpensslError();
         return CF_ERR_CRYPTO_OPERATION;
     }
-    uint32_t blobSize = sizeof(CfBlob) * revokedNum;
-    entrysOut->data = (CfBlob *)HcfMalloc(blobSize, 0);
-    if (entrysOut->data == NULL) {
-        LOGE("Failed to malloc for entrysOut array!");
+    CfResult res = HcfCX509CRLEntryCreateBatch(crl, ((HcfX509CRLOpensslImpl *)self)->certIssuer, entrysOut);
+    if (res != CF_SUCCESS) {
+        LOGE("X509 CRL entries create fail, res : %d!", res);
+        return res;
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult AllocRevokedColumns(uint32_t count, uint32_t serialLen, HcfX509CrlColumns *out)
+{
+    if (count > ((UINT32_MAX / sizeof(int64_t)) - 1)) {
+        LOGE("Revoked number is too large!");
+        return CF_INVALID_PARAMS;
+    }
+    out->serialOffsets.data = (uint8_t *)HcfMallocLarge(sizeof(uint32_t) * (count + 1), 0);
+    if (out->serialOffsets.data == NULL) {
+        LOGE("Failed to malloc for serial offsets!");
+        return CF_ERR_MALLOC;
+    }
+    out->serialOffsets.size = sizeof(uint32_t) * (count + 1);
+    if (count == 0) {
+        return CF_SUCCESS;
+    }
+    if (serialLen != 0) {
+        out->serials.data = (uint8_t *)HcfMallocLarge(serialLen, 0);
+        out->serials.size = serialLen;
+    }
+    out->revocationDates.data = (uint8_t *)HcfMallocLarge(sizeof(int64_t) * count, 0);
+    out->revocationDates.size = sizeof(int64_t) * count;
+    out->reasons.data = (uint8_t *)HcfMallocLarge(count, 0);
+    out->reasons.size = count;
+    if (((serialLen != 0) && (out->serials.data == NULL)) || (out->revocationDates.data == NULL) ||
+        (out->reasons.data == NULL)) {
+        LOGE("Failed to malloc for revoked columns!");
+        HcfX509CrlColumnsFree(out);
         return CF_ERR_MALLOC;
     }
-    entrysOut->count = revokedNum;
+    return CF_SUCCESS;
+}
+
+static CfResult GetRevokedReason(X509_REVOKED *rev, uint8_t *reason)
+{
+    int32_t critical = 0;
+    ASN1_ENUMERATED *reasonCode = X509_REVOKED_get_ext_d2i(rev, NID_crl_reason, &critical, NULL);
+    if (reasonCode == NULL) {
+        if (critical != -1) { /* -1 means the extension is absent, anything else is a malformed extension */
+            LOGE("Failed to decode CRL reason!");
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        *reason = HCF_CRL_REASON_ABSENT;
+        return CF_SUCCESS;
+    }
+    long value = ASN1_ENUMERATED_get(reasonCode);
+    ASN1_ENUMERATED_free(reasonCode);
+    if ((value < 0) || (value >= HCF_CRL_REASON_ABSENT)) {
+        LOGE("Invalid CRL reason!");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    *reason = (uint8_t)value;
+    return CF_SUCCESS;
+}
+
+static CfResult FillRevokedColumns(const STACK_OF(X509_REVOKED) *entrys, const ASN1_TIME *epoch,
+    HcfX509CrlColumns *out)
+{
+    uint32_t *offsets = (uint32_t *)out->serialOffsets.data;
+    int64_t *dates = (int64_t *)out->revocationDates.data;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < out->count; i++) {
+        X509_REVOKED *rev = sk_X509_REVOKED_value(entrys, (int32_t)i);
+        const ASN1_INTEGER *serial = X509_REVOKED_get0_serialNumber(rev);
+        int day = 0;
+        int sec = 0;
+        if ((serial == NULL) ||
+            (ASN1_TIME_diff(&day, &sec, epoch, X509_REVOKED_get0_revocationDate(rev)) != CF_OPENSSL_SUCCESS)) {
+            LOGE("Failed to get revoked serial or date!");
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        offsets[i] = offset;
+        uint32_t serialLen = (uint32_t)ASN1_STRING_length(serial);
+        if ((serialLen != 0) && (memcpy_s(out->serials.data + offset, out->serials.size - offset,
+            ASN1_STRING_get0_data(serial), serialLen) != EOK)) {
+            LOGE("Failed to copy revoked serial!");
+            return CF_ERR_COPY;
+        }
+        offset += serialLen;
+        dates[i] = (int64_t)day * SECONDS_PER_DAY + sec;
+        CfResult res = GetRevokedReason(rev, &out->reasons.data[i]);
+        if (res != CF_SUCCESS) {
+            return res;
+        }
+    }
+    offsets[out->count] = offset;
+    return CF_SUCCESS;
+}
+
+static CfResult GetRevokedColumns(HcfX509CrlSpi *self, HcfX509CrlColumns *columnsOut)
+{
+    if ((self == NULL) || (columnsOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    X509_CRL *crl = GetCrl(self);
+    if (crl == NULL) {
+        LOGE("crl is null!");
+        return CF_INVALID_PARAMS;
+    }
+    /* an empty CRL has no revokedCertificates field at all, which is reported as zero rows */
+    STACK_OF(X509_REVOKED) *entrys = X509_CRL_get_REVOKED(crl);
+    int32_t revokedNum = (entrys == NULL) ? 0 : sk_X509_REVOKED_num(entrys);
+    uint32_t serialLen = 0;
     for (int32_t i = 0; i < revokedNum; i++) {
-        if (DeepCopyRevokedCertificates(self, entrys, i, entrysOut) != CF_SUCCESS) {
-            LOGE("Falied to copy revoked certificates!");
-            DestroyCRLEntryArray(entrysOut);
-            return CF_ERR_MALLOC;
+        const ASN1_INTEGER *serial = X509_REVOKED_get0_serialNumber(sk_X509_REVOKED_value(entrys, i));
+        int32_t len = (serial == NULL) ? 0 : ASN1_STRING_length(serial);
+        if ((len < 0) || ((uint32_t)len > UINT32_MAX - serialLen)) {
+            LOGE("Revoked serial length is invalid!");
+            return CF_ERR_CRYPTO_OPERATION;
         }
+        serialLen += (uint32_t)len;
+    }
+    HcfX509CrlColumns columns = { 0 };
+    CfResult res = AllocRevokedColumns((uint32_t)revokedNum, serialLen, &columns);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    columns.count = (uint32_t)revokedNum;
+    ASN1_TIME *epoch = ASN1_TIME_set(NULL, 0);
+    if (epoch == NULL) {
+        LOGE("Failed to create epoch time!");
+        CfPrintOpensslError();
+        HcfX509CrlColumnsFree(&columns);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    res = FillRevokedColumns(entrys, epoch, &columns);
+    ASN1_TIME_free(epoch);
+    if (res != CF_SUCCESS) {
+        HcfX509CrlColumnsFree(&columns);
+        return res;
     }
+    *columnsOut = columns;
     return CF_SUCCESS;
 }
 
+/* One diff side: the blobs and, behind them, the serial bytes they point to, in a single allocation. */
+typedef struct {
+    CfBlobArray array;
+    uint32_t serialLen;
+    uint8_t *serialPos;
+} HcfRevokedSerials;
+
+/*
+ * i2d style: returns the length of the DER INTEGER content of serial, the two's complement bytes getSerialNumber
+ * returns, and writes them to out if it is not NULL.
+ */
+static uint32_t WriteSerialContent(const ASN1_INTEGER *serial, uint8_t *out)
+{
+    uint32_t len = (uint32_t)ASN1_STRING_length(serial);
+    const uint8_t *magnitude = SkipLeadingZero(ASN1_STRING_get0_data(serial), &len);
+    if (len == 0) {
+        if (out != NULL) {
+            out[0] = 0;
+        }
+        return 1;
+    }
+    bool negative = (ASN1_STRING_type(serial) == V_ASN1_NEG_INTEGER);
+    /* the complement only carries into the first byte when all the bytes after it are zero */
+    bool carry = true;
+    for (uint32_t i = 1; carry && (i < len); i++) {
+        carry = (magnitude[i] == 0);
+    }
+    uint8_t first = negative ? (uint8_t)(~magnitude[0] + (carry ? 1 : 0)) : magnitude[0];
+    /* a sign byte is needed when the top bit of the first byte does not give the sign */
+    uint32_t pad = (((first & 0x80) != 0) != negative) ? 1 : 0;
+    if (out == NULL) {
+        return len + pad;
+    }
+    if (pad != 0) {
+        out[0] = negative ? 0xFF : 0;
+    }
+    if (!negative) {
+        (void)memcpy_s(out + pad, len, magnitude, len);
+        return len + pad;
+    }
+    uint32_t sum = 1;
+    for (uint32_t i = len; i > 0; i--) {
+        sum += (uint8_t)~magnitude[i - 1];
+        out[pad + i - 1] = (uint8_t)sum;
+        sum >>= 8; /* 8: the carry to the next byte */
+    }
+    return len + pad;
+}
+
+static CfResult AppendSerial(const X509_REVOKED *rev, HcfRevokedSerials *out)
+{
+    const ASN1_INTEGER *serial = X509_REVOKED_get0_serialNumber(rev);
+    if (out->array.data == NULL) { /* counting pass */
+        uint32_t len = WriteSerialContent(serial, NULL);
+        if (len > MAX_LARGE_MEMORY_SIZE - out->serialLen) {
+            LOGE("Revoked serials are too long!");
+            return CF_INVALID_PARAMS;
+        }
+        out->serialLen += len;
+        out->array.count++;
+        return CF_SUCCESS;
+    }
+    CfBlob *blob = &out->array.data[out->array.count];
+    blob->data = out->serialPos;
+    blob->size = WriteSerialContent(serial, out->serialPos);
+    out->serialPos += blob->size;
+    out->array.count++;
+    return CF_SUCCESS;
+}
+
+static uint32_t SkipSameSerial(X509_REVOKED * const *serials, uint32_t count, uint32_t pos)
+{
+    uint32_t next = pos + 1;
+    while ((next < count) && (CompareRevokedSerial(&serials[pos], &serials[next]) == 0)) {
+        next++;
+    }
+    return next;
+}
+
+/* Walks both sorted serial lists once. With NULL output data only the counts and lengths are produced. */
+static CfResult MergeSerials(X509_REVOKED * const *oldSerials, uint32_t oldCount, X509_REVOKED * const *newSerials,
+    uint32_t newCount, HcfRevokedSerials *added, HcfRevokedSerials *removed)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    CfResult res = CF_SUCCESS;
+    while ((res == CF_SUCCESS) && ((i < oldCount) || (j < newCount))) {
+        int32_t cmp;
+        if (i == oldCount) {
+            cmp = 1;
+        } else if (j == newCount) {
+            cmp = -1;
+        } else {
+            cmp = CompareRevokedSerial(&oldSerials[i], &newSerials[j]);
+        }
+        if (cmp < 0) {
+            res = AppendSerial(oldSerials[i], removed);
+            i = SkipSameSerial(oldSerials, oldCount, i);
+        } else if (cmp > 0) {
+            res = AppendSerial(newSerials[j], added);
+            j = SkipSameSerial(newSerials, newCount, j);
+        } else {
+            i = SkipSameSerial(oldSerials, oldCount, i);
+            j = SkipSameSerial(newSerials, newCount, j);
+        }
+    }
+    return res;
+}
+
+static CfResult AllocSerialArray(HcfRevokedSerials *out)
+{
+    uint32_t count = out->array.count;
+    out->array.count = 0;
+    if (count == 0) {
+        return CF_SUCCESS;
+    }
+    if (count > (MAX_LARGE_MEMORY_SIZE - out->serialLen) / sizeof(CfBlob)) {
+        LOGE("Too many revoked serials!");
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t blobsLen = sizeof(CfBlob) * count;
+    /* the diff grows with the entries of the CRLs, the builder makes CRLs above HcfMalloc's limit */
+    out->array.data = (CfBlob *)HcfMallocLarge(blobsLen + out->serialLen, 0);
+    if (out->array.data == NULL) {
+        LOGE("Failed to malloc for serial array!");
+        return CF_ERR_MALLOC;
+    }
+    out->serialPos = (uint8_t *)out->array.data + blobsLen;
+    return CF_SUCCESS;
+}
+
+static CfResult DiffSortedSerials(X509_REVOKED * const *oldSerials, uint32_t oldCount,
+    X509_REVOKED * const *newSerials, uint32_t newCount, CfBlobArray *addedOut, CfBlobArray *removedOut)
+{
+    HcfRevokedSerials added = { { NULL, 0 }, 0, NULL };
+    HcfRevokedSerials removed = { { NULL, 0 }, 0, NULL };
+    CfResult res = MergeSerials(oldSerials, oldCount, newSerials, newCount, &added, &removed);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    res = AllocSerialArray(&added);
+    if (res != CF_SUCCESS) {
+        return res;
+    }
+    res = AllocSerialArray(&removed);
+    if (res != CF_SUCCESS) {
+        CfFree(added.array.data);
+        return res;
+    }
+    /* the second pass cannot fail, the lengths were checked by the first */
+    (void)MergeSerials(oldSerials, oldCount, newSerials, newCount, &added, &removed);
+    *addedOut = added.array;
+    *removedOut = removed.array;
+    return CF_SUCCESS;
+}
+
+static CfResult GetRevokedDiff(HcfX509CrlSpi *self, HcfX509CrlSpi *newer, CfBlobArray *addedOut,
+    CfBlobArray *removedOut)
+{
+    if ((self == NULL) || (newer == NULL) || (addedOut == NULL) || (removedOut == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    X509_CRL *oldCrl = GetCrl(self);
+    X509_CRL *newCrl = GetCrl(newer);
+    if ((oldCrl == NULL) || (newCrl == NULL)) {
+        LOGE("crl is null!");
+        return CF_INVALID_PARAMS;
+    }
+    if (X509_NAME_cmp(X509_CRL_get_issuer(oldCrl), X509_CRL_get_issuer(newCrl)) != 0) {
+        LOGE("The two CRLs are not issued by the same issuer!");
+        return CF_INVALID_PARAMS;
+    }
+    const HcfX509CrlSerialIndex *oldIndex = NULL;
+    const HcfX509CrlSerialIndex *newIndex = NULL;
+    CfResult res = GetSerialIndex((HcfX509CRLOpensslImpl *)self, &oldIndex);
+    if (res == CF_SUCCESS) {
+        res = GetSerialIndex((HcfX509CRLOpensslImpl *)newer, &newIndex);
+    }
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to build serial index!");
+        return res;
+    }
+    return DiffSortedSerials((oldIndex == NULL) ? NULL : oldIndex->items, (oldIndex == NULL) ? 0 : oldIndex->count,
+        (newIndex == NULL) ? NULL : newIndex->items, (newIndex == NULL) ? 0 : newIndex->count, addedOut, removedOut);
+}
+
 static CfResult GetTbsList(HcfX509CrlSpi *self, CfBlob *tbsCertListOut)
 {
     if ((self == NULL) || (tbsCertListOut == NULL)) {
@@ -507,7 +977,7 @@ static CfResult GetTbsList(HcfX509CrlSpi *self, CfBlob *tbsCertListOut)
         CfPrintOpensslError();
         return CF_ERR_CRYPTO_OPERATION;
     }
-    tbsCertListOut->data = (uint8_t *)HcfMalloc(length, 0);
+    tbsCertListOut->data = (uint8_t *)HcfMallocLarge(length, 0);
     if (tbsCertListOut->data == NULL) {
         LOGE("Failed to malloc for tbs!");
         OPENSSL_free(tbs);
@@ -707,6 +1177,93 @@ static CfResult GetSignatureAlgParams(HcfX509CrlSpi *self, CfBlob *sigAlgParamOu
     return GetSignatureAlgParamsInner(crl, sigAlgParamOut);
 }
 
+/*
+ * The duplicate shares the crl, its issuer and, once built, its serial index by reference, nothing is parsed or
+ * copied. A duplicate made before the first lookup by serial builds its own index when it needs one.
+ */
+static CfResult Dup(HcfX509CrlSpi *self, HcfX509CrlSpi **out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CRLOpensslImpl *impl = (HcfX509CRLOpensslImpl *)self;
+    HcfX509CRLOpensslImpl *dupCrl = (HcfX509CRLOpensslImpl *)HcfMalloc(sizeof(HcfX509CRLOpensslImpl), 0);
+    if (dupCrl == NULL) {
+        LOGE("Failed to malloc for x509 instance!");
+        return CF_ERR_MALLOC;
+    }
+    if (X509_CRL_up_ref(impl->crl) != CF_OPENSSL_SUCCESS) {
+        LOGE("Failed to up ref crl!");
+        CfPrintOpensslError();
+        CfFree(dupCrl);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    dupCrl->base = impl->base;
+    dupCrl->crl = impl->crl;
+    dupCrl->certIssuer = HcfCX509CrlIssuerRefAcquire(impl->certIssuer);
+    dupCrl->serialIndex = SerialIndexAcquire(__atomic_load_n(&impl->serialIndex, __ATOMIC_ACQUIRE));
+    *out = (HcfX509CrlSpi *)dupCrl;
+    return CF_SUCCESS;
+}
+
+static int EncodeCrl(const void *obj, unsigned char **der)
+{
+    return i2d_X509_CRL((X509_CRL *)obj, der);
+}
+
+static CfResult Equals(HcfX509CrlSpi *self, HcfX509CrlSpi *other, bool *out)
+{
+    if ((self == NULL) || (other == NULL) || (out == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetClass()) || !IsClassMatch((CfObjectBase *)other, GetClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CRLOpensslImpl *impl = (HcfX509CRLOpensslImpl *)self;
+    HcfX509CRLOpensslImpl *otherImpl = (HcfX509CRLOpensslImpl *)other;
+    if (impl->crl == otherImpl->crl) {
+        *out = true; /* the same object or duplicates of it */
+        return CF_SUCCESS;
+    }
+    uint8_t digest[CF_DER_DIGEST_LEN] = { 0 };
+    uint8_t otherDigest[CF_DER_DIGEST_LEN] = { 0 };
+    if ((CfGetDerDigest(&impl->digest, EncodeCrl, impl->crl, digest) == CF_SUCCESS) &&
+        (CfGetDerDigest(&otherImpl->digest, EncodeCrl, otherImpl->crl, otherDigest) == CF_SUCCESS)) {
+        *out = (memcmp(digest, otherDigest, CF_DER_DIGEST_LEN) == 0);
+        return CF_SUCCESS;
+    }
+    *out = (X509_CRL_match(impl->crl, otherImpl->crl) == 0);
+    return CF_SUCCESS;
+}
+
+static CfResult HashCode(HcfX509CrlSpi *self, uint32_t *out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetClass())) {
+        LOGE("Input wrong class type!");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CRLOpensslImpl *impl = (HcfX509CRLOpensslImpl *)self;
+    uint8_t digest[CF_DER_DIGEST_LEN] = { 0 };
+    CfResult res = CfGetDerDigest(&impl->digest, EncodeCrl, impl->crl, digest);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to get crl digest!");
+        return res;
+    }
+    *out = CfDerDigestHash(digest);
+    return CF_SUCCESS;
+}
+
 static void Destroy(CfObjectBase *self)
 {
     if (self == NULL) {
@@ -719,12 +1276,10 @@ static void Destroy(CfObjectBase *self)
     HcfX509CRLOpensslImpl *realCrl = (HcfX509CRLOpensslImpl *)self;
     X509_CRL_free(realCrl->crl);
     realCrl->crl = NULL;
-    if (realCrl->certIssuer != NULL) {
-        CfFree(realCrl->certIssuer->data);
-        realCrl->certIssuer->data = NULL;
-        CfFree(realCrl->certIssuer);
-        realCrl->certIssuer = NULL;
-    }
+    HcfCX509CrlIssuerRefRelease(realCrl->certIssuer);
+    realCrl->certIssuer = NULL;
+    SerialIndexRelease(realCrl->serialIndex);
+    realCrl->serialIndex = NULL;
     CfFree(realCrl);
 }
 
@@ -734,31 +1289,19 @@ static X509_CRL *ParseX509CRL(const CfEncodingBlob *inStream)
         LOGE("Invalid Paramas!");
         return NULL;
     }
-    BIO *bio = BIO_new_mem_buf(inStream->data, inStream->len);
-    if (bio == NULL) {
-        LOGE("bio get null!");
-        CfPrintOpensslError();
-        return NULL;
+    enum CfEncodingFormat format = CfResolveEncodingFormat(inStream->data, inStream->len, inStream->encodingFormat);
+    if (format == CF_FORMAT_PEM) {
+        return CfReadX509CrlFromPem(inStream->data, inStream->len);
     }
-    X509_CRL *crlOut = NULL;
-    switch (inStream->encodingFormat) {
-        case CF_FORMAT_DER:
-            crlOut = d2i_X509_CRL_bio(bio, NULL);
-            break;
-        case CF_FORMAT_PEM:
-            crlOut = PEM_read_bio_X509_CRL(bio, NULL, NULL, NULL);
-            break;
-        default:
-            LOGE("Not support format!");
-            break;
+    if (format != CF_FORMAT_DER) {
+        LOGE("Not support format!");
+        return NULL;
     }
-    BIO_free_all(bio);
-    if (crlOut == NULL) {
-        LOGE("Parse X509 CRL fail!");
-        CfPrintOpensslError();
+    if ((inStream->len > INT32_MAX) || (CfCheckDerFraming(inStream->data, (uint32_t)inStream->len) != CF_SUCCESS)) {
         return NULL;
     }
-    return crlOut;
+    const unsigned char *tmp = inStream->data;
+    return d2i_X509_CRL(NULL, &tmp, (long)inStream->len);
 }
 
 CfResult HcfCX509CrlSpiCreate(const CfEncodingBlob *inStream, HcfX509CrlSpi **spi)
@@ -767,19 +1310,34 @@ CfResult HcfCX509CrlSpiCreate(const CfEncodingBlob *inStream, HcfX509CrlSpi **sp
         LOGE("Invalid Paramas!");
         return CF_INVALID_PARAMS;
     }
+    /* malformed input is only counted, logging or dumping the error queue per input is too costly under a flood */
+    X509_CRL *crl = ParseX509CRL(inStream);
+    if (crl == NULL) {
+        CfCountRejectedInput(CF_REJECT_TYPE_CRL);
+        ERR_clear_error();
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = HcfCX509CrlSpiCreateWithCrl(crl, spi);
+    if (res != CF_SUCCESS) {
+        X509_CRL_free(crl);
+    }
+    return res;
+}
+
+CfResult HcfCX509CrlSpiCreateWithCrl(X509_CRL *crl, HcfX509CrlSpi **spi)
+{
+    if ((crl == NULL) || (spi == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
     HcfX509CRLOpensslImpl *returnCRL = (HcfX509CRLOpensslImpl *)HcfMalloc(sizeof(HcfX509CRLOpensslImpl), 0);
     if (returnCRL == NULL) {
         LOGE("Failed to malloc for x509 instance!");
         return CF_ERR_MALLOC;
     }
-    X509_CRL *crl = ParseX509CRL(inStream);
-    if (crl == NULL) {
-        LOGE("Failed to Parse x509 CRL!");
-        CfFree(returnCRL);
-        return CF_INVALID_PARAMS;
-    }
     returnCRL->crl = crl;
     returnCRL->certIssuer = NULL;
+    returnCRL->serialIndex = NULL;
     returnCRL->base.base.getClass = GetClass;
     returnCRL->base.base.destroy = Destroy;
     returnCRL->base.engineIsRevoked = IsRevoked;
@@ -792,12 +1350,18 @@ CfResult HcfCX509CrlSpiCreate(const CfEncodingBlob *inStream, HcfX509CrlSpi **sp
     returnCRL->base.engineGetNextUpdate = GetNextUpdate;
     returnCRL->base.engineGetRevokedCert = GetRevokedCert;
     returnCRL->base.engineGetRevokedCertWithCert = GetRevokedCertWithCert;
+    returnCRL->base.engineGetRevokedCertWithSerial = GetRevokedCertWithSerial;
     returnCRL->base.engineGetRevokedCerts = GetRevokedCerts;
+    returnCRL->base.engineGetRevokedColumns = GetRevokedColumns;
+    returnCRL->base.engineGetRevokedDiff = GetRevokedDiff;
     returnCRL->base.engineGetTbsInfo = GetTbsList;
     returnCRL->base.engineGetSignature = GetSignature;
     returnCRL->base.engineGetSignatureAlgName = GetSignatureAlgName;
     returnCRL->base.engineGetSignatureAlgOid = GetSignatureAlgOid;
     returnCRL->base.engineGetSignatureAlgParams = GetSignatureAlgParams;
+    returnCRL->base.engineDup = Dup;
+    returnCRL->base.engineEquals = Equals;
+    returnCRL->base.engineHashCode = HashCode;
     if (SetCertIssuer((HcfX509CrlSpi *)returnCRL) != CF_SUCCESS) {
         LOGI("No cert issuer find or set cert issuer fail!");
     }
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_pkcs7_openssl.h"
+
+#include <openssl/err.h>
+#include <openssl/pkcs7.h>
+#include <openssl/x509.h>
+
+#include "config.h"
+#include "cf_check.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_object_base.h"
+#include "cf_result.h"
+#include "certificate_openssl_common.h"
+#include "x509_certificate_openssl.h"
+#include "x509_crl_openssl.h"
+
+static PKCS7 *ParsePkcs7(const CfEncodingBlob *inStream)
+{
+    enum CfEncodingFormat format = CfResolveEncodingFormat(inStream->data, inStream->len, inStream->encodingFormat);
+    if (format == CF_FORMAT_PEM) {
+        return CfReadPkcs7FromPem(inStream->data, inStream->len);
+    }
+    /*
+     * ContentInfo is a SEQUENCE whose first element is the contentType OID, not a nested SEQUENCE, so
+     * CfCheckDerFraming does not apply here
+     */
+    if (format != CF_FORMAT_DER) {
+        LOGE("Not support format!");
+        return NULL;
+    }
+    const unsigned char *tmp = inStream->data;
+    return d2i_PKCS7(NULL, &tmp, (long)inStream->len);
+}
+
+/* certs-only bundles are SignedData, signedAndEnvelopedData carries the same two sets */
+static CfResult GetPkcs7Content(PKCS7 *p7, STACK_OF(X509) **certs, STACK_OF(X509_CRL) **crls)
+{
+    if (PKCS7_type_is_signed(p7) && (p7->d.sign != NULL)) {
+        *certs = p7->d.sign->cert;
+        *crls = p7->d.sign->crl;
+        return CF_SUCCESS;
+    }
+    if (PKCS7_type_is_signedAndEnveloped(p7) && (p7->d.signed_and_enveloped != NULL)) {
+        *certs = p7->d.signed_and_enveloped->cert;
+        *crls = p7->d.signed_and_enveloped->crl;
+        return CF_SUCCESS;
+    }
+    LOGE("The pkcs7 content type is not signed data!");
+    return CF_INVALID_PARAMS;
+}
+
+static CfResult TakeCerts(STACK_OF(X509) *certs, HcfPkcs7SpiContent *content)
+{
+    int32_t num = (certs == NULL) ? 0 : sk_X509_num(certs);
+    if (num == 0) {
+        return CF_SUCCESS;
+    }
+    content->certs = (HcfX509CertificateSpi **)HcfMalloc(sizeof(HcfX509CertificateSpi *) * num, 0);
+    if (content->certs == NULL) {
+        LOGE("Failed to malloc for cert spi array!");
+        return CF_ERR_MALLOC;
+    }
+    for (int32_t i = 0; i < num; i++) {
+        X509 *x509 = sk_X509_value(certs, i);
+        if (X509_up_ref(x509) != CF_OPENSSL_SUCCESS) {
+            LOGE("Failed to up ref x509 cert!");
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        CfResult res = OpensslX509CertSpiCreateWithX509(x509, &content->certs[i]);
+        if (res != CF_SUCCESS) {
+            LOGE("Failed to create cert spi[%d]!", i);
+            X509_free(x509);
+            return res;
+        }
+        content->certCount++;
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult TakeCrls(STACK_OF(X509_CRL) *crls, HcfPkcs7SpiContent *content)
+{
+    int32_t num = (crls == NULL) ? 0 : sk_X509_CRL_num(crls);
+    if (num == 0) {
+        return CF_SUCCESS;
+    }
+    content->crls = (HcfX509CrlSpi **)HcfMalloc(sizeof(HcfX509CrlSpi *) * num, 0);
+    if (content->crls == NULL) {
+        LOGE("Failed to malloc for crl spi array!");
+        return CF_ERR_MALLOC;
+    }
+    for (int32_t i = 0; i < num; i++) {
+        X509_CRL *crl = sk_X509_CRL_value(crls, i);
+        if (X509_CRL_up_ref(crl) != CF_OPENSSL_SUCCESS) {
+            LOGE("Failed to up ref x509 crl!");
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        CfResult res = HcfCX509CrlSpiCreateWithCrl(crl, &content->crls[i]);
+        if (res != CF_SUCCESS) {
+            LOGE("Failed to create crl spi[%d]!", i);
+            X509_CRL_free(crl);
+            return res;
+        }
+        content->crlCount++;
+    }
+    return CF_SUCCESS;
+}
+
+CfResult OpensslPkcs7SpiParse(const CfEncodingBlob *inStream, HcfPkcs7SpiContent *content)
+{
+    if ((inStream == NULL) || (inStream->data == NULL) || (inStream->len == 0) ||
+        (inStream->len > HCF_MAX_PKCS7_LEN) || (content == NULL)) {
+        LOGE("Invalid Paramas!");
+        return CF_INVALID_PARAMS;
+    }
+    PKCS7 *p7 = ParsePkcs7(inStream);
+    if (p7 == NULL) {
+        LOGE("Failed to parse pkcs7!");
+        CfPrintOpensslError();
+        return CF_INVALID_PARAMS;
+    }
+    STACK_OF(X509) *certs = NULL;
+    STACK_OF(X509_CRL) *crls = NULL;
+    CfResult res = GetPkcs7Content(p7, &certs, &crls);
+    if ((res == CF_SUCCESS) && (((certs == NULL) ? 0 : sk_X509_num(certs)) +
+        ((crls == NULL) ? 0 : sk_X509_CRL_num(crls)) > HCF_MAX_PKCS7_OBJ_NUM)) {
+        LOGE("Too many certs and crls in pkcs7!");
+        res = CF_INVALID_PARAMS;
+    }
+    if (res == CF_SUCCESS) {
+        res = TakeCerts(certs, content);
+    }
+    if (res == CF_SUCCESS) {
+        res = TakeCrls(crls, content);
+    }
+    PKCS7_free(p7); /* the spi objects hold their own references */
+    if (res != CF_SUCCESS) {
+        OpensslPkcs7SpiContentFree(content);
+    }
+    return res;
+}
+
+void OpensslPkcs7SpiContentFree(HcfPkcs7SpiContent *content)
+{
+    if (content == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < content->certCount; i++) {
+        CfObjDestroy(content->certs[i]);
+    }
+    for (uint32_t i = 0; i < content->crlCount; i++) {
+        CfObjDestroy(content->crls[i]);
+    }
+    CfFree(content->certs);
+    CfFree(content->crls);
+    content->certs = NULL;
+    content->certCount = 0;
+    content->crls = NULL;
+    content->crlCount = 0;
+}
@@ -18,13 +18,14 @@
 
 #include <openssl/x509.h>
 
+#include "cf_adapter_cert_peek.h"
 #include "cf_type.h"
 
-#define ASN1_TAG_TYPE_SEQ 0x30
-
 typedef struct {
     CfBase base; /* type verify for cert object */
-    X509 *x509Cert;
+    X509 *x509Cert; /* decoded on first access to a field that needs it, always read through the getter */
+    CfBlob encoded; /* DER encoding of the certificate */
+    CfCertPeekInfo peek; /* field offsets in encoded, the routing fields are served from them without decoding */
 } CfOpensslCertObj;
 
 #ifdef __cplusplus
@@ -39,6 +40,9 @@ int32_t CfOpensslVerifyCert(const CfBase *certObj, const CfBlob *pubKey);
 
 int32_t CfOpensslGetCertItem(const CfBase *object, CfItemId id, CfBlob *outBlob);
 
+/* The duplicate shares the decoded X509 by reference and keeps its own copy of the DER encoding. */
+int32_t CfOpensslDupCert(const CfBase *object, CfBase **dupObject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_ADAPTER_CERT_PEEK_H
+#define CF_ADAPTER_CERT_PEEK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ASN1_TAG_TYPE_SEQ 0x30
+
+typedef struct {
+    uint32_t offset;
+    uint32_t len;
+} CfDerSpan;
+
+/* Offsets of the routing fields of a DER certificate, all relative to the start of the certificate. */
+typedef struct {
+    uint32_t certLen; /* length of the certificate element, trailing data excluded */
+    bool tbsValid; /* false if the fields below could not be located, the cert must then be decoded */
+    int32_t version; /* 1, 2 or 3 */
+    CfDerSpan serial; /* big-endian magnitude of a non-negative serialNumber */
+    CfDerSpan issuer; /* DER encoded issuer Name */
+    int64_t notBefore; /* seconds since the epoch */
+    int64_t notAfter; /* seconds since the epoch */
+    CfDerSpan subject; /* DER encoded subject Name */
+    CfDerSpan publicKey; /* DER encoded SubjectPublicKeyInfo */
+} CfCertPeekInfo;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Checks the certificate framing and locates the TBS fields in one linear scan, without allocation.
+ * Fails only if the framing is invalid, a TBS it can not parse is reported by info->tbsValid.
+ */
+int32_t CfPeekCert(const uint8_t *data, uint32_t len, CfCertPeekInfo *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_ADAPTER_CERT_PEEK_H */
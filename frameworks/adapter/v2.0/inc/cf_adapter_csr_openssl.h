@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_ADAPTER_CSR_H
+#define CF_ADAPTER_CSR_H
+
+#include <openssl/x509.h>
+
+#include "cf_csr_adapter_ability_define.h"
+#include "cf_type.h"
+
+typedef struct {
+    CfBase base; /* type verify for csr object */
+    STACK_OF(X509_REQ) *reqs;
+} CfOpensslCsrObj;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int32_t CfOpensslCreateCsr(const CfEncodingBlob *inData, CfBase **object);
+
+void CfOpensslDestoryCsr(CfBase **object);
+
+int32_t CfOpensslGetCsrCount(const CfBase *object, uint32_t *count);
+
+int32_t CfOpensslGetCsrItem(const CfBase *object, uint32_t index, CfItemId id, CfBlob *out);
+
+int32_t CfOpensslVerifyCsr(const CfBase *object, uint32_t index, bool *valid);
+
+/* out is one uint8 per request, the signatures are checked on up to CF_CSR_VERIFY_THREAD_MAX threads */
+int32_t CfOpensslVerifyAllCsrs(const CfBase *object, CfBlob *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_ADAPTER_CSR_H */
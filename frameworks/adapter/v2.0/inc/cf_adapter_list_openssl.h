@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_ADAPTER_LIST_H
+#define CF_ADAPTER_LIST_H
+
+#include <openssl/x509.h>
+
+#include "cf_list_adapter_ability_define.h"
+#include "cf_type.h"
+
+#define CF_LIST_INDEX_COUNT (CF_LIST_INDEX_AUTHORITY_KEY_ID + 1)
+
+typedef struct {
+    const void *key; /* X509_NAME for the name indexes, ASN1_STRING for the others */
+    uint32_t pos; /* position of the certificate in the list */
+} CfListIndexNode;
+
+typedef struct {
+    CfListIndexNode *nodes; /* sorted by key, then by position */
+    uint32_t count;
+} CfListIndex;
+
+typedef struct {
+    CfBase base; /* type verify for list object */
+    STACK_OF(X509) *certs;
+    CfListIndex index[CF_LIST_INDEX_COUNT];
+} CfOpensslListObj;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int32_t CfOpensslCreateList(const CfEncodingBlob *inData, CfBase **object);
+
+void CfOpensslDestoryList(CfBase **object);
+
+int32_t CfOpensslFindCerts(const CfBase *object, CfListIndexType type, const CfBlob *key, CfBlob *out);
+
+int32_t CfOpensslSelectCerts(const CfBase *object, const CfListSelector *selector, CfBlob *out);
+
+int32_t CfOpensslGetCertColumn(const CfBase *object, CfItemId id, CfBlob *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_ADAPTER_LIST_H */
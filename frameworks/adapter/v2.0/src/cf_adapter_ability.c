@@ -16,9 +16,13 @@
 #include "cf_ability.h"
 
 #include "cf_adapter_cert_openssl.h"
+#include "cf_adapter_csr_openssl.h"
 #include "cf_adapter_extension_openssl.h"
+#include "cf_adapter_list_openssl.h"
 #include "cf_cert_adapter_ability_define.h"
+#include "cf_csr_adapter_ability_define.h"
 #include "cf_extension_adapter_ability_define.h"
+#include "cf_list_adapter_ability_define.h"
 #include "cf_log.h"
 #include "cf_magic.h"
 
@@ -28,6 +32,7 @@ static CfCertAdapterAbilityFunc g_certAdapterFunc = {
     .adapterDestory = CfOpensslDestoryCert,
     .adapterVerify = CfOpensslVerifyCert,
     .adapterGetItem = CfOpensslGetCertItem,
+    .adapterDup = CfOpensslDupCert,
 };
 
 static CfExtensionAdapterAbilityFunc g_extensionAdapterFunc = {
@@ -40,10 +45,31 @@ static CfExtensionAdapterAbilityFunc g_extensionAdapterFunc = {
     .adapterCheckCA = CfOpensslCheckCA,
 };
 
+static CfListAdapterAbilityFunc g_listAdapterFunc = {
+    .base.type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_FUNC, CF_OBJ_TYPE_LIST),
+    .adapterCreate = CfOpensslCreateList,
+    .adapterDestory = CfOpensslDestoryList,
+    .adapterFind = CfOpensslFindCerts,
+    .adapterSelect = CfOpensslSelectCerts,
+    .adapterGetColumn = CfOpensslGetCertColumn,
+};
+
+static CfCsrAdapterAbilityFunc g_csrAdapterFunc = {
+    .base.type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_FUNC, CF_OBJ_TYPE_CSR),
+    .adapterCreate = CfOpensslCreateCsr,
+    .adapterDestory = CfOpensslDestoryCsr,
+    .adapterGetCount = CfOpensslGetCsrCount,
+    .adapterGetItem = CfOpensslGetCsrItem,
+    .adapterVerify = CfOpensslVerifyCsr,
+    .adapterVerifyAll = CfOpensslVerifyAllCsrs,
+};
+
 __attribute__((constructor)) static void LoadAdapterAbility(void)
 {
     CF_LOG_I("enter load adapter ability");
     (void)RegisterAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER, CF_OBJ_TYPE_CERT), &g_certAdapterFunc.base);
     (void)RegisterAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER, CF_OBJ_TYPE_EXTENSION), &g_extensionAdapterFunc.base);
+    (void)RegisterAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER, CF_OBJ_TYPE_LIST), &g_listAdapterFunc.base);
+    (void)RegisterAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER, CF_OBJ_TYPE_CSR), &g_csrAdapterFunc.base);
 }
 
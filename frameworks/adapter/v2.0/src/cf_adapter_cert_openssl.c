@@ -17,6 +17,8 @@
 
 #include "securec.h"
 
+#include <stdbool.h>
+
 #include <openssl/asn1.h>
 #include <openssl/bio.h>
 #include <openssl/err.h>
@@ -28,9 +30,12 @@
 #include "cf_log.h"
 #include "cf_magic.h"
 #include "cf_memory.h"
+#include "cf_pem.h"
+#include "cf_reject.h"
 #include "cf_result.h"
 
 #define CF_OPENSSL_ERROR_LEN 128
+#define SECONDS_PER_DAY 86400
 
 static void CfPrintOpensslError(void)
 {
@@ -55,31 +60,87 @@ static int32_t DeepCopyDataToBlob(const unsigned char *data, uint32_t len, CfBlo
     return CF_SUCCESS;
 }
 
-static int32_t CreateX509Cert(const CfEncodingBlob *inData, CfOpensslCertObj *certObj)
+static int32_t GetDerFromPem(const CfEncodingBlob *inData, CfBlob *der)
 {
+    int32_t ret = CfPemDecode(inData->data, (uint32_t)inData->len, CF_PEM_LABEL_CERT, der, NULL);
+    if (ret == CF_SUCCESS) {
+        return CF_SUCCESS;
+    }
+    if (ret == CF_NOT_EXIST) {
+        return CF_ERR_CRYPTO_OPERATION; /* no BEGIN line at all, openssl would not find one either */
+    }
+
+    /* the armor forms the native decoder leaves out, such as encapsulated headers, go through openssl */
     BIO *bio = BIO_new_mem_buf(inData->data, inData->len);
     if (bio == NULL) {
         CF_LOG_E("malloc failed");
         CfPrintOpensslError();
         return CF_ERR_MALLOC;
     }
+    unsigned char *pemDer = NULL;
+    long derLen = 0;
+    ret = PEM_bytes_read_bio(&pemDer, &derLen, NULL, PEM_STRING_X509, bio, NULL, NULL);
+    BIO_free(bio);
+    if ((ret != 1) || (derLen <= 0)) {
+        ERR_clear_error();
+        OPENSSL_free(pemDer);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    int32_t res = DeepCopyDataToBlob(pemDer, (uint32_t)derLen, der);
+    OPENSSL_free(pemDer);
+    return res;
+}
 
-    /* format has checked in external. value is CF_FORMAT_PEM or CF_FORMAT_DER */
-    if (inData->encodingFormat == CF_FORMAT_PEM) {
-        certObj->x509Cert = PEM_read_bio_X509(bio, NULL, NULL, NULL);
-    } else { /* CF_FORMAT_DER */
-        certObj->x509Cert = d2i_X509_bio(bio, NULL);
+/* Only the framing is checked and the TBS fields located here, the X509 itself is decoded on first use. */
+static int32_t InitCertEncoding(const CfEncodingBlob *inData, CfOpensslCertObj *certObj)
+{
+    /* format has checked in external. value is CF_FORMAT_PEM, CF_FORMAT_DER or CF_FORMAT_AUTO */
+    if (CfResolveEncodingFormat(inData->data, inData->len, inData->encodingFormat) == CF_FORMAT_DER) {
+        int32_t ret = CfPeekCert(inData->data, (uint32_t)inData->len, &certObj->peek);
+        if (ret != CF_SUCCESS) {
+            return ret;
+        }
+        return DeepCopyDataToBlob(inData->data, certObj->peek.certLen, &certObj->encoded);
     }
-    BIO_free(bio);
 
-    if (certObj->x509Cert == NULL) {
-        CF_LOG_E("Failed to create cert object");
-        CfPrintOpensslError();
-        return CF_ERR_CRYPTO_OPERATION;
+    CfBlob der = { 0, NULL };
+    int32_t ret = GetDerFromPem(inData, &der);
+    if (ret != CF_SUCCESS) {
+        return ret;
     }
+    ret = CfPeekCert(der.data, der.size, &certObj->peek);
+    if (ret != CF_SUCCESS) {
+        CfFree(der.data);
+        return ret;
+    }
+    certObj->encoded.data = der.data; /* the decoded buffer is kept, data after the cert is not part of encoded */
+    certObj->encoded.size = certObj->peek.certLen;
     return CF_SUCCESS;
 }
 
+static X509 *GetX509Cert(const CfOpensslCertObj *certObj)
+{
+    /* the decoded cert is a cache of encoded, racing getters keep the first one published */
+    X509 **cache = (X509 **)&certObj->x509Cert;
+    X509 *x509Cert = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+    if (x509Cert != NULL) {
+        return x509Cert;
+    }
+    const unsigned char *data = certObj->encoded.data;
+    X509 *tmp = d2i_X509(NULL, &data, (long)certObj->encoded.size);
+    if (tmp == NULL) {
+        CF_LOG_E("Failed to decode cert");
+        CfPrintOpensslError();
+        return NULL;
+    }
+    X509 *expected = NULL;
+    if (!__atomic_compare_exchange_n(cache, &expected, tmp, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        X509_free(tmp);
+        return expected;
+    }
+    return tmp;
+}
+
 int32_t CfOpensslCreateCert(const CfEncodingBlob *inData, CfBase **object)
 {
     if ((CfCheckEncodingBlob(inData, MAX_LEN_CERTIFICATE) != CF_SUCCESS) || (object == NULL)) {
@@ -94,8 +155,11 @@ int32_t CfOpensslCreateCert(const CfEncodingBlob *inData, CfBase **object)
     }
     certObj->base.type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CERT);
 
-    int32_t ret = CreateX509Cert(inData, certObj);
+    int32_t ret = InitCertEncoding(inData, certObj);
     if (ret != CF_SUCCESS) {
+        if (ret == CF_ERR_CRYPTO_OPERATION) { /* malformed input, counted instead of logged */
+            CfCountRejectedInput(CF_REJECT_TYPE_CERT);
+        }
         CfFree(certObj);
         return ret;
     }
@@ -104,6 +168,42 @@ int32_t CfOpensslCreateCert(const CfEncodingBlob *inData, CfBase **object)
     return CF_SUCCESS;
 }
 
+int32_t CfOpensslDupCert(const CfBase *object, CfBase **dupObject)
+{
+    if ((object == NULL) || (dupObject == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslCertObj *srcObj = (const CfOpensslCertObj *)object;
+    if (srcObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CERT)) {
+        CF_LOG_E("the object is invalid , type = %lu", srcObj->base.type);
+        return CF_INVALID_PARAMS;
+    }
+
+    CfOpensslCertObj *certObj = CfMalloc(sizeof(CfOpensslCertObj));
+    if (certObj == NULL) {
+        CF_LOG_E("malloc failed");
+        return CF_ERR_MALLOC;
+    }
+    certObj->base.type = srcObj->base.type;
+    certObj->peek = srcObj->peek;
+    int32_t ret = DeepCopyDataToBlob(srcObj->encoded.data, srcObj->encoded.size, &certObj->encoded);
+    if (ret != CF_SUCCESS) {
+        CfFree(certObj);
+        return ret;
+    }
+
+    /* if not decoded yet, the duplicate decodes on its own first use */
+    X509 *x509Cert = __atomic_load_n((X509 * const *)&srcObj->x509Cert, __ATOMIC_ACQUIRE);
+    if ((x509Cert != NULL) && (X509_up_ref(x509Cert) == 1)) {
+        certObj->x509Cert = x509Cert;
+    }
+
+    *dupObject = &certObj->base;
+    return CF_SUCCESS;
+}
+
 void CfOpensslDestoryCert(CfBase **object)
 {
     if ((object == NULL) || (*object == NULL)) {
@@ -120,6 +220,7 @@ void CfOpensslDestoryCert(CfBase **object)
     if (certObj->x509Cert != NULL) {
         X509_free(certObj->x509Cert);
     }
+    CfFree(certObj->encoded.data);
     CfFree(certObj);
     *object = NULL;
     return;
@@ -132,9 +233,9 @@ int32_t CfOpensslVerifyCert(const CfBase *certObj, const CfBlob *pubKey)
     return CF_SUCCESS;
 }
 
-static int32_t GetCertTbs(const CfOpensslCertObj *certObj, CfBlob *outBlob)
+static int32_t GetCertTbs(X509 *x509Cert, CfBlob *outBlob)
 {
-    X509 *tmp = X509_dup(certObj->x509Cert);
+    X509 *tmp = X509_dup(x509Cert);
     if (tmp == NULL) {
         CF_LOG_E("Failed to copy x509Cert!");
         CfPrintOpensslError();
@@ -155,10 +256,10 @@ static int32_t GetCertTbs(const CfOpensslCertObj *certObj, CfBlob *outBlob)
     return ret;
 }
 
-static int32_t GetCertIssuerUniqueId(const CfOpensslCertObj *certObj, CfBlob *outBlob)
+static int32_t GetCertIssuerUniqueId(X509 *x509Cert, CfBlob *outBlob)
 {
     const ASN1_BIT_STRING *issuerUid = NULL;
-    (void)X509_get0_uids(certObj->x509Cert, &issuerUid, NULL);
+    (void)X509_get0_uids(x509Cert, &issuerUid, NULL);
     if (issuerUid == NULL) {
         CF_LOG_E("Failed to get internal issuerUid!");
         return CF_NOT_EXIST;
@@ -176,10 +277,10 @@ static int32_t GetCertIssuerUniqueId(const CfOpensslCertObj *certObj, CfBlob *ou
     return ret;
 }
 
-static int32_t GetCertSubjectUniqueId(const CfOpensslCertObj *certObj, CfBlob *outBlob)
+static int32_t GetCertSubjectUniqueId(X509 *x509Cert, CfBlob *outBlob)
 {
     const ASN1_BIT_STRING *subjectUid = NULL;
-    (void)X509_get0_uids(certObj->x509Cert, NULL, &subjectUid);
+    (void)X509_get0_uids(x509Cert, NULL, &subjectUid);
     if (subjectUid == NULL) {
         CF_LOG_E("Failed to get internal subjectUid!");
         return CF_NOT_EXIST;
@@ -197,9 +298,9 @@ static int32_t GetCertSubjectUniqueId(const CfOpensslCertObj *certObj, CfBlob *o
     return ret;
 }
 
-static int32_t GetCertPubKey(const CfOpensslCertObj *certObj, CfBlob *outBlob)
+static int32_t GetCertPubKey(X509 *x509Cert, CfBlob *outBlob)
 {
-    EVP_PKEY *pubKey = (EVP_PKEY *)X509_get_pubkey(certObj->x509Cert);
+    EVP_PKEY *pubKey = (EVP_PKEY *)X509_get_pubkey(x509Cert);
     if (pubKey == NULL) {
         CfPrintOpensslError();
         CF_LOG_E("the x509 cert data is error!");
@@ -221,12 +322,12 @@ static int32_t GetCertPubKey(const CfOpensslCertObj *certObj, CfBlob *outBlob)
     return ret;
 }
 
-static int32_t GetCertExtensions(const CfOpensslCertObj *certObj, CfBlob *outBlob)
+static int32_t GetCertExtensions(X509 *x509Cert, CfBlob *outBlob)
 {
     int32_t ret = CF_SUCCESS;
     unsigned char *extbytes = NULL;
     do {
-        X509_EXTENSIONS *exts = (X509_EXTENSIONS *)X509_get0_extensions(certObj->x509Cert);
+        X509_EXTENSIONS *exts = (X509_EXTENSIONS *)X509_get0_extensions(x509Cert);
         if (exts == NULL) {
             CF_LOG_E("the x509 cert data is error!");
             ret = CF_ERR_CRYPTO_OPERATION;
@@ -258,6 +359,86 @@ static int32_t GetCertExtensions(const CfOpensslCertObj *certObj, CfBlob *outBlo
     return ret;
 }
 
+static int32_t GetCertVersion(X509 *x509Cert, CfBlob *outBlob)
+{
+    int32_t version = (int32_t)X509_get_version(x509Cert) + 1; /* version 1 is encoded as 0 */
+    return DeepCopyDataToBlob((const unsigned char *)&version, sizeof(version), outBlob);
+}
+
+static int32_t GetCertSerial(X509 *x509Cert, CfBlob *outBlob)
+{
+    const ASN1_INTEGER *serial = X509_get0_serialNumber(x509Cert);
+    if ((serial == NULL) || (ASN1_STRING_length(serial) <= 0)) {
+        CF_LOG_E("Failed to get internal serial number!");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    return DeepCopyDataToBlob(ASN1_STRING_get0_data(serial), (uint32_t)ASN1_STRING_length(serial), outBlob);
+}
+
+static int32_t GetCertName(const X509_NAME *name, CfBlob *outBlob)
+{
+    unsigned char *out = NULL;
+    int len = i2d_X509_NAME((X509_NAME *)name, &out);
+    if (len <= 0) {
+        CF_LOG_E("Failed to convert internal name to der format, name len is : %d", len);
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+
+    int32_t ret = DeepCopyDataToBlob(out, (uint32_t)len, outBlob);
+    OPENSSL_free(out);
+    return ret;
+}
+
+static int32_t GetCertTime(const ASN1_TIME *time, CfBlob *outBlob)
+{
+    ASN1_TIME *epoch = ASN1_TIME_set(NULL, 0);
+    if (epoch == NULL) {
+        CF_LOG_E("Failed to malloc for asn1 time.");
+        return CF_ERR_MALLOC;
+    }
+
+    int day = 0;
+    int sec = 0;
+    int ret = ASN1_TIME_diff(&day, &sec, epoch, time);
+    ASN1_TIME_free(epoch);
+    if (ret != 1) {
+        CF_LOG_E("Failed to convert internal time!");
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    int64_t seconds = (int64_t)day * SECONDS_PER_DAY + sec;
+    return DeepCopyDataToBlob((const unsigned char *)&seconds, sizeof(seconds), outBlob);
+}
+
+/* the routing fields are copied from the offsets found at create, the same bytes openssl would give */
+static int32_t GetPeekedItem(const CfOpensslCertObj *certObj, CfItemId id, CfBlob *outBlob)
+{
+    const CfCertPeekInfo *peek = &certObj->peek;
+    const CfDerSpan *span = NULL;
+    switch (id) {
+        case CF_ITEM_VERSION:
+            return DeepCopyDataToBlob((const unsigned char *)&peek->version, sizeof(peek->version), outBlob);
+        case CF_ITEM_NOT_BEFORE:
+            return DeepCopyDataToBlob((const unsigned char *)&peek->notBefore, sizeof(peek->notBefore), outBlob);
+        case CF_ITEM_NOT_AFTER:
+            return DeepCopyDataToBlob((const unsigned char *)&peek->notAfter, sizeof(peek->notAfter), outBlob);
+        case CF_ITEM_SERIAL_NUMBER:
+            span = &peek->serial;
+            break;
+        case CF_ITEM_ISSUE_NAME:
+            span = &peek->issuer;
+            break;
+        case CF_ITEM_SUBJECT_NAME:
+            span = &peek->subject;
+            break;
+        default: /* CF_ITEM_PUBLIC_KEY */
+            span = &peek->publicKey;
+            break;
+    }
+    return DeepCopyDataToBlob(certObj->encoded.data + span->offset, span->len, outBlob);
+}
+
 int32_t CfOpensslGetCertItem(const CfBase *object, CfItemId id, CfBlob *outBlob)
 {
     if (object == NULL || outBlob == NULL) {
@@ -267,25 +448,63 @@ int32_t CfOpensslGetCertItem(const CfBase *object, CfItemId id, CfBlob *outBlob)
 
     const CfOpensslCertObj *certObj = (const CfOpensslCertObj *)object;
     if (certObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CERT) ||
-        certObj->x509Cert == NULL) {
+        certObj->encoded.data == NULL) {
         CF_LOG_E("the object is invalid , type = %lu", certObj->base.type);
         return CF_INVALID_PARAMS;
     }
 
+    /* the encoding and the routing fields are served without decoding the cert */
     switch (id) {
+        case CF_ITEM_ENCODED:
+            return DeepCopyDataToBlob(certObj->encoded.data, certObj->encoded.size, outBlob);
+        case CF_ITEM_VERSION:
+        case CF_ITEM_SERIAL_NUMBER:
+        case CF_ITEM_ISSUE_NAME:
+        case CF_ITEM_SUBJECT_NAME:
+        case CF_ITEM_NOT_BEFORE:
+        case CF_ITEM_NOT_AFTER:
+        case CF_ITEM_PUBLIC_KEY:
+            if (certObj->peek.tbsValid) {
+                return GetPeekedItem(certObj, id, outBlob);
+            }
+            break;
         case CF_ITEM_TBS:
-            return GetCertTbs(certObj, outBlob);
         case CF_ITEM_ISSUER_UNIQUE_ID:
-            return GetCertIssuerUniqueId(certObj, outBlob);
         case CF_ITEM_SUBJECT_UNIQUE_ID:
-            return GetCertSubjectUniqueId(certObj, outBlob);
         case CF_ITEM_EXTENSIONS:
-            return GetCertExtensions(certObj, outBlob);
-        case CF_ITEM_PUBLIC_KEY:
-            return GetCertPubKey(certObj, outBlob);
+            break;
         default:
             CF_LOG_E("the value of id is wrong, id = %d", (int32_t)id);
             return CF_INVALID_PARAMS;
     }
+
+    X509 *x509Cert = GetX509Cert(certObj);
+    if (x509Cert == NULL) {
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    switch (id) {
+        case CF_ITEM_TBS:
+            return GetCertTbs(x509Cert, outBlob);
+        case CF_ITEM_ISSUER_UNIQUE_ID:
+            return GetCertIssuerUniqueId(x509Cert, outBlob);
+        case CF_ITEM_SUBJECT_UNIQUE_ID:
+            return GetCertSubjectUniqueId(x509Cert, outBlob);
+        case CF_ITEM_EXTENSIONS:
+            return GetCertExtensions(x509Cert, outBlob);
+        case CF_ITEM_VERSION:
+            return GetCertVersion(x509Cert, outBlob);
+        case CF_ITEM_SERIAL_NUMBER:
+            return GetCertSerial(x509Cert, outBlob);
+        case CF_ITEM_ISSUE_NAME:
+            return GetCertName(X509_get_issuer_name(x509Cert), outBlob);
+        case CF_ITEM_SUBJECT_NAME:
+            return GetCertName(X509_get_subject_name(x509Cert), outBlob);
+        case CF_ITEM_NOT_BEFORE:
+            return GetCertTime(X509_get0_notBefore(x509Cert), outBlob);
+        case CF_ITEM_NOT_AFTER:
+            return GetCertTime(X509_get0_notAfter(x509Cert), outBlob);
+        default: /* CF_ITEM_PUBLIC_KEY */
+            return GetCertPubKey(x509Cert, outBlob);
+    }
 }
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_adapter_cert_peek.h"
+
+#include "securec.h"
+
+#include "cf_log.h"
+#include "cf_result.h"
+
+#define ASN1_TAG_TYPE_INTEGER 0x02
+#define ASN1_TAG_TYPE_BIT_STRING 0x03
+#define ASN1_TAG_TYPE_UTC_TIME 0x17
+#define ASN1_TAG_TYPE_GENERALIZED_TIME 0x18
+#define ASN1_TAG_CONTEXT_VERSION 0xA0
+#define ASN1_LEN_LONG_FORM 0x80
+#define ASN1_HEADER_MIN_LEN 2
+#define ASN1_INTEGER_SIGN_BIT 0x80
+#define BITS_PER_BYTE 8
+#define X509_VERSION_MAX_VALUE 2 /* version 3 is encoded as 2 */
+
+#define UTC_TIME_LEN 13 /* YYMMDDHHMMSSZ */
+#define GENERALIZED_TIME_LEN 15 /* YYYYMMDDHHMMSSZ */
+#define UTC_TIME_YEAR_DIGITS 2
+#define GENERALIZED_TIME_YEAR_DIGITS 4
+#define UTC_TIME_PIVOT_YEAR 50 /* RFC 5280: YY >= 50 is 19YY, otherwise 20YY */
+#define UTC_TIME_CENTURY_19 1900
+#define UTC_TIME_CENTURY_20 2000
+#define TIME_FIELD_DIGITS 2
+#define TIME_ZULU 'Z'
+#define DECIMAL_BASE 10
+
+#define MONTHS_PER_YEAR 12
+#define HOURS_PER_DAY 24
+#define MINUTES_PER_HOUR 60
+#define SECONDS_PER_MINUTE 60
+#define SECONDS_PER_HOUR 3600
+#define SECONDS_PER_DAY 86400
+#define MONTH_FEBRUARY 2
+#define DAYS_IN_LEAP_FEBRUARY 29
+
+/* days from civil, see "chrono-Compatible Low-Level Date Algorithms" by Howard Hinnant */
+#define DAYS_PER_YEAR 365
+#define DAYS_PER_ERA 146097
+#define YEARS_PER_ERA 400
+#define YEARS_PER_LEAP 4
+#define YEARS_PER_CENTURY 100
+#define MONTHS_FROM_MARCH 3
+#define MONTHS_BEFORE_MARCH 9
+#define DAYS_PER_FIVE_MONTHS 153
+#define FIVE_MONTHS 5
+#define DAY_OF_YEAR_ROUNDING 2
+#define DAYS_FROM_ERA_TO_EPOCH 719468
+
+typedef struct {
+    const uint8_t *data; /* start of the certificate, offsets are relative to it */
+    uint32_t pos; /* offset of the next element */
+    uint32_t end; /* offset past the content of the enclosing element */
+} DerReader;
+
+/* Reads the tag and length of the next element, the element must fit in the enclosing one. */
+static bool ReadHeader(const DerReader *reader, uint8_t tag, uint32_t *headerLen, uint32_t *bodyLen)
+{
+    const uint8_t *data = reader->data + reader->pos;
+    uint32_t len = reader->end - reader->pos;
+    if ((len < ASN1_HEADER_MIN_LEN) || (data[0] != tag)) {
+        return false;
+    }
+    uint32_t pos = 1;
+    uint8_t first = data[pos++];
+    uint32_t size = first;
+    if ((first & ASN1_LEN_LONG_FORM) != 0) {
+        uint32_t count = first & (uint8_t)~ASN1_LEN_LONG_FORM;
+        if ((count == 0) || (count > sizeof(uint32_t)) || (count > len - pos)) { /* 0: indefinite, not DER */
+            return false;
+        }
+        size = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            size = (size << BITS_PER_BYTE) | data[pos++];
+        }
+    }
+    if (size > len - pos) {
+        return false;
+    }
+    *headerLen = pos;
+    *bodyLen = size;
+    return true;
+}
+
+/* Moves past the next element, span is set to the whole element if not NULL. */
+static bool SkipElement(DerReader *reader, uint8_t tag, CfDerSpan *span)
+{
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if (!ReadHeader(reader, tag, &headerLen, &bodyLen)) {
+        return false;
+    }
+    if (span != NULL) {
+        span->offset = reader->pos;
+        span->len = headerLen + bodyLen;
+    }
+    reader->pos += headerLen + bodyLen;
+    return true;
+}
+
+/* Moves past the next element, inner is bound to its content. */
+static bool EnterElement(DerReader *reader, uint8_t tag, DerReader *inner)
+{
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if (!ReadHeader(reader, tag, &headerLen, &bodyLen)) {
+        return false;
+    }
+    inner->data = reader->data;
+    inner->pos = reader->pos + headerLen;
+    inner->end = inner->pos + bodyLen;
+    reader->pos = inner->end;
+    return true;
+}
+
+static bool PeekNextTag(const DerReader *reader, uint8_t tag)
+{
+    return (reader->pos < reader->end) && (reader->data[reader->pos] == tag);
+}
+
+/* version [0] EXPLICIT INTEGER DEFAULT v1 */
+static bool PeekVersion(DerReader *tbs, int32_t *version)
+{
+    if (!PeekNextTag(tbs, ASN1_TAG_CONTEXT_VERSION)) {
+        *version = 1;
+        return true;
+    }
+    DerReader explicitTag = { 0 };
+    DerReader value = { 0 };
+    if (!EnterElement(tbs, ASN1_TAG_CONTEXT_VERSION, &explicitTag) ||
+        !EnterElement(&explicitTag, ASN1_TAG_TYPE_INTEGER, &value) || (explicitTag.pos != explicitTag.end) ||
+        (value.end - value.pos != 1) || (value.data[value.pos] > X509_VERSION_MAX_VALUE)) {
+        return false;
+    }
+    *version = value.data[value.pos] + 1;
+    return true;
+}
+
+static bool PeekSerial(DerReader *tbs, CfDerSpan *serial)
+{
+    DerReader value = { 0 };
+    if (!EnterElement(tbs, ASN1_TAG_TYPE_INTEGER, &value) || (value.pos == value.end) ||
+        ((value.data[value.pos] & ASN1_INTEGER_SIGN_BIT) != 0)) { /* negative serials are left to openssl */
+        return false;
+    }
+    if ((value.end - value.pos > 1) && (value.data[value.pos] == 0)) {
+        value.pos++; /* drop the sign octet, keep the magnitude only */
+    }
+    serial->offset = value.pos;
+    serial->len = value.end - value.pos;
+    return true;
+}
+
+static bool ReadDigits(const uint8_t *text, uint32_t count, int32_t *value)
+{
+    int32_t result = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if ((text[i] < '0') || (text[i] > '9')) {
+            return false;
+        }
+        result = result * DECIMAL_BASE + (text[i] - '0');
+    }
+    *value = result;
+    return true;
+}
+
+static int32_t GetDaysInMonth(int32_t year, int32_t month)
+{
+    static const int32_t days[MONTHS_PER_YEAR] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool isLeap = ((year % YEARS_PER_LEAP) == 0) &&
+        (((year % YEARS_PER_CENTURY) != 0) || ((year % YEARS_PER_ERA) == 0));
+    return ((month == MONTH_FEBRUARY) && isLeap) ? DAYS_IN_LEAP_FEBRUARY : days[month - 1];
+}
+
+/* days since 1970-01-01 in the proleptic Gregorian calendar, year is never negative here */
+static int64_t GetDaysFromEpoch(int32_t year, int32_t month, int32_t day)
+{
+    year -= (month <= MONTH_FEBRUARY) ? 1 : 0;
+    int64_t era = year / YEARS_PER_ERA;
+    int64_t yearOfEra = year - era * YEARS_PER_ERA;
+    int64_t monthFromMarch = (month > MONTH_FEBRUARY) ? (month - MONTHS_FROM_MARCH) : (month + MONTHS_BEFORE_MARCH);
+    int64_t dayOfYear = (DAYS_PER_FIVE_MONTHS * monthFromMarch + DAY_OF_YEAR_ROUNDING) / FIVE_MONTHS + day - 1;
+    int64_t dayOfEra = yearOfEra * DAYS_PER_YEAR + yearOfEra / YEARS_PER_LEAP - yearOfEra / YEARS_PER_CENTURY +
+        dayOfYear;
+    return era * DAYS_PER_ERA + dayOfEra - DAYS_FROM_ERA_TO_EPOCH;
+}
+
+static bool ReadTimeText(DerReader *validity, const uint8_t **text, int32_t *year)
+{
+    DerReader value = { 0 };
+    if (PeekNextTag(validity, ASN1_TAG_TYPE_UTC_TIME)) {
+        if (!EnterElement(validity, ASN1_TAG_TYPE_UTC_TIME, &value) || (value.end - value.pos != UTC_TIME_LEN) ||
+            !ReadDigits(value.data + value.pos, UTC_TIME_YEAR_DIGITS, year)) {
+            return false;
+        }
+        *year += (*year >= UTC_TIME_PIVOT_YEAR) ? UTC_TIME_CENTURY_19 : UTC_TIME_CENTURY_20;
+        *text = value.data + value.pos + UTC_TIME_YEAR_DIGITS;
+        return true;
+    }
+    if (!EnterElement(validity, ASN1_TAG_TYPE_GENERALIZED_TIME, &value) ||
+        (value.end - value.pos != GENERALIZED_TIME_LEN) ||
+        !ReadDigits(value.data + value.pos, GENERALIZED_TIME_YEAR_DIGITS, year)) {
+        return false;
+    }
+    *text = value.data + value.pos + GENERALIZED_TIME_YEAR_DIGITS;
+    return true;
+}
+
+/* Only the Zulu form with seconds is accepted, which is the one DER and RFC 5280 allow. */
+static bool PeekTime(DerReader *validity, int64_t *epoch)
+{
+    const uint8_t *text = NULL;
+    int32_t year = 0;
+    int32_t month = 0;
+    int32_t day = 0;
+    int32_t hour = 0;
+    int32_t minute = 0;
+    int32_t second = 0;
+    if (!ReadTimeText(validity, &text, &year) || !ReadDigits(text, TIME_FIELD_DIGITS, &month) ||
+        !ReadDigits(text + TIME_FIELD_DIGITS, TIME_FIELD_DIGITS, &day) ||
+        !ReadDigits(text + TIME_FIELD_DIGITS * 2, TIME_FIELD_DIGITS, &hour) || /* 2: month and day */
+        !ReadDigits(text + TIME_FIELD_DIGITS * 3, TIME_FIELD_DIGITS, &minute) || /* 3: before minute */
+        !ReadDigits(text + TIME_FIELD_DIGITS * 4, TIME_FIELD_DIGITS, &second) || /* 4: before second */
+        (text[TIME_FIELD_DIGITS * 5] != TIME_ZULU)) { /* 5: the zone follows the second */
+        return false;
+    }
+    if ((month < 1) || (month > MONTHS_PER_YEAR) || (day < 1) || (day > GetDaysInMonth(year, month)) ||
+        (hour >= HOURS_PER_DAY) || (minute >= MINUTES_PER_HOUR) || (second >= SECONDS_PER_MINUTE)) {
+        return false;
+    }
+    *epoch = GetDaysFromEpoch(year, month, day) * SECONDS_PER_DAY + hour * SECONDS_PER_HOUR +
+        minute * SECONDS_PER_MINUTE + second;
+    return true;
+}
+
+/*
+ * TBSCertificate ::= SEQUENCE { version [0] OPTIONAL, serialNumber INTEGER, signature SEQUENCE, issuer Name,
+ *     validity SEQUENCE { notBefore Time, notAfter Time }, subject Name, subjectPublicKeyInfo SEQUENCE, ... }
+ */
+static bool PeekTbs(DerReader *tbs, CfCertPeekInfo *info)
+{
+    DerReader validity = { 0 };
+    if (!PeekVersion(tbs, &info->version) || !PeekSerial(tbs, &info->serial) ||
+        !SkipElement(tbs, ASN1_TAG_TYPE_SEQ, NULL) || !SkipElement(tbs, ASN1_TAG_TYPE_SEQ, &info->issuer) ||
+        !EnterElement(tbs, ASN1_TAG_TYPE_SEQ, &validity) || !SkipElement(tbs, ASN1_TAG_TYPE_SEQ, &info->subject) ||
+        !SkipElement(tbs, ASN1_TAG_TYPE_SEQ, &info->publicKey)) {
+        return false;
+    }
+    return PeekTime(&validity, &info->notBefore) && PeekTime(&validity, &info->notAfter) &&
+        (validity.pos == validity.end);
+}
+
+/* Certificate ::= SEQUENCE { tbsCertificate SEQUENCE, signatureAlgorithm SEQUENCE, signatureValue BIT STRING } */
+int32_t CfPeekCert(const uint8_t *data, uint32_t len, CfCertPeekInfo *info)
+{
+    if ((data == NULL) || (info == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+    (void)memset_s(info, sizeof(CfCertPeekInfo), 0, sizeof(CfCertPeekInfo));
+
+    DerReader reader = { data, 0, len };
+    DerReader cert = { 0 };
+    DerReader tbs = { 0 };
+    if (!EnterElement(&reader, ASN1_TAG_TYPE_SEQ, &cert) || !EnterElement(&cert, ASN1_TAG_TYPE_SEQ, &tbs) ||
+        !SkipElement(&cert, ASN1_TAG_TYPE_SEQ, NULL) || !SkipElement(&cert, ASN1_TAG_TYPE_BIT_STRING, NULL) ||
+        (cert.pos != cert.end)) {
+        return CF_ERR_CRYPTO_OPERATION; /* not logged, callers count malformed input */
+    }
+    info->certLen = cert.end;
+    info->tbsValid = PeekTbs(&tbs, info);
+    return CF_SUCCESS;
+}
@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_adapter_csr_openssl.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include <openssl/asn1.h>
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/objects.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include "securec.h"
+
+#include "cf_check.h"
+#include "cf_log.h"
+#include "cf_magic.h"
+#include "cf_memory.h"
+#include "cf_pem.h"
+#include "cf_result.h"
+
+#define CF_OPENSSL_ERROR_LEN 128
+#define ASN1_TAG_TYPE_SET 0x31
+#define ASN1_TAG_CONTEXT_0 0xA0
+#define ASN1_LEN_LONG_FORM 0x80
+#define ASN1_LEN_MAX_BYTES 4
+#define CSR_INFO_FIELDS_BEFORE_ATTRS 3 /* version, subject and subjectPKInfo */
+
+#ifndef CF_CSR_VERIFY_THREAD_MAX
+#define CF_CSR_VERIFY_THREAD_MAX 4 /* the calling thread included */
+#endif
+#define CF_CSR_VERIFY_PER_THREAD_MIN 16 /* smaller batches are not worth a thread */
+
+typedef struct {
+    const STACK_OF(X509_REQ) *reqs;
+    uint32_t count;
+    uint32_t next; /* only accessed with the __atomic builtins */
+    uint8_t *results;
+} CfCsrVerifyJob;
+
+DEFINE_STACK_OF(X509_REQ) /* openssl declares the stack type of requests but not its functions */
+
+static void CfPrintOpensslError(void)
+{
+    char szErr[CF_OPENSSL_ERROR_LEN] = {0};
+    unsigned long errCode = ERR_get_error();
+    ERR_error_string_n(errCode, szErr, CF_OPENSSL_ERROR_LEN);
+
+    CF_LOG_E("[Openssl]: engine fail, error code = %lu, error string = %s", errCode, szErr);
+}
+
+static int32_t PushCsr(STACK_OF(X509_REQ) *reqs, X509_REQ *req)
+{
+    if (sk_X509_REQ_num(reqs) >= MAX_COUNT_CSR_LIST) {
+        CF_LOG_E("too many csrs, max count = %d", MAX_COUNT_CSR_LIST);
+        X509_REQ_free(req);
+        return CF_INVALID_PARAMS;
+    }
+
+    if (sk_X509_REQ_push(reqs, req) <= 0) {
+        CF_LOG_E("push csr failed");
+        X509_REQ_free(req);
+        return CF_ERR_MALLOC;
+    }
+    return CF_SUCCESS;
+}
+
+/* also accepts the "NEW CERTIFICATE REQUEST" label that the native decoder leaves to openssl */
+static int32_t ReadPemCsrs(const CfEncodingBlob *inData, STACK_OF(X509_REQ) *reqs)
+{
+    BIO *bio = BIO_new_mem_buf(inData->data, (int)inData->len);
+    if (bio == NULL) {
+        CF_LOG_E("malloc failed");
+        CfPrintOpensslError();
+        return CF_ERR_MALLOC;
+    }
+
+    int32_t ret = CF_SUCCESS;
+    X509_REQ *req = NULL;
+    while ((req = PEM_read_bio_X509_REQ(bio, NULL, NULL, NULL)) != NULL) {
+        ret = PushCsr(reqs, req);
+        if (ret != CF_SUCCESS) {
+            break;
+        }
+    }
+    BIO_free(bio);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    /* reading stops with PEM_R_NO_START_LINE once all requests in the bundle are consumed */
+    unsigned long err = ERR_peek_last_error();
+    if ((sk_X509_REQ_num(reqs) == 0) || (ERR_GET_LIB(err) != ERR_LIB_PEM) ||
+        (ERR_GET_REASON(err) != PEM_R_NO_START_LINE)) {
+        CF_LOG_E("Failed to parse pem csrs");
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    ERR_clear_error();
+    return CF_SUCCESS;
+}
+
+/* unsupported is set for the armor forms the native decoder leaves out, such as encapsulated headers */
+static int32_t DecodePemCsrs(const CfEncodingBlob *inData, STACK_OF(X509_REQ) *reqs, bool *unsupported)
+{
+    uint32_t offset = 0;
+    uint32_t len = (uint32_t)inData->len;
+    while (true) {
+        CfBlob der = { 0, NULL };
+        uint32_t next = 0;
+        int32_t ret = CfPemDecode(inData->data + offset, len - offset, CF_PEM_LABEL_CSR, &der, &next);
+        if (ret == CF_NOT_EXIST) {
+            break;
+        }
+        if (ret != CF_SUCCESS) {
+            *unsupported = (ret == CF_INVALID_PARAMS);
+            return ret;
+        }
+
+        const unsigned char *tmp = der.data;
+        X509_REQ *req = d2i_X509_REQ(NULL, &tmp, (long)der.size);
+        CfFree(der.data);
+        if (req == NULL) {
+            CF_LOG_E("Failed to parse pem csr[%d]", sk_X509_REQ_num(reqs));
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        ret = PushCsr(reqs, req);
+        if (ret != CF_SUCCESS) {
+            return ret;
+        }
+        offset += next;
+    }
+
+    if (sk_X509_REQ_num(reqs) == 0) {
+        CF_LOG_E("No pem csr found");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    return CF_SUCCESS;
+}
+
+static int32_t ParsePemCsrs(const CfEncodingBlob *inData, STACK_OF(X509_REQ) *reqs)
+{
+    bool unsupported = false;
+    int32_t ret = DecodePemCsrs(inData, reqs, &unsupported);
+    if (!unsupported) {
+        return ret;
+    }
+
+    X509_REQ *req = NULL;
+    while ((req = sk_X509_REQ_pop(reqs)) != NULL) {
+        X509_REQ_free(req);
+    }
+    return ReadPemCsrs(inData, reqs);
+}
+
+static int32_t ParseDerCsrs(const CfEncodingBlob *inData, STACK_OF(X509_REQ) *reqs)
+{
+    const unsigned char *data = inData->data; /* data pointer will shift downward in d2i_X509_REQ */
+    const unsigned char *end = inData->data + inData->len;
+    while (data < end) {
+        X509_REQ *req = d2i_X509_REQ(NULL, &data, (long)(end - data));
+        if (req == NULL) {
+            CF_LOG_E("Failed to parse der csr[%d]", sk_X509_REQ_num(reqs));
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+
+        int32_t ret = PushCsr(reqs, req);
+        if (ret != CF_SUCCESS) {
+            return ret;
+        }
+    }
+    return CF_SUCCESS;
+}
+
+static void FreeCsrObj(CfOpensslCsrObj *csrObj)
+{
+    if (csrObj->reqs != NULL) {
+        sk_X509_REQ_pop_free(csrObj->reqs, X509_REQ_free);
+        csrObj->reqs = NULL;
+    }
+    CfFree(csrObj);
+}
+
+int32_t CfOpensslCreateCsr(const CfEncodingBlob *inData, CfBase **object)
+{
+    if ((CfCheckEncodingBlob(inData, MAX_LEN_CSR_LIST) != CF_SUCCESS) || (object == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfOpensslCsrObj *csrObj = CfMalloc(sizeof(CfOpensslCsrObj));
+    if (csrObj == NULL) {
+        CF_LOG_E("malloc failed");
+        return CF_ERR_MALLOC;
+    }
+    csrObj->base.type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CSR);
+
+    csrObj->reqs = sk_X509_REQ_new_null();
+    if (csrObj->reqs == NULL) {
+        CF_LOG_E("malloc csr stack failed");
+        CfFree(csrObj);
+        return CF_ERR_MALLOC;
+    }
+
+    /* format has checked in CfCheckEncodingBlob. an auto bundle is detected from its first request */
+    enum CfEncodingFormat format = CfResolveEncodingFormat(inData->data, inData->len, inData->encodingFormat);
+    int32_t ret = (format == CF_FORMAT_PEM) ? ParsePemCsrs(inData, csrObj->reqs) :
+        ParseDerCsrs(inData, csrObj->reqs);
+    if (ret != CF_SUCCESS) {
+        FreeCsrObj(csrObj);
+        return ret;
+    }
+
+    *object = &csrObj->base;
+    return CF_SUCCESS;
+}
+
+void CfOpensslDestoryCsr(CfBase **object)
+{
+    if ((object == NULL) || (*object == NULL)) {
+        CF_LOG_E("invalid input params");
+        return;
+    }
+
+    CfOpensslCsrObj *csrObj = (CfOpensslCsrObj *)*object;
+    if (csrObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CSR)) {
+        CF_LOG_E("the object is invalid , type = %lu", csrObj->base.type);
+        return;
+    }
+
+    FreeCsrObj(csrObj);
+    *object = NULL;
+    return;
+}
+
+static const CfOpensslCsrObj *CheckCsrObj(const CfBase *object)
+{
+    const CfOpensslCsrObj *csrObj = (const CfOpensslCsrObj *)object;
+    if ((csrObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CSR)) ||
+        (csrObj->reqs == NULL)) {
+        CF_LOG_E("the object is invalid , type = %lu", csrObj->base.type);
+        return NULL;
+    }
+    return csrObj;
+}
+
+static X509_REQ *GetCsr(const CfBase *object, uint32_t index)
+{
+    const CfOpensslCsrObj *csrObj = CheckCsrObj(object);
+    if (csrObj == NULL) {
+        return NULL;
+    }
+    if (index >= (uint32_t)sk_X509_REQ_num(csrObj->reqs)) {
+        CF_LOG_E("csr index out of range, index = %u", index);
+        return NULL;
+    }
+    return sk_X509_REQ_value(csrObj->reqs, (int)index);
+}
+
+int32_t CfOpensslGetCsrCount(const CfBase *object, uint32_t *count)
+{
+    if ((object == NULL) || (count == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslCsrObj *csrObj = CheckCsrObj(object);
+    if (csrObj == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+    *count = (uint32_t)sk_X509_REQ_num(csrObj->reqs);
+    return CF_SUCCESS;
+}
+
+static int32_t CopyToBlob(const void *data, uint32_t len, CfBlob *out)
+{
+    out->data = (uint8_t *)CfMalloc(len);
+    if (out->data == NULL) {
+        CF_LOG_E("malloc failed, len = %u", len);
+        return CF_ERR_MALLOC;
+    }
+    (void)memcpy_s(out->data, len, data, len);
+    out->size = len;
+    return CF_SUCCESS;
+}
+
+/* takes over the i2d output, out is allocated with CfMalloc as the callers free it with CfFree */
+static int32_t I2dToBlob(unsigned char *der, int len, CfBlob *out)
+{
+    if ((len <= 0) || (der == NULL)) {
+        CF_LOG_E("Failed to encode csr item");
+        CfPrintOpensslError();
+        OPENSSL_free(der);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    int32_t ret = CopyToBlob(der, (uint32_t)len, out);
+    OPENSSL_free(der);
+    return ret;
+}
+
+/* reads one element header with a single byte tag, the element must fit in len */
+static bool ReadDerHeader(const uint8_t *data, uint32_t len, uint32_t *headerLen, uint32_t *bodyLen)
+{
+    if (len < 2) { /* 2: tag and the first length byte */
+        return false;
+    }
+    uint32_t pos = 1;
+    uint32_t body = data[pos++];
+    if ((body & ASN1_LEN_LONG_FORM) != 0) {
+        uint32_t lenBytes = body & ~ASN1_LEN_LONG_FORM;
+        if ((lenBytes == 0) || (lenBytes > ASN1_LEN_MAX_BYTES) || (lenBytes > len - pos)) {
+            return false;
+        }
+        body = 0;
+        for (uint32_t i = 0; i < lenBytes; ++i) {
+            if (body > (UINT32_MAX >> 8)) { /* 8: bits per length byte */
+                return false;
+            }
+            body = (body << 8) | data[pos++]; /* 8: bits per length byte */
+        }
+    }
+    if (body > len - pos) {
+        return false;
+    }
+    *headerLen = pos;
+    *bodyLen = body;
+    return true;
+}
+
+/* the encoded request is kept by openssl, so the TBS and the attributes are cut from it as received */
+static int32_t GetCsrInfoSpan(const uint8_t *der, uint32_t derLen, uint32_t *offset, uint32_t *len)
+{
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if (!ReadDerHeader(der, derLen, &headerLen, &bodyLen)) {
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    uint32_t infoHeaderLen = 0;
+    uint32_t infoBodyLen = 0;
+    if (!ReadDerHeader(der + headerLen, bodyLen, &infoHeaderLen, &infoBodyLen)) {
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    *offset = headerLen;
+    *len = infoHeaderLen + infoBodyLen;
+    return CF_SUCCESS;
+}
+
+static int32_t GetCsrAttributes(const uint8_t *info, uint32_t infoLen, CfBlob *out)
+{
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if (!ReadDerHeader(info, infoLen, &headerLen, &bodyLen)) {
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+
+    uint32_t pos = headerLen;
+    uint32_t end = headerLen + bodyLen;
+    for (uint32_t i = 0; i < CSR_INFO_FIELDS_BEFORE_ATTRS; ++i) {
+        uint32_t fieldHeaderLen = 0;
+        uint32_t fieldBodyLen = 0;
+        if (!ReadDerHeader(info + pos, end - pos, &fieldHeaderLen, &fieldBodyLen)) {
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        pos += fieldHeaderLen + fieldBodyLen;
+    }
+
+    uint32_t attrsHeaderLen = 0;
+    uint32_t attrsBodyLen = 0;
+    if ((pos == end) || (info[pos] != ASN1_TAG_CONTEXT_0) ||
+        !ReadDerHeader(info + pos, end - pos, &attrsHeaderLen, &attrsBodyLen)) {
+        CF_LOG_E("csr attributes not found");
+        return CF_NOT_EXIST;
+    }
+
+    int32_t ret = CopyToBlob(info + pos, attrsHeaderLen + attrsBodyLen, out);
+    if (ret == CF_SUCCESS) {
+        out->data[0] = ASN1_TAG_TYPE_SET; /* [0] IMPLICIT SET OF Attribute, returned with its universal tag */
+    }
+    return ret;
+}
+
+static int32_t GetCsrEncodedPart(X509_REQ *req, CfItemId id, CfBlob *out)
+{
+    unsigned char *der = NULL;
+    int derLen = i2d_X509_REQ(req, &der);
+    if ((derLen <= 0) || (der == NULL)) {
+        CF_LOG_E("Failed to encode csr");
+        CfPrintOpensslError();
+        OPENSSL_free(der);
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+
+    uint32_t offset = 0;
+    uint32_t len = (uint32_t)derLen;
+    int32_t ret = CF_SUCCESS;
+    if (id != CF_ITEM_ENCODED) {
+        ret = GetCsrInfoSpan(der, (uint32_t)derLen, &offset, &len);
+    }
+    if (ret == CF_SUCCESS) {
+        ret = (id == CF_ITEM_ATTRIBUTES) ? GetCsrAttributes(der + offset, len, out) :
+            CopyToBlob(der + offset, len, out);
+    }
+    OPENSSL_free(der);
+    return ret;
+}
+
+static int32_t GetCsrExtensions(X509_REQ *req, CfBlob *out)
+{
+    STACK_OF(X509_EXTENSION) *exts = X509_REQ_get_extensions(req);
+    if ((exts == NULL) || (sk_X509_EXTENSION_num(exts) <= 0)) {
+        CF_LOG_E("csr requested extensions not found");
+        sk_X509_EXTENSION_free(exts);
+        ERR_clear_error();
+        return CF_NOT_EXIST;
+    }
+
+    unsigned char *der = NULL;
+    int len = i2d_X509_EXTENSIONS(exts, &der);
+    sk_X509_EXTENSION_pop_free(exts, X509_EXTENSION_free);
+    return I2dToBlob(der, len, out);
+}
+
+static int32_t GetCsrSigAlgName(X509_REQ *req, CfBlob *out)
+{
+    const X509_ALGOR *alg = NULL;
+    const ASN1_OBJECT *oidObj = NULL;
+    X509_REQ_get0_signature(req, NULL, &alg);
+    X509_ALGOR_get0(&oidObj, NULL, NULL, alg);
+
+    char name[MAX_LEN_OID] = { 0 };
+    int len = OBJ_obj2txt(name, MAX_LEN_OID, oidObj, 0); /* 0: use the long name if there is one */
+    if ((len <= 0) || (len >= MAX_LEN_OID)) {
+        CF_LOG_E("Failed to get csr signature algorithm name");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    return CopyToBlob(name, (uint32_t)len, out);
+}
+
+int32_t CfOpensslGetCsrItem(const CfBase *object, uint32_t index, CfItemId id, CfBlob *out)
+{
+    if ((object == NULL) || (out == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    X509_REQ *req = GetCsr(object, index);
+    if (req == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    unsigned char *der = NULL;
+    int len = 0;
+    const ASN1_BIT_STRING *signature = NULL;
+    int32_t version = 0;
+    switch (id) {
+        case CF_ITEM_ENCODED:
+        case CF_ITEM_TBS:
+        case CF_ITEM_ATTRIBUTES:
+            return GetCsrEncodedPart(req, id, out);
+        case CF_ITEM_VERSION:
+            version = (int32_t)X509_REQ_get_version(req) + 1; /* the encoded value is 0 for a v1 request */
+            return CopyToBlob(&version, sizeof(int32_t), out);
+        case CF_ITEM_SUBJECT_NAME:
+            len = i2d_X509_NAME(X509_REQ_get_subject_name(req), &der);
+            return I2dToBlob(der, len, out);
+        case CF_ITEM_PUBLIC_KEY:
+            len = i2d_X509_PUBKEY(X509_REQ_get_X509_PUBKEY(req), &der);
+            return I2dToBlob(der, len, out);
+        case CF_ITEM_EXTENSIONS:
+            return GetCsrExtensions(req, out);
+        case CF_ITEM_SIGNATURE:
+            X509_REQ_get0_signature(req, &signature, NULL);
+            return CopyToBlob(ASN1_STRING_get0_data(signature), (uint32_t)ASN1_STRING_length(signature), out);
+        case CF_ITEM_SIGNATURE_ALG_NAME:
+            return GetCsrSigAlgName(req, out);
+        default:
+            CF_LOG_E("csr item id invalid, id = %d", (int32_t)id);
+            return CF_INVALID_PARAMS;
+    }
+}
+
+static bool IsCsrSignatureValid(X509_REQ *req)
+{
+    EVP_PKEY *pubKey = X509_REQ_get0_pubkey(req);
+    bool valid = (pubKey != NULL) && (X509_REQ_verify(req, pubKey) == 1);
+    if (!valid) {
+        ERR_clear_error(); /* an invalid signature is a result, not an error of the call */
+    }
+    return valid;
+}
+
+int32_t CfOpensslVerifyCsr(const CfBase *object, uint32_t index, bool *valid)
+{
+    if ((object == NULL) || (valid == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    X509_REQ *req = GetCsr(object, index);
+    if (req == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+    *valid = IsCsrSignatureValid(req);
+    return CF_SUCCESS;
+}
+
+static void *VerifyCsrWorker(void *arg)
+{
+    CfCsrVerifyJob *job = (CfCsrVerifyJob *)arg;
+    while (true) {
+        uint32_t i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (i >= job->count) {
+            break;
+        }
+        job->results[i] = IsCsrSignatureValid(sk_X509_REQ_value(job->reqs, (int)i)) ? 1 : 0;
+    }
+    return NULL;
+}
+
+int32_t CfOpensslVerifyAllCsrs(const CfBase *object, CfBlob *out)
+{
+    if ((object == NULL) || (out == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslCsrObj *csrObj = CheckCsrObj(object);
+    if (csrObj == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    CfCsrVerifyJob job = { csrObj->reqs, (uint32_t)sk_X509_REQ_num(csrObj->reqs), 0, NULL };
+    job.results = (uint8_t *)CfMalloc(job.count);
+    if (job.results == NULL) {
+        CF_LOG_E("malloc results failed, count = %u", job.count);
+        return CF_ERR_MALLOC;
+    }
+
+    /* requests are handed out one at a time, so a slow key type does not hold back the other threads */
+    uint32_t threadNum = job.count / CF_CSR_VERIFY_PER_THREAD_MIN;
+    threadNum = (threadNum > CF_CSR_VERIFY_THREAD_MAX) ? CF_CSR_VERIFY_THREAD_MAX : threadNum;
+    pthread_t threads[CF_CSR_VERIFY_THREAD_MAX];
+    uint32_t started = 0;
+    for (; started + 1 < threadNum; ++started) {
+        if (pthread_create(&threads[started], NULL, VerifyCsrWorker, &job) != 0) {
+            CF_LOG_W("create csr verify thread failed, continue with %u threads", started + 1);
+            break;
+        }
+    }
+    (void)VerifyCsrWorker(&job);
+    for (uint32_t i = 0; i < started; ++i) {
+        (void)pthread_join(threads[i], NULL);
+    }
+
+    out->data = job.results;
+    out->size = job.count;
+    return CF_SUCCESS;
+}
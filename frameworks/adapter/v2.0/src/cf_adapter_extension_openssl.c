@@ -35,8 +35,8 @@
 
 int32_t CfOpensslCreateExtension(const CfEncodingBlob *inData, CfBase **object)
 {
-    if ((CfCheckEncodingBlob(inData, MAX_LEN_EXTENSIONS) != CF_SUCCESS) ||
-        (inData->encodingFormat != CF_FORMAT_DER) || (object == NULL)) {
+    if ((CfCheckEncodingBlob(inData, MAX_LEN_EXTENSIONS) != CF_SUCCESS) || (object == NULL) ||
+        (CfResolveEncodingFormat(inData->data, inData->len, inData->encodingFormat) != CF_FORMAT_DER)) {
         CF_LOG_E("invalid input params");
         return CF_INVALID_PARAMS;
     }
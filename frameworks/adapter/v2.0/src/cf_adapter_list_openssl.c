@@ -0,0 +1,803 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_adapter_list_openssl.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <openssl/asn1.h>
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/objects.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+
+#include "securec.h"
+
+#include "cf_check.h"
+#include "cf_log.h"
+#include "cf_magic.h"
+#include "cf_memory.h"
+#include "cf_pem.h"
+#include "cf_result.h"
+
+#define CF_OPENSSL_ERROR_LEN 128
+#define MAX_LEN_DATE 32
+#define SECONDS_PER_DAY 86400
+
+static void CfPrintOpensslError(void)
+{
+    char szErr[CF_OPENSSL_ERROR_LEN] = {0};
+    unsigned long errCode = ERR_get_error();
+    ERR_error_string_n(errCode, szErr, CF_OPENSSL_ERROR_LEN);
+
+    CF_LOG_E("[Openssl]: engine fail, error code = %lu, error string = %s", errCode, szErr);
+}
+
+static int32_t PushCert(STACK_OF(X509) *certs, X509 *x509)
+{
+    if (sk_X509_num(certs) >= MAX_COUNT_CERT_LIST) {
+        CF_LOG_E("too many certs in list, max count = %d", MAX_COUNT_CERT_LIST);
+        X509_free(x509);
+        return CF_INVALID_PARAMS;
+    }
+
+    if (sk_X509_push(certs, x509) <= 0) {
+        CF_LOG_E("push cert failed");
+        X509_free(x509);
+        return CF_ERR_MALLOC;
+    }
+    return CF_SUCCESS;
+}
+
+static int32_t ReadPemCerts(const CfEncodingBlob *inData, STACK_OF(X509) *certs)
+{
+    BIO *bio = BIO_new_mem_buf(inData->data, (int)inData->len);
+    if (bio == NULL) {
+        CF_LOG_E("malloc failed");
+        CfPrintOpensslError();
+        return CF_ERR_MALLOC;
+    }
+
+    int32_t ret = CF_SUCCESS;
+    X509 *x509 = NULL;
+    while ((x509 = PEM_read_bio_X509(bio, NULL, NULL, NULL)) != NULL) {
+        ret = PushCert(certs, x509);
+        if (ret != CF_SUCCESS) {
+            break;
+        }
+    }
+    BIO_free(bio);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    /* reading stops with PEM_R_NO_START_LINE once all certs in the bundle are consumed */
+    unsigned long err = ERR_peek_last_error();
+    if ((sk_X509_num(certs) == 0) || (ERR_GET_LIB(err) != ERR_LIB_PEM) ||
+        (ERR_GET_REASON(err) != PEM_R_NO_START_LINE)) {
+        CF_LOG_E("Failed to parse pem certs");
+        CfPrintOpensslError();
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    ERR_clear_error();
+    return CF_SUCCESS;
+}
+
+/* unsupported is set for the armor forms the native decoder leaves out, such as encapsulated headers */
+static int32_t DecodePemCerts(const CfEncodingBlob *inData, STACK_OF(X509) *certs, bool *unsupported)
+{
+    uint32_t offset = 0;
+    uint32_t len = (uint32_t)inData->len;
+    while (true) {
+        CfBlob der = { 0, NULL };
+        uint32_t next = 0;
+        int32_t ret = CfPemDecode(inData->data + offset, len - offset, CF_PEM_LABEL_CERT, &der, &next);
+        if (ret == CF_NOT_EXIST) {
+            break;
+        }
+        if (ret != CF_SUCCESS) {
+            *unsupported = (ret == CF_INVALID_PARAMS);
+            return ret;
+        }
+
+        const unsigned char *tmp = der.data;
+        X509 *x509 = d2i_X509(NULL, &tmp, (long)der.size);
+        CfFree(der.data);
+        if (x509 == NULL) {
+            CF_LOG_E("Failed to parse pem cert[%d]", sk_X509_num(certs));
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        ret = PushCert(certs, x509);
+        if (ret != CF_SUCCESS) {
+            return ret;
+        }
+        offset += next;
+    }
+
+    if (sk_X509_num(certs) == 0) {
+        CF_LOG_E("No pem cert found");
+        return CF_ERR_CRYPTO_OPERATION;
+    }
+    return CF_SUCCESS;
+}
+
+static int32_t ParsePemCerts(const CfEncodingBlob *inData, STACK_OF(X509) *certs)
+{
+    bool unsupported = false;
+    int32_t ret = DecodePemCerts(inData, certs, &unsupported);
+    if (!unsupported) {
+        return ret;
+    }
+
+    X509 *x509 = NULL;
+    while ((x509 = sk_X509_pop(certs)) != NULL) {
+        X509_free(x509);
+    }
+    return ReadPemCerts(inData, certs);
+}
+
+static int32_t ParseDerCerts(const CfEncodingBlob *inData, STACK_OF(X509) *certs)
+{
+    const unsigned char *data = inData->data; /* data pointer will shift downward in d2i_X509 */
+    const unsigned char *end = inData->data + inData->len;
+    while (data < end) {
+        X509 *x509 = d2i_X509(NULL, &data, (long)(end - data));
+        if (x509 == NULL) {
+            CF_LOG_E("Failed to parse der cert[%d]", sk_X509_num(certs));
+            CfPrintOpensslError();
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+
+        int32_t ret = PushCert(certs, x509);
+        if (ret != CF_SUCCESS) {
+            return ret;
+        }
+    }
+    return CF_SUCCESS;
+}
+
+static bool IsNameIndex(CfListIndexType type)
+{
+    return (type == CF_LIST_INDEX_SUBJECT_NAME) || (type == CF_LIST_INDEX_ISSUER_NAME);
+}
+
+static const void *GetIndexKey(X509 *x509, CfListIndexType type)
+{
+    switch (type) {
+        case CF_LIST_INDEX_SUBJECT_NAME:
+            return X509_get_subject_name(x509);
+        case CF_LIST_INDEX_ISSUER_NAME:
+            return X509_get_issuer_name(x509);
+        case CF_LIST_INDEX_SERIAL_NUMBER:
+            return X509_get0_serialNumber(x509);
+        case CF_LIST_INDEX_SUBJECT_KEY_ID:
+            return X509_get0_subject_key_id(x509);
+        case CF_LIST_INDEX_AUTHORITY_KEY_ID:
+            return X509_get0_authority_key_id(x509);
+        default:
+            return NULL;
+    }
+}
+
+static int CompareStringValue(const ASN1_STRING *str, const uint8_t *data, uint32_t len)
+{
+    uint32_t strLen = (uint32_t)ASN1_STRING_length(str);
+    if (strLen != len) {
+        return (strLen < len) ? -1 : 1;
+    }
+    return (len == 0) ? 0 : memcmp(ASN1_STRING_get0_data(str), data, len);
+}
+
+static int ComparePos(const CfListIndexNode *a, const CfListIndexNode *b)
+{
+    if (a->pos == b->pos) {
+        return 0;
+    }
+    return (a->pos < b->pos) ? -1 : 1;
+}
+
+static int CompareNameNode(const void *a, const void *b)
+{
+    const CfListIndexNode *nodeA = (const CfListIndexNode *)a;
+    const CfListIndexNode *nodeB = (const CfListIndexNode *)b;
+    int ret = X509_NAME_cmp((const X509_NAME *)nodeA->key, (const X509_NAME *)nodeB->key);
+    return (ret != 0) ? ret : ComparePos(nodeA, nodeB);
+}
+
+static int CompareStringNode(const void *a, const void *b)
+{
+    const CfListIndexNode *nodeA = (const CfListIndexNode *)a;
+    const CfListIndexNode *nodeB = (const CfListIndexNode *)b;
+    const ASN1_STRING *keyB = (const ASN1_STRING *)nodeB->key;
+    int ret = CompareStringValue((const ASN1_STRING *)nodeA->key, ASN1_STRING_get0_data(keyB),
+        (uint32_t)ASN1_STRING_length(keyB));
+    return (ret != 0) ? ret : ComparePos(nodeA, nodeB);
+}
+
+static int32_t BuildIndex(CfOpensslListObj *listObj, CfListIndexType type)
+{
+    uint32_t certNum = (uint32_t)sk_X509_num(listObj->certs);
+    CfListIndexNode *nodes = (CfListIndexNode *)CfMalloc(certNum * sizeof(CfListIndexNode));
+    if (nodes == NULL) {
+        CF_LOG_E("malloc index failed");
+        return CF_ERR_MALLOC;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < certNum; ++i) {
+        const void *key = GetIndexKey(sk_X509_value(listObj->certs, i), type);
+        if (key == NULL) { /* key identifiers are optional extensions */
+            continue;
+        }
+        nodes[count].key = key;
+        nodes[count].pos = i;
+        ++count;
+    }
+    qsort(nodes, count, sizeof(CfListIndexNode), IsNameIndex(type) ? CompareNameNode : CompareStringNode);
+
+    listObj->index[type].nodes = nodes;
+    listObj->index[type].count = count;
+    return CF_SUCCESS;
+}
+
+static void FreeListObj(CfOpensslListObj *listObj)
+{
+    for (uint32_t i = 0; i < CF_LIST_INDEX_COUNT; ++i) {
+        CF_FREE_PTR(listObj->index[i].nodes);
+        listObj->index[i].count = 0;
+    }
+    if (listObj->certs != NULL) {
+        sk_X509_pop_free(listObj->certs, X509_free);
+        listObj->certs = NULL;
+    }
+    CfFree(listObj);
+}
+
+int32_t CfOpensslCreateList(const CfEncodingBlob *inData, CfBase **object)
+{
+    if ((CfCheckEncodingBlob(inData, MAX_LEN_CERT_LIST) != CF_SUCCESS) || (object == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfOpensslListObj *listObj = CfMalloc(sizeof(CfOpensslListObj));
+    if (listObj == NULL) {
+        CF_LOG_E("malloc failed");
+        return CF_ERR_MALLOC;
+    }
+    listObj->base.type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_LIST);
+
+    listObj->certs = sk_X509_new_null();
+    if (listObj->certs == NULL) {
+        CF_LOG_E("malloc cert stack failed");
+        CfFree(listObj);
+        return CF_ERR_MALLOC;
+    }
+
+    /* format has checked in CfCheckEncodingBlob. an auto list is detected from its first cert */
+    enum CfEncodingFormat format = CfResolveEncodingFormat(inData->data, inData->len, inData->encodingFormat);
+    int32_t ret = (format == CF_FORMAT_PEM) ? ParsePemCerts(inData, listObj->certs) :
+        ParseDerCerts(inData, listObj->certs);
+    for (uint32_t i = 0; (ret == CF_SUCCESS) && (i < CF_LIST_INDEX_COUNT); ++i) {
+        ret = BuildIndex(listObj, (CfListIndexType)i);
+    }
+    if (ret != CF_SUCCESS) {
+        FreeListObj(listObj);
+        return ret;
+    }
+
+    *object = &listObj->base;
+    return CF_SUCCESS;
+}
+
+void CfOpensslDestoryList(CfBase **object)
+{
+    if ((object == NULL) || (*object == NULL)) {
+        CF_LOG_E("invalid input params");
+        return;
+    }
+
+    CfOpensslListObj *listObj = (CfOpensslListObj *)*object;
+    if (listObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_LIST)) {
+        CF_LOG_E("the object is invalid , type = %lu", listObj->base.type);
+        return;
+    }
+
+    FreeListObj(listObj);
+    *object = NULL;
+    return;
+}
+
+static const CfOpensslListObj *CheckListObj(const CfBase *object)
+{
+    const CfOpensslListObj *listObj = (const CfOpensslListObj *)object;
+    if ((listObj->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_LIST)) ||
+        (listObj->certs == NULL)) {
+        CF_LOG_E("the object is invalid , type = %lu", listObj->base.type);
+        return NULL;
+    }
+    return listObj;
+}
+
+static int CompareNodeWithKey(const CfListIndexNode *node, const X509_NAME *name, const CfBlob *value)
+{
+    if (name != NULL) {
+        return X509_NAME_cmp((const X509_NAME *)node->key, name);
+    }
+    return CompareStringValue((const ASN1_STRING *)node->key, value->data, value->size);
+}
+
+/* get the range [begin, end) of the nodes whose key equals to the name or value */
+static void SearchIndex(const CfListIndex *index, const X509_NAME *name, const CfBlob *value,
+    uint32_t *begin, uint32_t *end)
+{
+    uint32_t low = 0;
+    uint32_t high = index->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2; /* 2: binary search */
+        if (CompareNodeWithKey(&index->nodes[mid], name, value) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    *begin = low;
+    while ((low < index->count) && (CompareNodeWithKey(&index->nodes[low], name, value) == 0)) {
+        ++low;
+    }
+    *end = low;
+}
+
+static int32_t SearchByKey(const CfOpensslListObj *listObj, CfListIndexType type, const CfBlob *key,
+    uint32_t *begin, uint32_t *end)
+{
+    const CfListIndex *index = &listObj->index[type];
+    if (!IsNameIndex(type)) {
+        CfBlob value = *key;
+        /* openssl keeps the serial number without the sign padding */
+        while ((type == CF_LIST_INDEX_SERIAL_NUMBER) && (value.size > 1) && (value.data[0] == 0)) {
+            ++value.data;
+            --value.size;
+        }
+        SearchIndex(index, NULL, &value, begin, end);
+        return CF_SUCCESS;
+    }
+
+    const unsigned char *data = key->data;
+    X509_NAME *name = d2i_X509_NAME(NULL, &data, (long)key->size);
+    if (name == NULL) {
+        CF_LOG_E("Failed to parse name key");
+        CfPrintOpensslError();
+        return CF_INVALID_PARAMS;
+    }
+    SearchIndex(index, name, NULL, begin, end);
+    X509_NAME_free(name);
+    return CF_SUCCESS;
+}
+
+static int WriteBytes(const void *data, int len, unsigned char **out)
+{
+    if ((out != NULL) && (len > 0)) {
+        (void)memcpy_s(*out, (size_t)len, data, (size_t)len);
+        *out += len;
+    }
+    return len;
+}
+
+static int WriteSigAlgName(X509 *x509, unsigned char **out)
+{
+    const X509_ALGOR *alg = NULL;
+    const ASN1_OBJECT *oidObj = NULL;
+    X509_get0_signature(NULL, &alg, x509);
+    X509_ALGOR_get0(&oidObj, NULL, NULL, alg);
+
+    char name[MAX_LEN_OID] = { 0 };
+    int len = OBJ_obj2txt(name, MAX_LEN_OID, oidObj, 0); /* 0: use the long name if there is one */
+    if ((len <= 0) || (len >= MAX_LEN_OID)) {
+        return -1;
+    }
+    return WriteBytes(name, len, out);
+}
+
+static int WriteExtensions(X509 *x509, unsigned char **out)
+{
+    X509_EXTENSIONS *exts = (X509_EXTENSIONS *)X509_get0_extensions(x509);
+    if ((exts == NULL) || (sk_X509_EXTENSION_num(exts) <= 0)) {
+        return 0; /* the extensions are optional */
+    }
+    return i2d_X509_EXTENSIONS(exts, out);
+}
+
+/* i2d style: return the length of the field, and write it to *out then shift *out if out is not NULL */
+static int WriteField(X509 *x509, CfItemId id, unsigned char **out)
+{
+    const ASN1_BIT_STRING *signature = NULL;
+    const ASN1_INTEGER *serial = NULL;
+    switch (id) {
+        case CF_ITEM_ENCODED:
+            return i2d_X509(x509, out);
+        case CF_ITEM_SERIAL_NUMBER:
+            serial = X509_get0_serialNumber(x509);
+            return WriteBytes(ASN1_STRING_get0_data(serial), ASN1_STRING_length(serial), out);
+        case CF_ITEM_ISSUE_NAME:
+            return i2d_X509_NAME(X509_get_issuer_name(x509), out);
+        case CF_ITEM_SUBJECT_NAME:
+            return i2d_X509_NAME(X509_get_subject_name(x509), out);
+        case CF_ITEM_SIGNATURE:
+            X509_get0_signature(&signature, NULL, x509);
+            return WriteBytes(ASN1_STRING_get0_data(signature), ASN1_STRING_length(signature), out);
+        case CF_ITEM_SIGNATURE_ALG_NAME:
+            return WriteSigAlgName(x509, out);
+        case CF_ITEM_PUBLIC_KEY:
+            return i2d_X509_PUBKEY(X509_get_X509_PUBKEY(x509), out);
+        case CF_ITEM_EXTENSIONS:
+            return WriteExtensions(x509, out);
+        default:
+            return -1;
+    }
+}
+
+/* the cert at index i of the result, posArray is NULL when the result covers the whole list */
+static X509 *GetResultCert(const STACK_OF(X509) *certs, const uint32_t *posArray, uint32_t i)
+{
+    return sk_X509_value(certs, (int)((posArray == NULL) ? i : posArray[i]));
+}
+
+/* layout: uint32_t count if withCount, then uint32_t offset[count + 1] followed by the field bytes */
+static int32_t PackFields(const STACK_OF(X509) *certs, const uint32_t *posArray, uint32_t count, CfItemId id,
+    bool withCount, CfBlob *out)
+{
+    uint32_t countLen = withCount ? sizeof(uint32_t) : 0;
+    uint32_t headerLen = countLen + (count + 1) * sizeof(uint32_t);
+    uint32_t totalLen = headerLen;
+    for (uint32_t i = 0; i < count; ++i) {
+        int len = WriteField(GetResultCert(certs, posArray, i), id, NULL);
+        if ((len < 0) || CfIsAdditionOverflow(totalLen, (uint32_t)len)) {
+            CF_LOG_E("Failed to get item[%d] len of cert[%u]", (int32_t)id, i);
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        totalLen += (uint32_t)len;
+    }
+
+    uint8_t *packed = (uint8_t *)CfMallocLarge(totalLen);
+    if (packed == NULL) {
+        CF_LOG_E("malloc packed fields failed, len = %u", totalLen);
+        return CF_ERR_MALLOC;
+    }
+
+    if (withCount) {
+        *(uint32_t *)packed = count;
+    }
+    uint32_t *offset = (uint32_t *)(packed + countLen);
+    unsigned char *data = packed + headerLen; /* data pointer will shift downward in WriteField */
+    offset[0] = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        int len = WriteField(GetResultCert(certs, posArray, i), id, &data);
+        if (len < 0) {
+            CF_LOG_E("Failed to get item[%d] of cert[%u]", (int32_t)id, i);
+            CfFree(packed);
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        offset[i + 1] = offset[i] + (uint32_t)len;
+    }
+
+    out->data = packed;
+    out->size = totalLen;
+    return CF_SUCCESS;
+}
+
+static int32_t PackCerts(const STACK_OF(X509) *certs, const uint32_t *posArray, uint32_t count, CfBlob *out)
+{
+    if (count == 0) {
+        CF_LOG_E("no cert matched");
+        return CF_NOT_EXIST;
+    }
+    return PackFields(certs, posArray, count, CF_ITEM_ENCODED, true, out);
+}
+
+int32_t CfOpensslFindCerts(const CfBase *object, CfListIndexType type, const CfBlob *key, CfBlob *out)
+{
+    if ((object == NULL) || (out == NULL) || ((uint32_t)type >= CF_LIST_INDEX_COUNT) ||
+        (CfCheckBlob(key, MAX_LEN_CERTIFICATE) != CF_SUCCESS)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslListObj *listObj = CheckListObj(object);
+    if (listObj == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    int32_t ret = SearchByKey(listObj, type, key, &begin, &end);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    if (begin == end) {
+        CF_LOG_E("no cert matched");
+        return CF_NOT_EXIST;
+    }
+
+    uint32_t *posArray = (uint32_t *)CfMalloc((end - begin) * sizeof(uint32_t));
+    if (posArray == NULL) {
+        CF_LOG_E("malloc position array failed");
+        return CF_ERR_MALLOC;
+    }
+    for (uint32_t i = begin; i < end; ++i) {
+        posArray[i - begin] = listObj->index[type].nodes[i].pos;
+    }
+
+    ret = PackCerts(listObj->certs, posArray, end - begin, out);
+    CfFree(posArray);
+    return ret;
+}
+
+static int32_t CopyBlobToString(const CfBlob *blob, char *str, uint32_t maxLen)
+{
+    if ((CfCheckBlob(blob, maxLen - 1) != CF_SUCCESS) || (memcpy_s(str, maxLen, blob->data, blob->size) != EOK)) {
+        CF_LOG_E("invalid selector string");
+        return CF_INVALID_PARAMS;
+    }
+    str[blob->size] = '\0';
+    return CF_SUCCESS;
+}
+
+static bool HasExtKeyUsage(X509 *x509, const ASN1_OBJECT *usage)
+{
+    EXTENDED_KEY_USAGE *eku = X509_get_ext_d2i(x509, NID_ext_key_usage, NULL, NULL);
+    if (eku == NULL) {
+        return false;
+    }
+
+    bool found = false;
+    for (int i = 0; i < sk_ASN1_OBJECT_num(eku); ++i) {
+        const ASN1_OBJECT *obj = sk_ASN1_OBJECT_value(eku, i);
+        if ((OBJ_cmp(obj, usage) == 0) || (OBJ_obj2nid(obj) == NID_anyExtendedKeyUsage)) {
+            found = true;
+            break;
+        }
+    }
+    EXTENDED_KEY_USAGE_free(eku);
+    return found;
+}
+
+static bool IsValidAtDate(const X509 *x509, const ASN1_TIME *date)
+{
+    /* 0: equal in ASN1_TIME_compare, -1: a < b, 1: a > b, -2: error. */
+    return (ASN1_TIME_compare(date, X509_get0_notBefore(x509)) >= 0) &&
+        (ASN1_TIME_compare(X509_get0_notAfter(x509), date) >= 0);
+}
+
+typedef struct {
+    ASN1_OBJECT *usage;
+    ASN1_TIME *date;
+} CfListFilter;
+
+static void FreeFilter(CfListFilter *filter)
+{
+    if (filter->usage != NULL) {
+        ASN1_OBJECT_free(filter->usage);
+        filter->usage = NULL;
+    }
+    if (filter->date != NULL) {
+        ASN1_TIME_free(filter->date);
+        filter->date = NULL;
+    }
+}
+
+static int32_t InitFilter(const CfListSelector *selector, CfListFilter *filter)
+{
+    if (selector->extKeyUsage != NULL) {
+        char oid[MAX_LEN_OID] = { 0 };
+        if (CopyBlobToString(selector->extKeyUsage, oid, MAX_LEN_OID) != CF_SUCCESS) {
+            return CF_INVALID_PARAMS;
+        }
+        filter->usage = OBJ_txt2obj(oid, 1); /* 1: only numerical form is accepted */
+        if (filter->usage == NULL) {
+            CF_LOG_E("Failed to parse ext key usage oid");
+            CfPrintOpensslError();
+            return CF_INVALID_PARAMS;
+        }
+    }
+
+    if (selector->date != NULL) {
+        char date[MAX_LEN_DATE] = { 0 };
+        if (CopyBlobToString(selector->date, date, MAX_LEN_DATE) != CF_SUCCESS) {
+            return CF_INVALID_PARAMS;
+        }
+        filter->date = ASN1_TIME_new();
+        if (filter->date == NULL) {
+            CF_LOG_E("Failed to malloc for asn1 time.");
+            return CF_ERR_MALLOC;
+        }
+        if (ASN1_TIME_set_string(filter->date, date) != 1) {
+            CF_LOG_E("Failed to set time for asn1 time.");
+            CfPrintOpensslError();
+            return CF_INVALID_PARAMS;
+        }
+    }
+    return CF_SUCCESS;
+}
+
+static bool IsCertSelected(X509 *x509, const CfListFilter *filter)
+{
+    if ((filter->date != NULL) && !IsValidAtDate(x509, filter->date)) {
+        return false;
+    }
+    return (filter->usage == NULL) || HasExtKeyUsage(x509, filter->usage);
+}
+
+static int32_t FilterCerts(const CfOpensslListObj *listObj, const CfListSelector *selector,
+    const CfListFilter *filter, uint32_t *posArray, uint32_t *count)
+{
+    uint32_t matched = 0;
+    if (selector->issuer == NULL) {
+        uint32_t certNum = (uint32_t)sk_X509_num(listObj->certs);
+        for (uint32_t i = 0; i < certNum; ++i) {
+            if (IsCertSelected(sk_X509_value(listObj->certs, i), filter)) {
+                posArray[matched++] = i;
+            }
+        }
+        *count = matched;
+        return CF_SUCCESS;
+    }
+
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    int32_t ret = SearchByKey(listObj, CF_LIST_INDEX_ISSUER_NAME, selector->issuer, &begin, &end);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    const CfListIndex *index = &listObj->index[CF_LIST_INDEX_ISSUER_NAME];
+    for (uint32_t i = begin; i < end; ++i) {
+        if (IsCertSelected(sk_X509_value(listObj->certs, index->nodes[i].pos), filter)) {
+            posArray[matched++] = index->nodes[i].pos;
+        }
+    }
+    *count = matched;
+    return CF_SUCCESS;
+}
+
+int32_t CfOpensslSelectCerts(const CfBase *object, const CfListSelector *selector, CfBlob *out)
+{
+    if ((object == NULL) || (selector == NULL) || (out == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslListObj *listObj = CheckListObj(object);
+    if (listObj == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    if ((selector->issuer != NULL) && (CfCheckBlob(selector->issuer, MAX_LEN_CERTIFICATE) != CF_SUCCESS)) {
+        CF_LOG_E("invalid issuer selector");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfListFilter filter = { NULL, NULL };
+    int32_t ret = InitFilter(selector, &filter);
+    if (ret != CF_SUCCESS) {
+        FreeFilter(&filter);
+        return ret;
+    }
+
+    uint32_t *posArray = (uint32_t *)CfMalloc((uint32_t)sk_X509_num(listObj->certs) * sizeof(uint32_t));
+    if (posArray == NULL) {
+        CF_LOG_E("malloc position array failed");
+        FreeFilter(&filter);
+        return CF_ERR_MALLOC;
+    }
+
+    uint32_t count = 0;
+    ret = FilterCerts(listObj, selector, &filter, posArray, &count);
+    if (ret == CF_SUCCESS) {
+        ret = PackCerts(listObj->certs, posArray, count, out);
+    }
+    CfFree(posArray);
+    FreeFilter(&filter);
+    return ret;
+}
+
+static int32_t GetVersionColumn(const STACK_OF(X509) *certs, uint32_t certNum, CfBlob *out)
+{
+    int32_t *column = (int32_t *)CfMallocLarge(certNum * sizeof(int32_t));
+    if (column == NULL) {
+        CF_LOG_E("malloc version column failed");
+        return CF_ERR_MALLOC;
+    }
+
+    for (uint32_t i = 0; i < certNum; ++i) {
+        column[i] = (int32_t)X509_get_version(sk_X509_value(certs, i)) + 1; /* version 1 is encoded as 0 */
+    }
+    out->data = (uint8_t *)column;
+    out->size = certNum * sizeof(int32_t);
+    return CF_SUCCESS;
+}
+
+static int32_t GetTimeColumn(const STACK_OF(X509) *certs, uint32_t certNum, CfItemId id, CfBlob *out)
+{
+    ASN1_TIME *epoch = ASN1_TIME_set(NULL, 0);
+    if (epoch == NULL) {
+        CF_LOG_E("Failed to malloc for asn1 time.");
+        return CF_ERR_MALLOC;
+    }
+
+    int64_t *column = (int64_t *)CfMallocLarge(certNum * sizeof(int64_t));
+    if (column == NULL) {
+        CF_LOG_E("malloc time column failed");
+        ASN1_TIME_free(epoch);
+        return CF_ERR_MALLOC;
+    }
+
+    for (uint32_t i = 0; i < certNum; ++i) {
+        X509 *x509 = sk_X509_value(certs, i);
+        const ASN1_TIME *time = (id == CF_ITEM_NOT_BEFORE) ? X509_get0_notBefore(x509) : X509_get0_notAfter(x509);
+        int day = 0;
+        int sec = 0;
+        if (ASN1_TIME_diff(&day, &sec, epoch, time) != 1) {
+            CF_LOG_E("Failed to convert time of cert[%u]", i);
+            CfPrintOpensslError();
+            CfFree(column);
+            ASN1_TIME_free(epoch);
+            return CF_ERR_CRYPTO_OPERATION;
+        }
+        column[i] = (int64_t)day * SECONDS_PER_DAY + sec;
+    }
+    ASN1_TIME_free(epoch);
+
+    out->data = (uint8_t *)column;
+    out->size = certNum * sizeof(int64_t);
+    return CF_SUCCESS;
+}
+
+int32_t CfOpensslGetCertColumn(const CfBase *object, CfItemId id, CfBlob *out)
+{
+    if ((object == NULL) || (out == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    const CfOpensslListObj *listObj = CheckListObj(object);
+    if (listObj == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    uint32_t certNum = (uint32_t)sk_X509_num(listObj->certs);
+    switch (id) {
+        case CF_ITEM_VERSION:
+            return GetVersionColumn(listObj->certs, certNum, out);
+        case CF_ITEM_NOT_BEFORE:
+        case CF_ITEM_NOT_AFTER:
+            return GetTimeColumn(listObj->certs, certNum, id, out);
+        case CF_ITEM_ENCODED:
+        case CF_ITEM_SERIAL_NUMBER:
+        case CF_ITEM_ISSUE_NAME:
+        case CF_ITEM_SUBJECT_NAME:
+        case CF_ITEM_SIGNATURE:
+        case CF_ITEM_SIGNATURE_ALG_NAME:
+        case CF_ITEM_PUBLIC_KEY:
+        case CF_ITEM_EXTENSIONS:
+            return PackFields(listObj->certs, NULL, certNum, id, false, out);
+        default:
+            CF_LOG_E("the item id is not supported in list, id = %d", (int32_t)id);
+            return CF_NOT_SUPPORT;
+    }
+}
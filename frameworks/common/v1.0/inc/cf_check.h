@@ -26,6 +26,25 @@ extern "C" {
 int32_t CfCheckBlob(const CfBlob *blob, uint32_t maxLen);
 int32_t CfCheckEncodingBlob(const CfEncodingBlob *blob, uint32_t maxLen);
 
+/*
+ * Checks that data starts with a DER SEQUENCE of definite length that fits in len and whose content starts with
+ * another SEQUENCE, the outer framing of certificates and CRLs. Meant to reject garbage before openssl sees it,
+ * so it does not log.
+ */
+int32_t CfCheckDerFraming(const uint8_t *data, uint32_t len);
+
+/*
+ * Checks that data is one or more DER SEQUENCEs back to back with nothing left over and sets count to their
+ * number. Only the framing is read, not the content. Does not log either.
+ */
+int32_t CfCheckDerSequenceList(const uint8_t *data, uint32_t len, uint32_t *count);
+
+/*
+ * Returns format itself unless it is CF_FORMAT_AUTO. For CF_FORMAT_AUTO the data is taken as DER when it starts
+ * with a SEQUENCE that fits in len and as PEM otherwise, only the first few bytes are read.
+ */
+enum CfEncodingFormat CfResolveEncodingFormat(const uint8_t *data, size_t len, enum CfEncodingFormat format);
+
 #ifdef __cplusplus
 }
 #endif
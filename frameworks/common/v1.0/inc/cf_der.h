@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_DER_H
+#define CF_DER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CF_DER_TAG_INTEGER 0x02
+#define CF_DER_TAG_BIT_STRING 0x03
+#define CF_DER_TAG_OCTET_STRING 0x04
+#define CF_DER_TAG_ENUMERATED 0x0A
+#define CF_DER_TAG_UTC_TIME 0x17
+#define CF_DER_TAG_GENERALIZED_TIME 0x18
+#define CF_DER_TAG_SEQUENCE 0x30
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Writers for building DER without an intermediate ASN.1 tree, the caller sizes the buffer with the Size
+ * functions first and the Put functions return the number of bytes written. Nothing is checked here.
+ */
+
+/* Size of the tag and length octets for bodyLen bytes of content. */
+uint32_t CfDerHeaderSize(uint32_t bodyLen);
+
+uint32_t CfDerPutHeader(uint8_t *out, uint8_t tag, uint32_t bodyLen);
+
+/*
+ * Size of the whole TLV of a non-negative INTEGER or ENUMERATED whose big-endian magnitude is value, leading zero
+ * bytes of value are dropped and a zero byte is added when the top bit is set.
+ */
+uint32_t CfDerUintSize(const uint8_t *value, uint32_t len);
+
+uint32_t CfDerPutUint(uint8_t *out, uint8_t tag, const uint8_t *value, uint32_t len);
+
+/* Seconds since the epoch that fit a four digit year. */
+bool CfDerIsTimeValid(int64_t seconds);
+
+/* Time as RFC 5280 wants it, UTCTime for the years 1950 through 2049 and GeneralizedTime otherwise. */
+uint32_t CfDerTimeSize(int64_t seconds);
+
+uint32_t CfDerPutTime(uint8_t *out, int64_t seconds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_DER_H */
@@ -27,7 +27,13 @@ void CfFree(void* addr);
 
 void *CfMalloc(uint32_t size);
 
+/* Like HcfMalloc with the higher limit, only for buffers that grow with the entries of a CRL or a cert list. */
+void *HcfMallocLarge(uint32_t size, char val);
+
+void *CfMallocLarge(uint32_t size);
+
 #define MAX_MEMORY_SIZE (5 * 1024 * 1024)
+#define MAX_LARGE_MEMORY_SIZE (64 * 1024 * 1024)
 
 #define SELF_FREE_PTR(PTR, FREE_FUNC) \
 { \
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_PEM_H
+#define CF_PEM_H
+
+#include <stdint.h>
+#include "cf_blob.h"
+
+#define CF_PEM_LABEL_CERT "CERTIFICATE"
+#define CF_PEM_LABEL_CRL "X509 CRL"
+#define CF_PEM_LABEL_CSR "CERTIFICATE REQUEST"
+#define CF_PEM_LABEL_PKCS7 "PKCS7"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Decodes the first PEM block of data to DER, the block must carry the label and no encapsulated headers.
+ * Returns CF_NOT_EXIST if there is no block left, and CF_INVALID_PARAMS for any armor it does not handle,
+ * callers may then fall back to openssl for the uncommon forms. der is freed by the caller with CfFree,
+ * endOffset is set to the offset past the END line when not NULL, to read the next block of a bundle.
+ */
+int32_t CfPemDecode(const uint8_t *data, uint32_t len, const char *label, CfBlob *der, uint32_t *endOffset);
+
+/* Encodes der as one PEM block with 64 characters per line, pem is freed by the caller with CfFree. */
+int32_t CfPemEncode(const uint8_t *der, uint32_t derLen, const char *label, CfBlob *pem);
+
+/* Converts a DER encoding blob to PEM in place, the DER data is freed. */
+int32_t CfEncodingBlobToPem(CfEncodingBlob *blob, const char *label);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_PEM_H */
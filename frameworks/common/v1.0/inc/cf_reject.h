@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_REJECT_H
+#define CF_REJECT_H
+
+#include <stdint.h>
+
+typedef enum {
+    CF_REJECT_TYPE_CERT = 0,
+    CF_REJECT_TYPE_CRL,
+    CF_REJECT_TYPE_MAX,
+} CfRejectType;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Counts an input of type rejected as malformed. A summary is logged at most once per interval instead of one
+ * line per input, so a flood of garbage costs a counter increment per input.
+ */
+void CfCountRejectedInput(CfRejectType type);
+
+/* Number of inputs of type rejected since the process started. */
+uint64_t CfGetRejectedInputCount(CfRejectType type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CF_REJECT_H */
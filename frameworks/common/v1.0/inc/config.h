@@ -20,6 +20,10 @@
 #define HCF_MAX_ALGO_NAME_LEN 128 // input algoName parameter max length limit, include \0
 #define LOG_PRINT_MAX_LEN 1024 // log max length limit
 #define HCF_MAX_BUFFER_LEN 8192
+#define HCF_MAX_PKCS7_LEN (8 * 1024 * 1024) // a pkcs7 bundle carries whole chains and crls
+#define HCF_MAX_PKCS7_OBJ_NUM 4096 // certs and crls in one pkcs7 bundle
+#define HCF_MAX_CERT_ISSUE_NUM 4096 // certs issued in one batch
+#define HCF_MAX_CRL_BUILD_ENTRY_NUM (1024 * 1024) // revoked entries of one built crl
 #define SERIAL_NUMBER_HEDER_SIZE 2
 #define INVALID_VERSION (-1)
 #define INVALID_CONSTRAINTS_LEN (-1)
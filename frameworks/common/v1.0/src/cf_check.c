@@ -15,9 +15,16 @@
 
 #include "cf_check.h"
 
+#include <stdbool.h>
+
 #include "cf_log.h"
 #include "cf_result.h"
 
+#define ASN1_TAG_TYPE_SEQ 0x30
+#define ASN1_LEN_LONG_FORM 0x80
+#define ASN1_HEADER_MIN_LEN 2
+#define BITS_PER_BYTE 8
+
 int32_t CfCheckBlob(const CfBlob *blob, uint32_t maxLen)
 {
     if ((blob == NULL) || (blob->data == NULL) || (blob->size == 0) || (blob->size > maxLen)) {
@@ -34,9 +41,87 @@ int32_t CfCheckEncodingBlob(const CfEncodingBlob *blob, uint32_t maxLen)
         return CF_INVALID_PARAMS;
     }
 
-    if ((blob->encodingFormat != CF_FORMAT_DER) && (blob->encodingFormat != CF_FORMAT_PEM)) {
+    if ((blob->encodingFormat != CF_FORMAT_DER) && (blob->encodingFormat != CF_FORMAT_PEM) &&
+        (blob->encodingFormat != CF_FORMAT_AUTO)) {
         CF_LOG_E("invalid encode format");
         return CF_ERR_INVALID_CODE_FORMAT;
     }
     return CF_SUCCESS;
 }
+
+/* Reads the header of a SEQUENCE, the content must fit in len. */
+static bool ReadSequenceHeader(const uint8_t *data, uint32_t len, uint32_t *headerLen, uint32_t *bodyLen)
+{
+    if ((len < ASN1_HEADER_MIN_LEN) || (data[0] != ASN1_TAG_TYPE_SEQ)) {
+        return false;
+    }
+    uint32_t pos = 1;
+    uint8_t first = data[pos++];
+    uint32_t size = first;
+    if ((first & ASN1_LEN_LONG_FORM) != 0) {
+        uint32_t count = first & (uint8_t)~ASN1_LEN_LONG_FORM;
+        if ((count == 0) || (count > sizeof(uint32_t)) || (count > len - pos)) { /* 0: indefinite, not DER */
+            return false;
+        }
+        size = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            size = (size << BITS_PER_BYTE) | data[pos++];
+        }
+    }
+    if (size > len - pos) {
+        return false;
+    }
+    *headerLen = pos;
+    *bodyLen = size;
+    return true;
+}
+
+int32_t CfCheckDerFraming(const uint8_t *data, uint32_t len)
+{
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if ((data == NULL) || !ReadSequenceHeader(data, len, &headerLen, &bodyLen)) {
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t innerHeaderLen = 0;
+    uint32_t innerBodyLen = 0;
+    if (!ReadSequenceHeader(data + headerLen, bodyLen, &innerHeaderLen, &innerBodyLen)) {
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+int32_t CfCheckDerSequenceList(const uint8_t *data, uint32_t len, uint32_t *count)
+{
+    uint32_t num = 0;
+    uint32_t pos = 0;
+    while ((data != NULL) && (pos < len)) {
+        uint32_t headerLen = 0;
+        uint32_t bodyLen = 0;
+        if (!ReadSequenceHeader(data + pos, len - pos, &headerLen, &bodyLen)) {
+            return CF_INVALID_PARAMS;
+        }
+        pos += headerLen + bodyLen;
+        num++;
+    }
+    if ((num == 0) || (count == NULL)) {
+        return CF_INVALID_PARAMS;
+    }
+    *count = num;
+    return CF_SUCCESS;
+}
+
+enum CfEncodingFormat CfResolveEncodingFormat(const uint8_t *data, size_t len, enum CfEncodingFormat format)
+{
+    if (format != CF_FORMAT_AUTO) {
+        return format;
+    }
+    /* text starting with '0' has the SEQUENCE tag too, so the length has to fit the data as well */
+    uint32_t headerLen = 0;
+    uint32_t bodyLen = 0;
+    if ((data != NULL) && ReadSequenceHeader(data, (len > UINT32_MAX) ? UINT32_MAX : (uint32_t)len, &headerLen,
+        &bodyLen)) {
+        return CF_FORMAT_DER;
+    }
+    return CF_FORMAT_PEM;
+}
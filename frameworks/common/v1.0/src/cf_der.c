@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_der.h"
+
+#define DER_LEN_LONG_FORM 0x80
+#define DER_SHORT_LEN_MAX 0x7F
+#define DER_SIGN_BIT 0x80
+#define BITS_PER_BYTE 8
+#define UTC_TIME_LEN 13 /* YYMMDDHHMMSSZ */
+#define GENERALIZED_TIME_LEN 15 /* YYYYMMDDHHMMSSZ */
+#define UTC_YEAR_MIN 1950
+#define UTC_YEAR_MAX 2049
+#define TIME_MIN (-62167219200LL) /* 0000-01-01T00:00:00Z */
+#define TIME_MAX 253402300799LL /* 9999-12-31T23:59:59Z */
+#define SECONDS_PER_DAY 86400
+#define SECONDS_PER_HOUR 3600
+#define SECONDS_PER_MINUTE 60
+#define DECIMAL 10
+#define CENTURY 100
+
+typedef struct {
+    int64_t year;
+    uint32_t month;
+    uint32_t day;
+    uint32_t hour;
+    uint32_t minute;
+    uint32_t second;
+} DerDateTime;
+
+uint32_t CfDerHeaderSize(uint32_t bodyLen)
+{
+    uint32_t size = 1 + 1;
+    if (bodyLen <= DER_SHORT_LEN_MAX) {
+        return size;
+    }
+    for (uint32_t rest = bodyLen; rest != 0; rest >>= BITS_PER_BYTE) {
+        size++;
+    }
+    return size;
+}
+
+uint32_t CfDerPutHeader(uint8_t *out, uint8_t tag, uint32_t bodyLen)
+{
+    uint32_t size = CfDerHeaderSize(bodyLen);
+    out[0] = tag;
+    if (size == 1 + 1) {
+        out[1] = (uint8_t)bodyLen;
+        return size;
+    }
+    uint32_t count = size - 1 - 1;
+    out[1] = (uint8_t)(DER_LEN_LONG_FORM | count);
+    for (uint32_t i = 0; i < count; i++) {
+        out[size - 1 - i] = (uint8_t)(bodyLen >> (i * BITS_PER_BYTE));
+    }
+    return size;
+}
+
+static uint32_t UintContentSize(const uint8_t **value, uint32_t *len)
+{
+    while ((*len > 1) && ((*value)[0] == 0)) {
+        (*value)++;
+        (*len)--;
+    }
+    if (*len == 0) {
+        return 1;
+    }
+    return *len + ((((*value)[0] & DER_SIGN_BIT) != 0) ? 1 : 0);
+}
+
+uint32_t CfDerUintSize(const uint8_t *value, uint32_t len)
+{
+    uint32_t bodyLen = UintContentSize(&value, &len);
+    return CfDerHeaderSize(bodyLen) + bodyLen;
+}
+
+uint32_t CfDerPutUint(uint8_t *out, uint8_t tag, const uint8_t *value, uint32_t len)
+{
+    uint32_t bodyLen = UintContentSize(&value, &len);
+    uint32_t pos = CfDerPutHeader(out, tag, bodyLen);
+    if (bodyLen > len) {
+        out[pos++] = 0;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        out[pos++] = value[i];
+    }
+    return pos;
+}
+
+/* days since 1970-01-01 to the civil date, valid for the whole proleptic gregorian calendar */
+static void ToDateTime(int64_t seconds, DerDateTime *dateTime)
+{
+    int64_t days = seconds / SECONDS_PER_DAY;
+    int64_t rest = seconds % SECONDS_PER_DAY;
+    if (rest < 0) {
+        rest += SECONDS_PER_DAY;
+        days--;
+    }
+    dateTime->hour = (uint32_t)(rest / SECONDS_PER_HOUR);
+    dateTime->minute = (uint32_t)((rest % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+    dateTime->second = (uint32_t)(rest % SECONDS_PER_MINUTE);
+
+    int64_t z = days + 719468; /* shift the epoch to 0000-03-01 */
+    int64_t era = ((z >= 0) ? z : (z - 146096)) / 146097; /* 146097 days per 400 years */
+    int64_t dayOfEra = z - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153; /* months counted from march */
+    dateTime->day = (uint32_t)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    dateTime->month = (uint32_t)((monthIndex < 10) ? (monthIndex + 3) : (monthIndex - 9));
+    dateTime->year = yearOfEra + era * 400 + ((dateTime->month <= 2) ? 1 : 0);
+}
+
+static uint32_t PutDigits(uint8_t *out, uint32_t value, uint32_t count)
+{
+    for (uint32_t i = count; i > 0; i--) {
+        out[i - 1] = (uint8_t)('0' + value % DECIMAL);
+        value /= DECIMAL;
+    }
+    return count;
+}
+
+bool CfDerIsTimeValid(int64_t seconds)
+{
+    return (seconds >= TIME_MIN) && (seconds <= TIME_MAX);
+}
+
+uint32_t CfDerTimeSize(int64_t seconds)
+{
+    DerDateTime dateTime;
+    ToDateTime(seconds, &dateTime);
+    if ((dateTime.year >= UTC_YEAR_MIN) && (dateTime.year <= UTC_YEAR_MAX)) {
+        return 1 + 1 + UTC_TIME_LEN;
+    }
+    return 1 + 1 + GENERALIZED_TIME_LEN;
+}
+
+uint32_t CfDerPutTime(uint8_t *out, int64_t seconds)
+{
+    DerDateTime dateTime;
+    ToDateTime(seconds, &dateTime);
+    uint32_t pos = 0;
+    if ((dateTime.year >= UTC_YEAR_MIN) && (dateTime.year <= UTC_YEAR_MAX)) {
+        pos += CfDerPutHeader(out, CF_DER_TAG_UTC_TIME, UTC_TIME_LEN);
+        pos += PutDigits(out + pos, (uint32_t)(dateTime.year % CENTURY), 2);
+    } else {
+        pos += CfDerPutHeader(out, CF_DER_TAG_GENERALIZED_TIME, GENERALIZED_TIME_LEN);
+        pos += PutDigits(out + pos, (uint32_t)dateTime.year, 4);
+    }
+    pos += PutDigits(out + pos, dateTime.month, 2);
+    pos += PutDigits(out + pos, dateTime.day, 2);
+    pos += PutDigits(out + pos, dateTime.hour, 2);
+    pos += PutDigits(out + pos, dateTime.minute, 2);
+    pos += PutDigits(out + pos, dateTime.second, 2);
+    out[pos++] = 'Z';
+    return pos;
+}
@@ -38,7 +38,25 @@ void CfFree(void *addr)
     }
 }
 
+void *HcfMallocLarge(uint32_t size, char val)
+{
+    if ((size == 0) || (size > MAX_LARGE_MEMORY_SIZE)) {
+        LOGE("malloc size is invalid");
+        return NULL;
+    }
+    void *addr = malloc(size);
+    if (addr != NULL) {
+        (void)memset_s(addr, size, val, size);
+    }
+    return addr;
+}
+
 void *CfMalloc(uint32_t size)
 {
     return HcfMalloc(size, 0);
 }
+
+void *CfMallocLarge(uint32_t size)
+{
+    return HcfMallocLarge(size, 0);
+}
@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_pem.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "securec.h"
+
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_result.h"
+
+#define PEM_BEGIN_LINE "-----BEGIN "
+#define PEM_END_LINE "-----END "
+#define PEM_DASHES "-----"
+#define PEM_BEGIN_LINE_LEN (sizeof(PEM_BEGIN_LINE) - 1)
+#define PEM_END_LINE_LEN (sizeof(PEM_END_LINE) - 1)
+#define PEM_DASHES_LEN (sizeof(PEM_DASHES) - 1)
+
+#define BASE64_QUANTUM_CHARS 4
+#define BASE64_QUANTUM_BYTES 3
+#define BASE64_MAX_PADDING 2
+#define BASE64_BITS_PER_CHAR 6
+#define BASE64_VALUE_MAX 0x3F
+#define BASE64_WHITESPACE 0x40
+#define BASE64_PADDING 0x41
+#define BASE64_INVALID 0x80
+#define BYTE_MASK 0xFF
+#define SHIFT_FIRST_BYTE 16
+#define SHIFT_SECOND_BYTE 8
+#define SHIFT_FIRST_CHAR 18
+#define SHIFT_SECOND_CHAR 12
+#define SHIFT_THIRD_CHAR 6
+#define PEM_LINE_CHARS 64
+#define PEM_LINE_BYTES 48
+#define BASE64_LOWER_FIRST 26
+#define BASE64_DIGIT_FIRST 52
+#define BASE64_PLUS_VALUE 62
+#define BASE64_SLASH_VALUE 63
+
+/*
+ * characters decoded per step of the vector path. A step is a whole number of quantums, so the scalar path
+ * resumes on a quantum boundary when a step meets a line break or padding. The encoder vectorises whole lines.
+ */
+#if defined(__AVX2__)
+#define BASE64_SIMD_CHARS 32
+#elif defined(__SSE2__)
+#define BASE64_SIMD_CHARS 16
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BASE64_SIMD_CHARS 64
+#endif
+
+/* value of each base64 character, whitespace and '=' are marked, everything else is invalid */
+static const uint8_t g_base64Table[] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x40, 0x80, 0x80, 0x40, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x40, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3E, 0x80, 0x80, 0x80, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x80, 0x80, 0x80, 0x41, 0x80, 0x80,
+    0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static const char g_base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+typedef struct {
+    uint32_t bits; /* pending characters of the current quantum */
+    uint32_t count; /* count of characters in the current quantum, padding included */
+    uint32_t padding;
+    uint32_t written;
+} Base64State;
+
+static bool HasPrefix(const uint8_t *data, uint32_t len, const char *prefix, uint32_t prefixLen)
+{
+    return (len >= prefixLen) && (memcmp(data, prefix, prefixLen) == 0);
+}
+
+static uint32_t NextLine(const uint8_t *data, uint32_t len, uint32_t pos)
+{
+    const uint8_t *eol = memchr(data + pos, '\n', len - pos);
+    return (eol == NULL) ? len : (uint32_t)(eol - data) + 1;
+}
+
+/* returns the offset of the first line that starts with prefix, or len if there is none */
+static uint32_t FindLine(const uint8_t *data, uint32_t len, uint32_t pos, const char *prefix, uint32_t prefixLen)
+{
+    while (pos < len) {
+        if (HasPrefix(data + pos, len - pos, prefix, prefixLen)) {
+            return pos;
+        }
+        pos = NextLine(data, len, pos);
+    }
+    return len;
+}
+
+/* checks "<label>-----" and the end of line that follows it, returns the offset of the next line */
+static bool CheckLabel(const uint8_t *data, uint32_t len, uint32_t pos, const char *label, uint32_t *next)
+{
+    uint32_t labelLen = (uint32_t)strlen(label);
+    if (!HasPrefix(data + pos, len - pos, label, labelLen) ||
+        !HasPrefix(data + pos + labelLen, len - pos - labelLen, PEM_DASHES, PEM_DASHES_LEN)) {
+        return false;
+    }
+    pos += labelLen + PEM_DASHES_LEN;
+    if ((pos < len) && (data[pos] == '\r')) {
+        pos++;
+    }
+    if ((pos < len) && (data[pos] != '\n') && (data[pos] != '\0')) {
+        return false;
+    }
+    *next = (pos < len) ? pos + 1 : len;
+    return true;
+}
+
+static void FlushQuantum(Base64State *state, uint8_t *out)
+{
+    uint32_t bytes = BASE64_QUANTUM_BYTES - state->padding;
+    out[state->written++] = (uint8_t)(state->bits >> SHIFT_FIRST_BYTE);
+    if (bytes > 1) {
+        out[state->written++] = (uint8_t)((state->bits >> SHIFT_SECOND_BYTE) & BYTE_MASK);
+    }
+    if (bytes > 2) { /* 2: the third byte is absent with one padding character */
+        out[state->written++] = (uint8_t)(state->bits & BYTE_MASK);
+    }
+    state->bits = 0;
+    state->count = 0;
+}
+
+/* one character out of the fast path: whitespace, padding, or a quantum split across lines */
+static bool DecodeChar(Base64State *state, uint8_t value, uint8_t *out)
+{
+    if (value == BASE64_WHITESPACE) {
+        return true;
+    }
+    if (value == BASE64_PADDING) {
+        if ((state->count < BASE64_QUANTUM_CHARS - BASE64_MAX_PADDING) || (state->padding == BASE64_MAX_PADDING)) {
+            return false;
+        }
+        state->padding++;
+        value = 0;
+    } else if ((value > BASE64_VALUE_MAX) || (state->padding != 0)) {
+        return false; /* invalid character, or data after the padding */
+    }
+    state->bits = (state->bits << BASE64_BITS_PER_CHAR) | value;
+    if (++state->count == BASE64_QUANTUM_CHARS) {
+        FlushQuantum(state, out);
+    }
+    return true;
+}
+
+#ifdef BASE64_SIMD_CHARS
+/*
+ * A value is its character plus an offset that depends on the range of the alphabet it falls in: the offset is
+ * -'A' from value 0, and changes by the step at the first value of each following range.
+ */
+static const int8_t g_base64RangeFirst[] = { BASE64_LOWER_FIRST, BASE64_DIGIT_FIRST, BASE64_PLUS_VALUE,
+    BASE64_SLASH_VALUE };
+static const int8_t g_base64RangeStep[] = { 'a' - BASE64_LOWER_FIRST - 'A',
+    ('0' - BASE64_DIGIT_FIRST) - ('a' - BASE64_LOWER_FIRST), ('+' - BASE64_PLUS_VALUE) - ('0' - BASE64_DIGIT_FIRST),
+    ('/' - BASE64_SLASH_VALUE) - ('+' - BASE64_PLUS_VALUE) };
+#define BASE64_RANGE_COUNT (sizeof(g_base64RangeFirst) / sizeof(g_base64RangeFirst[0]))
+#endif
+
+#if defined(__AVX2__)
+static __m256i InRange256(__m256i c, char lo, char hi)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(lo - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), c));
+}
+
+/* decodes 32 data characters to 24 bytes, false if any of them is not a data character */
+static bool DecodeBlockSimd(const uint8_t *in, uint8_t *out)
+{
+    __m256i c = _mm256_loadu_si256((const __m256i *)in);
+    __m256i upper = InRange256(c, 'A', 'Z');
+    __m256i lower = InRange256(c, 'a', 'z');
+    __m256i digit = InRange256(c, '0', '9');
+    __m256i plus = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+'));
+    __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+    __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+        _mm256_or_si256(_mm256_or_si256(digit, plus), slash));
+    if ((uint32_t)_mm256_movemask_epi8(valid) != UINT32_MAX) {
+        return false;
+    }
+    __m256i offset = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+        _mm256_and_si256(lower, _mm256_set1_epi8(BASE64_LOWER_FIRST - 'a')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(BASE64_DIGIT_FIRST - '0')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(plus, _mm256_set1_epi8(BASE64_PLUS_VALUE - '+')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(slash, _mm256_set1_epi8(BASE64_SLASH_VALUE - '/')));
+    __m256i values = _mm256_add_epi8(c, offset);
+
+    /* 0x01400140: each pair of values to 12 bits, 0x00011000: each pair of those to the 24 bits of a quantum */
+    __m256i words = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+        _mm256_set1_epi32(0x00011000));
+    const __m256i order = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    uint8_t bytes[sizeof(__m256i)];
+    _mm256_storeu_si256((__m256i *)bytes, _mm256_shuffle_epi8(words, order));
+    uint32_t half = BASE64_SIMD_CHARS / 2 / BASE64_QUANTUM_CHARS * BASE64_QUANTUM_BYTES; /* bytes of each lane */
+    for (uint32_t i = 0; i < half; ++i) {
+        out[i] = bytes[i];
+        out[half + i] = bytes[sizeof(__m128i) + i];
+    }
+    return true;
+}
+#elif defined(__SSE2__)
+static __m128i InRange128(__m128i c, char lo, char hi)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)), _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), c));
+}
+
+/* decodes 16 data characters to 12 bytes, false if any of them is not a data character */
+static bool DecodeBlockSimd(const uint8_t *in, uint8_t *out)
+{
+    __m128i c = _mm_loadu_si128((const __m128i *)in);
+    __m128i upper = InRange128(c, 'A', 'Z');
+    __m128i lower = InRange128(c, 'a', 'z');
+    __m128i digit = InRange128(c, '0', '9');
+    __m128i plus = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+    __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+    __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash));
+    if (_mm_movemask_epi8(valid) != 0xFFFF) { /* 0xFFFF: one bit per character */
+        return false;
+    }
+    __m128i offset = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+        _mm_and_si128(lower, _mm_set1_epi8(BASE64_LOWER_FIRST - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(BASE64_DIGIT_FIRST - '0')));
+    offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(BASE64_PLUS_VALUE - '+')));
+    offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(BASE64_SLASH_VALUE - '/')));
+    __m128i values = _mm_add_epi8(c, offset);
+
+    /* each pair of values to 12 bits, then 0x00011000 joins each pair of those to the 24 bits of a quantum */
+    __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(BYTE_MASK)),
+        BASE64_BITS_PER_CHAR), _mm_srli_epi16(values, SHIFT_SECOND_BYTE));
+    uint32_t words[BASE64_SIMD_CHARS / BASE64_QUANTUM_CHARS];
+    _mm_storeu_si128((__m128i *)words, _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000)));
+    for (uint32_t i = 0; i < BASE64_SIMD_CHARS / BASE64_QUANTUM_CHARS; ++i) {
+        out[i * BASE64_QUANTUM_BYTES] = (uint8_t)(words[i] >> SHIFT_FIRST_BYTE);
+        out[i * BASE64_QUANTUM_BYTES + 1] = (uint8_t)(words[i] >> SHIFT_SECOND_BYTE);
+        out[i * BASE64_QUANTUM_BYTES + 2] = (uint8_t)words[i]; /* 2: third byte */
+    }
+    return true;
+}
+#elif defined(BASE64_SIMD_CHARS)
+static uint8x16_t InRangeNeon(uint8x16_t c, uint8_t lo, uint8_t hi)
+{
+    return vandq_u8(vcgeq_u8(c, vdupq_n_u8(lo)), vcleq_u8(c, vdupq_n_u8(hi)));
+}
+
+static bool DecodeCharsNeon(uint8x16_t c, uint8x16_t *values)
+{
+    uint8x16_t upper = InRangeNeon(c, 'A', 'Z');
+    uint8x16_t lower = InRangeNeon(c, 'a', 'z');
+    uint8x16_t digit = InRangeNeon(c, '0', '9');
+    uint8x16_t plus = vceqq_u8(c, vdupq_n_u8('+'));
+    uint8x16_t slash = vceqq_u8(c, vdupq_n_u8('/'));
+    uint8x16_t valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(vorrq_u8(digit, plus), slash));
+    if (vminvq_u8(valid) != BYTE_MASK) {
+        return false;
+    }
+    uint8x16_t offset = vorrq_u8(vandq_u8(upper, vdupq_n_u8((uint8_t)-'A')),
+        vandq_u8(lower, vdupq_n_u8((uint8_t)(BASE64_LOWER_FIRST - 'a'))));
+    offset = vorrq_u8(offset, vandq_u8(digit, vdupq_n_u8((uint8_t)(BASE64_DIGIT_FIRST - '0'))));
+    offset = vorrq_u8(offset, vandq_u8(plus, vdupq_n_u8((uint8_t)(BASE64_PLUS_VALUE - '+'))));
+    offset = vorrq_u8(offset, vandq_u8(slash, vdupq_n_u8((uint8_t)(BASE64_SLASH_VALUE - '/'))));
+    *values = vaddq_u8(c, offset);
+    return true;
+}
+
+/* decodes 64 data characters to 48 bytes, false if any of them is not a data character */
+static bool DecodeBlockSimd(const uint8_t *in, uint8_t *out)
+{
+    uint8x16x4_t chars = vld4q_u8(in); /* lane k of val[j] is character j of quantum k */
+    uint8x16x4_t values;
+    for (uint32_t i = 0; i < BASE64_QUANTUM_CHARS; ++i) {
+        if (!DecodeCharsNeon(chars.val[i], &values.val[i])) {
+            return false;
+        }
+    }
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4)); /* 2, 4: bit split */
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2)); /* 4, 2: bit split */
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]); /* 6: bit split */
+    vst3q_u8(out, bytes);
+    return true;
+}
+#endif
+
+static bool DecodeBase64(const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t *outLen)
+{
+    Base64State state = { 0, 0, 0, 0 };
+    uint32_t i = 0;
+    while (i < inLen) {
+#ifdef BASE64_SIMD_CHARS
+        if ((state.count == 0) && (state.padding == 0) && (inLen - i >= BASE64_SIMD_CHARS) &&
+            DecodeBlockSimd(in + i, out + state.written)) {
+            state.written += BASE64_SIMD_CHARS / BASE64_QUANTUM_CHARS * BASE64_QUANTUM_BYTES;
+            i += BASE64_SIMD_CHARS;
+            continue;
+        }
+#endif
+        /* fast path: a whole quantum of data characters, which is every quantum of a well formed line */
+        if ((state.count == 0) && (state.padding == 0) && (inLen - i >= BASE64_QUANTUM_CHARS)) {
+            uint32_t a = g_base64Table[in[i]];
+            uint32_t b = g_base64Table[in[i + 1]];
+            uint32_t c = g_base64Table[in[i + 2]]; /* 2: third character */
+            uint32_t d = g_base64Table[in[i + 3]]; /* 3: fourth character */
+            if ((a | b | c | d) <= BASE64_VALUE_MAX) {
+                state.bits = (a << (BASE64_BITS_PER_CHAR * 3)) | (b << (BASE64_BITS_PER_CHAR * 2)) | /* 3, 2: shift */
+                    (c << BASE64_BITS_PER_CHAR) | d;
+                FlushQuantum(&state, out);
+                i += BASE64_QUANTUM_CHARS;
+                continue;
+            }
+        }
+        if (!DecodeChar(&state, g_base64Table[in[i]], out)) {
+            return false;
+        }
+        i++;
+    }
+    if ((state.count != 0) || (state.written == 0)) {
+        return false;
+    }
+    *outLen = state.written;
+    return true;
+}
+
+static int32_t DecodeBody(const uint8_t *body, uint32_t bodyLen, CfBlob *der)
+{
+    uint32_t maxLen = (bodyLen / BASE64_QUANTUM_CHARS + 1) * BASE64_QUANTUM_BYTES;
+    uint8_t *out = (uint8_t *)CfMalloc(maxLen);
+    if (out == NULL) {
+        CF_LOG_E("malloc pem der failed");
+        return CF_ERR_MALLOC;
+    }
+    uint32_t outLen = 0;
+    if (!DecodeBase64(body, bodyLen, out, &outLen)) {
+        CF_LOG_D("invalid pem body");
+        CfFree(out);
+        return CF_INVALID_PARAMS;
+    }
+    der->data = out;
+    der->size = outLen;
+    return CF_SUCCESS;
+}
+
+int32_t CfPemDecode(const uint8_t *data, uint32_t len, const char *label, CfBlob *der, uint32_t *endOffset)
+{
+    if ((data == NULL) || (label == NULL) || (der == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    uint32_t begin = FindLine(data, len, 0, PEM_BEGIN_LINE, PEM_BEGIN_LINE_LEN);
+    if (begin == len) {
+        return CF_NOT_EXIST;
+    }
+    uint32_t bodyStart = 0;
+    if (!CheckLabel(data, len, begin + PEM_BEGIN_LINE_LEN, label, &bodyStart)) {
+        CF_LOG_D("unexpected pem label");
+        return CF_INVALID_PARAMS;
+    }
+    uint32_t end = FindLine(data, len, bodyStart, PEM_END_LINE, PEM_END_LINE_LEN);
+    uint32_t next = 0;
+    if ((end == len) || !CheckLabel(data, len, end + PEM_END_LINE_LEN, label, &next)) {
+        CF_LOG_D("invalid pem end line");
+        return CF_INVALID_PARAMS;
+    }
+
+    int32_t ret = DecodeBody(data + bodyStart, end - bodyStart, der);
+    if ((ret == CF_SUCCESS) && (endOffset != NULL)) {
+        *endOffset = next;
+    }
+    return ret;
+}
+
+static uint32_t WriteArmorLine(uint8_t *out, const char *prefix, uint32_t prefixLen, const char *label,
+    uint32_t labelLen)
+{
+    uint32_t pos = 0;
+    (void)memcpy_s(out + pos, prefixLen, prefix, prefixLen);
+    pos += prefixLen;
+    (void)memcpy_s(out + pos, labelLen, label, labelLen);
+    pos += labelLen;
+    (void)memcpy_s(out + pos, PEM_DASHES_LEN, PEM_DASHES, PEM_DASHES_LEN);
+    pos += PEM_DASHES_LEN;
+    out[pos++] = '\n';
+    return pos;
+}
+
+static void WriteQuantum(uint32_t bits, uint8_t *out)
+{
+    out[0] = (uint8_t)g_base64Alphabet[(bits >> SHIFT_FIRST_CHAR) & BASE64_VALUE_MAX];
+    out[1] = (uint8_t)g_base64Alphabet[(bits >> SHIFT_SECOND_CHAR) & BASE64_VALUE_MAX];
+    out[2] = (uint8_t)g_base64Alphabet[(bits >> SHIFT_THIRD_CHAR) & BASE64_VALUE_MAX]; /* 2: third character */
+    out[3] = (uint8_t)g_base64Alphabet[bits & BASE64_VALUE_MAX]; /* 3: fourth character */
+}
+
+#if defined(__AVX2__)
+/* characters of the 6 bit values, the values are in the low bits of each byte */
+static __m256i EncodeChars256(__m256i values)
+{
+    __m256i offset = _mm256_set1_epi8('A');
+    for (uint32_t i = 0; i < BASE64_RANGE_COUNT; ++i) {
+        __m256i inRange = _mm256_cmpgt_epi8(values, _mm256_set1_epi8(g_base64RangeFirst[i] - 1));
+        offset = _mm256_add_epi8(offset, _mm256_and_si256(inRange, _mm256_set1_epi8(g_base64RangeStep[i])));
+    }
+    return _mm256_add_epi8(values, offset);
+}
+
+/* splits the 24 bits of each 32 bits lane to the four values of the quantum, first value in the lowest byte */
+static __m256i SplitQuantums256(__m256i bits)
+{
+    __m256i values = _mm256_and_si256(_mm256_srli_epi32(bits, SHIFT_FIRST_CHAR), _mm256_set1_epi32(0x3F));
+    values = _mm256_or_si256(values, _mm256_and_si256(_mm256_srli_epi32(bits, 4), _mm256_set1_epi32(0x3F00)));
+    values = _mm256_or_si256(values, _mm256_and_si256(_mm256_slli_epi32(bits, 10), _mm256_set1_epi32(0x3F0000)));
+    return _mm256_or_si256(values, _mm256_and_si256(_mm256_slli_epi32(bits, 24), _mm256_set1_epi32(0x3F000000)));
+}
+
+static __m256i LoadQuantums256(const uint8_t *lo, const uint8_t *hi, __m256i order)
+{
+    __m256i bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)lo)),
+        _mm_loadu_si128((const __m128i *)hi), 1);
+    return _mm256_shuffle_epi8(bytes, order);
+}
+
+/* encodes the 48 bytes of a full line to 64 characters */
+static void EncodeLineSimd(const uint8_t *in, uint8_t *out)
+{
+    const __m256i order = _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+        2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    /* the second half is loaded 4 bytes early, so that no load reads past the end of the line */
+    const __m256i lateOrder = _mm256_add_epi8(order, _mm256_set1_epi8(4));
+    __m256i first = LoadQuantums256(in, in + 12, order); /* 12: bytes of each 128 bits lane */
+    __m256i second = LoadQuantums256(in + 20, in + 32, lateOrder); /* 20, 32: bytes 24 and 36, 4 bytes early */
+    _mm256_storeu_si256((__m256i *)out, EncodeChars256(SplitQuantums256(first)));
+    _mm256_storeu_si256((__m256i *)(out + sizeof(__m256i)), EncodeChars256(SplitQuantums256(second)));
+}
+#elif defined(__SSE2__)
+/* characters of the 6 bit values, the values are in the low bits of each byte */
+static __m128i EncodeChars128(__m128i values)
+{
+    __m128i offset = _mm_set1_epi8('A');
+    for (uint32_t i = 0; i < BASE64_RANGE_COUNT; ++i) {
+        __m128i inRange = _mm_cmpgt_epi8(values, _mm_set1_epi8(g_base64RangeFirst[i] - 1));
+        offset = _mm_add_epi8(offset, _mm_and_si128(inRange, _mm_set1_epi8(g_base64RangeStep[i])));
+    }
+    return _mm_add_epi8(values, offset);
+}
+
+/* splits the 24 bits of each 32 bits lane to the four values of the quantum, first value in the lowest byte */
+static __m128i SplitQuantums128(__m128i bits)
+{
+    __m128i values = _mm_and_si128(_mm_srli_epi32(bits, SHIFT_FIRST_CHAR), _mm_set1_epi32(0x3F));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_srli_epi32(bits, 4), _mm_set1_epi32(0x3F00)));
+    values = _mm_or_si128(values, _mm_and_si128(_mm_slli_epi32(bits, 10), _mm_set1_epi32(0x3F0000)));
+    return _mm_or_si128(values, _mm_and_si128(_mm_slli_epi32(bits, 24), _mm_set1_epi32(0x3F000000)));
+}
+
+static int32_t LoadQuantum(const uint8_t *in)
+{
+    return (int32_t)(((uint32_t)in[0] << SHIFT_FIRST_BYTE) | ((uint32_t)in[1] << SHIFT_SECOND_BYTE) | in[2]);
+}
+
+/* encodes the 48 bytes of a full line to 64 characters, 12 bytes per step */
+static void EncodeLineSimd(const uint8_t *in, uint8_t *out)
+{
+    for (uint32_t i = 0; i < PEM_LINE_BYTES / 12; ++i) { /* 12: bytes of 4 quantums */
+        const uint8_t *bytes = in + i * 12; /* 12: bytes of 4 quantums */
+        __m128i bits = _mm_setr_epi32(LoadQuantum(bytes), LoadQuantum(bytes + 3), LoadQuantum(bytes + 6),
+            LoadQuantum(bytes + 9)); /* 3, 6, 9: offsets of the quantums */
+        _mm_storeu_si128((__m128i *)(out + i * sizeof(__m128i)), EncodeChars128(SplitQuantums128(bits)));
+    }
+}
+#elif defined(BASE64_SIMD_CHARS)
+/* characters of the 6 bit values */
+static uint8x16_t EncodeCharsNeon(uint8x16_t values)
+{
+    uint8x16_t offset = vdupq_n_u8('A');
+    for (uint32_t i = 0; i < BASE64_RANGE_COUNT; ++i) {
+        uint8x16_t inRange = vcgeq_u8(values, vdupq_n_u8((uint8_t)g_base64RangeFirst[i]));
+        offset = vaddq_u8(offset, vandq_u8(inRange, vdupq_n_u8((uint8_t)g_base64RangeStep[i])));
+    }
+    return vaddq_u8(values, offset);
+}
+
+/* encodes the 48 bytes of a full line to 64 characters */
+static void EncodeLineSimd(const uint8_t *in, uint8_t *out)
+{
+    uint8x16x3_t bytes = vld3q_u8(in); /* lane k of val[j] is byte j of quantum k */
+    uint8x16_t mask = vdupq_n_u8(BASE64_VALUE_MAX);
+    uint8x16x4_t chars;
+    chars.val[0] = vshrq_n_u8(bytes.val[0], 2); /* 2: bit split */
+    chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask); /* 4 */
+    chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask); /* 2, 6 */
+    chars.val[3] = vandq_u8(bytes.val[2], mask);
+    for (uint32_t i = 0; i < BASE64_QUANTUM_CHARS; ++i) {
+        chars.val[i] = EncodeCharsNeon(chars.val[i]);
+    }
+    vst4q_u8(out, chars);
+}
+#endif
+
+/* the body is wrapped while it is written, returns the count of characters written */
+static uint32_t EncodeBody(const uint8_t *in, uint32_t inLen, uint8_t *out)
+{
+    uint32_t pos = 0;
+    uint32_t lineChars = 0;
+    uint32_t i = 0;
+#ifdef BASE64_SIMD_CHARS
+    for (; inLen - i >= PEM_LINE_BYTES; i += PEM_LINE_BYTES) {
+        EncodeLineSimd(in + i, out + pos);
+        pos += PEM_LINE_CHARS;
+        out[pos++] = '\n';
+    }
+#endif
+    for (; inLen - i >= BASE64_QUANTUM_BYTES; i += BASE64_QUANTUM_BYTES) {
+        uint32_t bits = ((uint32_t)in[i] << SHIFT_FIRST_BYTE) | ((uint32_t)in[i + 1] << SHIFT_SECOND_BYTE) |
+            in[i + 2]; /* 2: third byte */
+        WriteQuantum(bits, out + pos);
+        pos += BASE64_QUANTUM_CHARS;
+        lineChars += BASE64_QUANTUM_CHARS;
+        if (lineChars == PEM_LINE_CHARS) {
+            out[pos++] = '\n';
+            lineChars = 0;
+        }
+    }
+
+    uint32_t remain = inLen - i;
+    if (remain != 0) {
+        uint32_t bits = (uint32_t)in[i] << SHIFT_FIRST_BYTE;
+        if (remain > 1) {
+            bits |= (uint32_t)in[i + 1] << SHIFT_SECOND_BYTE;
+        }
+        WriteQuantum(bits, out + pos);
+        out[pos + BASE64_QUANTUM_CHARS - 1] = '=';
+        if (remain == 1) {
+            out[pos + BASE64_QUANTUM_CHARS - BASE64_MAX_PADDING] = '=';
+        }
+        pos += BASE64_QUANTUM_CHARS;
+        lineChars += BASE64_QUANTUM_CHARS;
+    }
+    if (lineChars != 0) {
+        out[pos++] = '\n';
+    }
+    return pos;
+}
+
+int32_t CfPemEncode(const uint8_t *der, uint32_t derLen, const char *label, CfBlob *pem)
+{
+    if ((der == NULL) || (derLen == 0) || (label == NULL) || (pem == NULL)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    uint32_t labelLen = (uint32_t)strlen(label);
+    uint64_t bodyChars = ((uint64_t)derLen + BASE64_QUANTUM_BYTES - 1) / BASE64_QUANTUM_BYTES * BASE64_QUANTUM_CHARS;
+    uint64_t lineCount = (bodyChars + PEM_LINE_CHARS - 1) / PEM_LINE_CHARS;
+    uint64_t labelLineLen = (uint64_t)labelLen + PEM_DASHES_LEN + 1; /* 1: end of line */
+    uint64_t armorLen = PEM_BEGIN_LINE_LEN + labelLineLen + PEM_END_LINE_LEN + labelLineLen;
+    uint64_t totalLen = armorLen + bodyChars + lineCount;
+    if (totalLen > MAX_MEMORY_SIZE) {
+        CF_LOG_E("der is too long to encode, len = %u", derLen);
+        return CF_INVALID_PARAMS;
+    }
+
+    uint8_t *out = (uint8_t *)CfMalloc((uint32_t)totalLen);
+    if (out == NULL) {
+        CF_LOG_E("malloc pem failed");
+        return CF_ERR_MALLOC;
+    }
+    uint32_t pos = WriteArmorLine(out, PEM_BEGIN_LINE, PEM_BEGIN_LINE_LEN, label, labelLen);
+    pos += EncodeBody(der, derLen, out + pos);
+    pos += WriteArmorLine(out + pos, PEM_END_LINE, PEM_END_LINE_LEN, label, labelLen);
+
+    pem->data = out;
+    pem->size = pos;
+    return CF_SUCCESS;
+}
+
+int32_t CfEncodingBlobToPem(CfEncodingBlob *blob, const char *label)
+{
+    if ((blob == NULL) || (blob->encodingFormat != CF_FORMAT_DER) || (blob->len > UINT32_MAX)) {
+        CF_LOG_E("invalid input params");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfBlob pem = { 0, NULL };
+    int32_t ret = CfPemEncode(blob->data, (uint32_t)blob->len, label, &pem);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    CfFree(blob->data);
+    blob->data = pem.data;
+    blob->len = pem.size;
+    blob->encodingFormat = CF_FORMAT_PEM;
+    return CF_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_reject.h"
+
+#include <stdbool.h>
+#include <time.h>
+
+#include "cf_log.h"
+
+#define REJECT_LOG_INTERVAL 10 /* seconds */
+
+typedef struct {
+    const char *name;
+    uint64_t total; /* the fields below are only accessed with the __atomic builtins */
+    uint64_t sinceLog;
+    int64_t nextLogTime;
+} CfRejectCounter;
+
+static CfRejectCounter g_rejectCounters[CF_REJECT_TYPE_MAX] = {
+    [CF_REJECT_TYPE_CERT] = { "cert", 0, 0, 0 },
+    [CF_REJECT_TYPE_CRL] = { "crl", 0, 0, 0 },
+};
+
+void CfCountRejectedInput(CfRejectType type)
+{
+    if ((uint32_t)type >= CF_REJECT_TYPE_MAX) {
+        return;
+    }
+    CfRejectCounter *counter = &g_rejectCounters[type];
+    uint64_t total = __atomic_add_fetch(&counter->total, 1, __ATOMIC_RELAXED);
+    (void)__atomic_add_fetch(&counter->sinceLog, 1, __ATOMIC_RELAXED);
+
+    struct timespec now = { 0 };
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return;
+    }
+    int64_t nextLogTime = __atomic_load_n(&counter->nextLogTime, __ATOMIC_RELAXED);
+    if ((int64_t)now.tv_sec < nextLogTime) {
+        return;
+    }
+    /* one of the racing callers wins the interval and logs for all of them */
+    if (!__atomic_compare_exchange_n(&counter->nextLogTime, &nextLogTime, (int64_t)now.tv_sec + REJECT_LOG_INTERVAL,
+        false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return;
+    }
+    uint64_t count = __atomic_exchange_n(&counter->sinceLog, 0, __ATOMIC_RELAXED);
+    CF_LOG_E("rejected %llu malformed %s inputs since the last report, %llu in total", (unsigned long long)count,
+        counter->name, (unsigned long long)total);
+}
+
+uint64_t CfGetRejectedInputCount(CfRejectType type)
+{
+    if ((uint32_t)type >= CF_REJECT_TYPE_MAX) {
+        return 0;
+    }
+    return __atomic_load_n(&g_rejectCounters[type].total, __ATOMIC_RELAXED);
+}
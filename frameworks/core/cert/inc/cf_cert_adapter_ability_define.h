@@ -24,6 +24,7 @@ typedef struct {
     void (*adapterDestory)(CfBase **object);
     int32_t (*adapterVerify)(const CfBase *certObj, const CfBlob *pubKey);
     int32_t (*adapterGetItem)(const CfBase *object, CfItemId id, CfBlob *outBlob);
+    int32_t (*adapterDup)(const CfBase *object, CfBase **dupObject);
 } CfCertAdapterAbilityFunc;
 
 #endif /* CF_CERT_ADAPTER_ABILITY_DEFINE_H */
\ No newline at end of file
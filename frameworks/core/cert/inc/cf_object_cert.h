@@ -30,6 +30,8 @@ int32_t CfCertCheck(const CfBase *obj, const CfParamSet *in, CfParamSet **out);
 
 void CfCertDestroy(CfBase **obj);
 
+int32_t CfCertDup(const CfBase *obj, CfBase **out);
+
 #ifdef __cplusplus
 }
 #endif
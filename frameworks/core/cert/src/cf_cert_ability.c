@@ -26,6 +26,7 @@ static CfObjectAbilityFunc g_certObjectFunc = {
     .destroy = CfCertDestroy,
     .check = CfCertCheck,
     .get = CfCertGet,
+    .dup = CfCertDup,
 };
 
 __attribute__((constructor)) static void LoadCertOjbectAbility(void)
@@ -23,6 +23,7 @@
 #include "cf_memory.h"
 #include "cf_param.h"
 #include "cf_param_parse.h"
+#include "cf_pem.h"
 #include "cf_result.h"
 
 #include "cf_cert_adapter_ability_define.h"
@@ -66,6 +67,31 @@ int32_t CfCertCreate(const CfEncodingBlob *in, CfBase **obj)
     return CF_SUCCESS;
 }
 
+/* the optional encoding format applies to CF_ITEM_ENCODED only, the adapter always gives DER */
+static int32_t GetItemFormat(const CfParamSet *in, CfItemId id, int32_t *format)
+{
+    CfParam *formatParam = NULL;
+    if (CfGetParam(in, CF_TAG_PARAM1_INT32, &formatParam) != CF_SUCCESS) {
+        *format = CF_FORMAT_DER;
+        return CF_SUCCESS;
+    }
+    *format = formatParam->int32Param;
+    if ((*format != CF_FORMAT_DER) && ((*format != CF_FORMAT_PEM) || (id != CF_ITEM_ENCODED))) {
+        CF_LOG_E("invalid encoding format of item, format = %d", *format);
+        return CF_INVALID_PARAMS;
+    }
+    return CF_SUCCESS;
+}
+
+static int32_t ConvertItemToPem(CfBlob *itemValue)
+{
+    CfBlob pem = { 0, NULL };
+    int32_t ret = CfPemEncode(itemValue->data, itemValue->size, CF_PEM_LABEL_CERT, &pem);
+    CfFree(itemValue->data);
+    *itemValue = pem;
+    return ret;
+}
+
 static int32_t CfCertGetItem(const CfCertObjStruct *obj, const CfParamSet *in, CfParamSet **out)
 {
     CfParam *tmpParam = NULL;
@@ -76,12 +102,25 @@ static int32_t CfCertGetItem(const CfCertObjStruct *obj, const CfParamSet *in, C
     }
 
     CF_LOG_I("cert get type = 0x%x", tmpParam->int32Param);
+    int32_t format = CF_FORMAT_DER;
+    ret = GetItemFormat(in, (CfItemId)tmpParam->int32Param, &format);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
     CfBlob itemValue = { 0, NULL };
     ret = obj->func.adapterGetItem(obj->adapterRes, (CfItemId)tmpParam->int32Param, &itemValue);
     if (ret != CF_SUCCESS) {
         CF_LOG_E("adapter get item failed, ret = %d", ret);
         return ret;
     }
+    if (format == CF_FORMAT_PEM) {
+        ret = ConvertItemToPem(&itemValue);
+        if (ret != CF_SUCCESS) {
+            CF_LOG_E("convert item to pem failed, ret = %d", ret);
+            return ret;
+        }
+    }
 
     CfParam params[] = {
         { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_BYTES },
@@ -156,3 +195,38 @@ void CfCertDestroy(CfBase **obj)
     return;
 }
 
+int32_t CfCertDup(const CfBase *obj, CfBase **out)
+{
+    if ((obj == NULL) || (out == NULL)) {
+        CF_LOG_E("cfcertdup params is null");
+        return CF_NULL_POINTER;
+    }
+
+    const CfCertObjStruct *src = (const CfCertObjStruct *)obj;
+    if (src->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CERT)) {
+        CF_LOG_E("invalid resource type");
+        return CF_INVALID_PARAMS;
+    }
+    if (src->func.adapterDup == NULL) {
+        CF_LOG_E("cert adapter dup not support");
+        return CF_NOT_SUPPORT;
+    }
+
+    CfCertObjStruct *tmp = CfMalloc(sizeof(CfCertObjStruct));
+    if (tmp == NULL) {
+        CF_LOG_E("malloc cert obj failed");
+        return CF_ERR_MALLOC;
+    }
+    tmp->base.type = CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CERT);
+
+    int32_t ret = src->func.adapterDup(src->adapterRes, &tmp->adapterRes);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("cert adapter dup failed");
+        CfFree(tmp);
+        return ret;
+    }
+    (void)memcpy_s(&tmp->func, sizeof(CfCertAdapterAbilityFunc), &src->func, sizeof(CfCertAdapterAbilityFunc));
+
+    *out = &(tmp->base);
+    return CF_SUCCESS;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_CSR_ADAPTER_ABILITY_DEFINE_H
+#define CF_CSR_ADAPTER_ABILITY_DEFINE_H
+
+#include <stdbool.h>
+
+#include "cf_type.h"
+
+typedef struct {
+    CfBase base;
+    int32_t (*adapterCreate)(const CfEncodingBlob *in, CfBase **object);
+    void (*adapterDestory)(CfBase **object);
+    int32_t (*adapterGetCount)(const CfBase *object, uint32_t *count);
+    int32_t (*adapterGetItem)(const CfBase *object, uint32_t index, CfItemId id, CfBlob *out);
+    int32_t (*adapterVerify)(const CfBase *object, uint32_t index, bool *valid);
+    int32_t (*adapterVerifyAll)(const CfBase *object, CfBlob *out);
+} CfCsrAdapterAbilityFunc;
+
+#endif /* CF_CSR_ADAPTER_ABILITY_DEFINE_H */
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_object_csr.h"
+
+#include "securec.h"
+
+#include "cf_ability.h"
+#include "cf_log.h"
+#include "cf_magic.h"
+#include "cf_memory.h"
+#include "cf_param.h"
+#include "cf_param_parse.h"
+#include "cf_result.h"
+
+#include "cf_csr_adapter_ability_define.h"
+
+typedef struct {
+    CfBase base;
+    CfCsrAdapterAbilityFunc func;
+    CfBase *adapterRes;
+} CfCsrObjStruct;
+
+int32_t CfCsrCreate(const CfEncodingBlob *in, CfBase **obj)
+{
+    if ((in == NULL) || (obj == NULL)) {
+        CF_LOG_E("param null");
+        return CF_NULL_POINTER;
+    }
+
+    CfCsrAdapterAbilityFunc *func = (CfCsrAdapterAbilityFunc *)GetAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER,
+        CF_OBJ_TYPE_CSR));
+    if ((func == NULL) || (func->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_FUNC, CF_OBJ_TYPE_CSR))) {
+        CF_LOG_E("invalid func type");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfCsrObjStruct *tmp = CfMalloc(sizeof(CfCsrObjStruct));
+    if (tmp == NULL) {
+        CF_LOG_E("malloc csr obj failed");
+        return CF_ERR_MALLOC;
+    }
+    tmp->base.type = CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CSR);
+
+    int32_t ret = func->adapterCreate(in, &tmp->adapterRes);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("csr adapter create failed");
+        CfFree(tmp);
+        return ret;
+    }
+    (void)memcpy_s(&tmp->func, sizeof(CfCsrAdapterAbilityFunc), func, sizeof(CfCsrAdapterAbilityFunc));
+
+    *obj = &(tmp->base);
+    return CF_SUCCESS;
+}
+
+/* the index of the request is optional, the first request is used if it is absent */
+static int32_t GetRequestIndex(const CfParamSet *in, uint32_t tag, uint32_t *index)
+{
+    CfParam *indexParam = NULL;
+    if (CfGetParam(in, tag, &indexParam) != CF_SUCCESS) {
+        *index = 0;
+        return CF_SUCCESS;
+    }
+    if (indexParam->int32Param < 0) {
+        CF_LOG_E("invalid request index, index = %d", indexParam->int32Param);
+        return CF_INVALID_PARAMS;
+    }
+    *index = (uint32_t)indexParam->int32Param;
+    return CF_SUCCESS;
+}
+
+static int32_t CfCsrGetItem(const CfCsrObjStruct *obj, const CfParamSet *in, CfParamSet **out)
+{
+    CfParam *idParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_PARAM0_INT32, &idParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get item id failed, ret = %d", ret);
+        return ret;
+    }
+
+    uint32_t index = 0;
+    ret = GetRequestIndex(in, CF_TAG_PARAM1_INT32, &index);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    CfBlob itemValue = { 0, NULL };
+    ret = obj->func.adapterGetItem(obj->adapterRes, index, (CfItemId)idParam->int32Param, &itemValue);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter get item failed, ret = %d", ret);
+        return ret;
+    }
+
+    CfParam params[] = {
+        { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_BYTES },
+        { .tag = CF_TAG_RESULT_BYTES, .blob = itemValue },
+    };
+    ret = CfConstructParamSetOut(params, sizeof(params) / sizeof(CfParam), out);
+    CfFree(itemValue.data);
+    return ret;
+}
+
+static int32_t CfCsrGetCount(const CfCsrObjStruct *obj, CfParamSet **out)
+{
+    uint32_t count = 0;
+    int32_t ret = obj->func.adapterGetCount(obj->adapterRes, &count);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter get count failed, ret = %d", ret);
+        return ret;
+    }
+
+    CfParam params[] = {
+        { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_INT },
+        { .tag = CF_TAG_RESULT_INT, .int32Param = (int32_t)count },
+    };
+    return CfConstructParamSetOut(params, sizeof(params) / sizeof(CfParam), out);
+}
+
+int32_t CfCsrGet(const CfBase *obj, const CfParamSet *in, CfParamSet **out)
+{
+    if ((obj == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("cfcsrget params is null");
+        return CF_NULL_POINTER;
+    }
+
+    CfCsrObjStruct *tmp = (CfCsrObjStruct *)obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CSR)) {
+        CF_LOG_E("invalid resource type");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfParam *tmpParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_GET_TYPE, &tmpParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get param item type failed, ret = %d", ret);
+        return ret;
+    }
+
+    switch (tmpParam->int32Param) {
+        case CF_GET_TYPE_CSR_ITEM:
+            return CfCsrGetItem(tmp, in, out);
+        case CF_GET_TYPE_CSR_COUNT:
+            return CfCsrGetCount(tmp, out);
+        default:
+            CF_LOG_E("csr get type invalid, type = %d", tmpParam->int32Param);
+            return CF_NOT_SUPPORT;
+    }
+}
+
+static int32_t CfCsrCheckSignature(const CfCsrObjStruct *obj, const CfParamSet *in, CfParamSet **out)
+{
+    uint32_t index = 0;
+    int32_t ret = GetRequestIndex(in, CF_TAG_PARAM0_INT32, &index);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    bool valid = false;
+    ret = obj->func.adapterVerify(obj->adapterRes, index, &valid);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter verify failed, ret = %d", ret);
+        return ret;
+    }
+
+    CfParam params[] = {
+        { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_BOOL },
+        { .tag = CF_TAG_RESULT_BOOL, .boolParam = valid },
+    };
+    return CfConstructParamSetOut(params, sizeof(params) / sizeof(CfParam), out);
+}
+
+static int32_t CfCsrCheckSignatures(const CfCsrObjStruct *obj, CfParamSet **out)
+{
+    CfBlob results = { 0, NULL };
+    int32_t ret = obj->func.adapterVerifyAll(obj->adapterRes, &results);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter verify all failed, ret = %d", ret);
+        return ret;
+    }
+
+    CfParam params[] = {
+        { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_BYTES },
+        { .tag = CF_TAG_RESULT_BYTES, .blob = results },
+    };
+    ret = CfConstructParamSetOut(params, sizeof(params) / sizeof(CfParam), out);
+    CfFree(results.data);
+    return ret;
+}
+
+int32_t CfCsrCheck(const CfBase *obj, const CfParamSet *in, CfParamSet **out)
+{
+    if ((obj == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("cfcsrcheck params is null");
+        return CF_NULL_POINTER;
+    }
+
+    CfCsrObjStruct *tmp = (CfCsrObjStruct *)obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CSR)) {
+        CF_LOG_E("invalid resource type");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfParam *tmpParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_CHECK_TYPE, &tmpParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get check type failed, ret = %d", ret);
+        return ret;
+    }
+
+    switch (tmpParam->int32Param) {
+        case CF_CHECK_TYPE_CSR_SIGNATURE:
+            return CfCsrCheckSignature(tmp, in, out);
+        case CF_CHECK_TYPE_CSR_SIGNATURES:
+            return CfCsrCheckSignatures(tmp, out);
+        default:
+            CF_LOG_E("csr check type invalid, type = %d", tmpParam->int32Param);
+            return CF_NOT_SUPPORT;
+    }
+}
+
+void CfCsrDestroy(CfBase **obj)
+{
+    if ((obj == NULL) || (*obj == NULL)) {
+        return;
+    }
+
+    CfCsrObjStruct *tmp = (CfCsrObjStruct *)*obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_CSR)) {
+        /* only csr objects can be destroyed */
+        CF_LOG_E("invalid resource type");
+        return;
+    }
+
+    tmp->func.adapterDestory(&tmp->adapterRes);
+    CfFree(tmp);
+    *obj = NULL;
+    return;
+}
@@ -59,6 +59,24 @@ static int32_t CfLifeCheck(const CfObject *object, const CfParamSet *in, CfParam
     return ret;
 }
 
+static int32_t CfLifeGetBytes(const CfObject *object, const CfParamSet *in, CfBlob *out)
+{
+    CF_LOG_I("enter get bytes");
+    if ((object == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("input params invalid");
+        return CF_NULL_POINTER;
+    }
+
+    CfLifeCtx *tmp = (CfLifeCtx *)object;
+    if (tmp->func.getBytes == NULL) {
+        CF_LOG_E("object type can not get bytes");
+        return CF_NOT_SUPPORT;
+    }
+    int32_t ret = tmp->func.getBytes(tmp->base, in, out);
+    CF_LOG_I("leave get bytes ret = %d", ret);
+    return ret;
+}
+
 static void CfLifeDestroy(CfObject **object)
 {
     CF_LOG_I("enter: destroy object");
@@ -74,6 +92,41 @@ static void CfLifeDestroy(CfObject **object)
     CF_LOG_I("leave: destroy object");
 }
 
+static int32_t CfLifeDup(const CfObject *object, CfObject **objectOut)
+{
+    CF_LOG_I("enter: dup object");
+    if ((object == NULL) || (objectOut == NULL)) {
+        CF_LOG_E("input params invalid");
+        return CF_NULL_POINTER;
+    }
+
+    const CfLifeCtx *src = (const CfLifeCtx *)object;
+    if (src->func.dup == NULL) {
+        CF_LOG_E("object type can not be duplicated");
+        return CF_NOT_SUPPORT;
+    }
+
+    CfLifeCtx *tmp = CfMalloc(sizeof(CfLifeCtx));
+    if (tmp == NULL) {
+        CF_LOG_E("malloc ctx failed");
+        return CF_ERR_MALLOC;
+    }
+
+    int32_t ret = src->func.dup(src->base, &tmp->base);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("dup object resource failed, ret = %d", ret);
+        CfFree(tmp);
+        return ret;
+    }
+    (void)memcpy_s(&tmp->func, sizeof(CfObjectAbilityFunc), &src->func, sizeof(CfObjectAbilityFunc));
+
+    tmp->object = src->object;
+    *objectOut = &tmp->object;
+
+    CF_LOG_I("leave: dup object success");
+    return CF_SUCCESS;
+}
+
 CF_API_EXPORT int32_t CfCreate(CfObjectType objType, const CfEncodingBlob *in, CfObject **object)
 {
     CF_LOG_I("enter: create object [%d]", objType);
@@ -105,6 +158,8 @@ CF_API_EXPORT int32_t CfCreate(CfObjectType objType, const CfEncodingBlob *in, C
     tmp->object.get = CfLifeGet;
     tmp->object.check = CfLifeCheck;
     tmp->object.destroy = CfLifeDestroy;
+    tmp->object.dup = CfLifeDup;
+    tmp->object.getBytes = CfLifeGetBytes;
     *object = &tmp->object;
 
     CF_LOG_I("leave: create object success");
@@ -24,6 +24,8 @@ typedef struct {
     int32_t (*get)(const CfBase *obj, const CfParamSet *in, CfParamSet **out);
     int32_t (*check)(const CfBase *obj, const CfParamSet *in, CfParamSet **out);
     void (*destroy)(CfBase **obj);
+    int32_t (*dup)(const CfBase *obj, CfBase **out); /* optional, NULL if the object type can not be duplicated */
+    int32_t (*getBytes)(const CfBase *obj, const CfParamSet *in, CfBlob *out); /* optional, NULL if not supported */
 } CfObjectAbilityFunc;
 
 #endif /* CF_OBJECT_ABILITY_DEFINE_H */
\ No newline at end of file
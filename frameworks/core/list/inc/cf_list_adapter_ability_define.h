@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_LIST_ADAPTER_ABILITY_DEFINE_H
+#define CF_LIST_ADAPTER_ABILITY_DEFINE_H
+
+#include "cf_type.h"
+
+/* every member is optional, a NULL member matches all certificates */
+typedef struct {
+    const CfBlob *issuer; /* DER encoded issuer name */
+    const CfBlob *extKeyUsage; /* extended key usage oid string, such as "1.3.6.1.5.5.7.3.1" */
+    const CfBlob *date; /* time string accepted by ASN1_TIME_set_string, such as "20230101000000Z" */
+} CfListSelector;
+
+typedef struct {
+    CfBase base;
+    int32_t (*adapterCreate)(const CfEncodingBlob *in, CfBase **object);
+    void (*adapterDestory)(CfBase **object);
+    int32_t (*adapterFind)(const CfBase *object, CfListIndexType type, const CfBlob *key, CfBlob *out);
+    int32_t (*adapterSelect)(const CfBase *object, const CfListSelector *selector, CfBlob *out);
+    int32_t (*adapterGetColumn)(const CfBase *object, CfItemId id, CfBlob *out);
+} CfListAdapterAbilityFunc;
+
+#endif /* CF_LIST_ADAPTER_ABILITY_DEFINE_H */
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_object_list.h"
+
+#include "securec.h"
+
+#include "cf_ability.h"
+#include "cf_log.h"
+#include "cf_magic.h"
+#include "cf_memory.h"
+#include "cf_param.h"
+#include "cf_param_parse.h"
+#include "cf_result.h"
+
+#include "cf_list_adapter_ability_define.h"
+
+typedef struct {
+    CfBase base;
+    CfListAdapterAbilityFunc func;
+    CfBase *adapterRes;
+} CfListObjStruct;
+
+int32_t CfListCreate(const CfEncodingBlob *in, CfBase **obj)
+{
+    if ((in == NULL) || (obj == NULL)) {
+        CF_LOG_E("param null");
+        return CF_NULL_POINTER;
+    }
+
+    CfListAdapterAbilityFunc *func = (CfListAdapterAbilityFunc *)GetAbility(CF_ABILITY(CF_ABILITY_TYPE_ADAPTER,
+        CF_OBJ_TYPE_LIST));
+    if ((func == NULL) || (func->base.type != CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_FUNC, CF_OBJ_TYPE_LIST))) {
+        CF_LOG_E("invalid func type");
+        return CF_INVALID_PARAMS;
+    }
+
+    CfListObjStruct *tmp = CfMalloc(sizeof(CfListObjStruct));
+    if (tmp == NULL) {
+        CF_LOG_E("malloc list obj failed");
+        return CF_ERR_MALLOC;
+    }
+    tmp->base.type = CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_LIST);
+
+    int32_t ret = func->adapterCreate(in, &tmp->adapterRes);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("list adapter create failed");
+        CfFree(tmp);
+        return ret;
+    }
+    (void)memcpy_s(&tmp->func, sizeof(CfListAdapterAbilityFunc), func, sizeof(CfListAdapterAbilityFunc));
+
+    *obj = &(tmp->base);
+    return CF_SUCCESS;
+}
+
+static int32_t CfListFind(const CfListObjStruct *obj, const CfParamSet *in, CfBlob *out)
+{
+    CfParam *indexTypeParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_PARAM0_INT32, &indexTypeParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get index type failed, ret = %d", ret);
+        return ret;
+    }
+
+    CfParam *keyParam = NULL;
+    ret = CfGetParam(in, CF_TAG_PARAM1_BUFFER, &keyParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get index key failed, ret = %d", ret);
+        return ret;
+    }
+
+    ret = obj->func.adapterFind(obj->adapterRes, (CfListIndexType)indexTypeParam->int32Param, &keyParam->blob, out);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter find failed, ret = %d", ret);
+    }
+    return ret;
+}
+
+static int32_t CfListSelect(const CfListObjStruct *obj, const CfParamSet *in, CfBlob *out)
+{
+    CfListSelector selector = { NULL, NULL, NULL };
+    CfParam *tmpParam = NULL;
+    if (CfGetParam(in, CF_TAG_PARAM0_BUFFER, &tmpParam) == CF_SUCCESS) {
+        selector.issuer = &tmpParam->blob;
+    }
+    if (CfGetParam(in, CF_TAG_PARAM1_BUFFER, &tmpParam) == CF_SUCCESS) {
+        selector.extKeyUsage = &tmpParam->blob;
+    }
+    if (CfGetParam(in, CF_TAG_PARAM2_BUFFER, &tmpParam) == CF_SUCCESS) {
+        selector.date = &tmpParam->blob;
+    }
+
+    int32_t ret = obj->func.adapterSelect(obj->adapterRes, &selector, out);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("adapter select failed, ret = %d", ret);
+    }
+    return ret;
+}
+
+static int32_t GetColumns(const CfListObjStruct *obj, const CfParamSet *in, CfBlobArray *columns)
+{
+    CfParam *idsParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_PARAM0_BUFFER, &idsParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get item ids failed, ret = %d", ret);
+        return ret;
+    }
+
+    const CfBlob *ids = &idsParam->blob;
+    if ((ids->data == NULL) || (ids->size == 0) || ((ids->size % sizeof(int32_t)) != 0) ||
+        ((ids->size / sizeof(int32_t)) > CF_ITEM_INVALID)) {
+        CF_LOG_E("invalid item ids, size = %u", ids->size);
+        return CF_INVALID_PARAMS;
+    }
+
+    uint32_t count = ids->size / sizeof(int32_t);
+    CfBlob *data = (CfBlob *)CfMalloc(count * sizeof(CfBlob));
+    if (data == NULL) {
+        CF_LOG_E("malloc columns failed");
+        return CF_ERR_MALLOC;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t id = 0;
+        (void)memcpy_s(&id, sizeof(int32_t), ids->data + i * sizeof(int32_t), sizeof(int32_t));
+        ret = obj->func.adapterGetColumn(obj->adapterRes, (CfItemId)id, &data[i]);
+        if (ret != CF_SUCCESS) {
+            CF_LOG_E("adapter get column[%u] failed, ret = %d", i, ret);
+            FreeCfBlobArray(data, i);
+            return ret;
+        }
+    }
+
+    columns->data = data;
+    columns->count = count;
+    return CF_SUCCESS;
+}
+
+static int32_t CfListGetItems(const CfListObjStruct *obj, const CfParamSet *in, CfParamSet **out)
+{
+    CfBlobArray columns = { NULL, 0 };
+    int32_t ret = GetColumns(obj, in, &columns);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    ret = CfConstructArrayParamSetOut(&columns, out);
+    FreeCfBlobArray(columns.data, columns.count);
+    return ret;
+}
+
+/* layout: uint32_t n, uint32_t offset[n + 1] followed by the n columns, which are not aligned in the buffer */
+static int32_t CfListGetItemsBytes(const CfListObjStruct *obj, const CfParamSet *in, CfBlob *out)
+{
+    CfBlobArray columns = { NULL, 0 };
+    int32_t ret = GetColumns(obj, in, &columns);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    uint32_t headerLen = (columns.count + 2) * sizeof(uint32_t); /* 2: the count and the end offset */
+    uint32_t totalLen = headerLen;
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        if (CfIsAdditionOverflow(totalLen, columns.data[i].size)) {
+            CF_LOG_E("columns are too large");
+            FreeCfBlobArray(columns.data, columns.count);
+            return CF_INVALID_PARAMS;
+        }
+        totalLen += columns.data[i].size;
+    }
+
+    uint8_t *packed = (uint8_t *)CfMallocLarge(totalLen);
+    if (packed == NULL) {
+        CF_LOG_E("malloc packed columns failed, len = %u", totalLen);
+        FreeCfBlobArray(columns.data, columns.count);
+        return CF_ERR_MALLOC;
+    }
+
+    uint32_t *header = (uint32_t *)packed;
+    header[0] = columns.count;
+    header[1] = 0;
+    uint32_t pos = headerLen;
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        (void)memcpy_s(packed + pos, totalLen - pos, columns.data[i].data, columns.data[i].size);
+        pos += columns.data[i].size;
+        header[i + 2] = pos - headerLen; /* 2: offset[i + 1] follows the count */
+    }
+    FreeCfBlobArray(columns.data, columns.count);
+
+    out->data = packed;
+    out->size = totalLen;
+    return CF_SUCCESS;
+}
+
+static const CfListObjStruct *CheckListGet(const CfBase *obj, const CfParamSet *in, int32_t *getType)
+{
+    const CfListObjStruct *tmp = (const CfListObjStruct *)obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_LIST)) {
+        CF_LOG_E("invalid resource type");
+        return NULL;
+    }
+
+    CfParam *tmpParam = NULL;
+    int32_t ret = CfGetParam(in, CF_TAG_GET_TYPE, &tmpParam);
+    if (ret != CF_SUCCESS) {
+        CF_LOG_E("get param item type failed, ret = %d", ret);
+        return NULL;
+    }
+    *getType = tmpParam->int32Param;
+    return tmp;
+}
+
+int32_t CfListGet(const CfBase *obj, const CfParamSet *in, CfParamSet **out)
+{
+    if ((obj == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("cflistget params is null");
+        return CF_NULL_POINTER;
+    }
+
+    int32_t getType = 0;
+    const CfListObjStruct *tmp = CheckListGet(obj, in, &getType);
+    if (tmp == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    CfBlob packed = { 0, NULL };
+    int32_t ret;
+    switch (getType) {
+        case CF_GET_TYPE_LIST_FIND:
+            ret = CfListFind(tmp, in, &packed);
+            break;
+        case CF_GET_TYPE_LIST_SELECT:
+            ret = CfListSelect(tmp, in, &packed);
+            break;
+        case CF_GET_TYPE_LIST_ITEMS:
+            return CfListGetItems(tmp, in, out);
+        default:
+            CF_LOG_E("list get type invalid, type = %d", getType);
+            return CF_NOT_SUPPORT;
+    }
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+
+    /* the matched certs are returned in one packed buffer, so the result count is not limited by the param count */
+    CfParam params[] = {
+        { .tag = CF_TAG_RESULT_TYPE, .int32Param = CF_TAG_TYPE_BYTES },
+        { .tag = CF_TAG_RESULT_BYTES, .blob = packed },
+    };
+    ret = CfConstructParamSetOut(params, sizeof(params) / sizeof(CfParam), out);
+    CfFree(packed.data);
+    return ret;
+}
+
+int32_t CfListGetBytes(const CfBase *obj, const CfParamSet *in, CfBlob *out)
+{
+    if ((obj == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("cflistgetbytes params is null");
+        return CF_NULL_POINTER;
+    }
+
+    int32_t getType = 0;
+    const CfListObjStruct *tmp = CheckListGet(obj, in, &getType);
+    if (tmp == NULL) {
+        return CF_INVALID_PARAMS;
+    }
+
+    switch (getType) {
+        case CF_GET_TYPE_LIST_FIND:
+            return CfListFind(tmp, in, out);
+        case CF_GET_TYPE_LIST_SELECT:
+            return CfListSelect(tmp, in, out);
+        case CF_GET_TYPE_LIST_ITEMS:
+            return CfListGetItemsBytes(tmp, in, out);
+        default:
+            CF_LOG_E("list get type invalid, type = %d", getType);
+            return CF_NOT_SUPPORT;
+    }
+}
+
+int32_t CfListCheck(const CfBase *obj, const CfParamSet *in, CfParamSet **out)
+{
+    if ((obj == NULL) || (in == NULL) || (out == NULL)) {
+        CF_LOG_E("cflistcheck params is null");
+        return CF_NULL_POINTER;
+    }
+
+    CfListObjStruct *tmp = (CfListObjStruct *)obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_LIST)) {
+        CF_LOG_E("invalid resource type");
+        return CF_INVALID_PARAMS;
+    }
+
+    return CF_SUCCESS; /* reserve check function */
+}
+
+void CfListDestroy(CfBase **obj)
+{
+    if ((obj == NULL) || (*obj == NULL)) {
+        return;
+    }
+
+    CfListObjStruct *tmp = (CfListObjStruct *)*obj;
+    if (tmp->base.type != CF_MAGIC(CF_MAGIC_TYPE_OBJ_RESOURCE, CF_OBJ_TYPE_LIST)) {
+        /* only list objects can be destroyed */
+        CF_LOG_E("invalid resource type");
+        return;
+    }
+
+    tmp->func.adapterDestory(&tmp->adapterRes);
+    CfFree(tmp);
+    *obj = NULL;
+    return;
+}
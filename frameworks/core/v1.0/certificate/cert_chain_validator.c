@@ -155,6 +155,20 @@ static CfResult Validate(HcfCertChainValidator *self, const HcfCertChainData *ce
     return res;
 }
 
+static CfResult SetTrustStore(HcfCertChainValidator *self, const char *dirPath)
+{
+    if ((self == NULL) || (dirPath == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetCertChainValidatorClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    CertChainValidatorImpl *impl = (CertChainValidatorImpl *)self;
+    return impl->spiObj->engineSetTrustStore(impl->spiObj, dirPath);
+}
+
 static const char *GetAlgorithm(HcfCertChainValidator *self)
 {
     if (self == NULL) {
@@ -195,6 +209,7 @@ CfResult HcfCertChainValidatorCreate(const char *algorithm, HcfCertChainValidato
     }
     returnValidator->base.validate = Validate;
     returnValidator->base.getAlgorithm = GetAlgorithm;
+    returnValidator->base.setTrustStore = SetTrustStore;
     returnValidator->base.base.destroy = DestroyCertChainValidator;
     returnValidator->base.base.getClass = GetCertChainValidatorClass;
     returnValidator->spiObj = spiObj;
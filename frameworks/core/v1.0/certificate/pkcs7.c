@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pkcs7.h"
+
+#include "config.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_object_base.h"
+#include "pkcs7_spi.h"
+#include "x509_certificate.h"
+#include "x509_certificate_spi.h"
+#include "x509_crl.h"
+#include "x509_crl_spi.h"
+#include "x509_pkcs7_openssl.h"
+
+static void DestroyObjArray(CfArray *array)
+{
+    for (uint32_t i = 0; i < array->count; i++) {
+        CfObjDestroy(array->data[i].data);
+    }
+    CfFree(array->data);
+    array->data = NULL;
+    array->count = 0;
+}
+
+static CfResult WrapCerts(HcfPkcs7SpiContent *content, CfArray *certsOut)
+{
+    if (content->certCount == 0) {
+        return CF_SUCCESS;
+    }
+    certsOut->data = (CfBlob *)HcfMalloc(sizeof(CfBlob) * content->certCount, 0);
+    if (certsOut->data == NULL) {
+        LOGE("Failed to malloc for certs array!");
+        return CF_ERR_MALLOC;
+    }
+    for (uint32_t i = 0; i < content->certCount; i++) {
+        HcfX509Certificate *cert = NULL;
+        CfResult res = HcfX509CertificateCreateWithSpi(content->certs[i], &cert);
+        if (res != CF_SUCCESS) {
+            LOGE("Failed to create cert[%u]!", i);
+            return res;
+        }
+        content->certs[i] = NULL; /* owned by cert now */
+        certsOut->data[i].data = (uint8_t *)cert;
+        certsOut->data[i].size = sizeof(HcfX509Certificate);
+        certsOut->count++;
+    }
+    return CF_SUCCESS;
+}
+
+static CfResult WrapCrls(HcfPkcs7SpiContent *content, CfArray *crlsOut)
+{
+    if (content->crlCount == 0) {
+        return CF_SUCCESS;
+    }
+    crlsOut->data = (CfBlob *)HcfMalloc(sizeof(CfBlob) * content->crlCount, 0);
+    if (crlsOut->data == NULL) {
+        LOGE("Failed to malloc for crls array!");
+        return CF_ERR_MALLOC;
+    }
+    for (uint32_t i = 0; i < content->crlCount; i++) {
+        HcfX509Crl *crl = NULL;
+        CfResult res = HcfX509CrlCreateWithSpi(content->crls[i], &crl);
+        if (res != CF_SUCCESS) {
+            LOGE("Failed to create crl[%u]!", i);
+            return res;
+        }
+        content->crls[i] = NULL; /* owned by crl now */
+        crlsOut->data[i].data = (uint8_t *)crl;
+        crlsOut->data[i].size = sizeof(HcfX509Crl);
+        crlsOut->count++;
+    }
+    return CF_SUCCESS;
+}
+
+CfResult HcfPkcs7ParseCerts(const CfEncodingBlob *inStream, CfArray *certsOut, CfArray *crlsOut)
+{
+    if ((inStream == NULL) || (inStream->data == NULL) || (inStream->len == 0) ||
+        (inStream->len > HCF_MAX_PKCS7_LEN) || (certsOut == NULL) || (crlsOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    HcfPkcs7SpiContent content = { NULL, 0, NULL, 0 };
+    CfResult res = OpensslPkcs7SpiParse(inStream, &content);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to parse pkcs7!");
+        return res;
+    }
+    CfArray certs = { NULL, CF_FORMAT_DER, 0 };
+    CfArray crls = { NULL, CF_FORMAT_DER, 0 };
+    res = WrapCerts(&content, &certs);
+    if (res == CF_SUCCESS) {
+        res = WrapCrls(&content, &crls);
+    }
+    /* entries already wrapped are NULL, CfObjDestroy skips them */
+    OpensslPkcs7SpiContentFree(&content);
+    if (res != CF_SUCCESS) {
+        DestroyObjArray(&certs);
+        DestroyObjArray(&crls);
+        return res;
+    }
+    *certsOut = certs;
+    *crlsOut = crls;
+    return CF_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_cert_builder.h"
+
+#include "config.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "utils.h"
+#include "x509_cert_builder_openssl.h"
+#include "x509_cert_builder_spi.h"
+#include "x509_certificate_spi.h"
+
+typedef struct {
+    HcfX509CertBuilder base;
+    HcfX509CertBuilderSpi *spiObj;
+} HcfX509CertBuilderImpl;
+
+static const char *GetX509CertBuilderClass(void)
+{
+    return "HcfX509CertBuilder";
+}
+
+static void DestroyX509CertBuilder(CfObjectBase *self)
+{
+    if (self == NULL) {
+        LOGE("Invalid input parameter.");
+        return;
+    }
+    if (!IsClassMatch(self, GetX509CertBuilderClass())) {
+        LOGE("Class is not match.");
+        return;
+    }
+    HcfX509CertBuilderImpl *impl = (HcfX509CertBuilderImpl *)self;
+    CfObjDestroy(impl->spiObj);
+    CfFree(impl);
+}
+
+static CfResult IssueOne(HcfX509CertBuilderImpl *impl, const HcfX509CertIssueParams *params,
+    HcfX509Certificate **certOut)
+{
+    HcfX509CertificateSpi *certSpi = NULL;
+    CfResult res = impl->spiObj->engineIssue(impl->spiObj, params, &certSpi);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to issue cert!");
+        return res;
+    }
+    res = HcfX509CertificateCreateWithSpi(certSpi, certOut);
+    if (res != CF_SUCCESS) {
+        CfObjDestroy(certSpi);
+    }
+    return res;
+}
+
+static CfResult Issue(HcfX509CertBuilder *self, const HcfX509CertIssueParams *params, HcfX509Certificate **certOut)
+{
+    if ((self == NULL) || (params == NULL) || (certOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertBuilderClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return IssueOne((HcfX509CertBuilderImpl *)self, params, certOut);
+}
+
+static void DestroyCertArray(CfArray *certs)
+{
+    for (uint32_t i = 0; i < certs->count; i++) {
+        CfObjDestroy(certs->data[i].data);
+    }
+    CfFree(certs->data);
+    certs->data = NULL;
+    certs->count = 0;
+}
+
+static CfResult IssueBatch(HcfX509CertBuilder *self, const HcfX509CertIssueParams *paramsList, uint32_t count,
+    CfArray *certsOut)
+{
+    if ((self == NULL) || (paramsList == NULL) || (count == 0) || (count > HCF_MAX_CERT_ISSUE_NUM) ||
+        (certsOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertBuilderClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CertBuilderImpl *impl = (HcfX509CertBuilderImpl *)self;
+    CfArray certs = { NULL, CF_FORMAT_DER, 0 };
+    certs.data = (CfBlob *)HcfMalloc(sizeof(CfBlob) * count, 0);
+    if (certs.data == NULL) {
+        LOGE("Failed to malloc for certs array!");
+        return CF_ERR_MALLOC;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        HcfX509Certificate *cert = NULL;
+        CfResult res = IssueOne(impl, &paramsList[i], &cert);
+        if (res != CF_SUCCESS) {
+            LOGE("Failed to issue cert[%u]!", i);
+            DestroyCertArray(&certs);
+            return res;
+        }
+        certs.data[i].data = (uint8_t *)cert;
+        certs.data[i].size = sizeof(HcfX509Certificate);
+        certs.count++;
+    }
+    *certsOut = certs;
+    return CF_SUCCESS;
+}
+
+CfResult HcfX509CertBuilderCreate(const HcfX509CertTemplate *tmpl, const CfBlob *signingKey,
+    HcfX509CertBuilder **builder)
+{
+    CF_LOG_I("enter");
+    if ((tmpl == NULL) || (signingKey == NULL) || (builder == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CertBuilderSpi *spiObj = NULL;
+    CfResult res = HcfX509CertBuilderSpiCreate(tmpl, signingKey, &spiObj);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to create cert builder spi object!");
+        return res;
+    }
+    HcfX509CertBuilderImpl *impl = (HcfX509CertBuilderImpl *)HcfMalloc(sizeof(HcfX509CertBuilderImpl), 0);
+    if (impl == NULL) {
+        LOGE("Failed to allocate builder memory!");
+        CfObjDestroy(spiObj);
+        return CF_ERR_MALLOC;
+    }
+    impl->base.base.getClass = GetX509CertBuilderClass;
+    impl->base.base.destroy = DestroyX509CertBuilder;
+    impl->base.issue = Issue;
+    impl->base.issueBatch = IssueBatch;
+    impl->spiObj = spiObj;
+    *builder = (HcfX509CertBuilder *)impl;
+    return CF_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include "x509_certificate_openssl.h"
 #include "cf_log.h"
 #include "cf_memory.h"
+#include "cf_pem.h"
 #include "utils.h"
 
 typedef CfResult (*HcfX509CertificateSpiCreateFunc)(const CfEncodingBlob *, HcfX509CertificateSpi **);
@@ -102,6 +103,26 @@ static CfResult GetEncoded(HcfCertificate *self, CfEncodingBlob *encodedByte)
         ((HcfX509CertificateImpl *)self)->spiObj, encodedByte);
 }
 
+static CfResult GetEncodedWithFormat(HcfX509Certificate *self, enum CfEncodingFormat format,
+    CfEncodingBlob *encodedByte)
+{
+    if ((format != CF_FORMAT_DER) && (format != CF_FORMAT_PEM)) {
+        LOGE("Invalid encoding format.");
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = GetEncoded((HcfCertificate *)self, encodedByte);
+    if ((res != CF_SUCCESS) || (format == CF_FORMAT_DER)) {
+        return res;
+    }
+    res = (CfResult)CfEncodingBlobToPem(encodedByte, CF_PEM_LABEL_CERT);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to convert cert to pem.");
+        CF_FREE_PTR(encodedByte->data);
+        encodedByte->len = 0;
+    }
+    return res;
+}
+
 static CfResult GetPublicKey(HcfCertificate *self, HcfPubKey **keyOut)
 {
     if ((self == NULL) || (keyOut == NULL)) {
@@ -340,6 +361,64 @@ static CfResult GetIssuerAltNames(HcfX509Certificate *self, CfArray *outName)
         ((HcfX509CertificateImpl *)self)->spiObj, outName);
 }
 
+static CfResult Dup(HcfX509Certificate *self, HcfX509Certificate **out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertificateClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CertificateImpl *impl = (HcfX509CertificateImpl *)self;
+    HcfX509CertificateImpl *dupImpl = (HcfX509CertificateImpl *)HcfMalloc(sizeof(HcfX509CertificateImpl), 0);
+    if (dupImpl == NULL) {
+        LOGE("Failed to allocate x509CertImpl memory!");
+        return CF_ERR_MALLOC;
+    }
+    HcfX509CertificateSpi *spiObj = NULL;
+    CfResult res = impl->spiObj->engineDup(impl->spiObj, &spiObj);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to dup spi object!");
+        CfFree(dupImpl);
+        return res;
+    }
+    *dupImpl = *impl;
+    dupImpl->spiObj = spiObj;
+    *out = (HcfX509Certificate *)dupImpl;
+    return CF_SUCCESS;
+}
+
+static CfResult Equals(HcfX509Certificate *self, HcfX509Certificate *other, bool *out)
+{
+    if ((self == NULL) || (other == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertificateClass()) ||
+        !IsClassMatch((CfObjectBase *)other, GetX509CertificateClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CertificateImpl *)self)->spiObj->engineEquals(
+        ((HcfX509CertificateImpl *)self)->spiObj, ((HcfX509CertificateImpl *)other)->spiObj, out);
+}
+
+static CfResult HashCode(HcfX509Certificate *self, uint32_t *out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CertificateClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CertificateImpl *)self)->spiObj->engineHashCode(
+        ((HcfX509CertificateImpl *)self)->spiObj, out);
+}
+
 CfResult HcfX509CertificateCreate(const CfEncodingBlob *inStream, HcfX509Certificate **returnObj)
 {
     CF_LOG_I("enter");
@@ -353,9 +432,24 @@ CfResult HcfX509CertificateCreate(const CfEncodingBlob *inStream, HcfX509Certifi
     HcfX509CertificateSpi *spiObj = NULL;
     CfResult res = funcSet->createFunc(inStream, &spiObj);
     if (res != CF_SUCCESS) {
-        LOGE("Failed to create spi object!");
+        if (res != CF_INVALID_PARAMS) { /* malformed input is counted by the spi, not logged per input */
+            LOGE("Failed to create spi object!");
+        }
         return res;
     }
+    res = HcfX509CertificateCreateWithSpi(spiObj, returnObj);
+    if (res != CF_SUCCESS) {
+        CfObjDestroy(spiObj);
+    }
+    return res;
+}
+
+CfResult HcfX509CertificateCreateWithSpi(HcfX509CertificateSpi *spiObj, HcfX509Certificate **returnObj)
+{
+    if ((spiObj == NULL) || (returnObj == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
     HcfX509CertificateImpl *x509CertImpl = (HcfX509CertificateImpl *)HcfMalloc(sizeof(HcfX509CertificateImpl), 0);
     if (x509CertImpl == NULL) {
         LOGE("Failed to allocate x509CertImpl memory!");
@@ -382,6 +476,10 @@ CfResult HcfX509CertificateCreate(const CfEncodingBlob *inStream, HcfX509Certifi
     x509CertImpl->base.getBasicConstraints = GetBasicConstraints;
     x509CertImpl->base.getSubjectAltNames = GetSubjectAltNames;
     x509CertImpl->base.getIssuerAltNames = GetIssuerAltNames;
+    x509CertImpl->base.getEncodedWithFormat = GetEncodedWithFormat;
+    x509CertImpl->base.dup = Dup;
+    x509CertImpl->base.equals = Equals;
+    x509CertImpl->base.hashCode = HashCode;
 
     x509CertImpl->spiObj = spiObj;
     *returnObj = (HcfX509Certificate *)x509CertImpl;
@@ -20,6 +20,7 @@
 #include "config.h"
 #include "cf_log.h"
 #include "cf_memory.h"
+#include "cf_pem.h"
 #include "utils.h"
 #include "x509_crl.h"
 #include "x509_crl_openssl.h"
@@ -140,6 +141,25 @@ static CfResult GetEncoded(HcfX509Crl *self, CfEncodingBlob *encodedByte)
         ((HcfX509CrlImpl *)self)->spiObj, encodedByte);
 }
 
+static CfResult GetEncodedWithFormat(HcfX509Crl *self, enum CfEncodingFormat format, CfEncodingBlob *encodedByte)
+{
+    if ((format != CF_FORMAT_DER) && (format != CF_FORMAT_PEM)) {
+        LOGE("Invalid encoding format.");
+        return CF_INVALID_PARAMS;
+    }
+    CfResult res = GetEncoded(self, encodedByte);
+    if ((res != CF_SUCCESS) || (format == CF_FORMAT_DER)) {
+        return res;
+    }
+    res = (CfResult)CfEncodingBlobToPem(encodedByte, CF_PEM_LABEL_CRL);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to convert crl to pem.");
+        CF_FREE_PTR(encodedByte->data);
+        encodedByte->len = 0;
+    }
+    return res;
+}
+
 static long GetVersion(HcfX509Crl *self)
 {
     if (self == NULL) {
@@ -224,6 +244,20 @@ static CfResult GetRevokedCertWithCert(HcfX509Crl *self, HcfX509Certificate *cer
         ((HcfX509CrlImpl *)self)->spiObj, cert, entryOut);
 }
 
+static CfResult GetRevokedCertWithSerial(HcfX509Crl *self, const CfBlob *serial, HcfX509CrlEntry **entryOut)
+{
+    if ((self == NULL) || (serial == NULL) || (entryOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CrlImpl *)self)->spiObj->engineGetRevokedCertWithSerial(
+        ((HcfX509CrlImpl *)self)->spiObj, serial, entryOut);
+}
+
 static CfResult GetRevokedCerts(HcfX509Crl *self, CfArray *entrysOut)
 {
     if ((self == NULL) || (entrysOut == NULL)) {
@@ -238,6 +272,35 @@ static CfResult GetRevokedCerts(HcfX509Crl *self, CfArray *entrysOut)
         ((HcfX509CrlImpl *)self)->spiObj, entrysOut);
 }
 
+static CfResult GetRevokedColumns(HcfX509Crl *self, HcfX509CrlColumns *columnsOut)
+{
+    if ((self == NULL) || (columnsOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CrlImpl *)self)->spiObj->engineGetRevokedColumns(
+        ((HcfX509CrlImpl *)self)->spiObj, columnsOut);
+}
+
+static CfResult GetRevokedDiff(HcfX509Crl *self, HcfX509Crl *newer, CfBlobArray *addedOut, CfBlobArray *removedOut)
+{
+    if ((self == NULL) || (newer == NULL) || (addedOut == NULL) || (removedOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass()) ||
+        !IsClassMatch((CfObjectBase *)newer, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CrlImpl *)self)->spiObj->engineGetRevokedDiff(
+        ((HcfX509CrlImpl *)self)->spiObj, ((HcfX509CrlImpl *)newer)->spiObj, addedOut, removedOut);
+}
+
 static CfResult GetTbsInfo(HcfX509Crl *self, CfBlob *tbsCertListOut)
 {
     if ((self == NULL) || (tbsCertListOut == NULL)) {
@@ -308,6 +371,63 @@ static CfResult GetSignatureAlgParams(HcfX509Crl *self, CfBlob *sigAlgParamOut)
         ((HcfX509CrlImpl *)self)->spiObj, sigAlgParamOut);
 }
 
+static CfResult Dup(HcfX509Crl *self, HcfX509Crl **out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    HcfX509CrlImpl *impl = (HcfX509CrlImpl *)self;
+    HcfX509CrlImpl *dupImpl = (HcfX509CrlImpl *)HcfMalloc(sizeof(HcfX509CrlImpl), 0);
+    if (dupImpl == NULL) {
+        LOGE("Failed to allocate x509CrlImpl memory!");
+        return CF_ERR_MALLOC;
+    }
+    HcfX509CrlSpi *spiObj = NULL;
+    CfResult res = impl->spiObj->engineDup(impl->spiObj, &spiObj);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to dup spi object!");
+        CfFree(dupImpl);
+        return res;
+    }
+    *dupImpl = *impl;
+    dupImpl->spiObj = spiObj;
+    *out = (HcfX509Crl *)dupImpl;
+    return CF_SUCCESS;
+}
+
+static CfResult Equals(HcfX509Crl *self, HcfX509Crl *other, bool *out)
+{
+    if ((self == NULL) || (other == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass()) ||
+        !IsClassMatch((CfObjectBase *)other, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CrlImpl *)self)->spiObj->engineEquals(
+        ((HcfX509CrlImpl *)self)->spiObj, ((HcfX509CrlImpl *)other)->spiObj, out);
+}
+
+static CfResult HashCode(HcfX509Crl *self, uint32_t *out)
+{
+    if ((self == NULL) || (out == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    if (!IsClassMatch((CfObjectBase *)self, GetX509CrlClass())) {
+        LOGE("Class is not match.");
+        return CF_INVALID_PARAMS;
+    }
+    return ((HcfX509CrlImpl *)self)->spiObj->engineHashCode(((HcfX509CrlImpl *)self)->spiObj, out);
+}
+
 CfResult HcfX509CrlCreate(const CfEncodingBlob *inStream, HcfX509Crl **returnObj)
 {
     CF_LOG_I("enter");
@@ -322,9 +442,24 @@ CfResult HcfX509CrlCreate(const CfEncodingBlob *inStream, HcfX509Crl **returnObj
     HcfX509CrlSpi *spiObj = NULL;
     CfResult res = funcSet->createFunc(inStream, &spiObj);
     if (res != CF_SUCCESS) {
-        LOGE("Failed to create spi object!");
+        if (res != CF_INVALID_PARAMS) { /* malformed input is counted by the spi, not logged per input */
+            LOGE("Failed to create spi object!");
+        }
         return res;
     }
+    res = HcfX509CrlCreateWithSpi(spiObj, returnObj);
+    if (res != CF_SUCCESS) {
+        CfObjDestroy(spiObj);
+    }
+    return res;
+}
+
+CfResult HcfX509CrlCreateWithSpi(HcfX509CrlSpi *spiObj, HcfX509Crl **returnObj)
+{
+    if ((spiObj == NULL) || (returnObj == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
     HcfX509CrlImpl *x509CertImpl = (HcfX509CrlImpl *)HcfMalloc(sizeof(HcfX509CrlImpl), 0);
     if (x509CertImpl == NULL) {
         LOGE("Failed to allocate x509CertImpl memory!");
@@ -336,19 +471,38 @@ CfResult HcfX509CrlCreate(const CfEncodingBlob *inStream, HcfX509Crl **returnObj
     x509CertImpl->base.base.isRevoked = IsRevoked;
     x509CertImpl->base.verify = Verify;
     x509CertImpl->base.getEncoded = GetEncoded;
+    x509CertImpl->base.getEncodedWithFormat = GetEncodedWithFormat;
     x509CertImpl->base.getVersion = GetVersion;
     x509CertImpl->base.getIssuerName = GetIssuerName;
     x509CertImpl->base.getLastUpdate = GetLastUpdate;
     x509CertImpl->base.getNextUpdate = GetNextUpdate;
     x509CertImpl->base.getRevokedCert = GetRevokedCert;
     x509CertImpl->base.getRevokedCertWithCert = GetRevokedCertWithCert;
+    x509CertImpl->base.getRevokedCertWithSerial = GetRevokedCertWithSerial;
     x509CertImpl->base.getRevokedCerts = GetRevokedCerts;
+    x509CertImpl->base.getRevokedColumns = GetRevokedColumns;
+    x509CertImpl->base.getRevokedDiff = GetRevokedDiff;
     x509CertImpl->base.getTbsInfo = GetTbsInfo;
     x509CertImpl->base.getSignature = GetSignature;
     x509CertImpl->base.getSignatureAlgName = GetSignatureAlgName;
     x509CertImpl->base.getSignatureAlgOid = GetSignatureAlgOid;
     x509CertImpl->base.getSignatureAlgParams = GetSignatureAlgParams;
+    x509CertImpl->base.dup = Dup;
+    x509CertImpl->base.equals = Equals;
+    x509CertImpl->base.hashCode = HashCode;
     x509CertImpl->spiObj = spiObj;
     *returnObj = (HcfX509Crl *)x509CertImpl;
     return CF_SUCCESS;
-}
\ No newline at end of file
+}
+
+void HcfX509CrlColumnsFree(HcfX509CrlColumns *columns)
+{
+    if (columns == NULL) {
+        return;
+    }
+    CfBlobDataFree(&columns->serialOffsets);
+    CfBlobDataFree(&columns->serials);
+    CfBlobDataFree(&columns->revocationDates);
+    CfBlobDataFree(&columns->reasons);
+    columns->count = 0;
+}
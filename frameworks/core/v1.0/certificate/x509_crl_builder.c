@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509_crl_builder.h"
+
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_object_base.h"
+#include "x509_crl_builder_openssl.h"
+#include "x509_crl_spi.h"
+
+CfResult HcfX509CrlBuild(const HcfX509CrlBuildParams *params, const HcfX509CrlColumns *revoked,
+    const CfBlob *signingKey, CfEncodingBlob *derOut, HcfX509Crl **crlOut)
+{
+    if ((params == NULL) || (revoked == NULL) || (signingKey == NULL) || (derOut == NULL)) {
+        LOGE("Invalid input parameter.");
+        return CF_INVALID_PARAMS;
+    }
+    CfEncodingBlob der = { NULL, 0, CF_FORMAT_DER };
+    HcfX509CrlSpi *spiObj = NULL;
+    CfResult res = OpensslX509CrlSpiBuild(params, revoked, signingKey, &der, (crlOut == NULL) ? NULL : &spiObj);
+    if (res != CF_SUCCESS) {
+        LOGE("Failed to build crl!");
+        return res;
+    }
+    if (crlOut != NULL) {
+        res = HcfX509CrlCreateWithSpi(spiObj, crlOut);
+        if (res != CF_SUCCESS) {
+            CfObjDestroy(spiObj);
+            CfFree(der.data);
+            return res;
+        }
+    }
+    *derOut = der;
+    return CF_SUCCESS;
+}
@@ -25,6 +25,7 @@ typedef struct HcfCertChainValidatorSpi HcfCertChainValidatorSpi;
 struct HcfCertChainValidatorSpi {
     CfObjectBase base;
     CfResult (*engineValidate)(HcfCertChainValidatorSpi *self, const CfArray *certsList);
+    CfResult (*engineSetTrustStore)(HcfCertChainValidatorSpi *self, const char *dirPath);
 };
 
 #endif // CF_CERT_CHAIN_VALIDATOR_SPI_H
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_PKCS7_SPI_H
+#define CF_PKCS7_SPI_H
+
+#include <stdint.h>
+
+#include "x509_certificate_spi.h"
+#include "x509_crl_spi.h"
+
+/* The spi objects of the certificates and CRLs in a PKCS#7 bundle, in the order of the bundle. */
+typedef struct {
+    HcfX509CertificateSpi **certs;
+    uint32_t certCount;
+    HcfX509CrlSpi **crls;
+    uint32_t crlCount;
+} HcfPkcs7SpiContent;
+
+#endif // CF_PKCS7_SPI_H
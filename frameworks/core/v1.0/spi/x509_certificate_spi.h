@@ -16,10 +16,13 @@
 #ifndef CF_X509_CERTIFICATE_SPI_H
 #define CF_X509_CERTIFICATE_SPI_H
 
+#include <stdbool.h>
+
 #include "cf_blob.h"
 #include "cf_object_base.h"
 #include "pub_key.h"
 #include "cf_result.h"
+#include "x509_certificate.h"
 
 typedef struct HcfX509CertificateSpi HcfX509CertificateSpi;
 
@@ -63,6 +66,23 @@ struct HcfX509CertificateSpi {
     CfResult (*engineGetSubjectAltNames)(HcfX509CertificateSpi *self, CfArray *outName);
 
     CfResult (*engineGetIssuerAltNames)(HcfX509CertificateSpi *self, CfArray *outName);
+
+    CfResult (*engineDup)(HcfX509CertificateSpi *self, HcfX509CertificateSpi **out);
+
+    CfResult (*engineEquals)(HcfX509CertificateSpi *self, HcfX509CertificateSpi *other, bool *out);
+
+    CfResult (*engineHashCode)(HcfX509CertificateSpi *self, uint32_t *out);
 };
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Wraps an spi object created by the adapter, the certificate owns it on success, the caller still does on failure. */
+CfResult HcfX509CertificateCreateWithSpi(HcfX509CertificateSpi *spiObj, HcfX509Certificate **returnObj);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // CF_X509_CERTIFICATE_SPI_H
@@ -21,6 +21,7 @@
 #include "pub_key.h"
 #include "cf_result.h"
 #include "x509_certificate.h"
+#include "x509_crl.h"
 #include "x509_crl_entry.h"
 
 typedef struct HcfX509CrlSpi HcfX509CrlSpi;
@@ -49,8 +50,15 @@ struct HcfX509CrlSpi {
     CfResult (*engineGetRevokedCertWithCert)(HcfX509CrlSpi *self, HcfX509Certificate *cert,
         HcfX509CrlEntry **entryOut);
 
+    CfResult (*engineGetRevokedCertWithSerial)(HcfX509CrlSpi *self, const CfBlob *serial, HcfX509CrlEntry **entryOut);
+
     CfResult (*engineGetRevokedCerts)(HcfX509CrlSpi *self, CfArray *entrysOut);
 
+    CfResult (*engineGetRevokedColumns)(HcfX509CrlSpi *self, HcfX509CrlColumns *columnsOut);
+
+    CfResult (*engineGetRevokedDiff)(HcfX509CrlSpi *self, HcfX509CrlSpi *newer, CfBlobArray *addedOut,
+        CfBlobArray *removedOut);
+
     CfResult (*engineGetTbsInfo)(HcfX509CrlSpi *self, CfBlob *tbsCertListOut);
 
     CfResult (*engineGetSignature)(HcfX509CrlSpi *self, CfBlob *signature);
@@ -60,6 +68,23 @@ struct HcfX509CrlSpi {
     CfResult (*engineGetSignatureAlgOid)(HcfX509CrlSpi *self, CfBlob *out);
 
     CfResult (*engineGetSignatureAlgParams)(HcfX509CrlSpi *self, CfBlob *sigAlgParamOut);
+
+    CfResult (*engineDup)(HcfX509CrlSpi *self, HcfX509CrlSpi **out);
+
+    CfResult (*engineEquals)(HcfX509CrlSpi *self, HcfX509CrlSpi *other, bool *out);
+
+    CfResult (*engineHashCode)(HcfX509CrlSpi *self, uint32_t *out);
 };
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Wraps an spi object created by the adapter, the crl owns it on success, the caller still does on failure. */
+CfResult HcfX509CrlCreateWithSpi(HcfX509CrlSpi *spiObj, HcfX509Crl **returnObj);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // CF_X509_CRL_SPI_H
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NAPI_CERT_CTX_POOL_H
+#define NAPI_CERT_CTX_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace CertFramework {
+/*
+ * Free list of zeroed async context blocks of one size. Contexts are taken and given back on the JS thread only,
+ * so each file keeps a thread_local pool per context type, which is a pool per env.
+ */
+class CertCtxPool {
+public:
+    explicit CertCtxPool(uint32_t size) : size_(size) {}
+    ~CertCtxPool();
+    void *Acquire(void);
+    void Release(void *ctx);
+
+private:
+    uint32_t size_ = 0;
+    std::vector<void *> freeList_;
+};
+}  // namespace CertFramework
+}  // namespace OHOS
+#endif
@@ -58,6 +58,12 @@ enum AsyncType {
     ASYNC_TYPE_CALLBACK = 1,
     ASYNC_TYPE_PROMISE = 2
 };
+
+enum CertNativeObjType {
+    CERT_NATIVE_OBJ_CERT = 1,
+    CERT_NATIVE_OBJ_CRL = 2,
+    CERT_NATIVE_OBJ_CRL_ENTRY = 3
+};
 } // namespace CertFramework
 } // namespace OHOS
 
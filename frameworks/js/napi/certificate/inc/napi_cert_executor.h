@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NAPI_CERT_EXECUTOR_H
+#define NAPI_CERT_EXECUTOR_H
+
+#include "napi/native_api.h"
+#include "napi/native_common.h"
+
+namespace OHOS {
+namespace CertFramework {
+/*
+ * Runs execute on the certificate worker pool instead of the shared libuv pool, and complete on the JS thread of
+ * env. Completions that finish close together are delivered in one JS thread wakeup. execute must not call napi.
+ * Falls back to napi async work if the pool can not be used for env.
+ */
+napi_status CertQueueAsyncWork(napi_env env, const char *name, napi_async_execute_callback execute,
+    napi_async_complete_callback complete, void *data);
+}  // namespace CertFramework
+}  // namespace OHOS
+#endif
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NAPI_CERT_TRANSFER_H
+#define NAPI_CERT_TRANSFER_H
+
+#include "napi/native_api.h"
+#include "napi/native_common.h"
+
+namespace OHOS {
+namespace CertFramework {
+using CertDetachedDeleter = void (*)(void *object);
+
+/*
+ * Parks object, the copy a detach callback of napi_coerce_to_native_binding_object hands to another worker, and
+ * returns the token to hand instead. A message that is never received is dropped without calling attach, so the
+ * copies still parked when env is cleaned up are given to deleter then. Returns nullptr and deletes object on failure.
+ */
+void *CertParkDetached(napi_env env, void *object, CertDetachedDeleter deleter);
+
+/* Takes back the object parked under token in the attach callback, nullptr if it was already deleted. */
+void *CertTakeDetached(void *token);
+}  // namespace CertFramework
+}  // namespace OHOS
+#endif
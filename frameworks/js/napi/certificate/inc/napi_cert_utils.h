@@ -38,12 +38,17 @@ napi_value CertConvertBlobToNapiValue(napi_env env, CfBlob *blob);
 
 bool CertGetStringFromJSParams(napi_env env, napi_value arg, std::string &returnStr);
 bool CertGetInt32FromJSParams(napi_env env, napi_value arg, int32_t &returnInt);
+bool CertGetSerialFromBigIntJSParams(napi_env env, napi_value arg, CfBlob &serial);
 bool CertGetCallbackFromJSParams(napi_env env, napi_value arg, napi_ref *returnCb);
 bool GetEncodingBlobFromValue(napi_env env, napi_value object, CfEncodingBlob **encodingBlob);
 bool GetCertChainFromValue(napi_env env, napi_value object, HcfCertChainData **certChainData);
 bool CertCheckArgsCount(napi_env env, size_t argc, size_t expectedCount, bool isSync);
+/* Reads the optional leading encoding format of getEncoded, argIndex is set to the index of the next argument. */
+bool CertGetOptionalEncodingFormat(napi_env env, size_t argc, napi_value *argv, int32_t &format, size_t &argIndex);
 AsyncType GetAsyncType(napi_env env, size_t argc, size_t maxCount, napi_value arg);
 napi_value CertGetResourceName(napi_env env, const char *name);
+int64_t CertEstimateNativeSize(CertNativeObjType type, size_t derLen);
+void CertAdjustExternalMemory(napi_env env, int64_t change);
 napi_value GenerateArrayBuffer(napi_env env, uint8_t *data, uint32_t size);
 napi_value CertNapiGetNull(napi_env env);
 napi_value ConvertArrayToNapiValue(napi_env env, CfArray *array);
@@ -30,7 +30,6 @@ struct AsyncContext {
     napi_value promise = nullptr;
     napi_ref callback = nullptr;
     napi_deferred deferred = nullptr;
-    napi_async_work asyncWork = nullptr;
     int32_t errCode = 0;
     const char *errMsg = nullptr;
 };
@@ -16,6 +16,7 @@
 #ifndef NAPI_X509_CERTIFICATE_H
 #define NAPI_X509_CERTIFICATE_H
 
+#include <memory>
 #include <string>
 
 #include "napi/native_api.h"
@@ -28,13 +29,16 @@ namespace CertFramework {
 class NapiX509Certificate {
 public:
     explicit NapiX509Certificate(HcfX509Certificate *x509Cert, CfObject *object);
-    ~NapiX509Certificate();
+    /* the copy shares the natives, for a cert sent to another worker */
+    NapiX509Certificate(const NapiX509Certificate &other) = default;
+    ~NapiX509Certificate() = default;
 
     static void DefineX509CertJSClass(napi_env env, napi_value exports);
     static napi_value NapiCreateX509Cert(napi_env env, napi_callback_info info);
     static void CreateX509CertExecute(napi_env env, void *data);
     static void CreateX509CertComplete(napi_env env, napi_status status, void *data);
     static napi_value CreateX509Cert(napi_env env);
+    static napi_status WrapX509Cert(napi_env env, napi_value instance, NapiX509Certificate *x509CertClass);
 
     napi_value Verify(napi_env env, napi_callback_info info);
     napi_value GetEncoded(napi_env env, napi_callback_info info);
@@ -57,22 +61,36 @@ public:
     napi_value GetBasicConstraints(napi_env env, napi_callback_info info);
     napi_value GetSubjectAlternativeNames(napi_env env, napi_callback_info info);
     napi_value GetIssuerAlternativeNames(napi_env env, napi_callback_info info);
+    napi_value Equals(napi_env env, napi_callback_info info);
+    napi_value HashCode(napi_env env, napi_callback_info info);
 
     HcfX509Certificate *GetX509Cert()
     {
-        return x509Cert_;
+        return x509Cert_.get();
     }
 
     CfObject *GetCertObject()
     {
-        return certObject_;
+        return certObject_.get();
+    }
+
+    int64_t GetNativeSize() const
+    {
+        return nativeSize_;
+    }
+
+    void SetNativeSize(int64_t nativeSize)
+    {
+        nativeSize_ = nativeSize;
     }
 
     static thread_local napi_ref classRef_;
 
 private:
-    HcfX509Certificate *x509Cert_ = nullptr;
-    CfObject *certObject_ = nullptr;
+    /* read only once created, so the wrappers of several workers may share them */
+    std::shared_ptr<HcfX509Certificate> x509Cert_;
+    std::shared_ptr<CfObject> certObject_;
+    int64_t nativeSize_ = 0; /* reported to the JS GC, given back in the finalizer, 0 in copies for other workers */
 };
 } // namespace CertFramework
 } // namespace OHOS
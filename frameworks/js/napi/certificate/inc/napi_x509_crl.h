@@ -16,6 +16,7 @@
 #ifndef NAPI_X509_CRL_H
 #define NAPI_X509_CRL_H
 
+#include <memory>
 #include <string>
 
 #include "napi/native_api.h"
@@ -27,13 +28,16 @@ namespace CertFramework {
 class NapiX509Crl {
 public:
     explicit NapiX509Crl(HcfX509Crl *x509Crl);
-    ~NapiX509Crl();
+    /* the copy shares the native CRL, for a CRL sent to another worker */
+    NapiX509Crl(const NapiX509Crl &other) = default;
+    ~NapiX509Crl() = default;
 
     static void DefineX509CrlJSClass(napi_env env, napi_value exports);
     static napi_value NapiCreateX509Crl(napi_env env, napi_callback_info info);
     static void CreateX509CrlExecute(napi_env env, void *data);
     static void CreateX509CrlComplete(napi_env env, napi_status status, void *data);
     static napi_value CreateX509Crl(napi_env env);
+    static napi_status WrapX509Crl(napi_env env, napi_value instance, NapiX509Crl *x509CrlClass);
 
     napi_value IsRevoked(napi_env env, napi_callback_info info);
     napi_value GetType(napi_env env, napi_callback_info info);
@@ -45,22 +49,39 @@ public:
     napi_value GetNextUpdate(napi_env env, napi_callback_info info);
     napi_value GetRevokedCertificate(napi_env env, napi_callback_info info);
     napi_value GetRevokedCertificateWithCert(napi_env env, napi_callback_info info);
+    napi_value GetRevokedCertificateWithSerial(napi_env env, napi_callback_info info);
     napi_value GetRevokedCertificates(napi_env env, napi_callback_info info);
+    napi_value GetRevokedColumns(napi_env env, napi_callback_info info);
+    napi_value GetRevokedDiff(napi_env env, napi_callback_info info);
     napi_value GetTBSCertList(napi_env env, napi_callback_info info);
     napi_value GetSignature(napi_env env, napi_callback_info info);
     napi_value GetSigAlgName(napi_env env, napi_callback_info info);
     napi_value GetSigAlgOID(napi_env env, napi_callback_info info);
     napi_value GetSigAlgParams(napi_env env, napi_callback_info info);
+    napi_value Equals(napi_env env, napi_callback_info info);
+    napi_value HashCode(napi_env env, napi_callback_info info);
 
     HcfX509Crl *GetX509Crl()
     {
-        return x509Crl_;
+        return x509Crl_.get();
+    }
+
+    int64_t GetNativeSize() const
+    {
+        return nativeSize_;
+    }
+
+    void SetNativeSize(int64_t nativeSize)
+    {
+        nativeSize_ = nativeSize;
     }
 
     static thread_local napi_ref classRef_;
 
 private:
-    HcfX509Crl *x509Crl_ = nullptr;
+    /* read only once created, so the wrappers of several workers may share it */
+    std::shared_ptr<HcfX509Crl> x509Crl_;
+    int64_t nativeSize_ = 0; /* reported to the JS GC, given back in the finalizer, 0 in copies for other workers */
 };
 } // namespace CertFramework
 } // namespace OHOS
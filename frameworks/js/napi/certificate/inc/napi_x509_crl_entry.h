@@ -43,10 +43,21 @@ public:
         return x509CrlEntry_;
     }
 
+    int64_t GetNativeSize() const
+    {
+        return nativeSize_;
+    }
+
+    void SetNativeSize(int64_t nativeSize)
+    {
+        nativeSize_ = nativeSize;
+    }
+
     static thread_local napi_ref classRef_;
 
 private:
     HcfX509CrlEntry *x509CrlEntry_ = nullptr;
+    int64_t nativeSize_ = 0; /* reported to the JS GC, given back in the finalizer */
 };
 } // namespace CertFramework
 } // namespace OHOS
@@ -23,6 +23,8 @@
 #include "cf_result.h"
 #include "cf_object_base.h"
 #include "napi_cert_defines.h"
+#include "napi_cert_ctx_pool.h"
+#include "napi_cert_executor.h"
 #include "napi_cert_utils.h"
 
 namespace OHOS {
@@ -33,7 +35,6 @@ struct CfCtx {
     AsyncType asyncType = ASYNC_TYPE_CALLBACK;
     napi_ref callback = nullptr;
     napi_deferred deferred = nullptr;
-    napi_async_work asyncWork = nullptr;
 
     NapiCertChainValidator *ccvClass = nullptr;
     HcfCertChainData *certChainData = nullptr;
@@ -42,6 +43,8 @@ struct CfCtx {
     const char *errMsg = nullptr;
 };
 
+static thread_local CertCtxPool g_ctxPool(sizeof(CfCtx));
+
 NapiCertChainValidator::NapiCertChainValidator(HcfCertChainValidator *certChainValidator)
 {
     this->certChainValidator_ = certChainValidator;
@@ -58,10 +61,6 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
         return;
     }
 
-    if (context->asyncWork != nullptr) {
-        napi_delete_async_work(env, context->asyncWork);
-    }
-
     if (context->callback != nullptr) {
         napi_delete_reference(env, context->callback);
     }
@@ -73,7 +72,7 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
         context->certChainData = nullptr;
     }
 
-    CfFree(context);
+    g_ctxPool.Release(context);
 }
 
 static void ReturnCallbackResult(napi_env env, CfCtx *context, napi_value result)
@@ -139,7 +138,7 @@ napi_value NapiCertChainValidator::Validate(napi_env env, napi_callback_info inf
     if (!CertCheckArgsCount(env, argc, ARGS_SIZE_TWO, false)) {
         return nullptr;
     }
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -163,14 +162,11 @@ napi_value NapiCertChainValidator::Validate(napi_env env, napi_callback_info inf
         napi_create_promise(env, &context->deferred, &promise);
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "Validate"),
+    CertQueueAsyncWork(
+        env, "Validate",
         ValidateExecute,
         ValidateComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return promise;
     } else {
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "napi_cert_ctx_pool.h"
+
+#include "securec.h"
+
+#include "cf_memory.h"
+
+namespace OHOS {
+namespace CertFramework {
+constexpr size_t MAX_CACHED_CTX_COUNT = 64;
+
+CertCtxPool::~CertCtxPool()
+{
+    for (void *ctx : freeList_) {
+        CfFree(ctx);
+    }
+    freeList_.clear();
+}
+
+void *CertCtxPool::Acquire(void)
+{
+    if (freeList_.empty()) {
+        return CfMalloc(size_);
+    }
+    void *ctx = freeList_.back();
+    freeList_.pop_back();
+    return ctx;
+}
+
+void CertCtxPool::Release(void *ctx)
+{
+    if (ctx == nullptr) {
+        return;
+    }
+    if (freeList_.size() >= MAX_CACHED_CTX_COUNT) {
+        CfFree(ctx);
+        return;
+    }
+    if (freeList_.capacity() == 0) {
+        freeList_.reserve(MAX_CACHED_CTX_COUNT);
+    }
+    (void)memset_s(ctx, size_, 0, size_);
+    freeList_.push_back(ctx);
+}
+}  // namespace CertFramework
+}  // namespace OHOS
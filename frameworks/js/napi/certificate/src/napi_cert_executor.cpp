@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "napi_cert_executor.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cf_log.h"
+#include "napi_cert_utils.h"
+
+#ifndef CERT_NAPI_WORKER_COUNT
+#define CERT_NAPI_WORKER_COUNT 4
+#endif
+
+namespace OHOS {
+namespace CertFramework {
+namespace {
+constexpr uint32_t WORKER_COUNT = CERT_NAPI_WORKER_COUNT;
+
+class CompletionChannel;
+
+struct CertAsyncTask {
+    napi_async_execute_callback execute = nullptr;
+    napi_async_complete_callback complete = nullptr;
+    void *data = nullptr;
+    std::shared_ptr<CompletionChannel> channel;
+};
+
+napi_status QueueFallbackWork(napi_env env, const char *name, napi_async_execute_callback execute,
+    napi_async_complete_callback complete, void *data);
+
+/*
+ * Runs the complete of a task on the JS thread in a handle scope of its own, so a batch does not pile up the
+ * handles of every task. An exception left by complete is reported and cleared, the next task still runs.
+ */
+void CompleteTask(napi_env env, napi_status status, const CertAsyncTask &task)
+{
+    napi_handle_scope scope = nullptr;
+    napi_status scopeStatus = napi_open_handle_scope(env, &scope);
+    if (scopeStatus != napi_ok) {
+        LOGE("open handle scope failed, status = %d", scopeStatus);
+    }
+    task.complete(env, status, task.data);
+    bool pending = false;
+    if ((napi_is_exception_pending(env, &pending) == napi_ok) && pending) {
+        napi_value exception = nullptr;
+        (void)napi_get_and_clear_last_exception(env, &exception);
+        LOGE("async work complete left an exception");
+        (void)napi_fatal_exception(env, exception);
+    }
+    if (scopeStatus == napi_ok) {
+        (void)napi_close_handle_scope(env, scope);
+    }
+}
+
+/*
+ * One per env, finished tasks are collected here and the threadsafe function is called only when the list
+ * goes from empty to non-empty, so one JS thread wakeup drains every task that finished in the meantime.
+ */
+class CompletionChannel {
+public:
+    explicit CompletionChannel(napi_env env) : env_(env) {}
+    bool Init(void);
+    void Close(void);
+    void Acquire(void);
+    void Post(CertAsyncTask &&task);
+    void RequeueStalled(const char *name);
+    napi_env GetEnv(void) const
+    {
+        return env_;
+    }
+
+private:
+    static void Drain(napi_env env, napi_value jsCb, void *context, void *data);
+    void Release(uint32_t count);
+
+    napi_env env_ = nullptr;
+    napi_threadsafe_function tsfn_ = nullptr;
+    uint32_t pending_ = 0; /* only used on the JS thread */
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<CertAsyncTask> finished_;
+    uint32_t running_ = 0; /* tasks on the pool, queued or being executed */
+    bool signaled_ = false;
+    bool stalled_ = false; /* the wakeup of finished_ failed, the next queued work requeues them */
+    bool closed_ = false;
+};
+
+bool CompletionChannel::Init(void)
+{
+    napi_value name = CertGetResourceName(env_, "CertAsyncCompletion");
+    napi_status status = napi_create_threadsafe_function(env_, nullptr, nullptr, name, 0, 1, nullptr, nullptr, this,
+        Drain, &tsfn_);
+    if (status != napi_ok) {
+        LOGE("create threadsafe function failed, status = %d", status);
+        tsfn_ = nullptr;
+        return false;
+    }
+    /* keeps the loop alive only while tasks are pending */
+    (void)napi_unref_threadsafe_function(env_, tsfn_);
+    return true;
+}
+
+void CompletionChannel::Acquire(void)
+{
+    if (pending_++ == 0) {
+        (void)napi_ref_threadsafe_function(env_, tsfn_);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_++;
+}
+
+void CompletionChannel::Release(uint32_t count)
+{
+    pending_ -= count;
+    if ((count != 0) && (pending_ == 0) && (tsfn_ != nullptr)) {
+        (void)napi_unref_threadsafe_function(env_, tsfn_);
+    }
+}
+
+void CompletionChannel::Post(CertAsyncTask &&task)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_--;
+    finished_.push_back(std::move(task));
+    if (closed_) {
+        cond_.notify_all(); /* Close is waiting for the task to complete it */
+        return;
+    }
+    if (signaled_) {
+        return;
+    }
+    signaled_ = true;
+    /* called under the lock, so Close can not release the function in between */
+    napi_status status = napi_call_threadsafe_function(tsfn_, nullptr, napi_tsfn_nonblocking);
+    if (status != napi_ok) {
+        LOGE("call threadsafe function failed, status = %d", status);
+        signaled_ = false; /* the next finished task tries again */
+        stalled_ = true;
+    }
+}
+
+/* On the JS thread, hands the tasks whose wakeup failed to napi async work, unless a later wakeup is on its way. */
+void CompletionChannel::RequeueStalled(const char *name)
+{
+    std::vector<CertAsyncTask> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stalled_ || signaled_) {
+            return;
+        }
+        stalled_ = false;
+        tasks.swap(finished_);
+    }
+    for (CertAsyncTask &task : tasks) {
+        if (QueueFallbackWork(env_, name, nullptr, task.complete, task.data) != napi_ok) {
+            LOGE("requeue stalled task failed");
+            CompleteTask(env_, napi_generic_failure, task);
+        }
+    }
+    Release(static_cast<uint32_t>(tasks.size()));
+}
+
+void CompletionChannel::Drain(napi_env env, napi_value jsCb, void *context, void *data)
+{
+    (void)jsCb;
+    (void)data;
+    if (env == nullptr) {
+        return; /* the function is being released */
+    }
+    CompletionChannel *channel = static_cast<CompletionChannel *>(context);
+    std::vector<CertAsyncTask> tasks;
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex_);
+        tasks.swap(channel->finished_);
+        channel->signaled_ = false;
+        channel->stalled_ = false;
+    }
+
+    for (const CertAsyncTask &task : tasks) {
+        CompleteTask(env, napi_ok, task);
+    }
+    channel->Release(static_cast<uint32_t>(tasks.size()));
+}
+
+/* Process wide, the threads are started on first use and live as long as the process. */
+class CertWorkerPool {
+public:
+    static CertWorkerPool &GetInstance(void)
+    {
+        static CertWorkerPool *pool = new CertWorkerPool();
+        return *pool;
+    }
+
+    void Submit(CertAsyncTask &&task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!started_) {
+                for (uint32_t i = 0; i < WORKER_COUNT; ++i) {
+                    std::thread(&CertWorkerPool::Run, this).detach();
+                }
+                started_ = true;
+            }
+            tasks_.push_back(std::move(task));
+        }
+        cond_.notify_one();
+    }
+
+    /* takes the tasks of channel that no worker has started yet */
+    std::vector<CertAsyncTask> Cancel(const CompletionChannel *channel)
+    {
+        std::vector<CertAsyncTask> cancelled;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = tasks_.begin(); it != tasks_.end();) {
+            if (it->channel.get() == channel) {
+                cancelled.push_back(std::move(*it));
+                it = tasks_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return cancelled;
+    }
+
+private:
+    void Run(void)
+    {
+        while (true) {
+            CertAsyncTask task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return !tasks_.empty(); });
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task.execute(task.channel->GetEnv(), task.data);
+            std::shared_ptr<CompletionChannel> channel = task.channel;
+            channel->Post(std::move(task));
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<CertAsyncTask> tasks_;
+    bool started_ = false;
+};
+
+/*
+ * Called by the env cleanup hook, so the env can still be used. Every task is completed as Drain does: the ones no
+ * worker has started are executed here, the ones being executed are waited for.
+ */
+void CompletionChannel::Close(void)
+{
+    std::vector<CertAsyncTask> cancelled = CertWorkerPool::GetInstance().Cancel(this);
+    std::vector<CertAsyncTask> tasks;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_ = true;
+        running_ -= static_cast<uint32_t>(cancelled.size());
+        cond_.wait(lock, [this] { return running_ == 0; });
+        tasks.swap(finished_);
+    }
+    if (tsfn_ != nullptr) {
+        (void)napi_release_threadsafe_function(tsfn_, napi_tsfn_abort);
+        tsfn_ = nullptr;
+    }
+    for (CertAsyncTask &task : cancelled) {
+        task.execute(env_, task.data);
+        tasks.push_back(std::move(task));
+    }
+    for (const CertAsyncTask &task : tasks) {
+        CompleteTask(env_, napi_ok, task);
+    }
+}
+
+thread_local std::shared_ptr<CompletionChannel> g_channel = nullptr;
+
+void CloseChannel(void *arg)
+{
+    (void)arg;
+    if (g_channel != nullptr) {
+        g_channel->Close();
+        g_channel = nullptr;
+    }
+}
+
+CompletionChannel *GetChannel(napi_env env)
+{
+    if ((g_channel != nullptr) && (g_channel->GetEnv() == env)) {
+        return g_channel.get();
+    }
+    if (g_channel != nullptr) {
+        return nullptr; /* another env on this thread, leave it to napi async work */
+    }
+    std::shared_ptr<CompletionChannel> channel = std::make_shared<CompletionChannel>(env);
+    if (!channel->Init()) {
+        return nullptr;
+    }
+    if (napi_add_env_cleanup_hook(env, CloseChannel, nullptr) != napi_ok) {
+        channel->Close();
+        return nullptr;
+    }
+    g_channel = channel;
+    return g_channel.get();
+}
+
+struct CertFallbackWork {
+    napi_async_work work = nullptr;
+    napi_async_execute_callback execute = nullptr;
+    napi_async_complete_callback complete = nullptr;
+    void *data = nullptr;
+};
+
+napi_status QueueFallbackWork(napi_env env, const char *name, napi_async_execute_callback execute,
+    napi_async_complete_callback complete, void *data)
+{
+    CertFallbackWork *fallback = new (std::nothrow) CertFallbackWork { nullptr, execute, complete, data };
+    if (fallback == nullptr) {
+        LOGE("new fallback work failed");
+        return napi_generic_failure;
+    }
+    napi_status status = napi_create_async_work(
+        env, nullptr, CertGetResourceName(env, name),
+        [](napi_env env, void *arg) {
+            CertFallbackWork *work = static_cast<CertFallbackWork *>(arg);
+            if (work->execute != nullptr) { /* null for a task that the pool has executed */
+                work->execute(env, work->data);
+            }
+        },
+        [](napi_env env, napi_status status, void *arg) {
+            CertFallbackWork *work = static_cast<CertFallbackWork *>(arg);
+            work->complete(env, status, work->data);
+            napi_delete_async_work(env, work->work);
+            delete work;
+        },
+        static_cast<void *>(fallback),
+        &fallback->work);
+    if (status != napi_ok) {
+        delete fallback;
+        return status;
+    }
+    status = napi_queue_async_work(env, fallback->work);
+    if (status != napi_ok) {
+        napi_delete_async_work(env, fallback->work);
+        delete fallback;
+    }
+    return status;
+}
+} // namespace
+
+napi_status CertQueueAsyncWork(napi_env env, const char *name, napi_async_execute_callback execute,
+    napi_async_complete_callback complete, void *data)
+{
+    CompletionChannel *channel = (WORKER_COUNT == 0) ? nullptr : GetChannel(env);
+    if (channel == nullptr) {
+        return QueueFallbackWork(env, name, execute, complete, data);
+    }
+    channel->RequeueStalled(name);
+    channel->Acquire();
+    CertWorkerPool::GetInstance().Submit(CertAsyncTask { execute, complete, data, g_channel });
+    return napi_ok;
+}
+}  // namespace CertFramework
+}  // namespace OHOS
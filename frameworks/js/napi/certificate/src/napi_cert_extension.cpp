@@ -25,6 +25,8 @@
 #include "cf_result.h"
 
 #include "napi_cert_defines.h"
+#include "napi_cert_ctx_pool.h"
+#include "napi_cert_executor.h"
 #include "napi_cert_utils.h"
 #include "napi_common.h"
 #include "napi_object.h"
@@ -41,6 +43,14 @@ struct CfExtensionAsyncContext {
 };
 using ExtsAsyncContext = CfExtensionAsyncContext *;
 
+/* both contexts of one call come from a single pooled block, exts must stay the first member */
+struct CfExtensionAsyncBlock {
+    CfExtensionAsyncContext exts;
+    AsyncContext async;
+};
+
+static thread_local CertCtxPool g_ctxPool(sizeof(CfExtensionAsyncBlock));
+
 NapiCertExtension::NapiCertExtension(CfObject *object)
 {
     this->object_ = object;
@@ -55,21 +65,14 @@ NapiCertExtension::~NapiCertExtension()
 
 static ExtsAsyncContext NewExtsAsyncContext(void)
 {
-    ExtsAsyncContext extsAsyncCtx = static_cast<ExtsAsyncContext>(CfMalloc(sizeof(CfExtensionAsyncContext)));
-    if (extsAsyncCtx == nullptr) {
+    CfExtensionAsyncBlock *block = static_cast<CfExtensionAsyncBlock *>(g_ctxPool.Acquire());
+    if (block == nullptr) {
         CF_LOG_E("Failed to malloc extension async context");
         return nullptr;
     }
 
-    AsyncCtx asyncCtx = static_cast<AsyncCtx>(CfMalloc(sizeof(AsyncContext)));
-    if (asyncCtx == nullptr) {
-        CF_LOG_E("Failed to malloc async context");
-        CfFree(extsAsyncCtx);
-        return nullptr;
-    }
-
-    extsAsyncCtx->async = asyncCtx;
-    return extsAsyncCtx;
+    block->exts.async = &block->async;
+    return &block->exts;
 }
 
 static void DeleteExtsAsyncContext(napi_env env, ExtsAsyncContext &context)
@@ -79,23 +82,17 @@ static void DeleteExtsAsyncContext(napi_env env, ExtsAsyncContext &context)
     }
 
     if (context->async != nullptr) {
-        if (context->async->asyncWork != nullptr) {
-            napi_delete_async_work(env, context->async->asyncWork);
-            context->async->asyncWork = nullptr;
-        }
-
         if (context->async->callback != nullptr) {
             napi_delete_reference(env, context->async->callback);
             context->async->callback = nullptr;
         }
     }
-    CfFree(context->async);
 
     CfEncodingBlobDataFree(context->encodingBlob);
     CfFree(context->encodingBlob);
     context->encodingBlob = nullptr;
 
-    CfFree(context);
+    g_ctxPool.Release(context);
 }
 
 static napi_value ParseCreateExtsJSParams(napi_env env, napi_callback_info info, ExtsAsyncContext context)
@@ -175,16 +172,11 @@ static void CreateCertExtsComplete(napi_env env, napi_status status, void *data)
 
 static napi_value CreateCertExtsAsyncWork(napi_env env, ExtsAsyncContext context)
 {
-    napi_create_async_work(
-        env,
-        nullptr,
-        GetResourceName(env, "CreateCertExtsAsyncWork"),
+    CertQueueAsyncWork(
+        env, "CreateCertExtsAsyncWork",
         CreateCertExtsExecute,
         CreateCertExtsComplete,
-        static_cast<void *>(context),
-        &context->async->asyncWork);
-
-    napi_queue_async_work(env, context->async->asyncWork);
+        static_cast<void *>(context));
     if (context->async->asyncType == ASYNC_TYPE_PROMISE) {
         return context->async->promise;
     } else {
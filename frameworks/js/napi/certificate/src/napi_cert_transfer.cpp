@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "napi_cert_transfer.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cf_log.h"
+
+namespace OHOS {
+namespace CertFramework {
+namespace {
+struct CertDetached {
+    napi_env env = nullptr;
+    void *object = nullptr;
+    CertDetachedDeleter deleter = nullptr;
+};
+
+/* attach runs on the receiving thread, so the parked copies are shared by all threads */
+std::mutex g_detachedMutex;
+std::unordered_map<uintptr_t, CertDetached> g_detached; /* keyed by a counter, an address may be reused */
+std::unordered_set<napi_env> g_hookedEnvs;
+uintptr_t g_lastToken = 0;
+
+void FreeDetached(void *arg)
+{
+    napi_env env = static_cast<napi_env>(arg);
+    std::vector<CertDetached> dropped;
+    {
+        std::lock_guard<std::mutex> lock(g_detachedMutex);
+        g_hookedEnvs.erase(env);
+        for (auto it = g_detached.begin(); it != g_detached.end();) {
+            if (it->second.env == env) {
+                dropped.push_back(it->second);
+                it = g_detached.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (const CertDetached &detached : dropped) {
+        detached.deleter(detached.object);
+    }
+}
+
+bool HookEnv(napi_env env)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_detachedMutex);
+        if (!g_hookedEnvs.insert(env).second) {
+            return true;
+        }
+    }
+    /* the hook is added on the JS thread of env, the only one that inserts env */
+    if (napi_add_env_cleanup_hook(env, FreeDetached, env) != napi_ok) {
+        std::lock_guard<std::mutex> lock(g_detachedMutex);
+        g_hookedEnvs.erase(env);
+        return false;
+    }
+    return true;
+}
+}  // namespace
+
+void *CertParkDetached(napi_env env, void *object, CertDetachedDeleter deleter)
+{
+    if ((object == nullptr) || (deleter == nullptr)) {
+        return nullptr;
+    }
+    if (!HookEnv(env)) {
+        LOGE("add detached cleanup hook failed");
+        deleter(object);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(g_detachedMutex);
+    uintptr_t token = ++g_lastToken;
+    g_detached[token] = CertDetached { env, object, deleter };
+    return reinterpret_cast<void *>(token);
+}
+
+void *CertTakeDetached(void *token)
+{
+    std::lock_guard<std::mutex> lock(g_detachedMutex);
+    auto it = g_detached.find(reinterpret_cast<uintptr_t>(token));
+    if (it == g_detached.end()) {
+        return nullptr;
+    }
+    void *object = it->second.object;
+    g_detached.erase(it);
+    return object;
+}
+}  // namespace CertFramework
+}  // namespace OHOS
@@ -427,6 +427,53 @@ bool CertGetInt32FromJSParams(napi_env env, napi_value arg, int32_t &returnInt)
     return true;
 }
 
+bool CertGetSerialFromBigIntJSParams(napi_env env, napi_value arg, CfBlob &serial)
+{
+    napi_valuetype valueType = napi_undefined;
+    napi_typeof(env, arg, &valueType);
+    if (valueType != napi_bigint) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "param type is not bigint"));
+        LOGE("wrong argument type. expect bigint type. [Type]: %d", valueType);
+        return false;
+    }
+
+    size_t wordsCount = 0;
+    if ((napi_get_value_bigint_words(env, arg, nullptr, &wordsCount, nullptr) != napi_ok) || (wordsCount == 0) ||
+        (wordsCount > MAX_SN_BYTE_CNT / sizeof(uint64_t))) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "serial number is too long"));
+        LOGE("invalid bigint words count: %zu", wordsCount);
+        return false;
+    }
+    uint32_t size = static_cast<uint32_t>(wordsCount * sizeof(uint64_t));
+    uint64_t *words = static_cast<uint64_t *>(CfMalloc(size));
+    if (words == nullptr) {
+        LOGE("malloc words failed");
+        return false;
+    }
+    int signBit = 0;
+    if ((napi_get_value_bigint_words(env, arg, &signBit, &wordsCount, words) != napi_ok) || (signBit != 0)) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "serial number is negative"));
+        LOGE("get bigint words failed or bigint is negative");
+        CfFree(words);
+        return false;
+    }
+
+    /* words are little-endian, the serial blob is big-endian */
+    serial.data = static_cast<uint8_t *>(CfMalloc(size));
+    if (serial.data == nullptr) {
+        LOGE("malloc serial failed");
+        CfFree(words);
+        return false;
+    }
+    const uint8_t *wordsData = reinterpret_cast<const uint8_t *>(words);
+    for (uint32_t i = 0; i < size; ++i) {
+        serial.data[i] = wordsData[size - 1 - i];
+    }
+    serial.size = size;
+    CfFree(words);
+    return true;
+}
+
 bool CertGetCallbackFromJSParams(napi_env env, napi_value arg, napi_ref *returnCb)
 {
     napi_valuetype valueType = napi_undefined;
@@ -486,6 +533,35 @@ bool CertCheckArgsCount(napi_env env, size_t argc, size_t expectedCount, bool is
     return true;
 }
 
+bool CertGetOptionalEncodingFormat(napi_env env, size_t argc, napi_value *argv, int32_t &format, size_t &argIndex)
+{
+    format = CF_FORMAT_DER;
+    argIndex = PARAM0;
+    if (argc == 0) {
+        return true;
+    }
+    napi_valuetype valueType = napi_undefined;
+    napi_typeof(env, argv[PARAM0], &valueType);
+    if (valueType != napi_number) {
+        if (argc > ARGS_SIZE_ONE) {
+            napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "param type is not number"));
+            LOGE("wrong argument type. expect encoding format. [Type]: %d", valueType);
+            return false;
+        }
+        return true;
+    }
+    if (!CertGetInt32FromJSParams(env, argv[PARAM0], format)) {
+        return false;
+    }
+    if ((format != CF_FORMAT_DER) && (format != CF_FORMAT_PEM)) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "invalid encoding format"));
+        LOGE("invalid encoding format: %d", format);
+        return false;
+    }
+    argIndex = PARAM1;
+    return true;
+}
+
 AsyncType GetAsyncType(napi_env env, size_t argc, size_t maxCount, napi_value arg)
 {
     if (argc == (maxCount - 1)) { /* inner caller func: maxCount is bigger than 1 */
@@ -503,6 +579,44 @@ AsyncType GetAsyncType(napi_env env, size_t argc, size_t maxCount, napi_value ar
     return ASYNC_TYPE_CALLBACK;
 }
 
+/* Native overhead of the wrapped objects, measured with openssl 3. */
+constexpr int64_t CERT_DECODED_BASE_SIZE = 16 * 1024; /* caches of a decoded X509 besides its fields */
+constexpr int64_t CRL_DECODED_BASE_SIZE = 2 * 1024;
+constexpr int64_t DECODED_SIZE_PER_DER_BYTE = 8;
+constexpr int64_t CRL_ENTRY_SIZE = 512; /* entries share the CRL they came from, only their own part counts */
+
+/*
+ * Rough native memory behind a wrapper, so the JS GC sees large native objects. It is derived from the DER length
+ * of the decoded object, so the same cert or CRL counts the same whether it was given as PEM or DER.
+ */
+int64_t CertEstimateNativeSize(CertNativeObjType type, size_t derLen)
+{
+    int64_t len = static_cast<int64_t>(derLen);
+    switch (type) {
+        case CERT_NATIVE_OBJ_CERT:
+            /* the cert object keeps its own DER copy besides the decoded X509 */
+            return CERT_DECODED_BASE_SIZE + (DECODED_SIZE_PER_DER_BYTE + 1) * len;
+        case CERT_NATIVE_OBJ_CRL:
+            return CRL_DECODED_BASE_SIZE + DECODED_SIZE_PER_DER_BYTE * len;
+        case CERT_NATIVE_OBJ_CRL_ENTRY:
+            return CRL_ENTRY_SIZE;
+        default:
+            return 0;
+    }
+}
+
+void CertAdjustExternalMemory(napi_env env, int64_t change)
+{
+    if (change == 0) {
+        return;
+    }
+    int64_t adjustedValue = 0;
+    napi_status status = napi_adjust_external_memory(env, change, &adjustedValue);
+    if (status != napi_ok) {
+        LOGE("adjust external memory failed, status = %d", status);
+    }
+}
+
 napi_value CertGetResourceName(napi_env env, const char *name)
 {
     napi_value resourceName = nullptr;
@@ -36,6 +36,7 @@ static napi_value CreateEncodingFormat(napi_env env)
 
     CertAddUint32Property(env, encodingFormat, "FORMAT_DER", CF_FORMAT_DER);
     CertAddUint32Property(env, encodingFormat, "FORMAT_PEM", CF_FORMAT_PEM);
+    CertAddUint32Property(env, encodingFormat, "FORMAT_AUTO", CF_FORMAT_AUTO);
 
     return encodingFormat;
 }
@@ -87,6 +88,12 @@ static napi_value CreateCertItemType(napi_env env)
     CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_ISSUER_UNIQUE_ID", CF_ITEM_ISSUER_UNIQUE_ID);
     CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_SUBJECT_UNIQUE_ID", CF_ITEM_SUBJECT_UNIQUE_ID);
     CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_EXTENSIONS", CF_ITEM_EXTENSIONS);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_VERSION", CF_ITEM_VERSION);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_SERIAL_NUMBER", CF_ITEM_SERIAL_NUMBER);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_ISSUER_NAME", CF_ITEM_ISSUE_NAME);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_SUBJECT_NAME", CF_ITEM_SUBJECT_NAME);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_NOT_BEFORE", CF_ITEM_NOT_BEFORE);
+    CertAddUint32Property(env, certItemType, "CERT_ITEM_TYPE_NOT_AFTER", CF_ITEM_NOT_AFTER);
 
     return certItemType;
 }
@@ -43,6 +43,7 @@ constexpr size_t PARAM_INDEX_3 = 3;
 constexpr size_t PARAM_INDEX_4 = 4;
 
 constexpr size_t PARAM_COUNT_CERT_GET_ITEM = 1;
+constexpr size_t PARAM_COUNT_CERT_GET_ITEM_FORMAT = 2;
 constexpr size_t PARAM_COUNT_EXT_GET_OIDS = 1;
 constexpr size_t PARAM_COUNT_EXT_GET_ENTRY = 2;
 constexpr size_t PARAM_COUNT_EXT_GET_ITEM = 0;
@@ -70,6 +71,7 @@ struct CfResultMap {
 
 const struct CfInputParamsMap INPUT_PARAMS_MAP[] = {
     { OPERATION_TYPE_GET, CF_GET_TYPE_CERT_ITEM, PARAM_COUNT_CERT_GET_ITEM, { napi_number } },
+    { OPERATION_TYPE_GET, CF_GET_TYPE_CERT_ITEM, PARAM_COUNT_CERT_GET_ITEM_FORMAT, { napi_number, napi_number } },
     { OPERATION_TYPE_GET, CF_GET_TYPE_EXT_OIDS, PARAM_COUNT_EXT_GET_OIDS, { napi_number } },
     { OPERATION_TYPE_GET, CF_GET_TYPE_EXT_ENTRY, PARAM_COUNT_EXT_GET_ENTRY, { napi_number, napi_object } },
     { OPERATION_TYPE_GET, CF_GET_TYPE_EXT_ITEM, PARAM_COUNT_EXT_GET_ITEM, { napi_undefined } },
@@ -261,14 +263,14 @@ static int32_t CheckParamsNapiType(napi_env env, napi_value *argv, size_t argc,
 static int32_t CheckInputParams(napi_env env, napi_value *argv, size_t argc, int32_t opType, int32_t typeValue)
 {
     for (uint32_t i = 0; i < sizeof(INPUT_PARAMS_MAP) / sizeof(INPUT_PARAMS_MAP[0]); ++i) {
-        if ((opType == INPUT_PARAMS_MAP[i].opType) && (typeValue == INPUT_PARAMS_MAP[i].type)) {
-            if (CheckParamsNapiType(env, argv, argc, INPUT_PARAMS_MAP[i].expectedType,
-                INPUT_PARAMS_MAP[i].paramsCnt) != CF_SUCCESS) {
-                return CF_INVALID_PARAMS;
-            }
-            return CF_SUCCESS;
+        /* a type may accept several argument lists, the one with the same count is checked */
+        if ((opType == INPUT_PARAMS_MAP[i].opType) && (typeValue == INPUT_PARAMS_MAP[i].type) &&
+            (argc == INPUT_PARAMS_MAP[i].paramsCnt)) {
+            return CheckParamsNapiType(env, argv, argc, INPUT_PARAMS_MAP[i].expectedType,
+                INPUT_PARAMS_MAP[i].paramsCnt);
         }
     }
+    CF_LOG_E("params count invalid");
     return CF_INVALID_PARAMS;
 }
 
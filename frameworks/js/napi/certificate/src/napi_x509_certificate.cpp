@@ -23,6 +23,9 @@
 #include "cf_object_base.h"
 #include "cf_result.h"
 #include "napi_cert_defines.h"
+#include "napi_cert_ctx_pool.h"
+#include "napi_cert_executor.h"
+#include "napi_cert_transfer.h"
 #include "napi_pub_key.h"
 #include "napi_cert_utils.h"
 
@@ -38,7 +41,6 @@ struct CfCtx {
     napi_value promise = nullptr;
     napi_ref callback = nullptr;
     napi_deferred deferred = nullptr;
-    napi_async_work asyncWork = nullptr;
 
     CfEncodingBlob *encodingBlob = nullptr;
     NapiX509Certificate *certClass = nullptr;
@@ -49,20 +51,20 @@ struct CfCtx {
     HcfX509Certificate *cert = nullptr;
     CfObject *object = nullptr;
     CfEncodingBlob *encoded = nullptr;
+    int32_t encodingFormat = CF_FORMAT_DER;
+    size_t derLen = 0;
 };
 
+static thread_local CertCtxPool g_ctxPool(sizeof(CfCtx));
+
 NapiX509Certificate::NapiX509Certificate(HcfX509Certificate *x509Cert, CfObject *object)
+    : x509Cert_(x509Cert, [](HcfX509Certificate *cert) { CfObjDestroy(cert); }),
+      certObject_(object, [](CfObject *obj) {
+          if (obj != nullptr) {
+              obj->destroy(&obj);
+          }
+      })
 {
-    this->x509Cert_ = x509Cert;
-    this->certObject_ = object;
-}
-
-NapiX509Certificate::~NapiX509Certificate()
-{
-    CfObjDestroy(this->x509Cert_);
-    if (this->certObject_ != nullptr) {
-        this->certObject_->destroy(&(this->certObject_));
-    }
 }
 
 static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
@@ -71,10 +73,6 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
         return;
     }
 
-    if (context->asyncWork != nullptr) {
-        napi_delete_async_work(env, context->asyncWork);
-    }
-
     if (context->callback != nullptr) {
         napi_delete_reference(env, context->callback);
     }
@@ -87,7 +85,7 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
     CfFree(context->encoded);
     context->encoded = nullptr;
 
-    CfFree(context);
+    g_ctxPool.Release(context);
 }
 
 static void ReturnCallbackResult(napi_env env, CfCtx *context, napi_value result)
@@ -171,7 +169,8 @@ static void GetEncodedExecute(napi_env env, void *data)
         context->errMsg = "malloc encoding blob failed";
         return;
     }
-    context->errCode = cert->base.getEncoded(&(cert->base), encodingBlob);
+    context->errCode = cert->getEncodedWithFormat(cert,
+        static_cast<enum CfEncodingFormat>(context->encodingFormat), encodingBlob);
     if (context->errCode != CF_SUCCESS) {
         LOGE("get cert encoded failed!");
         context->errMsg = "get cert encoded failed";
@@ -202,7 +201,7 @@ napi_value NapiX509Certificate::Verify(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -224,14 +223,11 @@ napi_value NapiX509Certificate::Verify(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "Verify"),
+    CertQueueAsyncWork(
+        env, "Verify",
         VerifyExecute,
         VerifyComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -241,34 +237,37 @@ napi_value NapiX509Certificate::Verify(napi_env env, napi_callback_info info)
 
 napi_value NapiX509Certificate::GetEncoded(napi_env env, napi_callback_info info)
 {
-    size_t argc = ARGS_SIZE_ONE;
-    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    size_t argc = ARGS_SIZE_TWO;
+    napi_value argv[ARGS_SIZE_TWO] = { nullptr };
     napi_value thisVar = nullptr;
     napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
-    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, false)) {
+    int32_t encodingFormat = CF_FORMAT_DER;
+    size_t argIndex = PARAM0;
+    if ((argc > ARGS_SIZE_TWO) || !CertGetOptionalEncodingFormat(env, argc, argv, encodingFormat, argIndex)) {
+        return nullptr;
+    }
+    if (!CertCheckArgsCount(env, argc - argIndex, ARGS_SIZE_ONE, false)) {
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
     }
     context->certClass = this;
+    context->encodingFormat = encodingFormat;
 
-    if (!CreateCallbackAndPromise(env, context, argc, ARGS_SIZE_ONE, argv[PARAM0])) {
+    if (!CreateCallbackAndPromise(env, context, argc - argIndex, ARGS_SIZE_ONE, argv[argIndex])) {
         FreeCryptoFwkCtx(env, context);
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "GetEncoded"),
+    CertQueueAsyncWork(
+        env, "GetEncoded",
         GetEncodedExecute,
         GetEncodedComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -645,6 +644,59 @@ napi_value NapiX509Certificate::GetIssuerAlternativeNames(napi_env env, napi_cal
     return returnValue;
 }
 
+napi_value NapiX509Certificate::Equals(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGS_SIZE_ONE;
+    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, true)) {
+        return nullptr;
+    }
+
+    /* unwrap only objects of this class, the native of another class would be misread */
+    napi_value constructor = nullptr;
+    bool isInstance = false;
+    napi_get_reference_value(env, classRef_, &constructor);
+    napi_instanceof(env, argv[PARAM0], constructor, &isInstance);
+    NapiX509Certificate *napiOther = nullptr;
+    if (isInstance) {
+        napi_unwrap(env, argv[PARAM0], reinterpret_cast<void **>(&napiOther));
+    }
+    if (napiOther == nullptr) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "the other object is not a X509Cert"));
+        LOGE("the other object is not a X509Cert!");
+        return nullptr;
+    }
+
+    HcfX509Certificate *cert = GetX509Cert();
+    bool isEqual = false;
+    CfResult ret = cert->equals(cert, napiOther->GetX509Cert(), &isEqual);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "cert equals failed"));
+        LOGE("cert equals failed!");
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_get_boolean(env, isEqual, &result);
+    return result;
+}
+
+napi_value NapiX509Certificate::HashCode(napi_env env, napi_callback_info info)
+{
+    HcfX509Certificate *cert = GetX509Cert();
+    uint32_t hashCode = 0;
+    CfResult ret = cert->hashCode(cert, &hashCode);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "cert get hash code failed"));
+        LOGE("cert get hash code failed!");
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_create_uint32(env, hashCode, &result);
+    return result;
+}
+
 static napi_value NapiVerify(napi_env env, napi_callback_info info)
 {
     napi_value thisVar = nullptr;
@@ -892,6 +944,32 @@ static napi_value NapiGetIssuerAlternativeNames(napi_env env, napi_callback_info
     return x509Cert->GetIssuerAlternativeNames(env, info);
 }
 
+static napi_value NapiEquals(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Certificate *x509Cert = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Cert));
+    if (x509Cert == nullptr) {
+        LOGE("x509Cert is nullptr!");
+        return nullptr;
+    }
+    return x509Cert->Equals(env, info);
+}
+
+static napi_value NapiHashCode(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Certificate *x509Cert = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Cert));
+    if (x509Cert == nullptr) {
+        LOGE("x509Cert is nullptr!");
+        return nullptr;
+    }
+    return x509Cert->HashCode(env, info);
+}
+
 static napi_value NapiGetItem(napi_env env, napi_callback_info info)
 {
     napi_value thisVar = nullptr;
@@ -923,6 +1001,14 @@ void NapiX509Certificate::CreateX509CertExecute(napi_env env, void *data)
     context->errCode = CfCreate(CF_OBJ_TYPE_CERT, context->encodingBlob, &context->object);
     if (context->errCode != CF_SUCCESS) {
         context->errMsg = "create certObj failed";
+        return;
+    }
+
+    /* the input may be PEM, the native size follows the DER of the decoded cert */
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (context->cert->base.getEncoded(&(context->cert->base), &der) == CF_SUCCESS) {
+        context->derLen = der.len;
+        CfEncodingBlobDataFree(&der);
     }
 }
 
@@ -949,14 +1035,8 @@ void NapiX509Certificate::CreateX509CertComplete(napi_env env, napi_status statu
         FreeCryptoFwkCtx(env, context);
         return;
     }
-    napi_wrap(
-        env, instance, x509CertClass,
-        [](napi_env env, void *data, void *hint) {
-            NapiX509Certificate *certClass = static_cast<NapiX509Certificate *>(data);
-            delete certClass;
-            return;
-        },
-        nullptr, nullptr);
+    x509CertClass->SetNativeSize(CertEstimateNativeSize(CERT_NATIVE_OBJ_CERT, context->derLen));
+    (void)WrapX509Cert(env, instance, x509CertClass);
     ReturnResult(env, context, instance);
     FreeCryptoFwkCtx(env, context);
 }
@@ -971,7 +1051,7 @@ napi_value NapiX509Certificate::NapiCreateX509Cert(napi_env env, napi_callback_i
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -987,14 +1067,11 @@ napi_value NapiX509Certificate::NapiCreateX509Cert(napi_env env, napi_callback_i
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "CreateX509Cert"),
+    CertQueueAsyncWork(
+        env, "CreateX509Cert",
         CreateX509CertExecute,
         CreateX509CertComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -1036,6 +1113,8 @@ void NapiX509Certificate::DefineX509CertJSClass(napi_env env, napi_value exports
         DECLARE_NAPI_FUNCTION("getBasicConstraints", NapiGetBasicConstraints),
         DECLARE_NAPI_FUNCTION("getSubjectAltNames", NapiGetSubjectAlternativeNames),
         DECLARE_NAPI_FUNCTION("getIssuerAltNames", NapiGetIssuerAlternativeNames),
+        DECLARE_NAPI_FUNCTION("equals", NapiEquals),
+        DECLARE_NAPI_FUNCTION("hashCode", NapiHashCode),
         DECLARE_NAPI_FUNCTION("getItem", NapiGetItem),
     };
     napi_value constructor = nullptr;
@@ -1044,6 +1123,61 @@ void NapiX509Certificate::DefineX509CertJSClass(napi_env env, napi_value exports
     napi_create_reference(env, constructor, 1, &classRef_);
 }
 
+static void *DetachX509Cert(napi_env env, void *value, void *hint)
+{
+    /* the receiving worker gets its own wrapper holding another reference to the same natives */
+    NapiX509Certificate *x509CertClass =
+        new (std::nothrow) NapiX509Certificate(*static_cast<NapiX509Certificate *>(value));
+    if (x509CertClass == nullptr) {
+        LOGE("Failed to copy x509Cert class");
+        return nullptr;
+    }
+    x509CertClass->SetNativeSize(0); /* the natives are reported by the env that created them only */
+    return CertParkDetached(env, x509CertClass,
+        [](void *object) { delete static_cast<NapiX509Certificate *>(object); });
+}
+
+static napi_value AttachX509Cert(napi_env env, void *value, void *hint)
+{
+    NapiX509Certificate *x509CertClass = static_cast<NapiX509Certificate *>(CertTakeDetached(value));
+    if (x509CertClass == nullptr) {
+        LOGE("Failed to share x509Cert class");
+        return nullptr;
+    }
+    napi_value instance = NapiX509Certificate::CreateX509Cert(env);
+    if ((instance == nullptr) || (NapiX509Certificate::WrapX509Cert(env, instance, x509CertClass) != napi_ok)) {
+        LOGE("Failed to attach x509Cert class");
+        delete x509CertClass;
+        return nullptr;
+    }
+    return instance;
+}
+
+/* Hands x509CertClass to instance, which may then be posted to other workers without reparsing. */
+napi_status NapiX509Certificate::WrapX509Cert(napi_env env, napi_value instance, NapiX509Certificate *x509CertClass)
+{
+    napi_status status = napi_wrap(
+        env, instance, x509CertClass,
+        [](napi_env env, void *data, void *hint) {
+            NapiX509Certificate *certClass = static_cast<NapiX509Certificate *>(data);
+            CertAdjustExternalMemory(env, -certClass->GetNativeSize());
+            delete certClass;
+            return;
+        },
+        nullptr, nullptr);
+    if (status != napi_ok) {
+        LOGE("Failed to wrap x509Cert class");
+        return status;
+    }
+    CertAdjustExternalMemory(env, x509CertClass->GetNativeSize());
+    status = napi_coerce_to_native_binding_object(env, instance, DetachX509Cert, AttachX509Cert, x509CertClass,
+        nullptr);
+    if (status != napi_ok) {
+        LOGE("x509Cert can not be sent to other workers");
+    }
+    return napi_ok;
+}
+
 napi_value NapiX509Certificate::CreateX509Cert(napi_env env)
 {
     napi_value constructor = nullptr;
@@ -23,6 +23,9 @@
 #include "cf_object_base.h"
 #include "cf_result.h"
 #include "napi_cert_defines.h"
+#include "napi_cert_ctx_pool.h"
+#include "napi_cert_executor.h"
+#include "napi_cert_transfer.h"
 #include "napi_pub_key.h"
 #include "napi_cert_utils.h"
 #include "napi_x509_certificate.h"
@@ -37,7 +40,6 @@ struct CfCtx {
     napi_value promise = nullptr;
     napi_ref callback = nullptr;
     napi_deferred deferred = nullptr;
-    napi_async_work asyncWork = nullptr;
 
     CfEncodingBlob *encodingBlob = nullptr;
     NapiX509Crl *crlClass = nullptr;
@@ -52,18 +54,18 @@ struct CfCtx {
     CfEncodingBlob *encoded = nullptr;
     CfBlob *blob = nullptr;
     CfArray *array = nullptr;
+    int32_t encodingFormat = CF_FORMAT_DER;
+    size_t derLen = 0;
 };
 
+static thread_local CertCtxPool g_ctxPool(sizeof(CfCtx));
+
 static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
 {
     if (context == nullptr) {
         return;
     }
 
-    if (context->asyncWork != nullptr) {
-        napi_delete_async_work(env, context->asyncWork);
-    }
-
     if (context->callback != nullptr) {
         napi_delete_reference(env, context->callback);
     }
@@ -87,7 +89,7 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
         context->array = nullptr;
     }
 
-    CfFree(context);
+    g_ctxPool.Release(context);
 }
 
 static void ReturnCallbackResult(napi_env env, CfCtx *context, napi_value result)
@@ -142,13 +144,8 @@ static bool CreateCallbackAndPromise(napi_env env, CfCtx *context, size_t argc,
 }
 
 NapiX509Crl::NapiX509Crl(HcfX509Crl *x509Crl)
+    : x509Crl_(x509Crl, [](HcfX509Crl *crl) { CfObjDestroy(crl); })
 {
-    this->x509Crl_ = x509Crl;
-}
-
-NapiX509Crl::~NapiX509Crl()
-{
-    CfObjDestroy(this->x509Crl_);
 }
 
 static void GetEncodedExecute(napi_env env, void *data)
@@ -162,7 +159,8 @@ static void GetEncodedExecute(napi_env env, void *data)
         context->errMsg = "malloc encoding blob failed";
         return;
     }
-    context->errCode = x509Crl->getEncoded(x509Crl, encodingBlob);
+    context->errCode = x509Crl->getEncodedWithFormat(x509Crl,
+        static_cast<enum CfEncodingFormat>(context->encodingFormat), encodingBlob);
     if (context->errCode != CF_SUCCESS) {
         LOGE("get encoded failed!");
         context->errMsg = "get encoded failed";
@@ -220,6 +218,23 @@ void GetRevokedCertificatesExecute(napi_env env, void *data)
     context->array = array;
 }
 
+static void WrapX509CrlEntry(napi_env env, napi_value instance, NapiX509CrlEntry *x509CrlEntryClass)
+{
+    napi_status status = napi_wrap(
+        env, instance, x509CrlEntryClass,
+        [](napi_env env, void *data, void *hint) {
+            NapiX509CrlEntry *x509CrlEntryClass = static_cast<NapiX509CrlEntry *>(data);
+            CertAdjustExternalMemory(env, -x509CrlEntryClass->GetNativeSize());
+            delete x509CrlEntryClass;
+            return;
+        },
+        nullptr, nullptr);
+    if (status == napi_ok) {
+        x509CrlEntryClass->SetNativeSize(CertEstimateNativeSize(CERT_NATIVE_OBJ_CRL_ENTRY, 0));
+        CertAdjustExternalMemory(env, x509CrlEntryClass->GetNativeSize());
+    }
+}
+
 static napi_value GenerateCrlEntryArray(napi_env env, CfArray *array)
 {
     if (array == nullptr) {
@@ -243,14 +258,7 @@ static napi_value GenerateCrlEntryArray(napi_env env, CfArray *array)
             CfObjDestroy(entry);
             return nullptr; /* the C++ objects wrapped will be automatically released by scope manager. */
         }
-        napi_wrap(
-            env, instance, x509CrlEntryClass,
-            [](napi_env env, void *data, void *hint) {
-                NapiX509CrlEntry *x509CrlEntryClass = static_cast<NapiX509CrlEntry *>(data);
-                delete x509CrlEntryClass;
-                return;
-            },
-            nullptr, nullptr);
+        WrapX509CrlEntry(env, instance, x509CrlEntryClass);
         napi_set_element(env, returnArray, i, instance);
     }
     return returnArray;
@@ -306,34 +314,37 @@ napi_value NapiX509Crl::GetType(napi_env env, napi_callback_info info)
 
 napi_value NapiX509Crl::GetEncoded(napi_env env, napi_callback_info info)
 {
-    size_t argc = ARGS_SIZE_ONE;
-    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    size_t argc = ARGS_SIZE_TWO;
+    napi_value argv[ARGS_SIZE_TWO] = { nullptr };
     napi_value thisVar = nullptr;
     napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
-    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, false)) {
+    int32_t encodingFormat = CF_FORMAT_DER;
+    size_t argIndex = PARAM0;
+    if ((argc > ARGS_SIZE_TWO) || !CertGetOptionalEncodingFormat(env, argc, argv, encodingFormat, argIndex)) {
+        return nullptr;
+    }
+    if (!CertCheckArgsCount(env, argc - argIndex, ARGS_SIZE_ONE, false)) {
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
     }
     context->crlClass = this;
+    context->encodingFormat = encodingFormat;
 
-    if (!CreateCallbackAndPromise(env, context, argc, ARGS_SIZE_ONE, argv[PARAM0])) {
+    if (!CreateCallbackAndPromise(env, context, argc - argIndex, ARGS_SIZE_ONE, argv[argIndex])) {
         FreeCryptoFwkCtx(env, context);
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "GetEncoded"),
+    CertQueueAsyncWork(
+        env, "GetEncoded",
         GetEncodedExecute,
         GetEncodedComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -359,7 +370,7 @@ napi_value NapiX509Crl::Verify(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -372,14 +383,11 @@ napi_value NapiX509Crl::Verify(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "Verify"),
+    CertQueueAsyncWork(
+        env, "Verify",
         VerifyExecute,
         VerifyComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -497,14 +505,42 @@ napi_value NapiX509Crl::GetRevokedCertificate(napi_env env, napi_callback_info i
         CfObjDestroy(crlEntry);
         return nullptr;
     }
-    napi_wrap(
-        env, instance, x509CrlEntryClass,
-        [](napi_env env, void *data, void *hint) {
-            NapiX509CrlEntry *x509CrlEntryClass = static_cast<NapiX509CrlEntry *>(data);
-            delete x509CrlEntryClass;
-            return;
-        },
-        nullptr, nullptr);
+    WrapX509CrlEntry(env, instance, x509CrlEntryClass);
+    return instance;
+}
+
+napi_value NapiX509Crl::GetRevokedCertificateWithSerial(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGS_SIZE_ONE;
+    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, true)) {
+        return nullptr;
+    }
+    CfBlob serial = { 0, nullptr };
+    if (!CertGetSerialFromBigIntJSParams(env, argv[PARAM0], serial)) {
+        LOGE("get serial failed!");
+        return nullptr;
+    }
+    HcfX509Crl *x509Crl = GetX509Crl();
+    HcfX509CrlEntry *crlEntry = nullptr;
+    CfResult ret = x509Crl->getRevokedCertWithSerial(x509Crl, &serial, &crlEntry);
+    CfBlobDataFree(&serial);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "get revoked cert with serial failed!"));
+        LOGE("get revoked cert with serial failed!");
+        return nullptr;
+    }
+    napi_value instance = NapiX509CrlEntry::CreateX509CrlEntry(env);
+    NapiX509CrlEntry *x509CrlEntryClass = new (std::nothrow) NapiX509CrlEntry(crlEntry);
+    if (x509CrlEntryClass == nullptr) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_ERR_MALLOC, "Failed to create a x509CrlEntry class"));
+        LOGE("Failed to create a x509CrlEntry class");
+        CfObjDestroy(crlEntry);
+        return nullptr;
+    }
+    WrapX509CrlEntry(env, instance, x509CrlEntryClass);
     return instance;
 }
 
@@ -544,14 +580,7 @@ napi_value NapiX509Crl::GetRevokedCertificateWithCert(napi_env env, napi_callbac
         CfObjDestroy(crlEntry);
         return nullptr;
     }
-    napi_wrap(
-        env, instance, x509CrlEntryClass,
-        [](napi_env env, void *data, void *hint) {
-            NapiX509CrlEntry *x509CrlEntryClass = static_cast<NapiX509CrlEntry *>(data);
-            delete x509CrlEntryClass;
-            return;
-        },
-        nullptr, nullptr);
+    WrapX509CrlEntry(env, instance, x509CrlEntryClass);
     return instance;
 }
 
@@ -565,7 +594,7 @@ napi_value NapiX509Crl::GetRevokedCertificates(napi_env env, napi_callback_info
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -577,14 +606,11 @@ napi_value NapiX509Crl::GetRevokedCertificates(napi_env env, napi_callback_info
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "GetRevokedCertificates"),
+    CertQueueAsyncWork(
+        env, "GetRevokedCertificates",
         GetRevokedCertificatesExecute,
         GetRevokedCertificatesComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -592,6 +618,141 @@ napi_value NapiX509Crl::GetRevokedCertificates(napi_env env, napi_callback_info
     }
 }
 
+static napi_value ConvertColumnToTypedArray(napi_env env, CfBlob *column, napi_typedarray_type type, size_t elemSize)
+{
+    size_t length = column->size / elemSize;
+    napi_value buffer = nullptr;
+    napi_status status = napi_ok;
+    if (column->size == 0) {
+        status = napi_create_arraybuffer(env, 0, nullptr, &buffer);
+    } else {
+        /* the column memory is handed over to the array buffer, so large CRLs are not copied again */
+        status = napi_create_external_arraybuffer(env, column->data, column->size,
+            [](napi_env env, void *data, void *hint) { CfFree(data); }, nullptr, &buffer);
+        if (status == napi_ok) {
+            column->data = nullptr;
+            column->size = 0;
+        }
+    }
+    if (status != napi_ok) {
+        LOGE("create column array buffer failed!");
+        return nullptr;
+    }
+    napi_value typedArray = nullptr;
+    if (napi_create_typedarray(env, type, length, buffer, 0, &typedArray) != napi_ok) {
+        LOGE("create column typed array failed!");
+        return nullptr;
+    }
+    return typedArray;
+}
+
+static napi_value ConvertColumnsToNapiValue(napi_env env, HcfX509CrlColumns *columns)
+{
+    napi_value serialOffsets = ConvertColumnToTypedArray(env, &columns->serialOffsets, napi_uint32_array,
+        sizeof(uint32_t));
+    napi_value serials = ConvertColumnToTypedArray(env, &columns->serials, napi_uint8_array, sizeof(uint8_t));
+    napi_value revocationDates = ConvertColumnToTypedArray(env, &columns->revocationDates, napi_bigint64_array,
+        sizeof(int64_t));
+    napi_value reasons = ConvertColumnToTypedArray(env, &columns->reasons, napi_uint8_array, sizeof(uint8_t));
+    if ((serialOffsets == nullptr) || (serials == nullptr) || (revocationDates == nullptr) || (reasons == nullptr)) {
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_create_object(env, &result);
+    CertAddUint32Property(env, result, CERT_TAG_COUNT.c_str(), columns->count);
+    napi_set_named_property(env, result, "serialOffsets", serialOffsets);
+    napi_set_named_property(env, result, "serials", serials);
+    napi_set_named_property(env, result, "revocationDates", revocationDates);
+    napi_set_named_property(env, result, "reasons", reasons);
+    return result;
+}
+
+napi_value NapiX509Crl::GetRevokedColumns(napi_env env, napi_callback_info info)
+{
+    HcfX509Crl *x509Crl = GetX509Crl();
+    HcfX509CrlColumns columns = { 0 };
+    CfResult ret = x509Crl->getRevokedColumns(x509Crl, &columns);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "get revoked columns failed"));
+        LOGE("getRevokedColumns failed!");
+        return nullptr;
+    }
+    napi_value result = ConvertColumnsToNapiValue(env, &columns);
+    HcfX509CrlColumnsFree(&columns);
+    if (result == nullptr) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_ERR_MALLOC, "convert revoked columns failed"));
+    }
+    return result;
+}
+
+static napi_value ConvertSerialsToNapiValue(napi_env env, const CfBlobArray *serials)
+{
+    napi_value returnArray = nullptr;
+    if (napi_create_array(env, &returnArray) != napi_ok) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_ERR_MALLOC, "create serial array failed"));
+        LOGE("create serial array failed!");
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < serials->count; i++) {
+        napi_value serial = ConvertBlobToBigIntWords(env, serials->data[i]);
+        if (serial == nullptr) {
+            napi_throw(env, CertGenerateBusinessError(env, CF_ERR_MALLOC, "convert revoked serial failed"));
+            LOGE("convert revoked serial %u failed!", i);
+            return nullptr;
+        }
+        napi_set_element(env, returnArray, i, serial);
+    }
+    return returnArray;
+}
+
+napi_value NapiX509Crl::GetRevokedDiff(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGS_SIZE_ONE;
+    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, true)) {
+        return nullptr;
+    }
+
+    /* unwrap only objects of this class, the native of another class would be misread */
+    napi_value constructor = nullptr;
+    bool isInstance = false;
+    napi_get_reference_value(env, classRef_, &constructor);
+    napi_instanceof(env, argv[PARAM0], constructor, &isInstance);
+    NapiX509Crl *napiNewerCrl = nullptr;
+    if (isInstance) {
+        napi_unwrap(env, argv[PARAM0], reinterpret_cast<void **>(&napiNewerCrl));
+    }
+    if (napiNewerCrl == nullptr) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "the newer object is not a X509Crl"));
+        LOGE("the newer object is not a X509Crl!");
+        return nullptr;
+    }
+
+    HcfX509Crl *x509Crl = GetX509Crl();
+    CfBlobArray added = { nullptr, 0 };
+    CfBlobArray removed = { nullptr, 0 };
+    CfResult ret = x509Crl->getRevokedDiff(x509Crl, napiNewerCrl->GetX509Crl(), &added, &removed);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "get revoked diff failed"));
+        LOGE("getRevokedDiff failed!");
+        return nullptr;
+    }
+    napi_value addedArray = ConvertSerialsToNapiValue(env, &added);
+    napi_value removedArray = (addedArray == nullptr) ? nullptr : ConvertSerialsToNapiValue(env, &removed);
+    CfFree(added.data); /* the serials are packed behind the blobs */
+    CfFree(removed.data);
+    if ((addedArray == nullptr) || (removedArray == nullptr)) {
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_create_object(env, &result);
+    napi_set_named_property(env, result, "added", addedArray);
+    napi_set_named_property(env, result, "removed", removedArray);
+    return result;
+}
+
 napi_value NapiX509Crl::GetTBSCertList(napi_env env, napi_callback_info info)
 {
     HcfX509Crl *x509Crl = GetX509Crl();
@@ -709,6 +870,59 @@ napi_value NapiX509Crl::GetSigAlgParams(napi_env env, napi_callback_info info)
     return returnBlob;
 }
 
+napi_value NapiX509Crl::Equals(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGS_SIZE_ONE;
+    napi_value argv[ARGS_SIZE_ONE] = { nullptr };
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, &argc, argv, &thisVar, nullptr);
+    if (!CertCheckArgsCount(env, argc, ARGS_SIZE_ONE, true)) {
+        return nullptr;
+    }
+
+    /* unwrap only objects of this class, the native of another class would be misread */
+    napi_value constructor = nullptr;
+    bool isInstance = false;
+    napi_get_reference_value(env, classRef_, &constructor);
+    napi_instanceof(env, argv[PARAM0], constructor, &isInstance);
+    NapiX509Crl *napiOther = nullptr;
+    if (isInstance) {
+        napi_unwrap(env, argv[PARAM0], reinterpret_cast<void **>(&napiOther));
+    }
+    if (napiOther == nullptr) {
+        napi_throw(env, CertGenerateBusinessError(env, CF_INVALID_PARAMS, "the other object is not a X509Crl"));
+        LOGE("the other object is not a X509Crl!");
+        return nullptr;
+    }
+
+    HcfX509Crl *x509Crl = GetX509Crl();
+    bool isEqual = false;
+    CfResult ret = x509Crl->equals(x509Crl, napiOther->GetX509Crl(), &isEqual);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "crl equals failed"));
+        LOGE("crl equals failed!");
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_get_boolean(env, isEqual, &result);
+    return result;
+}
+
+napi_value NapiX509Crl::HashCode(napi_env env, napi_callback_info info)
+{
+    HcfX509Crl *x509Crl = GetX509Crl();
+    uint32_t hashCode = 0;
+    CfResult ret = x509Crl->hashCode(x509Crl, &hashCode);
+    if (ret != CF_SUCCESS) {
+        napi_throw(env, CertGenerateBusinessError(env, ret, "crl get hash code failed"));
+        LOGE("crl get hash code failed!");
+        return nullptr;
+    }
+    napi_value result = nullptr;
+    napi_create_uint32(env, hashCode, &result);
+    return result;
+}
+
 static napi_value NapiIsRevoked(napi_env env, napi_callback_info info)
 {
     napi_value thisVar = nullptr;
@@ -841,6 +1055,19 @@ static napi_value NapiGetRevokedCertificateWithCert(napi_env env, napi_callback_
     return x509Crl->GetRevokedCertificateWithCert(env, info);
 }
 
+static napi_value NapiGetRevokedCertificateWithSerial(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Crl *x509Crl = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Crl));
+    if (x509Crl == nullptr) {
+        LOGE("x509Crl is nullptr!");
+        return nullptr;
+    }
+    return x509Crl->GetRevokedCertificateWithSerial(env, info);
+}
+
 static napi_value NapiGetRevokedCertificates(napi_env env, napi_callback_info info)
 {
     napi_value thisVar = nullptr;
@@ -854,6 +1081,32 @@ static napi_value NapiGetRevokedCertificates(napi_env env, napi_callback_info in
     return x509Crl->GetRevokedCertificates(env, info);
 }
 
+static napi_value NapiGetRevokedColumns(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Crl *x509Crl = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Crl));
+    if (x509Crl == nullptr) {
+        LOGE("x509Crl is nullptr!");
+        return nullptr;
+    }
+    return x509Crl->GetRevokedColumns(env, info);
+}
+
+static napi_value NapiGetRevokedDiff(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Crl *x509Crl = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Crl));
+    if (x509Crl == nullptr) {
+        LOGE("x509Crl is nullptr!");
+        return nullptr;
+    }
+    return x509Crl->GetRevokedDiff(env, info);
+}
+
 static napi_value NapiGetTBSCertList(napi_env env, napi_callback_info info)
 {
     napi_value thisVar = nullptr;
@@ -919,12 +1172,46 @@ static napi_value NapiGetSigAlgParams(napi_env env, napi_callback_info info)
     return x509Crl->GetSigAlgParams(env, info);
 }
 
+static napi_value NapiEquals(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Crl *x509Crl = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Crl));
+    if (x509Crl == nullptr) {
+        LOGE("x509Crl is nullptr!");
+        return nullptr;
+    }
+    return x509Crl->Equals(env, info);
+}
+
+static napi_value NapiHashCode(napi_env env, napi_callback_info info)
+{
+    napi_value thisVar = nullptr;
+    napi_get_cb_info(env, info, nullptr, nullptr, &thisVar, nullptr);
+    NapiX509Crl *x509Crl = nullptr;
+    napi_unwrap(env, thisVar, reinterpret_cast<void **>(&x509Crl));
+    if (x509Crl == nullptr) {
+        LOGE("x509Crl is nullptr!");
+        return nullptr;
+    }
+    return x509Crl->HashCode(env, info);
+}
+
 void NapiX509Crl::CreateX509CrlExecute(napi_env env, void *data)
 {
     CfCtx *context = static_cast<CfCtx *>(data);
     context->errCode = HcfX509CrlCreate(context->encodingBlob, &context->crl);
     if (context->errCode != CF_SUCCESS) {
         context->errMsg = "create X509Crl failed";
+        return;
+    }
+
+    /* the input may be PEM, the native size follows the DER of the decoded CRL */
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (context->crl->getEncoded(context->crl, &der) == CF_SUCCESS) {
+        context->derLen = der.len;
+        CfEncodingBlobDataFree(&der);
     }
 }
 
@@ -948,14 +1235,8 @@ void NapiX509Crl::CreateX509CrlComplete(napi_env env, napi_status status, void *
         FreeCryptoFwkCtx(env, context);
         return;
     }
-    napi_wrap(
-        env, instance, x509CrlClass,
-        [](napi_env env, void *data, void *hint) {
-            NapiX509Crl *crlClass = static_cast<NapiX509Crl *>(data);
-            delete crlClass;
-            return;
-        },
-        nullptr, nullptr);
+    x509CrlClass->SetNativeSize(CertEstimateNativeSize(CERT_NATIVE_OBJ_CRL, context->derLen));
+    (void)WrapX509Crl(env, instance, x509CrlClass);
     ReturnResult(env, context, instance);
     FreeCryptoFwkCtx(env, context);
 }
@@ -970,7 +1251,7 @@ napi_value NapiX509Crl::NapiCreateX509Crl(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -986,14 +1267,11 @@ napi_value NapiX509Crl::NapiCreateX509Crl(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "createX509Crl"),
+    CertQueueAsyncWork(
+        env, "createX509Crl",
         CreateX509CrlExecute,
         CreateX509CrlComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -1026,12 +1304,17 @@ void NapiX509Crl::DefineX509CrlJSClass(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION("getNextUpdate", NapiGetNextUpdate),
         DECLARE_NAPI_FUNCTION("getRevokedCert", NapiGetRevokedCertificate),
         DECLARE_NAPI_FUNCTION("getRevokedCertWithCert", NapiGetRevokedCertificateWithCert),
+        DECLARE_NAPI_FUNCTION("getRevokedCertWithSerial", NapiGetRevokedCertificateWithSerial),
         DECLARE_NAPI_FUNCTION("getRevokedCerts", NapiGetRevokedCertificates),
+        DECLARE_NAPI_FUNCTION("getRevokedColumns", NapiGetRevokedColumns),
+        DECLARE_NAPI_FUNCTION("getRevokedDiff", NapiGetRevokedDiff),
         DECLARE_NAPI_FUNCTION("getTbsInfo", NapiGetTBSCertList),
         DECLARE_NAPI_FUNCTION("getSignature", NapiGetSignature),
         DECLARE_NAPI_FUNCTION("getSignatureAlgName", NapiGetSigAlgName),
         DECLARE_NAPI_FUNCTION("getSignatureAlgOid", NapiGetSigAlgOID),
         DECLARE_NAPI_FUNCTION("getSignatureAlgParams", NapiGetSigAlgParams),
+        DECLARE_NAPI_FUNCTION("equals", NapiEquals),
+        DECLARE_NAPI_FUNCTION("hashCode", NapiHashCode),
     };
     napi_value constructor = nullptr;
     napi_define_class(env, "X509Crl", NAPI_AUTO_LENGTH, X509CrlConstructor, nullptr,
@@ -1039,6 +1322,59 @@ void NapiX509Crl::DefineX509CrlJSClass(napi_env env, napi_value exports)
     napi_create_reference(env, constructor, 1, &classRef_);
 }
 
+static void *DetachX509Crl(napi_env env, void *value, void *hint)
+{
+    /* the receiving worker gets its own wrapper holding another reference to the same CRL */
+    NapiX509Crl *x509CrlClass = new (std::nothrow) NapiX509Crl(*static_cast<NapiX509Crl *>(value));
+    if (x509CrlClass == nullptr) {
+        LOGE("Failed to copy x509Crl class");
+        return nullptr;
+    }
+    x509CrlClass->SetNativeSize(0); /* the CRL is reported by the env that created it only */
+    return CertParkDetached(env, x509CrlClass, [](void *object) { delete static_cast<NapiX509Crl *>(object); });
+}
+
+static napi_value AttachX509Crl(napi_env env, void *value, void *hint)
+{
+    NapiX509Crl *x509CrlClass = static_cast<NapiX509Crl *>(CertTakeDetached(value));
+    if (x509CrlClass == nullptr) {
+        LOGE("Failed to share x509Crl class");
+        return nullptr;
+    }
+    napi_value instance = NapiX509Crl::CreateX509Crl(env);
+    if ((instance == nullptr) || (NapiX509Crl::WrapX509Crl(env, instance, x509CrlClass) != napi_ok)) {
+        LOGE("Failed to attach x509Crl class");
+        delete x509CrlClass;
+        return nullptr;
+    }
+    return instance;
+}
+
+/* Hands x509CrlClass to instance, which may then be posted to other workers without reparsing. */
+napi_status NapiX509Crl::WrapX509Crl(napi_env env, napi_value instance, NapiX509Crl *x509CrlClass)
+{
+    napi_status status = napi_wrap(
+        env, instance, x509CrlClass,
+        [](napi_env env, void *data, void *hint) {
+            NapiX509Crl *crlClass = static_cast<NapiX509Crl *>(data);
+            CertAdjustExternalMemory(env, -crlClass->GetNativeSize());
+            delete crlClass;
+            return;
+        },
+        nullptr, nullptr);
+    if (status != napi_ok) {
+        LOGE("Failed to wrap x509Crl class");
+        return status;
+    }
+    CertAdjustExternalMemory(env, x509CrlClass->GetNativeSize());
+    status = napi_coerce_to_native_binding_object(env, instance, DetachX509Crl, AttachX509Crl, x509CrlClass,
+        nullptr);
+    if (status != napi_ok) {
+        LOGE("x509Crl can not be sent to other workers");
+    }
+    return napi_ok;
+}
+
 napi_value NapiX509Crl::CreateX509Crl(napi_env env)
 {
     napi_value constructor = nullptr;
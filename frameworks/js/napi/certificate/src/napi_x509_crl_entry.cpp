@@ -23,6 +23,8 @@
 #include "cf_object_base.h"
 #include "cf_result.h"
 #include "napi_cert_defines.h"
+#include "napi_cert_ctx_pool.h"
+#include "napi_cert_executor.h"
 #include "napi_cert_utils.h"
 
 namespace OHOS {
@@ -34,7 +36,6 @@ struct CfCtx {
     napi_value promise = nullptr;
     napi_ref callback = nullptr;
     napi_deferred deferred = nullptr;
-    napi_async_work asyncWork = nullptr;
 
     NapiX509CrlEntry *crlEntryClass = nullptr;
 
@@ -44,16 +45,14 @@ struct CfCtx {
     CfBlob *blob = nullptr;
 };
 
+static thread_local CertCtxPool g_ctxPool(sizeof(CfCtx));
+
 static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
 {
     if (context == nullptr) {
         return;
     }
 
-    if (context->asyncWork != nullptr) {
-        napi_delete_async_work(env, context->asyncWork);
-    }
-
     if (context->callback != nullptr) {
         napi_delete_reference(env, context->callback);
     }
@@ -66,7 +65,7 @@ static void FreeCryptoFwkCtx(napi_env env, CfCtx *context)
     CfFree(context->blob);
     context->blob = nullptr;
 
-    CfFree(context);
+    g_ctxPool.Release(context);
 }
 
 static void ReturnCallbackResult(napi_env env, CfCtx *context, napi_value result)
@@ -173,7 +172,7 @@ napi_value NapiX509CrlEntry::GetEncoded(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    CfCtx *context = static_cast<CfCtx *>(HcfMalloc(sizeof(CfCtx), 0));
+    CfCtx *context = static_cast<CfCtx *>(g_ctxPool.Acquire());
     if (context == nullptr) {
         LOGE("malloc context failed!");
         return nullptr;
@@ -185,14 +184,11 @@ napi_value NapiX509CrlEntry::GetEncoded(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    napi_create_async_work(
-        env, nullptr, CertGetResourceName(env, "GetEncoded"),
+    CertQueueAsyncWork(
+        env, "GetEncoded",
         GetEncodedExecute,
         GetEncodedComplete,
-        static_cast<void *>(context),
-        &context->asyncWork);
-
-    napi_queue_async_work(env, context->asyncWork);
+        static_cast<void *>(context));
     if (context->asyncType == ASYNC_TYPE_PROMISE) {
         return context->promise;
     } else {
@@ -40,6 +40,13 @@ struct HcfCertChainValidator {
 
     /** Get algorithm name. */
     const char *(*getAlgorithm)(HcfCertChainValidator *self);
+
+    /**
+     * Use the certs in the hashed directory dirPath as the trust anchors, the certs of a chain after its leaf are
+     * then untrusted intermediates and a chain may be the leaf alone. The files are PEM, named by subject name hash
+     * as openssl rehash does, and are parsed only when a validation needs them.
+     */
+    CfResult (*setTrustStore)(HcfCertChainValidator *self, const char *dirPath);
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_PKCS7_H
+#define CF_PKCS7_H
+
+#include "cf_blob.h"
+#include "cf_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parse the certificates and CRLs of a PKCS#7 SignedData in DER or PEM, such as a certs-only bundle.
+ * Every blob of certsOut points to an HcfX509Certificate and every blob of crlsOut to an HcfX509Crl, in the order
+ * of the bundle. The caller destroys each object with CfObjDestroy and frees the blob arrays with CfFree.
+ * Either array may be empty.
+ */
+CfResult HcfPkcs7ParseCerts(const CfEncodingBlob *inStream, CfArray *certsOut, CfArray *crlsOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CF_PKCS7_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_X509_CERT_BUILDER_H
+#define CF_X509_CERT_BUILDER_H
+
+#include <stdint.h>
+#include "cf_blob.h"
+#include "cf_object_base.h"
+#include "cf_result.h"
+#include "x509_certificate.h"
+
+typedef struct HcfX509CertBuilder HcfX509CertBuilder;
+
+/* The part shared by every certificate of a builder, all fields are DER. */
+typedef struct {
+    CfBlob issuer; /* Name */
+    CfBlob subject; /* Name, may be the empty SEQUENCE when subjectAltNames is set */
+    CfBlob subjectAltNames; /* GeneralNames, size 0 for none, critical when the subject is empty */
+    CfBlob extensions; /* Extension entries back to back, size 0 for none */
+} HcfX509CertTemplate;
+
+/* The part that varies per certificate. */
+typedef struct {
+    CfBlob serialNumber; /* big-endian magnitude, at most 20 bytes once encoded */
+    int64_t notBefore; /* seconds since the epoch */
+    int64_t notAfter;
+    CfBlob publicKey; /* DER SubjectPublicKeyInfo */
+} HcfX509CertIssueParams;
+
+struct HcfX509CertBuilder {
+    struct CfObjectBase base;
+
+    /** Issue one v3 certificate of the template, signed by the key of the builder. */
+    CfResult (*issue)(HcfX509CertBuilder *self, const HcfX509CertIssueParams *params, HcfX509Certificate **certOut);
+
+    /**
+     * Issue a certificate for each of the count params, every blob of certsOut points to an HcfX509Certificate in
+     * the order of params. The caller destroys each object with CfObjDestroy and frees the blob array with CfFree.
+     * Nothing is returned if one of them fails.
+     */
+    CfResult (*issueBatch)(HcfX509CertBuilder *self, const HcfX509CertIssueParams *paramsList, uint32_t count,
+        CfArray *certsOut);
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Generate a certificate builder. The template is encoded once here, so issuing only encodes the serial
+ * number, validity and public key. signingKey is the issuer private key in DER, PKCS#8 or the traditional form of
+ * RSA and EC, RSA signs with SHA256 and PKCS#1 v1.5, EC with ECDSA and SHA256, Ed25519 as is.
+ * A builder does not change after creation and can issue from several threads at once.
+ */
+CfResult HcfX509CertBuilderCreate(const HcfX509CertTemplate *tmpl, const CfBlob *signingKey,
+    HcfX509CertBuilder **builder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CF_X509_CERT_BUILDER_H
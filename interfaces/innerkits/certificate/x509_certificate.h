@@ -16,6 +16,8 @@
 #ifndef CF_X509_CERTIFICATE_H
 #define CF_X509_CERTIFICATE_H
 
+#include <stdbool.h>
+
 #include "certificate.h"
 #include "cf_blob.h"
 #include "cf_result.h"
@@ -83,6 +85,22 @@ struct HcfX509Certificate {
 
     /** Get issuer alternative name from certificate. */
     CfResult (*getIssuerAltNames)(HcfX509Certificate *self, CfArray *outName);
+
+    /** Get the serialized cert data in the given format, DER or PEM. */
+    CfResult (*getEncodedWithFormat)(HcfX509Certificate *self, enum CfEncodingFormat format,
+        CfEncodingBlob *encodedByte);
+
+    /**
+     * Create a new certificate object sharing the parsed certificate of self, without encoding or parsing it again.
+     * Both objects are used and destroyed independently.
+     */
+    CfResult (*dup)(HcfX509Certificate *self, HcfX509Certificate **out);
+
+    /** Check whether the two certificates have the same DER encoding. */
+    CfResult (*equals)(HcfX509Certificate *self, HcfX509Certificate *other, bool *out);
+
+    /** Get a hash of the DER encoding, equal certificates have the same hash in every process. */
+    CfResult (*hashCode)(HcfX509Certificate *self, uint32_t *out);
 };
 
 #ifdef __cplusplus
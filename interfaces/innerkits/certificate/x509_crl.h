@@ -22,6 +22,21 @@
 #include "x509_certificate.h"
 #include "x509_crl_entry.h"
 
+/** Reason code reported for entries that carry no CRLReason extension. */
+#define HCF_CRL_REASON_ABSENT 0xFF
+
+/**
+ * All revoked entries of a CRL, laid out as columns in CRL order.
+ * The serial of entry i is serials.data[offset[i], offset[i + 1]), where offset is serialOffsets read as uint32_t.
+ */
+typedef struct {
+    uint32_t count;
+    CfBlob serialOffsets;   /* uint32_t[count + 1] */
+    CfBlob serials;         /* big-endian serial number magnitudes, concatenated */
+    CfBlob revocationDates; /* int64_t[count], seconds since the epoch */
+    CfBlob reasons;         /* uint8_t[count], CRLReason code or HCF_CRL_REASON_ABSENT */
+} HcfX509CrlColumns;
+
 typedef struct HcfX509Crl HcfX509Crl;
 
 struct HcfX509Crl {
@@ -31,6 +46,9 @@ struct HcfX509Crl {
     /** Get the der coding format. */
     CfResult (*getEncoded)(HcfX509Crl *self, CfEncodingBlob *encodedOut);
 
+    /** Get the serialized CRL data in the given format, DER or PEM. */
+    CfResult (*getEncodedWithFormat)(HcfX509Crl *self, enum CfEncodingFormat format, CfEncodingBlob *encodedOut);
+
     /** Use the public key to verify the signature of CRL. */
     CfResult (*verify)(HcfX509Crl *self, HcfPubKey *key);
 
@@ -53,9 +71,26 @@ struct HcfX509Crl {
     CfResult (*getRevokedCertWithCert)(HcfX509Crl *self, HcfX509Certificate *cert,
         HcfX509CrlEntry **entryOut);
 
+    /**
+     * Find the CRL entry of a serial number given as a big-endian byte blob, leading zero bytes are ignored.
+     * Returns CF_NOT_EXIST when the serial is not on this CRL.
+     */
+    CfResult (*getRevokedCertWithSerial)(HcfX509Crl *self, const CfBlob *serial, HcfX509CrlEntry **entryOut);
+
     /** Get all entries in this CRL. */
     CfResult (*getRevokedCerts)(HcfX509Crl *self, CfArray *entrysOut);
 
+    /** Get all entries in this CRL as columns, without creating an entry object per revoked certificate. */
+    CfResult (*getRevokedColumns)(HcfX509Crl *self, HcfX509CrlColumns *columnsOut);
+
+    /**
+     * Compare this CRL with a newer CRL of the same issuer. Serials revoked only in the newer CRL are returned in
+     * addedOut, serials revoked only in this CRL are returned in removedOut, both in ascending order. A serial is
+     * the content of its DER INTEGER, as getSerialNumber returns it. Each array is one allocation with the serial
+     * bytes behind the blobs, free it with CfFree(array.data) only.
+     */
+    CfResult (*getRevokedDiff)(HcfX509Crl *self, HcfX509Crl *newer, CfBlobArray *addedOut, CfBlobArray *removedOut);
+
     /** Get the CRL information encoded by Der from this CRL. */
     CfResult (*getTbsInfo)(HcfX509Crl *self, CfBlob *tbsCertListOut);
 
@@ -70,6 +105,18 @@ struct HcfX509Crl {
 
     /** Get the der encoded signature algorithm parameters from the CRL signature algorithm. */
     CfResult (*getSignatureAlgParams)(HcfX509Crl *self, CfBlob *sigAlgParamOut);
+
+    /**
+     * Create a new CRL object sharing the parsed CRL of self, without encoding or parsing it again.
+     * Both objects are used and destroyed independently.
+     */
+    CfResult (*dup)(HcfX509Crl *self, HcfX509Crl **out);
+
+    /** Check whether the two CRLs have the same DER encoding. */
+    CfResult (*equals)(HcfX509Crl *self, HcfX509Crl *other, bool *out);
+
+    /** Get a hash of the DER encoding, equal CRLs have the same hash in every process. */
+    CfResult (*hashCode)(HcfX509Crl *self, uint32_t *out);
 };
 
 #ifdef __cplusplus
@@ -77,6 +124,7 @@ extern "C" {
 #endif
 
 CfResult HcfX509CrlCreate(const CfEncodingBlob *inStream, HcfX509Crl **returnObj);
+void HcfX509CrlColumnsFree(HcfX509CrlColumns *columns);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_X509_CRL_BUILDER_H
+#define CF_X509_CRL_BUILDER_H
+
+#include <stdint.h>
+#include "cf_blob.h"
+#include "cf_result.h"
+#include "x509_crl.h"
+
+/* The CRL wide fields, all blobs are DER except crlNumber. */
+typedef struct {
+    CfBlob issuer; /* Name */
+    int64_t thisUpdate; /* seconds since the epoch */
+    int64_t nextUpdate;
+    CfBlob crlNumber; /* big-endian magnitude, size 0 to leave the CRL number extension out */
+    CfBlob extensions; /* other Extension entries back to back, size 0 for none */
+} HcfX509CrlBuildParams;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Build and sign a v2 CRL with the entries of revoked, laid out as getRevokedColumns returns them.
+ * The entries are written in ascending serial order and a serial may appear only once. signingKey is the issuer
+ * private key in DER, with the same algorithms as HcfX509CertBuilderCreate. derOut gets the signed CRL, crlOut
+ * may be NULL and otherwise gets it as an object whose revoked serial index comes in order and is not sorted again.
+ */
+CfResult HcfX509CrlBuild(const HcfX509CrlBuildParams *params, const HcfX509CrlColumns *revoked,
+    const CfBlob *signingKey, CfEncodingBlob *derOut, HcfX509Crl **crlOut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CF_X509_CRL_BUILDER_H
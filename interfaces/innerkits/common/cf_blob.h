@@ -28,6 +28,8 @@ struct CfBlob {
 enum CfEncodingFormat {
     CF_FORMAT_DER = 0,
     CF_FORMAT_PEM = 1,
+    /* input only, PEM armor or a DER SEQUENCE is detected from the data */
+    CF_FORMAT_AUTO = 2,
 };
 
 typedef struct {
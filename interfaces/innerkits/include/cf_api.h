@@ -23,6 +23,13 @@ struct CfObjectInner {
     int32_t (*get)(const CfObject *object, const CfParamSet *paramSetIn, CfParamSet **paramSetOut);
     int32_t (*check)(const CfObject *object, const CfParamSet *paramSetIn, CfParamSet **paramSetOut);
     void (*destroy)(CfObject **object);
+    /* creates an independent object sharing the parsed resource of object, CF_NOT_SUPPORT for some object types */
+    int32_t (*dup)(const CfObject *object, CfObject **objectOut);
+    /*
+     * like get, but returns the bytes result in out instead of a param set, so it is not limited by
+     * CF_PARAM_SET_MAX_SIZE, out is freed by CfBlobDataFree, CF_NOT_SUPPORT for some object types
+     */
+    int32_t (*getBytes)(const CfObject *object, const CfParamSet *paramSetIn, CfBlob *out);
 };
 
 #ifdef __cplusplus
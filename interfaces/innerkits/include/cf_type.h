@@ -29,6 +29,7 @@ typedef enum {
     CF_OBJ_TYPE_EXTENSION,
     CF_OBJ_TYPE_CRL,
     CF_OBJ_TYPE_LIST,
+    CF_OBJ_TYPE_CSR,
 } CfObjectType;
 
 typedef struct {
@@ -51,6 +52,7 @@ typedef enum {
     CF_ITEM_NOT_AFTER,
     CF_ITEM_SIGNATURE,
     CF_ITEM_SIGNATURE_ALG_NAME,
+    CF_ITEM_ATTRIBUTES, /* CSR attributes, DER encoded SET OF Attribute */
 
     CF_ITEM_INVALID,
 } CfItemId;
@@ -68,14 +70,47 @@ typedef enum {
 } CfExtensionEntryType;
 
 typedef enum {
-    CF_GET_TYPE_CERT_ITEM,
+    CF_LIST_INDEX_SUBJECT_NAME, /* key: DER encoded subject name */
+    CF_LIST_INDEX_ISSUER_NAME, /* key: DER encoded issuer name */
+    CF_LIST_INDEX_SERIAL_NUMBER, /* key: big-endian serial number bytes */
+    CF_LIST_INDEX_SUBJECT_KEY_ID, /* key: subject key identifier bytes */
+    CF_LIST_INDEX_AUTHORITY_KEY_ID, /* key: authority key identifier bytes */
+} CfListIndexType;
+
+typedef enum {
+    CF_GET_TYPE_CERT_ITEM, /* param0 int32: CfItemId, optional param1 int32: CfEncodingFormat of CF_ITEM_ENCODED */
     CF_GET_TYPE_EXT_ITEM,
     CF_GET_TYPE_EXT_OIDS,
     CF_GET_TYPE_EXT_ENTRY,
+    CF_GET_TYPE_LIST_FIND, /* param0 int32: CfListIndexType, param1 buffer: index key */
+    CF_GET_TYPE_LIST_SELECT, /* optional param0 buffer: issuer, param1 buffer: eku oid, param2 buffer: date */
+    CF_GET_TYPE_LIST_ITEMS, /* param0 buffer: int32 CfItemId array, one result column per item id */
+    CF_GET_TYPE_CSR_ITEM, /* param0 int32: CfItemId, optional param1 int32: index of the request, default 0 */
+    CF_GET_TYPE_CSR_COUNT, /* count of requests in the object */
 } CfGetType;
 
+/*
+ * Column layout of CF_GET_TYPE_LIST_ITEMS, n is the count of certs in the list, integers are in host byte order:
+ * CF_ITEM_VERSION: int32_t[n]
+ * CF_ITEM_NOT_BEFORE, CF_ITEM_NOT_AFTER: int64_t[n], seconds since 1970-01-01T00:00:00Z
+ * others: uint32_t offset[n + 1] followed by the field bytes, field i is data[offset[i], offset[i + 1])
+ * CF_GET_TYPE_CERT_ITEM returns one element of the same layout, the version, the time or the field bytes.
+ * CF_GET_TYPE_LIST_FIND and CF_GET_TYPE_LIST_SELECT return one buffer: uint32_t m, the count of matched certs,
+ * followed by the CF_ITEM_ENCODED layout of the m certs.
+ * Results larger than CF_PARAM_SET_MAX_SIZE can only be got through getBytes of the object, where
+ * CF_GET_TYPE_LIST_ITEMS returns one buffer: uint32_t k, uint32_t offset[k + 1] followed by the k columns.
+ */
+
+/*
+ * Items of CF_GET_TYPE_CSR_ITEM: CF_ITEM_ENCODED, CF_ITEM_TBS, CF_ITEM_VERSION (int32, 1 for a v1 request),
+ * CF_ITEM_SUBJECT_NAME, CF_ITEM_PUBLIC_KEY, CF_ITEM_ATTRIBUTES, CF_ITEM_SIGNATURE, CF_ITEM_SIGNATURE_ALG_NAME, and
+ * CF_ITEM_EXTENSIONS for the requested extensions, which can be passed to CfCreate as CF_OBJ_TYPE_EXTENSION.
+ */
+
 typedef enum {
     CF_CHECK_TYPE_EXT_CA,
+    CF_CHECK_TYPE_CSR_SIGNATURE, /* optional param0 int32: index of the request, result bool */
+    CF_CHECK_TYPE_CSR_SIGNATURES, /* result bytes: one uint8 per request, 1 if its signature is valid */
 } CfCheckType;
 
 typedef enum {
@@ -140,6 +175,10 @@ static inline bool CfIsAdditionOverflow(uint32_t a, uint32_t b)
 
 #define MAX_LEN_CERTIFICATE    65536
 #define MAX_LEN_EXTENSIONS     65536
+#define MAX_LEN_CERT_LIST      (64 * 1024 * 1024)
+#define MAX_COUNT_CERT_LIST    65536
+#define MAX_LEN_CSR_LIST       (64 * 1024 * 1024)
+#define MAX_COUNT_CSR_LIST     65536
 
 #define BASIC_CONSTRAINTS_NO_CA             (-1)
 #define BASIC_CONSTRAINTS_PATHLEN_NO_LIMIT  (-2)
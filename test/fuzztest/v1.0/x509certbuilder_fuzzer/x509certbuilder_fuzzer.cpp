@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509certbuilder_fuzzer.h"
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <vector>
+
+#include "cf_blob.h"
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "securec.h"
+#include "x509_cert_builder.h"
+#include "x509_certificate.h"
+
+namespace OHOS {
+    constexpr int64_t TEST_NOT_BEFORE = 1700000000;
+    constexpr int64_t TEST_NOT_AFTER = 2000000000;
+    constexpr uint32_t TEST_BATCH_COUNT = 2;
+
+    /* Name with the commonName "Fuzz CA" */
+    static uint8_t g_testName[] = {
+        0x30, 0x12, 0x31, 0x10, 0x30, 0x0E, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0C, 0x07,
+        0x46, 0x75, 0x7A, 0x7A, 0x20, 0x43, 0x41
+    };
+    static uint8_t g_testSerial[] = { 0x01 };
+
+    static std::vector<uint8_t> g_privateKey;
+    static std::vector<uint8_t> g_publicKey;
+
+    static std::vector<uint8_t> EncodeKey(EVP_PKEY *key, bool isPublic)
+    {
+        int len = isPublic ? i2d_PUBKEY(key, nullptr) : i2d_PrivateKey(key, nullptr);
+        if (len <= 0) {
+            return {};
+        }
+        std::vector<uint8_t> der(len);
+        unsigned char *out = der.data();
+        (void)(isPublic ? i2d_PUBKEY(key, &out) : i2d_PrivateKey(key, &out));
+        return der;
+    }
+
+    static bool InitTestKey(void)
+    {
+        if (!g_privateKey.empty()) {
+            return true;
+        }
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        if (ctx == nullptr) {
+            return false;
+        }
+        EVP_PKEY *key = nullptr;
+        if ((EVP_PKEY_keygen_init(ctx) == 1) &&
+            (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1) == 1) &&
+            (EVP_PKEY_keygen(ctx, &key) == 1)) {
+            g_privateKey = EncodeKey(key, false);
+            g_publicKey = EncodeKey(key, true);
+        }
+        EVP_PKEY_free(key);
+        EVP_PKEY_CTX_free(ctx);
+        return !g_privateKey.empty() && !g_publicKey.empty();
+    }
+
+    static CfBlob GetNameBlob(void)
+    {
+        return { sizeof(g_testName), g_testName };
+    }
+
+    static HcfX509CertIssueParams GetIssueParams(void)
+    {
+        HcfX509CertIssueParams params = {
+            .serialNumber = { sizeof(g_testSerial), g_testSerial },
+            .notBefore = TEST_NOT_BEFORE,
+            .notAfter = TEST_NOT_AFTER,
+            .publicKey = { static_cast<uint32_t>(g_publicKey.size()), g_publicKey.data() },
+        };
+        return params;
+    }
+
+    static void TestIssue(const HcfX509CertTemplate *tmpl, const CfBlob *signingKey,
+        const HcfX509CertIssueParams *params)
+    {
+        HcfX509CertBuilder *builder = nullptr;
+        if (HcfX509CertBuilderCreate(tmpl, signingKey, &builder) != CF_SUCCESS) {
+            return;
+        }
+        HcfX509Certificate *cert = nullptr;
+        if (builder->issue(builder, params, &cert) == CF_SUCCESS) {
+            CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+            if (cert->base.getEncoded(&cert->base, &der) == CF_SUCCESS) {
+                CfFree(der.data);
+            }
+            CfObjDestroy(cert);
+        }
+        HcfX509CertIssueParams paramsList[TEST_BATCH_COUNT] = { *params, *params };
+        CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+        if (builder->issueBatch(builder, paramsList, TEST_BATCH_COUNT, &certs) == CF_SUCCESS) {
+            for (uint32_t i = 0; i < certs.count; i++) {
+                CfObjDestroy(certs.data[i].data);
+            }
+            CfFree(certs.data);
+        }
+        CfObjDestroy(builder);
+    }
+
+    static void TestTemplate(const CfBlob *input)
+    {
+        CfBlob name = GetNameBlob();
+        CfBlob none = { 0, nullptr };
+        CfBlob signingKey = { static_cast<uint32_t>(g_privateKey.size()), g_privateKey.data() };
+        HcfX509CertIssueParams params = GetIssueParams();
+        HcfX509CertTemplate templates[] = {
+            { *input, name, none, none },
+            { name, *input, none, none },
+            { name, name, *input, none },
+            { name, name, none, *input },
+        };
+        for (const HcfX509CertTemplate &tmpl : templates) {
+            TestIssue(&tmpl, &signingKey, &params);
+        }
+        HcfX509CertTemplate tmpl = { name, name, none, none };
+        TestIssue(&tmpl, input, &params);
+    }
+
+    static void TestIssueParams(const CfBlob *input, const uint8_t *data, size_t size)
+    {
+        CfBlob name = GetNameBlob();
+        CfBlob none = { 0, nullptr };
+        CfBlob signingKey = { static_cast<uint32_t>(g_privateKey.size()), g_privateKey.data() };
+        HcfX509CertTemplate tmpl = { name, name, none, none };
+
+        HcfX509CertIssueParams params = GetIssueParams();
+        params.serialNumber = *input;
+        TestIssue(&tmpl, &signingKey, &params);
+        params = GetIssueParams();
+        params.publicKey = *input;
+        TestIssue(&tmpl, &signingKey, &params);
+        if (size >= sizeof(int64_t) * 2) { /* notBefore and notAfter */
+            params = GetIssueParams();
+            (void)memcpy_s(&params.notBefore, sizeof(int64_t), data, sizeof(int64_t));
+            (void)memcpy_s(&params.notAfter, sizeof(int64_t), data + sizeof(int64_t), sizeof(int64_t));
+            TestIssue(&tmpl, &signingKey, &params);
+        }
+    }
+
+    bool FuzzDoX509CertBuilderTest(const uint8_t* data, size_t size)
+    {
+        if ((data == nullptr) || (size == 0) || !InitTestKey()) {
+            return false;
+        }
+        CfBlob input = { static_cast<uint32_t>(size), const_cast<uint8_t *>(data) };
+        TestTemplate(&input);
+        TestIssueParams(&input, data, size);
+        return true;
+    }
+}
+
+/* Fuzzer entry point */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    /* Run your code on data */
+    OHOS::FuzzDoX509CertBuilderTest(data, size);
+    return 0;
+}
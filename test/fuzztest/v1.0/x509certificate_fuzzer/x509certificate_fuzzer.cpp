@@ -121,6 +121,21 @@ namespace OHOS {
         CfArrayDataClearAndFree(&subjectAltName);
     }
 
+    static void TestDup(HcfX509Certificate *x509CertObj)
+    {
+        HcfX509Certificate *dupCertObj = nullptr;
+        CfResult res = x509CertObj->dup(x509CertObj, &dupCertObj);
+        if (res != CF_SUCCESS) {
+            return;
+        }
+        TestQuery(dupCertObj);
+        bool isEqual = false;
+        (void)x509CertObj->equals(x509CertObj, dupCertObj, &isEqual);
+        uint32_t hashCode = 0;
+        (void)dupCertObj->hashCode(dupCertObj, &hashCode);
+        CfObjDestroy(dupCertObj);
+    }
+
     static void CreateOneCert(void)
     {
         CfEncodingBlob inStream = { 0 };
@@ -135,6 +150,7 @@ namespace OHOS {
         TestGetEncoded(x509CertObj);
         TestVerify(x509CertObj);
         TestQuery(x509CertObj);
+        TestDup(x509CertObj);
     }
 
     bool X509CertificateFuzzTest(const uint8_t* data, size_t size)
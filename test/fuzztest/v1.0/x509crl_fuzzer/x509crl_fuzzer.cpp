@@ -160,6 +160,25 @@ namespace OHOS {
         if (encodingBlob.data != nullptr) {
             CfFree(encodingBlob.data);
         }
+        CfEncodingBlob pemBlob = { 0 };
+        (void)x509CrlPem->getEncodedWithFormat(x509CrlPem, CF_FORMAT_PEM, &pemBlob);
+        if (pemBlob.data != nullptr) {
+            CfFree(pemBlob.data);
+        }
+        HcfX509Crl *dupCrl = nullptr;
+        if (x509CrlPem->dup(x509CrlPem, &dupCrl) == CF_SUCCESS) {
+            CfArray entrys = { 0 };
+            (void)dupCrl->getRevokedCerts(dupCrl, &entrys);
+            for (uint32_t i = 0; i < entrys.count; i++) {
+                CfObjDestroy(reinterpret_cast<HcfX509CrlEntry *>(entrys.data[i].data));
+            }
+            CfFree(entrys.data);
+            bool isEqual = false;
+            (void)x509CrlPem->equals(x509CrlPem, dupCrl, &isEqual);
+            uint32_t hashCode = 0;
+            (void)dupCrl->hashCode(dupCrl, &hashCode);
+            CfObjDestroy(dupCrl);
+        }
         CfBlob issuerName = { 0 };
         (void)x509CrlPem->getIssuerName(x509CrlPem, &issuerName);
         if (issuerName.data != nullptr) {
@@ -240,6 +259,19 @@ namespace OHOS {
             HcfX509CrlEntry *crlEntry = reinterpret_cast<HcfX509CrlEntry *>(entrys.data[0].data);
             CfObjDestroy(crlEntry);
         }
+        uint8_t serialData[] = { 0x01 };
+        CfBlob serial = { sizeof(serialData), serialData };
+        HcfX509CrlEntry *serialEntry = nullptr;
+        x509CrlDer->getRevokedCertWithSerial(x509CrlDer, &serial, &serialEntry);
+        CfObjDestroy(serialEntry);
+        HcfX509CrlColumns columns = { 0 };
+        x509CrlDer->getRevokedColumns(x509CrlDer, &columns);
+        HcfX509CrlColumnsFree(&columns);
+        CfBlobArray added = { nullptr, 0 };
+        CfBlobArray removed = { nullptr, 0 };
+        x509CrlDer->getRevokedDiff(x509CrlDer, x509CrlDer, &added, &removed);
+        CfFree(added.data);
+        CfFree(removed.data);
 
         CfBlob signature = { 0 };
         x509CrlDer->getSignature(x509CrlDer, &signature);
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509crlbuilder_fuzzer.h"
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <vector>
+
+#include "cf_blob.h"
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "securec.h"
+#include "x509_crl.h"
+#include "x509_crl_builder.h"
+
+namespace OHOS {
+    constexpr int64_t TEST_THIS_UPDATE = 1700000000;
+    constexpr int64_t TEST_NEXT_UPDATE = 1702592000;
+    constexpr uint32_t TEST_MAX_ENTRY_NUM = 64;
+    constexpr uint32_t TEST_MAX_SERIAL_LEN = 24;
+
+    /* Name with the commonName "Fuzz CA" */
+    static uint8_t g_testName[] = {
+        0x30, 0x12, 0x31, 0x10, 0x30, 0x0E, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0C, 0x07,
+        0x46, 0x75, 0x7A, 0x7A, 0x20, 0x43, 0x41
+    };
+
+    static std::vector<uint8_t> g_privateKey;
+
+    static bool InitTestKey(void)
+    {
+        if (!g_privateKey.empty()) {
+            return true;
+        }
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        if (ctx == nullptr) {
+            return false;
+        }
+        EVP_PKEY *key = nullptr;
+        if ((EVP_PKEY_keygen_init(ctx) == 1) &&
+            (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1) == 1) &&
+            (EVP_PKEY_keygen(ctx, &key) == 1)) {
+            int len = i2d_PrivateKey(key, nullptr);
+            if (len > 0) {
+                g_privateKey.resize(len);
+                unsigned char *out = g_privateKey.data();
+                (void)i2d_PrivateKey(key, &out);
+            }
+        }
+        EVP_PKEY_free(key);
+        EVP_PKEY_CTX_free(ctx);
+        return !g_privateKey.empty();
+    }
+
+    static HcfX509CrlBuildParams GetBuildParams(void)
+    {
+        HcfX509CrlBuildParams params = {
+            .issuer = { sizeof(g_testName), g_testName },
+            .thisUpdate = TEST_THIS_UPDATE,
+            .nextUpdate = TEST_NEXT_UPDATE,
+            .crlNumber = { 0, nullptr },
+            .extensions = { 0, nullptr },
+        };
+        return params;
+    }
+
+    static void TestBuild(const HcfX509CrlBuildParams *params, const HcfX509CrlColumns *revoked,
+        const CfBlob *signingKey)
+    {
+        CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+        HcfX509Crl *crl = nullptr;
+        if (HcfX509CrlBuild(params, revoked, signingKey, &der, &crl) != CF_SUCCESS) {
+            return;
+        }
+        HcfX509CrlColumns columns = { 0 };
+        if (crl->getRevokedColumns(crl, &columns) == CF_SUCCESS) {
+            HcfX509CrlColumnsFree(&columns);
+        }
+        CfFree(der.data);
+        CfObjDestroy(crl);
+    }
+
+    static void TestBuildParams(const CfBlob *input)
+    {
+        CfBlob signingKey = { static_cast<uint32_t>(g_privateKey.size()), g_privateKey.data() };
+        HcfX509CrlColumns revoked = { 0 };
+        HcfX509CrlBuildParams params = GetBuildParams();
+        params.issuer = *input;
+        TestBuild(&params, &revoked, &signingKey);
+        params = GetBuildParams();
+        params.crlNumber = *input;
+        TestBuild(&params, &revoked, &signingKey);
+        params = GetBuildParams();
+        params.extensions = *input;
+        TestBuild(&params, &revoked, &signingKey);
+        params = GetBuildParams();
+        TestBuild(&params, &revoked, input);
+    }
+
+    /*
+     * Rows read from the input one after another: the serial length, the serial, the reason and a day offset of the
+     * revocation date. The serial lengths go past the limit and the reasons cover invalid codes.
+     */
+    static void TestBuildRows(const uint8_t *data, size_t size)
+    {
+        std::vector<uint32_t> offsets = { 0 };
+        std::vector<uint8_t> serials;
+        std::vector<int64_t> dates;
+        std::vector<uint8_t> reasons;
+        size_t pos = 0;
+        while ((pos + 1 < size) && (dates.size() < TEST_MAX_ENTRY_NUM)) {
+            size_t serialLen = data[pos++] % (TEST_MAX_SERIAL_LEN + 1);
+            if (pos + serialLen + 2 > size) { /* 2: the reason and the date */
+                break;
+            }
+            serials.insert(serials.end(), data + pos, data + pos + serialLen);
+            pos += serialLen;
+            offsets.push_back(static_cast<uint32_t>(serials.size()));
+            reasons.push_back(data[pos++]);
+            dates.push_back(TEST_THIS_UPDATE - static_cast<int64_t>(data[pos++]) * 86400); /* days before */
+        }
+        HcfX509CrlColumns revoked = {
+            .count = static_cast<uint32_t>(dates.size()),
+            .serialOffsets = { static_cast<uint32_t>(offsets.size() * sizeof(uint32_t)),
+                reinterpret_cast<uint8_t *>(offsets.data()) },
+            .serials = { static_cast<uint32_t>(serials.size()), serials.data() },
+            .revocationDates = { static_cast<uint32_t>(dates.size() * sizeof(int64_t)),
+                reinterpret_cast<uint8_t *>(dates.data()) },
+            .reasons = { static_cast<uint32_t>(reasons.size()), reasons.data() },
+        };
+        CfBlob signingKey = { static_cast<uint32_t>(g_privateKey.size()), g_privateKey.data() };
+        HcfX509CrlBuildParams params = GetBuildParams();
+        TestBuild(&params, &revoked, &signingKey);
+    }
+
+    /* Columns whose count and offsets come from the input and need not match the sizes. */
+    static void TestBuildColumns(const uint8_t *data, size_t size)
+    {
+        uint32_t count = data[0] % TEST_MAX_ENTRY_NUM;
+        std::vector<uint32_t> offsets(count + 1);
+        for (uint32_t i = 0; i <= count; i++) {
+            offsets[i] = data[(i + 1) % size];
+        }
+        std::vector<int64_t> dates(count, TEST_THIS_UPDATE);
+        std::vector<uint8_t> reasons(count, HCF_CRL_REASON_ABSENT);
+        HcfX509CrlColumns revoked = {
+            .count = count,
+            .serialOffsets = { static_cast<uint32_t>(offsets.size() * sizeof(uint32_t)),
+                reinterpret_cast<uint8_t *>(offsets.data()) },
+            .serials = { static_cast<uint32_t>(size), const_cast<uint8_t *>(data) },
+            .revocationDates = { static_cast<uint32_t>(dates.size() * sizeof(int64_t)),
+                reinterpret_cast<uint8_t *>(dates.data()) },
+            .reasons = { static_cast<uint32_t>(reasons.size()), reasons.data() },
+        };
+        CfBlob signingKey = { static_cast<uint32_t>(g_privateKey.size()), g_privateKey.data() };
+        HcfX509CrlBuildParams params = GetBuildParams();
+        TestBuild(&params, &revoked, &signingKey);
+    }
+
+    bool FuzzDoX509CrlBuilderTest(const uint8_t* data, size_t size)
+    {
+        if ((data == nullptr) || (size == 0) || !InitTestKey()) {
+            return false;
+        }
+        CfBlob input = { static_cast<uint32_t>(size), const_cast<uint8_t *>(data) };
+        TestBuildParams(&input);
+        TestBuildRows(data, size);
+        TestBuildColumns(data, size);
+        return true;
+    }
+}
+
+/* Fuzzer entry point */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    /* Run your code on data */
+    OHOS::FuzzDoX509CrlBuilderTest(data, size);
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "x509pkcs7_fuzzer.h"
+
+#include "cf_blob.h"
+#include "cf_memory.h"
+#include "cf_object_base.h"
+#include "cf_result.h"
+#include "pkcs7.h"
+#include "x509_certificate.h"
+#include "x509_crl.h"
+
+namespace OHOS {
+    static void DestroyArray(CfArray *array)
+    {
+        for (uint32_t i = 0; i < array->count; i++) {
+            CfObjDestroy(array->data[i].data);
+        }
+        CfFree(array->data);
+    }
+
+    static void TestParse(const uint8_t* data, size_t size, enum CfEncodingFormat format)
+    {
+        CfEncodingBlob inStream = { const_cast<uint8_t *>(data), size, format };
+        CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+        CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+        if (HcfPkcs7ParseCerts(&inStream, &certs, &crls) != CF_SUCCESS) {
+            return;
+        }
+        for (uint32_t i = 0; i < certs.count; i++) {
+            HcfX509Certificate *cert = reinterpret_cast<HcfX509Certificate *>(certs.data[i].data);
+            CfBlob serial = { 0, nullptr };
+            if (cert->getSerialNumber(cert, &serial) == CF_SUCCESS) {
+                CfFree(serial.data);
+            }
+        }
+        for (uint32_t i = 0; i < crls.count; i++) {
+            HcfX509Crl *crl = reinterpret_cast<HcfX509Crl *>(crls.data[i].data);
+            CfEncodingBlob encoded = { nullptr, 0, CF_FORMAT_DER };
+            if (crl->getEncoded(crl, &encoded) == CF_SUCCESS) {
+                CfFree(encoded.data);
+            }
+        }
+        DestroyArray(&certs);
+        DestroyArray(&crls);
+    }
+
+    bool FuzzDoX509Pkcs7Test(const uint8_t* data, size_t size)
+    {
+        if ((data == nullptr) || (size == 0)) {
+            return false;
+        }
+        TestParse(data, size, CF_FORMAT_DER);
+        TestParse(data, size, CF_FORMAT_PEM);
+        return true;
+    }
+}
+
+/* Fuzzer entry point */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    /* Run your code on data */
+    OHOS::FuzzDoX509Pkcs7Test(data, size);
+    return 0;
+}
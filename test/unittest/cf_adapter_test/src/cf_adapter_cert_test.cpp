@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 #include "cf_adapter_cert_openssl.h"
 #include "cf_test_common.h"
@@ -155,7 +157,7 @@ HWTEST_F(CfAdapterCertTest, OpensslCreateCertTest006, TestSize.Level0)
     CfEncodingBlob invalCert004 = {
         const_cast<uint8_t *>(g_certData03),
         sizeof(g_certData03),
-        static_cast<enum CfEncodingFormat>(CF_FORMAT_PEM + 1)
+        static_cast<enum CfEncodingFormat>(CF_FORMAT_AUTO + 1)
     };
     int32_t ret = CfOpensslCreateCert(&invalCert004, &obj004);
     EXPECT_EQ(ret, CF_INVALID_PARAMS) << "Abnormal adapter create cert object test failed, recode:" << ret;
@@ -691,4 +693,229 @@ HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest018, TestSize.Level0)
     CfFree(outBlob018.data);
     CfOpensslDestoryCert(&obj018);
 }
+
+/**
+ * @tc.name: OpensslGetCertItemTest019
+ * @tc.desc: Test CertFramework adapter get cert encoded, the der and pem input give the same der encoding
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest019, TestSize.Level0)
+{
+    CfBase *derObj019 = nullptr;
+    int32_t ret = CfOpensslCreateCert(&g_cert[0], &derObj019);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+    CfBlob outBlob019 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(derObj019, CF_ITEM_ENCODED, &outBlob019);
+    EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert encoded test failed, recode:" << ret;
+    CfBlob derCert = { sizeof(g_certData01), const_cast<uint8_t *>(g_certData01) };
+    EXPECT_EQ(CompareBlob(&outBlob019, &derCert), true);
+    CfFree(outBlob019.data);
+    CfOpensslDestoryCert(&derObj019);
+
+    CfBase *pemObj019 = nullptr;
+    ret = CfOpensslCreateCert(&g_cert[1], &pemObj019);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+    outBlob019 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(pemObj019, CF_ITEM_ENCODED, &outBlob019);
+    EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert encoded test failed, recode:" << ret;
+    EXPECT_EQ(outBlob019.data[0], ASN1_TAG_TYPE_SEQ) << "The pem cert is not returned as der";
+    CfFree(outBlob019.data);
+    CfOpensslDestoryCert(&pemObj019);
+}
+
+/**
+ * @tc.name: OpensslGetCertItemTest020
+ * @tc.desc: Test CertFramework adapter cert with valid outer framing but invalid content, decode fails on access
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest020, TestSize.Level0)
+{
+    /* SEQUENCE { SEQUENCE { NULL }, SEQUENCE { NULL }, BIT STRING } */
+    uint8_t framedData020[] = {
+        0x30, 0x0C, 0x30, 0x02, 0x05, 0x00, 0x30, 0x02, 0x05, 0x00, 0x03, 0x02, 0x00, 0x00
+    };
+    CfEncodingBlob framedCert020 = { framedData020, sizeof(framedData020), CF_FORMAT_DER };
+    CfBase *obj020 = nullptr;
+    int32_t ret = CfOpensslCreateCert(&framedCert020, &obj020);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+    CfBlob outBlob020 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(obj020, CF_ITEM_ENCODED, &outBlob020);
+    EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert encoded test failed, recode:" << ret;
+    CfFree(outBlob020.data);
+
+    outBlob020 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(obj020, CF_ITEM_PUBLIC_KEY, &outBlob020);
+    EXPECT_EQ(ret, CF_ERR_CRYPTO_OPERATION) << "Abnormal adapter get public key test failed, recode:" << ret;
+
+    outBlob020 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(obj020, CF_ITEM_SERIAL_NUMBER, &outBlob020);
+    EXPECT_EQ(ret, CF_ERR_CRYPTO_OPERATION) << "Abnormal adapter get serial number test failed, recode:" << ret;
+
+    framedData020[1] = 0x0D; /* outer length beyond data */
+    CfBase *obj020Invalid = nullptr;
+    ret = CfOpensslCreateCert(&framedCert020, &obj020Invalid);
+    EXPECT_EQ(ret, CF_ERR_CRYPTO_OPERATION) << "Abnormal adapter create cert object test failed, recode:" << ret;
+
+    CfOpensslDestoryCert(&obj020);
+}
+
+/**
+ * @tc.name: OpensslGetCertItemTest021
+ * @tc.desc: Test CertFramework adapter get routing fields, the peeked fields are the same as the decoded ones
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest021, TestSize.Level0)
+{
+    const CfItemId items[] = {
+        CF_ITEM_VERSION, CF_ITEM_SERIAL_NUMBER, CF_ITEM_ISSUE_NAME, CF_ITEM_SUBJECT_NAME,
+        CF_ITEM_NOT_BEFORE, CF_ITEM_NOT_AFTER, CF_ITEM_PUBLIC_KEY,
+    };
+    for (uint32_t i = 0; i < sizeof(g_cert) / sizeof(g_cert[0]); ++i) {
+        CfBase *obj021 = nullptr;
+        int32_t ret = CfOpensslCreateCert(&g_cert[i], &obj021);
+        ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+        CfOpensslCertObj *certObj = reinterpret_cast<CfOpensslCertObj *>(obj021);
+        ASSERT_EQ(certObj->peek.tbsValid, true) << "The cert fields are not located, index:" << i;
+
+        for (uint32_t j = 0; j < sizeof(items) / sizeof(items[0]); ++j) {
+            CfBlob peeked = { 0, nullptr };
+            certObj->peek.tbsValid = true;
+            ret = CfOpensslGetCertItem(obj021, items[j], &peeked);
+            EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get peeked item test failed, item:" << items[j];
+
+            CfBlob decoded = { 0, nullptr };
+            certObj->peek.tbsValid = false; /* force the decoded route */
+            ret = CfOpensslGetCertItem(obj021, items[j], &decoded);
+            EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get decoded item test failed, item:" << items[j];
+            EXPECT_EQ(CompareBlob(&peeked, &decoded), true) << "The peeked item is different, item:" << items[j];
+            CfFree(peeked.data);
+            CfFree(decoded.data);
+        }
+        CfOpensslDestoryCert(&obj021);
+    }
+}
+
+/**
+ * @tc.name: OpensslGetCertItemTest022
+ * @tc.desc: Test CertFramework adapter create cert and get routing fields interface performance
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest022, TestSize.Level0)
+{
+    const CfItemId items[] = { CF_ITEM_SERIAL_NUMBER, CF_ITEM_ISSUE_NAME, CF_ITEM_SUBJECT_NAME, CF_ITEM_NOT_AFTER };
+    for (uint32_t i = 0; i < PERFORMANCE_COUNT; ++i) { /* run 1000 times */
+        CfBase *obj022 = nullptr;
+        int32_t ret = CfOpensslCreateCert(&g_cert[0], &obj022);
+        ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+        for (uint32_t j = 0; j < sizeof(items) / sizeof(items[0]); ++j) {
+            CfBlob outBlob022 = { 0, nullptr };
+            ret = CfOpensslGetCertItem(obj022, items[j], &outBlob022);
+            EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert item test failed, item:" << items[j];
+            CfFree(outBlob022.data);
+        }
+        EXPECT_EQ(reinterpret_cast<CfOpensslCertObj *>(obj022)->x509Cert, nullptr) << "The cert is decoded";
+        CfOpensslDestoryCert(&obj022);
+    }
+}
+
+/**
+ * @tc.name: OpensslGetCertItemTest023
+ * @tc.desc: Test CertFramework adapter get cert item interface from several threads on the first decoding
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslGetCertItemTest023, TestSize.Level0)
+{
+    constexpr uint32_t threadCount = 4;
+    for (uint32_t i = 0; i < PERFORMANCE_COUNT / threadCount; ++i) {
+        CfBase *obj023 = nullptr;
+        int32_t ret = CfOpensslCreateCert(&g_cert[0], &obj023);
+        ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+        int32_t results[threadCount] = { 0 };
+        std::vector<std::thread> threads;
+        for (uint32_t j = 0; j < threadCount; ++j) {
+            threads.emplace_back([obj023, &results, j]() {
+                CfBlob outBlob023 = { 0, nullptr };
+                results[j] = CfOpensslGetCertItem(obj023, CF_ITEM_EXTENSIONS, &outBlob023);
+                CfFree(outBlob023.data);
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        for (uint32_t j = 0; j < threadCount; ++j) {
+            EXPECT_EQ(results[j], CF_SUCCESS) << "Normal adapter get cert item test failed, thread:" << j;
+        }
+        CfOpensslDestoryCert(&obj023);
+    }
+}
+
+/**
+ * @tc.name: OpensslDupCertTest001
+ * @tc.desc: Test CertFramework adapter dup cert interface, the decoded cert is shared
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslDupCertTest001, TestSize.Level0)
+{
+    CfBase *obj001 = nullptr;
+    int32_t ret = CfOpensslCreateCert(&g_cert[0], &obj001);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+    CfBase *dupObj001 = nullptr;
+    ret = CfOpensslDupCert(obj001, &dupObj001); /* not decoded yet */
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter dup cert object test failed, recode:" << ret;
+    EXPECT_EQ(reinterpret_cast<CfOpensslCertObj *>(dupObj001)->x509Cert, nullptr);
+    CfOpensslDestoryCert(&dupObj001);
+
+    CfBlob outBlob001 = { 0, nullptr };
+    ret = CfOpensslGetCertItem(obj001, CF_ITEM_EXTENSIONS, &outBlob001);
+    EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert item test failed, recode:" << ret;
+    CfFree(outBlob001.data);
+
+    ret = CfOpensslDupCert(obj001, &dupObj001);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter dup cert object test failed, recode:" << ret;
+    X509 *x509Cert = reinterpret_cast<CfOpensslCertObj *>(obj001)->x509Cert;
+    EXPECT_NE(x509Cert, nullptr);
+    EXPECT_EQ(reinterpret_cast<CfOpensslCertObj *>(dupObj001)->x509Cert, x509Cert);
+    CfOpensslDestoryCert(&obj001);
+
+    CfBlob encoded = { 0, nullptr };
+    ret = CfOpensslGetCertItem(dupObj001, CF_ITEM_ENCODED, &encoded);
+    EXPECT_EQ(ret, CF_SUCCESS) << "Normal adapter get cert item test failed, recode:" << ret;
+    EXPECT_EQ(encoded.size, g_cert[0].len);
+    CfFree(encoded.data);
+    CfOpensslDestoryCert(&dupObj001);
+}
+
+/**
+ * @tc.name: OpensslDupCertTest002
+ * @tc.desc: Test CertFramework adapter dup cert interface Abnormal function
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterCertTest, OpensslDupCertTest002, TestSize.Level0)
+{
+    CfBase *obj002 = nullptr;
+    int32_t ret = CfOpensslCreateCert(&g_cert[0], &obj002);
+    ASSERT_EQ(ret, CF_SUCCESS) << "Normal adapter create cert object test failed, recode:" << ret;
+
+    CfBase *dupObj002 = nullptr;
+    EXPECT_NE(CfOpensslDupCert(nullptr, &dupObj002), CF_SUCCESS);
+    EXPECT_NE(CfOpensslDupCert(obj002, nullptr), CF_SUCCESS);
+
+    obj002->type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_EXTENSION); /* object type error */
+    EXPECT_NE(CfOpensslDupCert(obj002, &dupObj002), CF_SUCCESS);
+    obj002->type = CF_MAGIC(CF_MAGIC_TYPE_ADAPTER_RESOURCE, CF_OBJ_TYPE_CERT); /* normal case */
+    CfOpensslDestoryCert(&obj002);
+}
 }
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include "cf_result.h"
+#include "x509_cert_chain_cache_openssl.h"
+#include "x509_cert_chain_validator_openssl.h"
+
+#include "cf_test_chain_common.h"
+#include "cf_test_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkChainTest;
+
+namespace {
+constexpr uint32_t DEFAULT_TTL = 300; /* seconds, the TTL of the cache */
+constexpr unsigned long CACHE_FLAGS = X509_V_FLAG_NO_CHECK_TIME; /* the flags the validator keys paths with */
+
+TestChainCert g_root;
+TestChainCert g_inter;
+TestChainCert g_leaf;
+
+class CfAdapterChainCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfAdapterChainCacheTest::SetUpTestCase(void)
+{
+    g_root = IssueTestChainCert("Cache Root", nullptr, GetTestCaExtensions());
+    g_inter = IssueTestChainCert("Cache Inter", &g_root, GetTestCaExtensions());
+    g_leaf = IssueTestChainCert("Cache Leaf", &g_inter, {});
+}
+
+void CfAdapterChainCacheTest::TearDownTestCase(void)
+{
+    FreeTestChainCert(g_leaf);
+    FreeTestChainCert(g_inter);
+    FreeTestChainCert(g_root);
+}
+
+void CfAdapterChainCacheTest::SetUp()
+{
+}
+
+void CfAdapterChainCacheTest::TearDown()
+{
+}
+
+static CfResult Validate(const std::vector<X509 *> &certs)
+{
+    std::vector<std::vector<uint8_t>> ders;
+    std::vector<CfBlob> blobs;
+    for (X509 *x509 : certs) {
+        ders.push_back(EncodeTestChainCert(x509));
+    }
+    for (std::vector<uint8_t> &der : ders) {
+        blobs.push_back({ static_cast<uint32_t>(der.size()), der.data() });
+    }
+    HcfCertChainValidatorSpi *spi = nullptr;
+    CfResult ret = HcfCertChainValidatorSpiCreate(&spi);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    CfArray certsList = { blobs.data(), CF_FORMAT_DER, static_cast<uint32_t>(blobs.size()) };
+    ret = spi->engineValidate(spi, &certsList);
+    CfObjDestroy(spi);
+    return ret;
+}
+
+/* Whether the path from the issuer of a leaf up to the top is cached. */
+static bool IsPathCached(const std::vector<X509 *> &upper)
+{
+    uint8_t key[CF_CHAIN_CACHE_KEY_LEN] = { 0 };
+    if (CfChainCacheGetKey(CACHE_FLAGS, upper.data(), upper.size(), key) != CF_SUCCESS) {
+        return false;
+    }
+    return CfChainCacheContains(key);
+}
+
+/**
+ * @tc.name: CfAdapterChainCacheTest001
+ * @tc.desc: a validated upper path is cached, other paths and other flags miss
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterChainCacheTest, CfAdapterChainCacheTest001, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    TestChainCert other = IssueTestChainCert("Cache Other Inter", &g_root, GetTestCaExtensions());
+    ASSERT_NE(other.x509, nullptr);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, g_root.x509 }), false);
+
+    EXPECT_EQ(Validate({ g_leaf.x509, g_inter.x509, g_root.x509 }), CF_SUCCESS);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, g_root.x509 }), true);
+    EXPECT_EQ(IsPathCached({ other.x509, g_root.x509 }), false);
+    EXPECT_EQ(IsPathCached({ g_root.x509 }), false);
+
+    X509 *upper[] = { g_inter.x509, g_root.x509 };
+    uint8_t key[CF_CHAIN_CACHE_KEY_LEN] = { 0 };
+    ASSERT_EQ(CfChainCacheGetKey(CACHE_FLAGS | X509_V_FLAG_PARTIAL_CHAIN, upper, 2, key), CF_SUCCESS);
+    EXPECT_EQ(CfChainCacheContains(key), false);
+    FreeTestChainCert(other);
+}
+
+/**
+ * @tc.name: CfAdapterChainCacheTest002
+ * @tc.desc: on a hit the leaf is still verified against its cached issuer
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterChainCacheTest, CfAdapterChainCacheTest002, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    EXPECT_EQ(Validate({ g_leaf.x509, g_inter.x509, g_root.x509 }), CF_SUCCESS);
+    ASSERT_EQ(IsPathCached({ g_inter.x509, g_root.x509 }), true);
+
+    TestChainCert leaf = IssueTestChainCert("Cache Leaf 2", &g_inter, {});
+    /* same names as the cached intermediate, another key, so only the signature of the leaf is wrong */
+    TestChainCert forger = IssueTestChainCert("Cache Inter", &g_root, GetTestCaExtensions());
+    TestChainCert forged = IssueTestChainCert("Cache Leaf", &forger, {});
+    ASSERT_NE(leaf.x509, nullptr);
+    ASSERT_NE(forged.x509, nullptr);
+    EXPECT_EQ(Validate({ leaf.x509, g_inter.x509, g_root.x509 }), CF_SUCCESS);
+    EXPECT_EQ(Validate({ forged.x509, g_inter.x509, g_root.x509 }), CF_ERR_CERT_SIGNATURE_FAILURE);
+    FreeTestChainCert(forged);
+    FreeTestChainCert(forger);
+    FreeTestChainCert(leaf);
+}
+
+/**
+ * @tc.name: CfAdapterChainCacheTest003
+ * @tc.desc: a cached path expires after the TTL
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterChainCacheTest, CfAdapterChainCacheTest003, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Cache TTL Root", nullptr, GetTestCaExtensions());
+    ASSERT_NE(root.x509, nullptr);
+    X509 *upper[] = { root.x509 };
+    uint8_t key[CF_CHAIN_CACHE_KEY_LEN] = { 0 };
+    ASSERT_EQ(CfChainCacheGetKey(CACHE_FLAGS, upper, 1, key), CF_SUCCESS);
+
+    CfChainCacheSetTtl(0);
+    CfChainCacheAdd(key);
+    EXPECT_EQ(CfChainCacheContains(key), false);
+
+    CfChainCacheSetTtl(1);
+    CfChainCacheAdd(key);
+    EXPECT_EQ(CfChainCacheContains(key), true);
+    std::this_thread::sleep_for(std::chrono::seconds(2)); /* past the TTL of 1 second */
+    EXPECT_EQ(CfChainCacheContains(key), false);
+
+    CfChainCacheSetTtl(DEFAULT_TTL);
+    CfChainCacheAdd(key);
+    EXPECT_EQ(CfChainCacheContains(key), true);
+    FreeTestChainCert(root);
+}
+
+/**
+ * @tc.name: CfAdapterChainCacheTest004
+ * @tc.desc: a path under a changed anchor misses, even with the name and key of the cached one
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterChainCacheTest, CfAdapterChainCacheTest004, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    EXPECT_EQ(Validate({ g_leaf.x509, g_inter.x509, g_root.x509 }), CF_SUCCESS);
+    ASSERT_EQ(IsPathCached({ g_inter.x509, g_root.x509 }), true);
+
+    /* the root issued again with another serial, the same name and key */
+    TestChainCert reissued = IssueTestChainCert("Cache Root", nullptr, GetTestCaExtensions(), 2, g_root.key);
+    /* another root of the same name, which did not sign the intermediate */
+    TestChainCert impostor = IssueTestChainCert("Cache Root", nullptr, GetTestCaExtensions());
+    ASSERT_NE(reissued.x509, nullptr);
+    ASSERT_NE(impostor.x509, nullptr);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, reissued.x509 }), false);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, impostor.x509 }), false);
+
+    EXPECT_EQ(Validate({ g_leaf.x509, g_inter.x509, impostor.x509 }), CF_ERR_CERT_SIGNATURE_FAILURE);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, impostor.x509 }), false);
+    EXPECT_EQ(Validate({ g_leaf.x509, g_inter.x509, reissued.x509 }), CF_SUCCESS);
+    EXPECT_EQ(IsPathCached({ g_inter.x509, reissued.x509 }), true);
+    FreeTestChainCert(impostor);
+    FreeTestChainCert(reissued);
+}
+
+/**
+ * @tc.name: CfAdapterChainCacheTest005
+ * @tc.desc: a path with name constraints, policy constraints or inhibitAnyPolicy is validated but never cached
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfAdapterChainCacheTest, CfAdapterChainCacheTest005, TestSize.Level0)
+{
+    const TestExtensions constraints = {
+        { NID_name_constraints, "critical,permitted;DNS:example.com" },
+        { NID_policy_constraints, "critical,inhibitPolicyMapping:0" },
+        { NID_inhibit_any_policy, "critical,0" },
+    };
+    long serial = 1;
+    for (const std::pair<int, std::string> &constraint : constraints) {
+        TestExtensions extensions = GetTestCaExtensions();
+        extensions.push_back(constraint);
+        TestChainCert inter = IssueTestChainCert("Cache Constrained Inter", &g_root, extensions, ++serial);
+        TestChainCert leaf = IssueTestChainCert("Cache Leaf", &inter, {});
+        ASSERT_NE(leaf.x509, nullptr);
+
+        X509 *upper[] = { inter.x509, g_root.x509 };
+        EXPECT_EQ(CfChainCacheIsCacheable(upper, 2), false);
+        EXPECT_EQ(Validate({ leaf.x509, inter.x509, g_root.x509 }), CF_SUCCESS);
+        EXPECT_EQ(IsPathCached({ inter.x509, g_root.x509 }), false);
+        FreeTestChainCert(leaf);
+        FreeTestChainCert(inter);
+    }
+    X509 *upper[] = { g_inter.x509, g_root.x509 };
+    EXPECT_EQ(CfChainCacheIsCacheable(upper, 2), true);
+}
+}
@@ -1,592 +1,1052 @@
-/*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include <gtest/gtest.h>
-
-#include "cf_log.h"
-#include "cf_memory.h"
-#include "cf_result.h"
-#include "cf_type.h"
-#include "utils.h"
-
-using namespace testing::ext;
-namespace {
-constexpr uint32_t TEST_DEFAULT_SIZE = 10;
-constexpr uint32_t TEST_DEFAULT_COUNT = 2;
-class CfCommonTest : public testing::Test {
-public:
-    static void SetUpTestCase(void);
-
-    static void TearDownTestCase(void);
-
-    void SetUp();
-
-    void TearDown();
-};
-
-void CfCommonTest::SetUpTestCase(void)
-{
-}
-
-void CfCommonTest::TearDownTestCase(void)
-{
-}
-
-void CfCommonTest::SetUp()
-{
-}
-
-void CfCommonTest::TearDown()
-{
-}
-
-/**
-* @tc.name: CfBlobDataFree001
-* @tc.desc: CfBlobDataFree blob is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataFree001, TestSize.Level0)
-{
-    CfBlobDataFree(nullptr);
-}
-
-/**
-* @tc.name: CfBlobDataFree002
-* @tc.desc: CfBlobDataFree blob.data is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataFree002, TestSize.Level0)
-{
-    CfBlob blob = { 0, nullptr };
-    CfBlobDataFree(&blob);
-}
-
-/**
-* @tc.name: CfBlobDataFree003
-* @tc.desc: CfBlobDataFree normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataFree003, TestSize.Level0)
-{
-    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
-    blob.data = static_cast<uint8_t *>(CfMalloc(blob.size));
-    ASSERT_NE(blob.data, nullptr);
-    CfBlobDataFree(&blob);
-}
-
-/**
-* @tc.name: CfBlobDataClearAndFree001
-* @tc.desc: CfBlobDataClearAndFree blob is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataClearAndFree001, TestSize.Level0)
-{
-    CfBlobDataClearAndFree(nullptr);
-}
-
-/**
-* @tc.name: CfBlobDataClearAndFree002
-* @tc.desc: CfBlobDataClearAndFree blob.data is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataClearAndFree002, TestSize.Level0)
-{
-    CfBlob blob = { 0, nullptr };
-    CfBlobDataClearAndFree(&blob);
-}
-
-/**
-* @tc.name: CfBlobDataClearAndFree003
-* @tc.desc: CfBlobDataClearAndFree normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfBlobDataClearAndFree003, TestSize.Level0)
-{
-    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
-    blob.data = static_cast<uint8_t *>(CfMalloc(blob.size));
-    ASSERT_NE(blob.data, nullptr);
-    CfBlobDataClearAndFree(&blob);
-}
-
-/**
-* @tc.name: CfEncodingBlobDataFree001
-* @tc.desc: CfEncodingBlobDataFree encodingBlob is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfEncodingBlobDataFree001, TestSize.Level0)
-{
-    CfEncodingBlobDataFree(nullptr);
-}
-
-/**
-* @tc.name: CfEncodingBlobDataFree001
-* @tc.desc: CfEncodingBlobDataFree encodingBlob.data is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfEncodingBlobDataFree002, TestSize.Level0)
-{
-    CfEncodingBlob blob = { nullptr, 0, CF_FORMAT_DER };
-    CfEncodingBlobDataFree(&blob);
-}
-
-/**
-* @tc.name: CfEncodingBlobDataFree003
-* @tc.desc: CfEncodingBlobDataFree normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfEncodingBlobDataFree003, TestSize.Level0)
-{
-    CfEncodingBlob blob = { nullptr, TEST_DEFAULT_SIZE, CF_FORMAT_DER };
-    blob.data = static_cast<uint8_t *>(CfMalloc(blob.len));
-    ASSERT_NE(blob.data, nullptr);
-    CfEncodingBlobDataFree(&blob);
-}
-
-/**
-* @tc.name: CfArrayDataClearAndFree001
-* @tc.desc: CfArrayDataClearAndFree array is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfArrayDataClearAndFree001, TestSize.Level0)
-{
-    CfArrayDataClearAndFree(nullptr);
-}
-
-/**
-* @tc.name: CfArrayDataClearAndFree002
-* @tc.desc: CfArrayDataClearAndFree normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfArrayDataClearAndFree002, TestSize.Level0)
-{
-    CfArray array = { nullptr, CF_FORMAT_DER, TEST_DEFAULT_COUNT };
-    array.data = static_cast<CfBlob *>(CfMalloc(array.count * sizeof(CfBlob)));
-    ASSERT_NE(array.data, nullptr);
-
-    for (uint32_t i = 0; i < array.count; ++i) {
-        array.data[i].size = TEST_DEFAULT_SIZE;
-        array.data[i].data = static_cast<uint8_t *>(CfMalloc(array.data[i].size));
-        ASSERT_NE(array.data[i].data, nullptr);
-    }
-
-    CfArrayDataClearAndFree(&array);
-}
-
-/**
-* @tc.name: FreeCfBlobArray001
-* @tc.desc: FreeCfBlobArray array is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, FreeCfBlobArray001, TestSize.Level0)
-{
-    FreeCfBlobArray(nullptr, 0);
-}
-
-/**
-* @tc.name: FreeCfBlobArray002
-* @tc.desc: FreeCfBlobArray normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, FreeCfBlobArray002, TestSize.Level0)
-{
-    CfBlob *array = static_cast<CfBlob *>(CfMalloc(TEST_DEFAULT_COUNT * sizeof(CfBlob)));
-    ASSERT_NE(array, nullptr);
-
-    FreeCfBlobArray(array, TEST_DEFAULT_COUNT);
-}
-
-/**
-* @tc.name: FreeCfBlobArray003
-* @tc.desc: FreeCfBlobArray normal case 2
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, FreeCfBlobArray003, TestSize.Level0)
-{
-    CfBlob *array = static_cast<CfBlob *>(CfMalloc(TEST_DEFAULT_COUNT * sizeof(CfBlob)));
-    ASSERT_NE(array, nullptr);
-
-    for (uint32_t i = 0; i < TEST_DEFAULT_COUNT; ++i) {
-        array[i].size = TEST_DEFAULT_SIZE;
-        array[i].data = static_cast<uint8_t *>(CfMalloc(array[i].size));
-        ASSERT_NE(array[i].data, nullptr);
-    }
-
-    FreeCfBlobArray(array, TEST_DEFAULT_COUNT);
-}
-
-/**
-* @tc.name: CfLogTest001
-* @tc.desc: Test Log Warn
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest001, TestSize.Level0)
-{
-    CF_LOG_W("this is test for log Warn");
-}
-
-/**
-* @tc.name: CfLogTest002
-* @tc.desc: Test Log Info
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest002, TestSize.Level0)
-{
-    CF_LOG_I("this is test for log Info");
-}
-
-/**
-* @tc.name: CfLogTest003
-* @tc.desc: Test Log Error
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest003, TestSize.Level0)
-{
-    CF_LOG_E("this is test for log Error");
-}
-
-/**
-* @tc.name: CfLogTest004
-* @tc.desc: Test Log Debug
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest004, TestSize.Level0)
-{
-    CF_LOG_D("this is test for log Debug");
-}
-
-/**
-* @tc.name: CfLogTest005
-* @tc.desc: Test Log ID INVALID
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest005, TestSize.Level0)
-{
-    CfLog(CF_LOG_LEVEL_D + 1, __func__, __LINE__, "this is test for default branch");
-}
-
-/**
-* @tc.name: CfLogTest006
-* @tc.desc: Test Log info length more than 512
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfLogTest006, TestSize.Level0)
-{
-    CF_LOG_W("MoreThan512Bytes................................................"
-        "................................................................"
-        "................................................................"
-        "................................................................"
-        "................................................................"
-        "................................................................"
-        "................................................................"
-        "..................................................................");
-}
-
-/**
-* @tc.name: CfMemTest001
-* @tc.desc: malloc and free normal
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfMemTest001, TestSize.Level0)
-{
-    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(TEST_DEFAULT_SIZE));
-    ASSERT_NE(buf, nullptr);
-    CfFree(buf);
-}
-
-/**
-* @tc.name: CfMemTest002
-* @tc.desc: malloc 0
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfMemTest002, TestSize.Level0)
-{
-    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(0));
-    ASSERT_EQ(buf, nullptr);
-}
-
-/**
-* @tc.name: CfMemTest003
-* @tc.desc: malloc more than MAX_MEMORY_SIZE
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfMemTest003, TestSize.Level0)
-{
-    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(MAX_MEMORY_SIZE + 1));
-    ASSERT_EQ(buf, nullptr);
-}
-
-/**
-* @tc.name: CfMemTest004
-* @tc.desc: free nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, CfMemTest004, TestSize.Level0)
-{
-    CfFree(nullptr);
-}
-
-/**
-* @tc.name: IsStrValid001
-* @tc.desc: str is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsStrValid001, TestSize.Level0)
-{
-    bool checkRes = IsStrValid(nullptr, 0);
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsStrValid002
-* @tc.desc: len invalid
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsStrValid002, TestSize.Level0)
-{
-    char str[] = "this is test for beyond max length.";
-    bool checkRes = IsStrValid(str, TEST_DEFAULT_SIZE);
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsStrValid003
-* @tc.desc: normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsStrValid003, TestSize.Level0)
-{
-    char str[] = "123456789";
-    bool checkRes = IsStrValid(str, TEST_DEFAULT_SIZE);
-    EXPECT_EQ(checkRes, true);
-}
-
-/**
-* @tc.name: IsBlobValid001
-* @tc.desc: normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsBlobValid001, TestSize.Level0)
-{
-    uint8_t blobData[] = "normal case";
-    CfBlob blob = { sizeof(blobData), blobData };
-    bool checkRes = IsBlobValid(&blob);
-    EXPECT_EQ(checkRes, true);
-}
-
-/**
-* @tc.name: IsBlobValid002
-* @tc.desc: blob is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsBlobValid002, TestSize.Level0)
-{
-    bool checkRes = IsBlobValid(nullptr);
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsBlobValid003
-* @tc.desc: blob data is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsBlobValid003, TestSize.Level0)
-{
-    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
-    bool checkRes = IsBlobValid(&blob);
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsBlobValid004
-* @tc.desc: blob size is 0
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsBlobValid004, TestSize.Level0)
-{
-    uint8_t blobData[] = "invalid blob size is 0";
-    CfBlob blob = { 0, blobData };
-    bool checkRes = IsBlobValid(&blob);
-    EXPECT_EQ(checkRes, false);
-}
-
-static const char *GetClass(void)
-{
-    return "TEST_FOR_GET_CLASS";
-}
-
-static const char *GetClassNull(void)
-{
-    return nullptr;
-}
-
-/**
-* @tc.name: IsClassMatch001
-* @tc.desc: obj is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsClassMatch001, TestSize.Level0)
-{
-    bool checkRes = IsClassMatch(nullptr, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsClassMatch002
-* @tc.desc: obj->getClass() is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsClassMatch002, TestSize.Level0)
-{
-    CfObjectBase obj = { GetClassNull, nullptr };
-    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsClassMatch003
-* @tc.desc: class is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsClassMatch003, TestSize.Level0)
-{
-    CfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsClassMatch(&obj, nullptr);
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsClassMatch004
-* @tc.desc: normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsClassMatch004, TestSize.Level0)
-{
-    CfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, true);
-}
-
-/**
-* @tc.name: IsClassMatch005
-* @tc.desc: class not equal
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsClassMatch005, TestSize.Level0)
-{
-    CfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS123");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsPubKeyClassMatch001
-* @tc.desc: normal case
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsPubKeyClassMatch001, TestSize.Level0)
-{
-    HcfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, true);
-}
-
-/**
-* @tc.name: IsPubKeyClassMatch002
-* @tc.desc: class not equal
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsPubKeyClassMatch002, TestSize.Level0)
-{
-    HcfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS000");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsPubKeyClassMatch003
-* @tc.desc: obj is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsPubKeyClassMatch003, TestSize.Level0)
-{
-    bool checkRes = IsPubKeyClassMatch(nullptr, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsPubKeyClassMatch004
-* @tc.desc: obj->getClass() is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsPubKeyClassMatch004, TestSize.Level0)
-{
-    HcfObjectBase obj = { GetClassNull, nullptr };
-    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS");
-    EXPECT_EQ(checkRes, false);
-}
-
-/**
-* @tc.name: IsPubKeyClassMatch005
-* @tc.desc: class is nullptr
-* @tc.type: FUNC
-* @tc.require: AR000HS2RB /SR000HS2Q1
-*/
-HWTEST_F(CfCommonTest, IsPubKeyClassMatch005, TestSize.Level0)
-{
-    HcfObjectBase obj = { GetClass, nullptr };
-    bool checkRes = IsPubKeyClassMatch(&obj, nullptr);
-    EXPECT_EQ(checkRes, false);
-}
-} // end of namespace
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+#include "securec.h"
+
+#include "cf_check.h"
+#include "cf_log.h"
+#include "cf_memory.h"
+#include "cf_pem.h"
+#include "cf_reject.h"
+#include "cf_result.h"
+#include "cf_type.h"
+#include "napi_cert_ctx_pool.h"
+#include "utils.h"
+
+using namespace testing::ext;
+namespace {
+constexpr uint32_t TEST_DEFAULT_SIZE = 10;
+constexpr uint32_t TEST_DEFAULT_COUNT = 2;
+constexpr uint32_t TEST_BENCHMARK_SIZE = 1024 * 1024;
+constexpr uint32_t TEST_BENCHMARK_COUNT = 20;
+constexpr uint32_t TEST_PEM_LINE_CHARS = 64;
+constexpr uint32_t TEST_CTX_SIZE = 256; /* about the size of the async contexts of the bindings */
+constexpr uint32_t TEST_CTX_BENCHMARK_COUNT = 1000000;
+class CfCommonTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfCommonTest::SetUpTestCase(void)
+{
+}
+
+void CfCommonTest::TearDownTestCase(void)
+{
+}
+
+void CfCommonTest::SetUp()
+{
+}
+
+void CfCommonTest::TearDown()
+{
+}
+
+/**
+* @tc.name: CfBlobDataFree001
+* @tc.desc: CfBlobDataFree blob is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataFree001, TestSize.Level0)
+{
+    CfBlobDataFree(nullptr);
+}
+
+/**
+* @tc.name: CfBlobDataFree002
+* @tc.desc: CfBlobDataFree blob.data is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataFree002, TestSize.Level0)
+{
+    CfBlob blob = { 0, nullptr };
+    CfBlobDataFree(&blob);
+}
+
+/**
+* @tc.name: CfBlobDataFree003
+* @tc.desc: CfBlobDataFree normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataFree003, TestSize.Level0)
+{
+    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
+    blob.data = static_cast<uint8_t *>(CfMalloc(blob.size));
+    ASSERT_NE(blob.data, nullptr);
+    CfBlobDataFree(&blob);
+}
+
+/**
+* @tc.name: CfBlobDataClearAndFree001
+* @tc.desc: CfBlobDataClearAndFree blob is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataClearAndFree001, TestSize.Level0)
+{
+    CfBlobDataClearAndFree(nullptr);
+}
+
+/**
+* @tc.name: CfBlobDataClearAndFree002
+* @tc.desc: CfBlobDataClearAndFree blob.data is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataClearAndFree002, TestSize.Level0)
+{
+    CfBlob blob = { 0, nullptr };
+    CfBlobDataClearAndFree(&blob);
+}
+
+/**
+* @tc.name: CfBlobDataClearAndFree003
+* @tc.desc: CfBlobDataClearAndFree normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfBlobDataClearAndFree003, TestSize.Level0)
+{
+    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
+    blob.data = static_cast<uint8_t *>(CfMalloc(blob.size));
+    ASSERT_NE(blob.data, nullptr);
+    CfBlobDataClearAndFree(&blob);
+}
+
+/**
+* @tc.name: CfEncodingBlobDataFree001
+* @tc.desc: CfEncodingBlobDataFree encodingBlob is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfEncodingBlobDataFree001, TestSize.Level0)
+{
+    CfEncodingBlobDataFree(nullptr);
+}
+
+/**
+* @tc.name: CfEncodingBlobDataFree001
+* @tc.desc: CfEncodingBlobDataFree encodingBlob.data is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfEncodingBlobDataFree002, TestSize.Level0)
+{
+    CfEncodingBlob blob = { nullptr, 0, CF_FORMAT_DER };
+    CfEncodingBlobDataFree(&blob);
+}
+
+/**
+* @tc.name: CfEncodingBlobDataFree003
+* @tc.desc: CfEncodingBlobDataFree normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfEncodingBlobDataFree003, TestSize.Level0)
+{
+    CfEncodingBlob blob = { nullptr, TEST_DEFAULT_SIZE, CF_FORMAT_DER };
+    blob.data = static_cast<uint8_t *>(CfMalloc(blob.len));
+    ASSERT_NE(blob.data, nullptr);
+    CfEncodingBlobDataFree(&blob);
+}
+
+/**
+* @tc.name: CfArrayDataClearAndFree001
+* @tc.desc: CfArrayDataClearAndFree array is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfArrayDataClearAndFree001, TestSize.Level0)
+{
+    CfArrayDataClearAndFree(nullptr);
+}
+
+/**
+* @tc.name: CfArrayDataClearAndFree002
+* @tc.desc: CfArrayDataClearAndFree normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfArrayDataClearAndFree002, TestSize.Level0)
+{
+    CfArray array = { nullptr, CF_FORMAT_DER, TEST_DEFAULT_COUNT };
+    array.data = static_cast<CfBlob *>(CfMalloc(array.count * sizeof(CfBlob)));
+    ASSERT_NE(array.data, nullptr);
+
+    for (uint32_t i = 0; i < array.count; ++i) {
+        array.data[i].size = TEST_DEFAULT_SIZE;
+        array.data[i].data = static_cast<uint8_t *>(CfMalloc(array.data[i].size));
+        ASSERT_NE(array.data[i].data, nullptr);
+    }
+
+    CfArrayDataClearAndFree(&array);
+}
+
+/**
+* @tc.name: FreeCfBlobArray001
+* @tc.desc: FreeCfBlobArray array is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, FreeCfBlobArray001, TestSize.Level0)
+{
+    FreeCfBlobArray(nullptr, 0);
+}
+
+/**
+* @tc.name: FreeCfBlobArray002
+* @tc.desc: FreeCfBlobArray normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, FreeCfBlobArray002, TestSize.Level0)
+{
+    CfBlob *array = static_cast<CfBlob *>(CfMalloc(TEST_DEFAULT_COUNT * sizeof(CfBlob)));
+    ASSERT_NE(array, nullptr);
+
+    FreeCfBlobArray(array, TEST_DEFAULT_COUNT);
+}
+
+/**
+* @tc.name: FreeCfBlobArray003
+* @tc.desc: FreeCfBlobArray normal case 2
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, FreeCfBlobArray003, TestSize.Level0)
+{
+    CfBlob *array = static_cast<CfBlob *>(CfMalloc(TEST_DEFAULT_COUNT * sizeof(CfBlob)));
+    ASSERT_NE(array, nullptr);
+
+    for (uint32_t i = 0; i < TEST_DEFAULT_COUNT; ++i) {
+        array[i].size = TEST_DEFAULT_SIZE;
+        array[i].data = static_cast<uint8_t *>(CfMalloc(array[i].size));
+        ASSERT_NE(array[i].data, nullptr);
+    }
+
+    FreeCfBlobArray(array, TEST_DEFAULT_COUNT);
+}
+
+/**
+* @tc.name: CfLogTest001
+* @tc.desc: Test Log Warn
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest001, TestSize.Level0)
+{
+    CF_LOG_W("this is test for log Warn");
+}
+
+/**
+* @tc.name: CfLogTest002
+* @tc.desc: Test Log Info
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest002, TestSize.Level0)
+{
+    CF_LOG_I("this is test for log Info");
+}
+
+/**
+* @tc.name: CfLogTest003
+* @tc.desc: Test Log Error
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest003, TestSize.Level0)
+{
+    CF_LOG_E("this is test for log Error");
+}
+
+/**
+* @tc.name: CfLogTest004
+* @tc.desc: Test Log Debug
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest004, TestSize.Level0)
+{
+    CF_LOG_D("this is test for log Debug");
+}
+
+/**
+* @tc.name: CfLogTest005
+* @tc.desc: Test Log ID INVALID
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest005, TestSize.Level0)
+{
+    CfLog(CF_LOG_LEVEL_D + 1, __func__, __LINE__, "this is test for default branch");
+}
+
+/**
+* @tc.name: CfLogTest006
+* @tc.desc: Test Log info length more than 512
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfLogTest006, TestSize.Level0)
+{
+    CF_LOG_W("MoreThan512Bytes................................................"
+        "................................................................"
+        "................................................................"
+        "................................................................"
+        "................................................................"
+        "................................................................"
+        "................................................................"
+        "..................................................................");
+}
+
+/**
+* @tc.name: CfMemTest001
+* @tc.desc: malloc and free normal
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfMemTest001, TestSize.Level0)
+{
+    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(TEST_DEFAULT_SIZE));
+    ASSERT_NE(buf, nullptr);
+    CfFree(buf);
+}
+
+/**
+* @tc.name: CfMemTest002
+* @tc.desc: malloc 0
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfMemTest002, TestSize.Level0)
+{
+    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(0));
+    ASSERT_EQ(buf, nullptr);
+}
+
+/**
+* @tc.name: CfMemTest003
+* @tc.desc: malloc more than MAX_MEMORY_SIZE
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfMemTest003, TestSize.Level0)
+{
+    uint8_t *buf = static_cast<uint8_t *>(CfMalloc(MAX_MEMORY_SIZE + 1));
+    ASSERT_EQ(buf, nullptr);
+}
+
+/**
+* @tc.name: CfMemTest004
+* @tc.desc: free nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfMemTest004, TestSize.Level0)
+{
+    CfFree(nullptr);
+}
+
+/**
+* @tc.name: IsStrValid001
+* @tc.desc: str is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsStrValid001, TestSize.Level0)
+{
+    bool checkRes = IsStrValid(nullptr, 0);
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsStrValid002
+* @tc.desc: len invalid
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsStrValid002, TestSize.Level0)
+{
+    char str[] = "this is test for beyond max length.";
+    bool checkRes = IsStrValid(str, TEST_DEFAULT_SIZE);
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsStrValid003
+* @tc.desc: normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsStrValid003, TestSize.Level0)
+{
+    char str[] = "123456789";
+    bool checkRes = IsStrValid(str, TEST_DEFAULT_SIZE);
+    EXPECT_EQ(checkRes, true);
+}
+
+/**
+* @tc.name: IsBlobValid001
+* @tc.desc: normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsBlobValid001, TestSize.Level0)
+{
+    uint8_t blobData[] = "normal case";
+    CfBlob blob = { sizeof(blobData), blobData };
+    bool checkRes = IsBlobValid(&blob);
+    EXPECT_EQ(checkRes, true);
+}
+
+/**
+* @tc.name: IsBlobValid002
+* @tc.desc: blob is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsBlobValid002, TestSize.Level0)
+{
+    bool checkRes = IsBlobValid(nullptr);
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsBlobValid003
+* @tc.desc: blob data is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsBlobValid003, TestSize.Level0)
+{
+    CfBlob blob = { TEST_DEFAULT_SIZE, nullptr };
+    bool checkRes = IsBlobValid(&blob);
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsBlobValid004
+* @tc.desc: blob size is 0
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsBlobValid004, TestSize.Level0)
+{
+    uint8_t blobData[] = "invalid blob size is 0";
+    CfBlob blob = { 0, blobData };
+    bool checkRes = IsBlobValid(&blob);
+    EXPECT_EQ(checkRes, false);
+}
+
+static const char *GetClass(void)
+{
+    return "TEST_FOR_GET_CLASS";
+}
+
+static const char *GetClassNull(void)
+{
+    return nullptr;
+}
+
+/**
+* @tc.name: IsClassMatch001
+* @tc.desc: obj is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsClassMatch001, TestSize.Level0)
+{
+    bool checkRes = IsClassMatch(nullptr, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsClassMatch002
+* @tc.desc: obj->getClass() is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsClassMatch002, TestSize.Level0)
+{
+    CfObjectBase obj = { GetClassNull, nullptr };
+    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsClassMatch003
+* @tc.desc: class is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsClassMatch003, TestSize.Level0)
+{
+    CfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsClassMatch(&obj, nullptr);
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsClassMatch004
+* @tc.desc: normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsClassMatch004, TestSize.Level0)
+{
+    CfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, true);
+}
+
+/**
+* @tc.name: IsClassMatch005
+* @tc.desc: class not equal
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsClassMatch005, TestSize.Level0)
+{
+    CfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsClassMatch(&obj, "TEST_FOR_GET_CLASS123");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsPubKeyClassMatch001
+* @tc.desc: normal case
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsPubKeyClassMatch001, TestSize.Level0)
+{
+    HcfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, true);
+}
+
+/**
+* @tc.name: IsPubKeyClassMatch002
+* @tc.desc: class not equal
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsPubKeyClassMatch002, TestSize.Level0)
+{
+    HcfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS000");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsPubKeyClassMatch003
+* @tc.desc: obj is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsPubKeyClassMatch003, TestSize.Level0)
+{
+    bool checkRes = IsPubKeyClassMatch(nullptr, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsPubKeyClassMatch004
+* @tc.desc: obj->getClass() is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsPubKeyClassMatch004, TestSize.Level0)
+{
+    HcfObjectBase obj = { GetClassNull, nullptr };
+    bool checkRes = IsPubKeyClassMatch(&obj, "TEST_FOR_GET_CLASS");
+    EXPECT_EQ(checkRes, false);
+}
+
+/**
+* @tc.name: IsPubKeyClassMatch005
+* @tc.desc: class is nullptr
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, IsPubKeyClassMatch005, TestSize.Level0)
+{
+    HcfObjectBase obj = { GetClass, nullptr };
+    bool checkRes = IsPubKeyClassMatch(&obj, nullptr);
+    EXPECT_EQ(checkRes, false);
+}
+/**
+* @tc.name: CfPemDecode001
+* @tc.desc: decode a block with a quantum split across lines and padding, then find no more block
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemDecode001, TestSize.Level0)
+{
+    const char pem[] = "text before\r\n-----BEGIN CERTIFICATE-----\r\nTWFu\r\nTW\r\nE=\r\n-----END CERTIFICATE-----\r\n";
+    const uint8_t expect[] = { 'M', 'a', 'n', 'M', 'a' };
+    uint32_t len = sizeof(pem); /* the terminating zero is part of the input, as for the pem test data */
+    CfBlob der = { 0, nullptr };
+    uint32_t endOffset = 0;
+    int32_t ret = CfPemDecode(reinterpret_cast<const uint8_t *>(pem), len, CF_PEM_LABEL_CERT, &der, &endOffset);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(der.size, sizeof(expect));
+    EXPECT_EQ(memcmp(der.data, expect, sizeof(expect)), 0);
+    EXPECT_EQ(endOffset, len - 1);
+    CfFree(der.data);
+
+    der = { 0, nullptr };
+    ret = CfPemDecode(reinterpret_cast<const uint8_t *>(pem) + endOffset, len - endOffset, CF_PEM_LABEL_CERT,
+        &der, nullptr);
+    EXPECT_EQ(ret, CF_NOT_EXIST);
+}
+
+/**
+* @tc.name: CfPemDecode002
+* @tc.desc: read the blocks of a bundle one after the other
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemDecode002, TestSize.Level0)
+{
+    const char pem[] = "-----BEGIN X509 CRL-----\nAAEC\n-----END X509 CRL-----\n"
+        "-----BEGIN X509 CRL-----\nAw==\n-----END X509 CRL-----";
+    const uint8_t expect[] = { 0x00, 0x01, 0x02 };
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(pem);
+    uint32_t len = strlen(pem);
+    CfBlob der = { 0, nullptr };
+    uint32_t endOffset = 0;
+    int32_t ret = CfPemDecode(data, len, CF_PEM_LABEL_CRL, &der, &endOffset);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(der.size, sizeof(expect));
+    EXPECT_EQ(memcmp(der.data, expect, sizeof(expect)), 0);
+    CfFree(der.data);
+
+    der = { 0, nullptr };
+    uint32_t nextOffset = 0;
+    ret = CfPemDecode(data + endOffset, len - endOffset, CF_PEM_LABEL_CRL, &der, &nextOffset);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(der.size, 1);
+    EXPECT_EQ(der.data[0], 0x03);
+    EXPECT_EQ(endOffset + nextOffset, len);
+    CfFree(der.data);
+}
+
+/**
+* @tc.name: CfPemDecode003
+* @tc.desc: armor and base64 the native decoder does not handle are reported as invalid
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemDecode003, TestSize.Level0)
+{
+    const char *pems[] = {
+        "-----BEGIN CERTIFICATE-----\nProc-Type: 4,ENCRYPTED\n\nTWFu\n-----END CERTIFICATE-----\n",
+        "-----BEGIN X509 CERTIFICATE-----\nTWFu\n-----END X509 CERTIFICATE-----\n",
+        "-----BEGIN CERTIFICATE-----\nTWE=TWFu\n-----END CERTIFICATE-----\n",
+        "-----BEGIN CERTIFICATE-----\nTWFuT\n-----END CERTIFICATE-----\n",
+        "-----BEGIN CERTIFICATE-----\nTWFu\n-----END X509 CRL-----\n",
+        "-----BEGIN CERTIFICATE-----\nTWFu\n",
+        "-----BEGIN CERTIFICATE-----\n-----END CERTIFICATE-----\n",
+    };
+    for (uint32_t i = 0; i < sizeof(pems) / sizeof(pems[0]); ++i) {
+        CfBlob der = { 0, nullptr };
+        int32_t ret = CfPemDecode(reinterpret_cast<const uint8_t *>(pems[i]), strlen(pems[i]), CF_PEM_LABEL_CERT,
+            &der, nullptr);
+        EXPECT_EQ(ret, CF_INVALID_PARAMS) << "index:" << i;
+        EXPECT_EQ(der.data, nullptr) << "index:" << i;
+    }
+
+    CfBlob der = { 0, nullptr };
+    int32_t ret = CfPemDecode(nullptr, 0, CF_PEM_LABEL_CERT, &der, nullptr);
+    EXPECT_EQ(ret, CF_INVALID_PARAMS);
+}
+/**
+* @tc.name: CfPemEncode001
+* @tc.desc: encode der to one PEM block with 64 characters per line
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemEncode001, TestSize.Level0)
+{
+    const uint8_t der[] = { 'M', 'a', 'n', 'M', 'a' };
+    const char *expect = "-----BEGIN X509 CRL-----\nTWFuTWE=\n-----END X509 CRL-----\n";
+    CfBlob pem = { 0, nullptr };
+    int32_t ret = CfPemEncode(der, sizeof(der), CF_PEM_LABEL_CRL, &pem);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(pem.size, strlen(expect));
+    EXPECT_EQ(memcmp(pem.data, expect, pem.size), 0);
+    CfFree(pem.data);
+
+    const uint32_t lens[] = { 1, 2, 3, 47, 48, 49, 96, 1000 }; /* 48 bytes fill one 64 characters line */
+    uint8_t data[1000] = { 0 };
+    for (uint32_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    for (uint32_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+        pem = { 0, nullptr };
+        ret = CfPemEncode(data, lens[i], CF_PEM_LABEL_CERT, &pem);
+        ASSERT_EQ(ret, CF_SUCCESS) << "len:" << lens[i];
+        CfBlob out = { 0, nullptr };
+        ret = CfPemDecode(pem.data, pem.size, CF_PEM_LABEL_CERT, &out, nullptr);
+        ASSERT_EQ(ret, CF_SUCCESS) << "len:" << lens[i];
+        ASSERT_EQ(out.size, lens[i]);
+        EXPECT_EQ(memcmp(out.data, data, lens[i]), 0) << "len:" << lens[i];
+        EXPECT_EQ(pem.data[pem.size - 1], '\n');
+        CfFree(out.data);
+        CfFree(pem.data);
+    }
+}
+
+/**
+* @tc.name: CfPemEncode002
+* @tc.desc: encode with invalid params, and convert an encoding blob in place
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemEncode002, TestSize.Level0)
+{
+    const uint8_t der[] = { 0x30, 0x00 };
+    CfBlob pem = { 0, nullptr };
+    EXPECT_EQ(CfPemEncode(nullptr, sizeof(der), CF_PEM_LABEL_CERT, &pem), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfPemEncode(der, 0, CF_PEM_LABEL_CERT, &pem), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfPemEncode(der, sizeof(der), nullptr, &pem), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfPemEncode(der, sizeof(der), CF_PEM_LABEL_CERT, nullptr), CF_INVALID_PARAMS);
+
+    CfEncodingBlob blob = { static_cast<uint8_t *>(CfMalloc(sizeof(der))), sizeof(der), CF_FORMAT_DER };
+    ASSERT_NE(blob.data, nullptr);
+    (void)memcpy_s(blob.data, blob.len, der, sizeof(der));
+    const char *expect = "-----BEGIN CERTIFICATE-----\nMAA=\n-----END CERTIFICATE-----\n";
+    int32_t ret = CfEncodingBlobToPem(&blob, CF_PEM_LABEL_CERT);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(blob.encodingFormat, CF_FORMAT_PEM);
+    ASSERT_EQ(blob.len, strlen(expect));
+    EXPECT_EQ(memcmp(blob.data, expect, blob.len), 0);
+    CfFree(blob.data);
+}
+
+/**
+* @tc.name: CfCheckDerFraming001
+* @tc.desc: outer framing of a certificate or CRL, short and long form lengths
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfCheckDerFraming001, TestSize.Level0)
+{
+    const uint8_t shortForm[] = { 0x30, 0x02, 0x30, 0x00 };
+    EXPECT_EQ(CfCheckDerFraming(shortForm, sizeof(shortForm)), CF_SUCCESS);
+    const uint8_t longForm[] = { 0x30, 0x81, 0x03, 0x30, 0x01, 0x00 };
+    EXPECT_EQ(CfCheckDerFraming(longForm, sizeof(longForm)), CF_SUCCESS);
+    const uint8_t trailing[] = { 0x30, 0x02, 0x30, 0x00, 0xFF };
+    EXPECT_EQ(CfCheckDerFraming(trailing, sizeof(trailing)), CF_SUCCESS); /* only the first element is read */
+}
+
+/**
+* @tc.name: CfCheckDerFraming002
+* @tc.desc: malformed framing is rejected
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfCheckDerFraming002, TestSize.Level0)
+{
+    const uint8_t notSeq[] = { 0x31, 0x02, 0x30, 0x00 };
+    const uint8_t innerNotSeq[] = { 0x30, 0x02, 0x02, 0x00 };
+    const uint8_t truncated[] = { 0x30, 0x04, 0x30, 0x00 };
+    const uint8_t innerTruncated[] = { 0x30, 0x02, 0x30, 0x01 };
+    const uint8_t indefinite[] = { 0x30, 0x80, 0x30, 0x00, 0x00, 0x00 };
+    const uint8_t hugeLen[] = { 0x30, 0x84, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x00 };
+    const uint8_t tooManyLenBytes[] = { 0x30, 0x85, 0x00, 0x00, 0x00, 0x00, 0x02, 0x30, 0x00 };
+    const uint8_t pem[] = "-----BEGIN CERTIFICATE-----";
+    EXPECT_EQ(CfCheckDerFraming(notSeq, sizeof(notSeq)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(innerNotSeq, sizeof(innerNotSeq)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(truncated, sizeof(truncated)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(innerTruncated, sizeof(innerTruncated)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(indefinite, sizeof(indefinite)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(hugeLen, sizeof(hugeLen)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(tooManyLenBytes, sizeof(tooManyLenBytes)), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(pem, sizeof(pem) - 1), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(notSeq, 0), CF_INVALID_PARAMS);
+    EXPECT_EQ(CfCheckDerFraming(nullptr, sizeof(notSeq)), CF_INVALID_PARAMS);
+}
+
+/**
+* @tc.name: CfCountRejectedInput001
+* @tc.desc: rejected inputs are counted per type, invalid types are ignored
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfCountRejectedInput001, TestSize.Level0)
+{
+    uint64_t certCount = CfGetRejectedInputCount(CF_REJECT_TYPE_CERT);
+    uint64_t crlCount = CfGetRejectedInputCount(CF_REJECT_TYPE_CRL);
+    for (uint32_t i = 0; i < TEST_DEFAULT_SIZE; ++i) {
+        CfCountRejectedInput(CF_REJECT_TYPE_CERT);
+    }
+    CfCountRejectedInput(CF_REJECT_TYPE_CRL);
+    CfCountRejectedInput(CF_REJECT_TYPE_MAX);
+    EXPECT_EQ(CfGetRejectedInputCount(CF_REJECT_TYPE_CERT), certCount + TEST_DEFAULT_SIZE);
+    EXPECT_EQ(CfGetRejectedInputCount(CF_REJECT_TYPE_CRL), crlCount + 1);
+    EXPECT_EQ(CfGetRejectedInputCount(CF_REJECT_TYPE_MAX), 0);
+}
+
+/**
+* @tc.name: CfResolveEncodingFormat001
+* @tc.desc: only CF_FORMAT_AUTO is resolved, a SEQUENCE that fits is DER and anything else PEM
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfResolveEncodingFormat001, TestSize.Level0)
+{
+    const uint8_t der[] = { 0x30, 0x02, 0x30, 0x00 };
+    const uint8_t pem[] = "-----BEGIN CERTIFICATE-----\n";
+    const uint8_t digitText[] = "0123"; /* starts with the SEQUENCE tag, but '1' as a length does not fit */
+    EXPECT_EQ(CfResolveEncodingFormat(der, sizeof(der), CF_FORMAT_AUTO), CF_FORMAT_DER);
+    EXPECT_EQ(CfResolveEncodingFormat(pem, sizeof(pem) - 1, CF_FORMAT_AUTO), CF_FORMAT_PEM);
+    EXPECT_EQ(CfResolveEncodingFormat(digitText, sizeof(digitText) - 1, CF_FORMAT_AUTO), CF_FORMAT_PEM);
+    EXPECT_EQ(CfResolveEncodingFormat(nullptr, 0, CF_FORMAT_AUTO), CF_FORMAT_PEM);
+    EXPECT_EQ(CfResolveEncodingFormat(pem, sizeof(pem) - 1, CF_FORMAT_DER), CF_FORMAT_DER);
+    EXPECT_EQ(CfResolveEncodingFormat(der, sizeof(der), CF_FORMAT_PEM), CF_FORMAT_PEM);
+}
+
+static std::vector<uint8_t> GetTestData(uint32_t len)
+{
+    std::vector<uint8_t> data(len);
+    for (uint32_t i = 0; i < len; ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + (i >> 8) + 1); /* 7, 8: every byte value, in no fixed period */
+    }
+    return data;
+}
+
+/* a PEM block written by another encoder, lineChars 0 puts the whole body on one line */
+static std::string GetForeignPem(const std::vector<uint8_t> &data, uint32_t lineChars, const char *eol)
+{
+    std::vector<uint8_t> body((data.size() + 2) / 3 * 4 + 1); /* 2, 3, 4: quantums, 1: terminating zero */
+    int bodyLen = EVP_EncodeBlock(body.data(), data.data(), static_cast<int>(data.size()));
+    uint32_t step = (lineChars == 0) ? static_cast<uint32_t>(bodyLen) : lineChars;
+    std::string pem = std::string("-----BEGIN CERTIFICATE-----") + eol;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(bodyLen); i += step) {
+        pem.append(reinterpret_cast<const char *>(body.data()) + i, std::min(step, bodyLen - i));
+        pem += eol;
+    }
+    return pem + "-----END CERTIFICATE-----" + eol;
+}
+
+/**
+* @tc.name: CfPemDecode004
+* @tc.desc: decode bodies of any length with 64 or 76 characters per line, CRLF, or on one line
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemDecode004, TestSize.Level0)
+{
+    const uint32_t lineChars[] = { 64, 64, 76, 0 };
+    const char *eols[] = { "\n", "\r\n", "\n", "\n" };
+    std::vector<uint32_t> lens = { 1000, 4097, 50000 };
+    for (uint32_t len = 1; len <= 200; ++len) { /* 200: some lines, every count of trailing quantums and padding */
+        lens.push_back(len);
+    }
+    for (uint32_t len : lens) {
+        std::vector<uint8_t> data = GetTestData(len);
+        for (uint32_t i = 0; i < sizeof(lineChars) / sizeof(lineChars[0]); ++i) {
+            std::string pem = GetForeignPem(data, lineChars[i], eols[i]);
+            CfBlob der = { 0, nullptr };
+            int32_t ret = CfPemDecode(reinterpret_cast<const uint8_t *>(pem.data()), pem.size(), CF_PEM_LABEL_CERT,
+                &der, nullptr);
+            ASSERT_EQ(ret, CF_SUCCESS) << "len:" << len << " index:" << i;
+            ASSERT_EQ(der.size, len) << "len:" << len << " index:" << i;
+            EXPECT_EQ(memcmp(der.data, data.data(), len), 0) << "len:" << len << " index:" << i;
+            CfFree(der.data);
+        }
+    }
+}
+
+/**
+* @tc.name: CfPemDecode005
+* @tc.desc: a character next to the ranges of the alphabet, at any position of the body, is rejected
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemDecode005, TestSize.Level0)
+{
+    const char invalid[] = { '@', '[', '`', '{', '*', ',', '.', ':', '-', '\0', static_cast<char>(0xC1),
+        static_cast<char>(0xFF) };
+    std::vector<uint8_t> data = GetTestData(300); /* 300: a few lines of whole quantums */
+    std::string pem = GetForeignPem(data, TEST_PEM_LINE_CHARS, "\n");
+    size_t bodyStart = pem.find('\n') + 1;
+    size_t bodyEnd = pem.find("-----END");
+    for (size_t pos = bodyStart; pos < bodyEnd; ++pos) {
+        if (pem[pos] == '\n') {
+            continue;
+        }
+        for (char c : invalid) {
+            std::string bad = pem;
+            bad[pos] = c;
+            CfBlob der = { 0, nullptr };
+            int32_t ret = CfPemDecode(reinterpret_cast<const uint8_t *>(bad.data()), bad.size(), CF_PEM_LABEL_CERT,
+                &der, nullptr);
+            EXPECT_EQ(ret, CF_INVALID_PARAMS) << "pos:" << pos << " char:" << static_cast<int>(c);
+            CfFree(der.data);
+        }
+    }
+}
+
+/**
+* @tc.name: CfPemEncode003
+* @tc.desc: the output is the same as the one of openssl for any length
+* @tc.type: FUNC
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemEncode003, TestSize.Level0)
+{
+    std::vector<uint32_t> lens = { 1000, 4800, 50001 };
+    for (uint32_t len = 1; len <= 200; ++len) { /* 200: some lines, every count of trailing bytes */
+        lens.push_back(len);
+    }
+    for (uint32_t len : lens) {
+        std::vector<uint8_t> data = GetTestData(len);
+        BIO *bio = BIO_new(BIO_s_mem());
+        ASSERT_NE(bio, nullptr);
+        ASSERT_GT(PEM_write_bio(bio, CF_PEM_LABEL_CERT, "", data.data(), len), 0);
+        char *expect = nullptr;
+        long expectLen = BIO_get_mem_data(bio, &expect);
+
+        CfBlob pem = { 0, nullptr };
+        int32_t ret = CfPemEncode(data.data(), len, CF_PEM_LABEL_CERT, &pem);
+        ASSERT_EQ(ret, CF_SUCCESS) << "len:" << len;
+        ASSERT_EQ(pem.size, static_cast<uint32_t>(expectLen)) << "len:" << len;
+        EXPECT_EQ(memcmp(pem.data, expect, pem.size), 0) << "len:" << len;
+        CfFree(pem.data);
+        BIO_free(bio);
+    }
+}
+
+/**
+* @tc.name: CfPemBenchmark001
+* @tc.desc: time of the native PEM decoder and encoder against the openssl PEM functions on 1MB of DER
+* @tc.type: PERF
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfPemBenchmark001, TestSize.Level0)
+{
+    std::vector<uint8_t> data = GetTestData(TEST_BENCHMARK_SIZE);
+    CfBlob pem = { 0, nullptr };
+    ASSERT_EQ(CfPemEncode(data.data(), data.size(), CF_PEM_LABEL_CERT, &pem), CF_SUCCESS);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BENCHMARK_COUNT; ++i) {
+        CfBlob der = { 0, nullptr };
+        ASSERT_EQ(CfPemDecode(pem.data, pem.size, CF_PEM_LABEL_CERT, &der, nullptr), CF_SUCCESS);
+        EXPECT_EQ(der.size, data.size());
+        CfFree(der.data);
+    }
+    auto nativeDecode = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BENCHMARK_COUNT; ++i) {
+        BIO *bio = BIO_new_mem_buf(pem.data, pem.size);
+        ASSERT_NE(bio, nullptr);
+        char *name = nullptr;
+        char *header = nullptr;
+        unsigned char *der = nullptr;
+        long derLen = 0;
+        EXPECT_EQ(PEM_read_bio(bio, &name, &header, &der, &derLen), 1);
+        EXPECT_EQ(static_cast<size_t>(derLen), data.size());
+        OPENSSL_free(name);
+        OPENSSL_free(header);
+        OPENSSL_free(der);
+        BIO_free(bio);
+    }
+    auto opensslDecode = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BENCHMARK_COUNT; ++i) {
+        CfBlob out = { 0, nullptr };
+        ASSERT_EQ(CfPemEncode(data.data(), data.size(), CF_PEM_LABEL_CERT, &out), CF_SUCCESS);
+        CfFree(out.data);
+    }
+    auto nativeEncode = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_BENCHMARK_COUNT; ++i) {
+        BIO *bio = BIO_new(BIO_s_mem());
+        ASSERT_NE(bio, nullptr);
+        EXPECT_GT(PEM_write_bio(bio, CF_PEM_LABEL_CERT, "", data.data(), data.size()), 0);
+        BIO_free(bio);
+    }
+    auto opensslEncode = std::chrono::steady_clock::now() - start;
+    CfFree(pem.data);
+
+    using std::chrono::microseconds;
+    std::cout << "pem decode 1MB x" << TEST_BENCHMARK_COUNT << ", native: " <<
+        std::chrono::duration_cast<microseconds>(nativeDecode).count() << "us, openssl: " <<
+        std::chrono::duration_cast<microseconds>(opensslDecode).count() << "us" << std::endl;
+    std::cout << "pem encode 1MB x" << TEST_BENCHMARK_COUNT << ", native: " <<
+        std::chrono::duration_cast<microseconds>(nativeEncode).count() << "us, openssl: " <<
+        std::chrono::duration_cast<microseconds>(opensslEncode).count() << "us" << std::endl;
+}
+
+/**
+* @tc.name: CfCtxPoolBenchmark001
+* @tc.desc: time of taking and giving back an async context with the context pool against CfMalloc and CfFree
+* @tc.type: PERF
+* @tc.require: AR000HS2RB /SR000HS2Q1
+*/
+HWTEST_F(CfCommonTest, CfCtxPoolBenchmark001, TestSize.Level0)
+{
+    OHOS::CertFramework::CertCtxPool pool(TEST_CTX_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_CTX_BENCHMARK_COUNT; ++i) {
+        void *ctx = pool.Acquire();
+        ASSERT_NE(ctx, nullptr);
+        pool.Release(ctx);
+    }
+    auto pooled = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TEST_CTX_BENCHMARK_COUNT; ++i) {
+        void *ctx = CfMalloc(TEST_CTX_SIZE);
+        ASSERT_NE(ctx, nullptr);
+        CfFree(ctx);
+    }
+    auto malloced = std::chrono::steady_clock::now() - start;
+
+    using std::chrono::microseconds;
+    std::cout << "ctx " << TEST_CTX_SIZE << "B x" << TEST_CTX_BENCHMARK_COUNT << ", pool: " <<
+        std::chrono::duration_cast<microseconds>(pooled).count() << "us, CfMalloc: " <<
+        std::chrono::duration_cast<microseconds>(malloced).count() << "us" << std::endl;
+}
+} // end of namespace
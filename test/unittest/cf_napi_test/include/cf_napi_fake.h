@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_NAPI_FAKE_H
+#define CF_NAPI_FAKE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "napi/native_api.h"
+
+/*
+ * A napi test double for the bindings: threadsafe functions, async work, env cleanup hooks, and a small value
+ * model of primitives, objects, classes, wraps, buffers and promises. The thread calling FakeNapiRunLoop plays the
+ * JS thread of every env, values are only used on that thread and live until the next reset.
+ */
+namespace CertframeworkNapiTest {
+enum FakePromiseState {
+    FAKE_PROMISE_PENDING,
+    FAKE_PROMISE_RESOLVED,
+    FAKE_PROMISE_REJECTED,
+};
+
+napi_env FakeNapiGetEnv(uint32_t index);
+
+/* runs the queued threadsafe function calls and async work, returns the count of callbacks run */
+uint32_t FakeNapiRunLoop(void);
+
+/* waits until count calls of napi_call_threadsafe_function were made since the last reset, failed ones included */
+bool FakeNapiWaitCalls(uint32_t count);
+
+uint32_t FakeNapiGetCallCount(void);
+uint32_t FakeNapiGetAsyncWorkCount(void);
+bool FakeNapiIsReferenced(void);
+bool FakeNapiIsReleased(void);
+
+/* makes napi_call_threadsafe_function fail, as when the wakeup of the loop fails */
+void FakeNapiSetCallFailure(bool fail);
+
+/* calls func as JS does, with thisVar as this */
+napi_value FakeNapiCall(napi_env env, napi_value func, napi_value thisVar, const std::vector<napi_value> &args);
+napi_value FakeNapiCallMethod(napi_env env, napi_value object, const char *name, const std::vector<napi_value> &args);
+
+/* result may be nullptr, it is set once the promise is settled */
+FakePromiseState FakeNapiGetPromiseState(napi_value promise, napi_value *result);
+
+/* runs the finalizer of a wrapped object or of an external buffer, as the GC does once it is unreachable */
+void FakeNapiCollect(napi_value value);
+
+/*
+ * calls the detach callback of a native binding object as posting it to another worker does, the result is what the
+ * receiving worker gets
+ */
+void *FakeNapiDetach(napi_env env, napi_value object);
+
+/* calls the attach callback of object in env with the result of FakeNapiDetach, as the receiving worker does */
+napi_value FakeNapiAttach(napi_env env, napi_value object, void *detached);
+
+/* handle scopes opened since the last reset, and the ones of them not closed yet */
+uint32_t FakeNapiGetOpenedScopeCount(void);
+uint32_t FakeNapiGetLiveScopeCount(void);
+
+/* calls of napi_fatal_exception since the last reset */
+uint32_t FakeNapiGetFatalExceptionCount(void);
+
+/* the sum of napi_adjust_external_memory of env since the last reset */
+int64_t FakeNapiGetExternalMemory(napi_env env);
+
+void FakeNapiRunCleanupHooks(void);
+
+/* finalizes the values left, then forgets every value, reference and pending exception */
+void FakeNapiReset(void);
+}
+
+#endif /* CF_NAPI_FAKE_H */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "napi_cert_ctx_pool.h"
+
+using namespace testing::ext;
+using namespace OHOS::CertFramework;
+
+namespace {
+constexpr uint32_t CTX_SIZE = 256; /* about the size of the async contexts of the bindings */
+constexpr uint32_t CACHED_CTX_COUNT = 64; /* the most contexts a pool keeps */
+constexpr uint32_t MORE_THAN_CACHED = 100;
+constexpr uint8_t DIRTY_BYTE = 0xA5;
+
+/* as the bindings declare theirs, so each thread initializes its own on first use */
+thread_local CertCtxPool g_threadPool(CTX_SIZE);
+
+class CfNapiCtxPoolTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfNapiCtxPoolTest::SetUpTestCase(void)
+{
+}
+
+void CfNapiCtxPoolTest::TearDownTestCase(void)
+{
+}
+
+void CfNapiCtxPoolTest::SetUp()
+{
+}
+
+void CfNapiCtxPoolTest::TearDown()
+{
+}
+
+bool IsZeroed(const void *ctx)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(ctx);
+    for (uint32_t i = 0; i < CTX_SIZE; ++i) {
+        if (bytes[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @tc.name: CfNapiCtxPoolTest001
+ * @tc.desc: a released context is handed out again by the next acquire, zeroed
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiCtxPoolTest, CfNapiCtxPoolTest001, TestSize.Level0)
+{
+    CertCtxPool pool(CTX_SIZE);
+    void *first = pool.Acquire();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(IsZeroed(first), true);
+    (void)memset(first, DIRTY_BYTE, CTX_SIZE);
+    pool.Release(first);
+    pool.Release(nullptr);
+
+    void *second = pool.Acquire();
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(IsZeroed(second), true);
+    void *third = pool.Acquire(); /* the pool is empty again */
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(third, second);
+    EXPECT_EQ(IsZeroed(third), true);
+    pool.Release(second);
+    pool.Release(third); /* the pool frees the contexts it keeps when destroyed */
+}
+
+/**
+ * @tc.name: CfNapiCtxPoolTest002
+ * @tc.desc: the pool keeps the first released contexts up to its cap, frees the others, and hands them out last in
+ *           first out
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiCtxPoolTest, CfNapiCtxPoolTest002, TestSize.Level0)
+{
+    CertCtxPool pool(CTX_SIZE);
+    std::vector<void *> contexts;
+    for (uint32_t i = 0; i < MORE_THAN_CACHED; ++i) {
+        contexts.push_back(pool.Acquire());
+        ASSERT_NE(contexts.back(), nullptr);
+        (void)memset(contexts.back(), DIRTY_BYTE, CTX_SIZE);
+    }
+    for (void *ctx : contexts) {
+        pool.Release(ctx);
+    }
+
+    /* without the cap the first one out would be the last released */
+    std::vector<void *> reused;
+    for (uint32_t i = 0; i < CACHED_CTX_COUNT; ++i) {
+        reused.push_back(pool.Acquire());
+        EXPECT_EQ(reused.back(), contexts[CACHED_CTX_COUNT - 1 - i]) << "ctx: " << i;
+        EXPECT_EQ(IsZeroed(reused.back()), true) << "ctx: " << i;
+    }
+    void *fresh = pool.Acquire();
+    ASSERT_NE(fresh, nullptr);
+    EXPECT_EQ(IsZeroed(fresh), true);
+    reused.push_back(fresh);
+    for (void *ctx : reused) {
+        pool.Release(ctx);
+    }
+}
+
+/**
+ * @tc.name: CfNapiCtxPoolTest003
+ * @tc.desc: a thread_local pool, as the bindings keep per env, does not hand out the contexts of another thread
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiCtxPoolTest, CfNapiCtxPoolTest003, TestSize.Level0)
+{
+    void *ctx = g_threadPool.Acquire();
+    ASSERT_NE(ctx, nullptr);
+    g_threadPool.Release(ctx);
+
+    void *other = nullptr;
+    std::thread worker([&other] {
+        other = g_threadPool.Acquire();
+        g_threadPool.Release(other);
+    });
+    worker.join();
+    EXPECT_NE(other, nullptr);
+    EXPECT_NE(other, ctx);
+    EXPECT_EQ(g_threadPool.Acquire(), ctx);
+    g_threadPool.Release(ctx);
+}
+}
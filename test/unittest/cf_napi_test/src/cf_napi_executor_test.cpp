@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cf_napi_fake.h"
+#include "napi_cert_executor.h"
+
+using namespace testing::ext;
+using namespace OHOS::CertFramework;
+using namespace CertframeworkNapiTest;
+
+namespace {
+constexpr uint32_t TASK_COUNT = 64;
+constexpr uint32_t WAIT_MS = 10;
+constexpr uint32_t THROW_INTERVAL = 8;
+
+struct TestTask {
+    std::atomic<uint32_t> executed { 0 };
+    std::atomic<uint32_t> completed { 0 };
+    std::thread::id completeThread;
+    uint32_t liveScopes = 0; /* handle scopes open while completing */
+};
+
+std::mutex g_gateMutex;
+std::condition_variable g_gateCond;
+bool g_gateOpen = true;
+std::atomic<uint32_t> g_blocked { 0 };
+
+class CfNapiExecutorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfNapiExecutorTest::SetUpTestCase(void)
+{
+}
+
+void CfNapiExecutorTest::TearDownTestCase(void)
+{
+}
+
+void CfNapiExecutorTest::SetUp()
+{
+    FakeNapiReset();
+}
+
+void CfNapiExecutorTest::TearDown()
+{
+    FakeNapiRunCleanupHooks(); /* closes the channel of the env, the next test starts with a new one */
+    FakeNapiReset();
+}
+
+void TaskExecute(napi_env env, void *data)
+{
+    (void)env;
+    static_cast<TestTask *>(data)->executed++;
+}
+
+void GatedTaskExecute(napi_env env, void *data)
+{
+    (void)env;
+    g_blocked++;
+    std::unique_lock<std::mutex> lock(g_gateMutex);
+    g_gateCond.wait(lock, [] { return g_gateOpen; });
+    static_cast<TestTask *>(data)->executed++;
+}
+
+void TaskComplete(napi_env env, napi_status status, void *data)
+{
+    (void)env;
+    (void)status;
+    TestTask *task = static_cast<TestTask *>(data);
+    task->completeThread = std::this_thread::get_id();
+    task->liveScopes = FakeNapiGetLiveScopeCount();
+    task->completed++;
+}
+
+void ThrowingTaskComplete(napi_env env, napi_status status, void *data)
+{
+    TaskComplete(env, status, data);
+    napi_value msg = nullptr;
+    napi_value error = nullptr;
+    napi_create_string_utf8(env, "complete failed", NAPI_AUTO_LENGTH, &msg);
+    napi_create_error(env, nullptr, msg, &error);
+    napi_throw(env, error);
+}
+
+/* every THROW_INTERVAL task throws from its complete */
+napi_async_complete_callback GetComplete(uint32_t index)
+{
+    return ((index % THROW_INTERVAL) == 1) ? ThrowingTaskComplete : TaskComplete;
+}
+
+/* each task completed in a scope of its own, the exceptions of the throwing ones are reported and cleared */
+void CheckCompleteScopes(napi_env env, const std::vector<TestTask> &tasks)
+{
+    for (uint32_t i = 0; i < tasks.size(); ++i) {
+        EXPECT_EQ(tasks[i].liveScopes, 1) << "task:" << i;
+    }
+    EXPECT_EQ(FakeNapiGetOpenedScopeCount(), tasks.size());
+    EXPECT_EQ(FakeNapiGetLiveScopeCount(), 0);
+    EXPECT_EQ(FakeNapiGetFatalExceptionCount(), (tasks.size() + THROW_INTERVAL - 1) / THROW_INTERVAL);
+    bool pending = true;
+    napi_is_exception_pending(env, &pending);
+    EXPECT_EQ(pending, false);
+}
+
+void SetGate(bool open)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_gateMutex);
+        g_gateOpen = open;
+    }
+    g_gateCond.notify_all();
+}
+
+/* every task executed and completed once, on the calling thread */
+void CheckTasks(const std::vector<TestTask> &tasks)
+{
+    for (uint32_t i = 0; i < tasks.size(); ++i) {
+        EXPECT_EQ(tasks[i].executed, 1) << "task:" << i;
+        EXPECT_EQ(tasks[i].completed, 1) << "task:" << i;
+        EXPECT_EQ(tasks[i].completeThread, std::this_thread::get_id()) << "task:" << i;
+    }
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest001
+ * @tc.desc: the tasks that finish before the JS thread wakes up are completed by one wakeup
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest001, TestSize.Level0)
+{
+    napi_env env = FakeNapiGetEnv(0);
+    std::vector<TestTask> tasks(TASK_COUNT);
+    for (TestTask &task : tasks) {
+        ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, TaskComplete, &task), napi_ok);
+    }
+    EXPECT_EQ(FakeNapiIsReferenced(), true);
+    for (const TestTask &task : tasks) {
+        while (task.executed == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS)); /* the last task is posted after execute */
+    EXPECT_EQ(FakeNapiGetCallCount(), 1);
+
+    EXPECT_EQ(FakeNapiRunLoop(), 1);
+    CheckTasks(tasks);
+    EXPECT_EQ(FakeNapiIsReferenced(), false);
+    EXPECT_EQ(FakeNapiGetAsyncWorkCount(), 0);
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest002
+ * @tc.desc: a failed wakeup is retried by the next task, and its task is completed by napi async work
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest002, TestSize.Level0)
+{
+    napi_env env = FakeNapiGetEnv(0);
+    std::vector<TestTask> tasks(4); /* 4: two for the retry, two for the fallback */
+    SetGate(false);
+    g_blocked = 0;
+    FakeNapiSetCallFailure(true);
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", GatedTaskExecute, TaskComplete, &tasks[0]), napi_ok);
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, TaskComplete, &tasks[1]), napi_ok);
+    ASSERT_EQ(FakeNapiWaitCalls(1), true);
+    EXPECT_EQ(FakeNapiRunLoop(), 0);
+    EXPECT_EQ(tasks[1].completed, 0);
+
+    /* the task that finishes next makes the wakeup again, which completes both */
+    FakeNapiSetCallFailure(false);
+    SetGate(true);
+    ASSERT_EQ(FakeNapiWaitCalls(2), true); /* 2: the failed call, then this one */
+    EXPECT_EQ(FakeNapiRunLoop(), 1);
+    EXPECT_EQ(tasks[0].completed, 1);
+    EXPECT_EQ(tasks[1].completed, 1);
+
+    /* with no task left to retry, the next queued work hands the stalled one to napi async work */
+    FakeNapiSetCallFailure(true);
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, TaskComplete, &tasks[2]), napi_ok);
+    ASSERT_EQ(FakeNapiWaitCalls(3), true); /* 3: the failed call of this task */
+    FakeNapiSetCallFailure(false);
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, TaskComplete, &tasks[3]), napi_ok);
+    EXPECT_EQ(FakeNapiGetAsyncWorkCount(), 1);
+    ASSERT_EQ(FakeNapiWaitCalls(4), true); /* 4: the call of the last task */
+    EXPECT_EQ(FakeNapiRunLoop(), 2); /* 2: the async work, and the wakeup */
+    CheckTasks(tasks);
+    EXPECT_EQ(FakeNapiIsReferenced(), false);
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest003
+ * @tc.desc: closing the env completes the finished, running and queued tasks
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest003, TestSize.Level0)
+{
+    napi_env env = FakeNapiGetEnv(0);
+    std::vector<TestTask> tasks(TASK_COUNT);
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, TaskComplete, &tasks[0]), napi_ok);
+    ASSERT_EQ(FakeNapiWaitCalls(1), true); /* finished, and not completed yet */
+
+    SetGate(false);
+    g_blocked = 0;
+    for (uint32_t i = 1; i < TASK_COUNT; ++i) {
+        ASSERT_EQ(CertQueueAsyncWork(env, "test", GatedTaskExecute, TaskComplete, &tasks[i]), napi_ok);
+    }
+    while (g_blocked == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::thread opener([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
+        SetGate(true);
+    });
+    FakeNapiRunCleanupHooks(); /* waits for the tasks being executed, executes the queued ones */
+    opener.join();
+
+    CheckTasks(tasks);
+    EXPECT_EQ(FakeNapiIsReleased(), true);
+    EXPECT_EQ(FakeNapiRunLoop(), 0);
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest004
+ * @tc.desc: a second env on the same thread uses napi async work
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest004, TestSize.Level0)
+{
+    std::vector<TestTask> tasks(2); /* 2: one per env */
+    ASSERT_EQ(CertQueueAsyncWork(FakeNapiGetEnv(0), "test", TaskExecute, TaskComplete, &tasks[0]), napi_ok);
+    ASSERT_EQ(CertQueueAsyncWork(FakeNapiGetEnv(1), "test", TaskExecute, TaskComplete, &tasks[1]), napi_ok);
+    EXPECT_EQ(FakeNapiGetAsyncWorkCount(), 1);
+    ASSERT_EQ(FakeNapiWaitCalls(1), true);
+    EXPECT_EQ(FakeNapiRunLoop(), 2); /* 2: the wakeup, and the async work */
+    CheckTasks(tasks);
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest005
+ * @tc.desc: a complete that throws does not stop the other completions of its wakeup
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest005, TestSize.Level0)
+{
+    napi_env env = FakeNapiGetEnv(0);
+    std::vector<TestTask> tasks(TASK_COUNT);
+    SetGate(false);
+    g_blocked = 0;
+    ASSERT_EQ(CertQueueAsyncWork(env, "test", GatedTaskExecute, TaskComplete, &tasks[0]), napi_ok);
+    for (uint32_t i = 1; i < TASK_COUNT; ++i) {
+        ASSERT_EQ(CertQueueAsyncWork(env, "test", TaskExecute, GetComplete(i), &tasks[i]), napi_ok);
+    }
+    for (uint32_t i = 1; i < TASK_COUNT; ++i) {
+        while (tasks[i].executed == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    SetGate(true);
+    while (tasks[0].completed == 0) {
+        if (FakeNapiRunLoop() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    (void)FakeNapiRunLoop();
+    CheckTasks(tasks);
+    CheckCompleteScopes(env, tasks);
+    EXPECT_EQ(FakeNapiIsReferenced(), false);
+}
+
+/**
+ * @tc.name: CfNapiExecutorTest006
+ * @tc.desc: closing the env completes the tasks in scopes of their own, also when some of them throw
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiExecutorTest, CfNapiExecutorTest006, TestSize.Level0)
+{
+    napi_env env = FakeNapiGetEnv(0);
+    std::vector<TestTask> tasks(TASK_COUNT);
+    SetGate(false);
+    g_blocked = 0;
+    for (uint32_t i = 0; i < TASK_COUNT; ++i) {
+        ASSERT_EQ(CertQueueAsyncWork(env, "test", GatedTaskExecute, GetComplete(i), &tasks[i]), napi_ok);
+    }
+    while (g_blocked == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::thread opener([] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
+        SetGate(true);
+    });
+    FakeNapiRunCleanupHooks(); /* most of the tasks are still queued and are executed here */
+    opener.join();
+
+    CheckTasks(tasks);
+    CheckCompleteScopes(env, tasks);
+}
+}
@@ -0,0 +1,1150 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_napi_fake.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr uint32_t ENV_COUNT = 2;
+constexpr uint32_t WAIT_SECONDS = 10;
+
+struct FakeTsfn {
+    napi_env env = nullptr;
+    void *context = nullptr;
+    napi_threadsafe_function_call_js callJs = nullptr;
+};
+
+struct FakeWork {
+    napi_env env = nullptr;
+    napi_async_execute_callback execute = nullptr;
+    napi_async_complete_callback complete = nullptr;
+    void *data = nullptr;
+};
+
+struct FakeHook {
+    napi_env env = nullptr;
+    void (*fun)(void *arg) = nullptr;
+    void *arg = nullptr;
+};
+
+struct FakeNapiState {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<FakeTsfn *> tsfns; /* freed on reset only, as a released function may still be seen by a caller */
+    std::deque<FakeTsfn *> calls;
+    std::deque<FakeWork *> works;
+    std::vector<FakeHook> hooks;
+    uint32_t callCount = 0;
+    uint32_t workCount = 0;
+    bool referenced = false;
+    bool released = false;
+    bool callFailure = false;
+};
+
+FakeNapiState g_state;
+int g_envs[ENV_COUNT] = { 0 };
+
+struct FakeValue {
+    napi_valuetype type = napi_undefined;
+    bool boolean = false;
+    double number = 0;
+    std::string str;
+    int signBit = 0;
+    std::vector<uint64_t> words;
+    std::map<std::string, FakeValue *> properties;
+    bool isArray = false;
+    std::vector<FakeValue *> elements;
+    /* a function, or a class whose instances get the methods and values of descriptors */
+    napi_callback callback = nullptr;
+    void *callbackData = nullptr;
+    std::vector<napi_property_descriptor> descriptors;
+    FakeValue *constructor = nullptr;
+    /* napi_wrap and napi_coerce_to_native_binding_object */
+    void *native = nullptr;
+    napi_env finalizeEnv = nullptr;
+    napi_finalize finalize = nullptr;
+    void *finalizeHint = nullptr;
+    bool wrapped = false;
+    napi_native_binding_detach_callback detach = nullptr;
+    napi_native_binding_attach_callback attach = nullptr;
+    void *bindingNative = nullptr;
+    void *bindingHint = nullptr;
+    /* an array buffer owns bytes or points to external data, a typed array views one */
+    bool isArrayBuffer = false;
+    std::vector<uint8_t> bytes;
+    uint8_t *external = nullptr;
+    size_t byteLength = 0;
+    bool isTypedArray = false;
+    napi_typedarray_type arrayType = napi_uint8_array;
+    FakeValue *arrayBuffer = nullptr;
+    size_t byteOffset = 0;
+    size_t length = 0;
+    bool isPromise = false;
+    CertframeworkNapiTest::FakePromiseState promiseState = CertframeworkNapiTest::FAKE_PROMISE_PENDING;
+    FakeValue *promiseResult = nullptr;
+};
+
+struct FakeRef {
+    FakeValue *value = nullptr;
+    uint32_t count = 0;
+};
+
+struct FakeEnvState {
+    FakeValue *exception = nullptr;
+    int64_t externalMemory = 0;
+};
+
+struct FakeCallbackInfo {
+    FakeValue *thisVar = nullptr;
+    std::vector<FakeValue *> args;
+    void *data = nullptr;
+};
+
+/* used on the JS thread only */
+std::vector<FakeValue *> g_values;
+std::vector<FakeRef *> g_refs;
+std::map<napi_env, FakeEnvState> g_envStates;
+uint32_t g_openedScopes = 0;
+uint32_t g_liveScopes = 0;
+uint32_t g_fatalExceptions = 0;
+
+FakeValue *NewValue(napi_valuetype type)
+{
+    FakeValue *value = new FakeValue();
+    value->type = type;
+    g_values.push_back(value);
+    return value;
+}
+
+FakeValue *ToFake(napi_value value)
+{
+    return reinterpret_cast<FakeValue *>(value);
+}
+
+napi_value ToNapi(FakeValue *value)
+{
+    return reinterpret_cast<napi_value>(value);
+}
+
+napi_status SetResult(napi_value *result, FakeValue *value)
+{
+    if (result == nullptr) {
+        return napi_invalid_arg;
+    }
+    *result = ToNapi(value);
+    return napi_ok;
+}
+
+size_t GetElementSize(napi_typedarray_type type)
+{
+    switch (type) {
+        case napi_int16_array:
+        case napi_uint16_array:
+            return sizeof(uint16_t);
+        case napi_int32_array:
+        case napi_uint32_array:
+        case napi_float32_array:
+            return sizeof(uint32_t);
+        case napi_float64_array:
+        case napi_bigint64_array:
+        case napi_biguint64_array:
+            return sizeof(uint64_t);
+        default:
+            return sizeof(uint8_t);
+    }
+}
+
+uint8_t *GetBufferData(FakeValue *buffer)
+{
+    return (buffer->external != nullptr) ? buffer->external : buffer->bytes.data();
+}
+
+/* the finalizers of a wrap and of an external buffer run once */
+void Finalize(FakeValue *value)
+{
+    if (value->finalize == nullptr) {
+        return;
+    }
+    napi_finalize finalize = value->finalize;
+    value->finalize = nullptr;
+    void *data = value->isArrayBuffer ? static_cast<void *>(value->external) : value->native;
+    value->native = nullptr;
+    value->external = nullptr;
+    value->byteLength = 0;
+    finalize(value->finalizeEnv, data, value->finalizeHint);
+}
+
+void SetProperties(FakeValue *object, size_t count, const napi_property_descriptor *descriptors)
+{
+    for (size_t i = 0; i < count; ++i) {
+        FakeValue *property = ToFake(descriptors[i].value);
+        if (descriptors[i].method != nullptr) {
+            property = NewValue(napi_function);
+            property->callback = descriptors[i].method;
+            property->callbackData = descriptors[i].data;
+        }
+        object->properties[descriptors[i].utf8name] = property;
+    }
+}
+}
+
+namespace CertframeworkNapiTest {
+napi_env FakeNapiGetEnv(uint32_t index)
+{
+    return reinterpret_cast<napi_env>(&g_envs[index % ENV_COUNT]);
+}
+
+uint32_t FakeNapiRunLoop(void)
+{
+    uint32_t count = 0;
+    while (true) {
+        FakeTsfn *tsfn = nullptr;
+        FakeWork *work = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(g_state.mutex);
+            if (!g_state.calls.empty()) {
+                tsfn = g_state.calls.front();
+                g_state.calls.pop_front();
+            } else if (!g_state.works.empty()) {
+                work = g_state.works.front();
+                g_state.works.pop_front();
+            } else {
+                return count;
+            }
+        }
+        if (tsfn != nullptr) {
+            tsfn->callJs(tsfn->env, nullptr, tsfn->context, nullptr);
+        } else {
+            work->execute(work->env, work->data);
+            work->complete(work->env, napi_ok, work->data); /* the work is deleted here */
+        }
+        count++;
+    }
+}
+
+bool FakeNapiWaitCalls(uint32_t count)
+{
+    std::unique_lock<std::mutex> lock(g_state.mutex);
+    return g_state.cond.wait_for(lock, std::chrono::seconds(WAIT_SECONDS),
+        [count] { return g_state.callCount >= count; });
+}
+
+uint32_t FakeNapiGetCallCount(void)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    return g_state.callCount;
+}
+
+uint32_t FakeNapiGetAsyncWorkCount(void)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    return g_state.workCount;
+}
+
+bool FakeNapiIsReferenced(void)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    return g_state.referenced;
+}
+
+bool FakeNapiIsReleased(void)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    return g_state.released;
+}
+
+void FakeNapiSetCallFailure(bool fail)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.callFailure = fail;
+}
+
+napi_value FakeNapiCall(napi_env env, napi_value func, napi_value thisVar, const std::vector<napi_value> &args)
+{
+    FakeValue *function = ToFake(func);
+    if ((function == nullptr) || (function->callback == nullptr)) {
+        return nullptr;
+    }
+    FakeCallbackInfo info;
+    info.thisVar = ToFake(thisVar);
+    for (napi_value arg : args) {
+        info.args.push_back(ToFake(arg));
+    }
+    info.data = function->callbackData;
+    return function->callback(env, reinterpret_cast<napi_callback_info>(&info));
+}
+
+napi_value FakeNapiCallMethod(napi_env env, napi_value object, const char *name, const std::vector<napi_value> &args)
+{
+    FakeValue *value = ToFake(object);
+    if (value == nullptr) {
+        return nullptr;
+    }
+    auto it = value->properties.find(name);
+    return (it == value->properties.end()) ? nullptr : FakeNapiCall(env, ToNapi(it->second), object, args);
+}
+
+FakePromiseState FakeNapiGetPromiseState(napi_value promise, napi_value *result)
+{
+    FakeValue *value = ToFake(promise);
+    if ((value == nullptr) || !value->isPromise) {
+        return FAKE_PROMISE_PENDING;
+    }
+    if (result != nullptr) {
+        *result = ToNapi(value->promiseResult);
+    }
+    return value->promiseState;
+}
+
+void FakeNapiCollect(napi_value value)
+{
+    if (value != nullptr) {
+        Finalize(ToFake(value));
+    }
+}
+
+void *FakeNapiDetach(napi_env env, napi_value object)
+{
+    FakeValue *value = ToFake(object);
+    if ((value == nullptr) || (value->detach == nullptr)) {
+        return nullptr;
+    }
+    return value->detach(env, value->bindingNative, value->bindingHint);
+}
+
+napi_value FakeNapiAttach(napi_env env, napi_value object, void *detached)
+{
+    FakeValue *value = ToFake(object);
+    if ((value == nullptr) || (value->attach == nullptr)) {
+        return nullptr;
+    }
+    return value->attach(env, detached, value->bindingHint);
+}
+
+uint32_t FakeNapiGetOpenedScopeCount(void)
+{
+    return g_openedScopes;
+}
+
+uint32_t FakeNapiGetLiveScopeCount(void)
+{
+    return g_liveScopes;
+}
+
+uint32_t FakeNapiGetFatalExceptionCount(void)
+{
+    return g_fatalExceptions;
+}
+
+int64_t FakeNapiGetExternalMemory(napi_env env)
+{
+    return g_envStates[env].externalMemory;
+}
+
+void FakeNapiRunCleanupHooks(void)
+{
+    std::vector<FakeHook> hooks;
+    {
+        std::lock_guard<std::mutex> lock(g_state.mutex);
+        hooks.swap(g_state.hooks);
+    }
+    for (const FakeHook &hook : hooks) {
+        hook.fun(hook.arg);
+    }
+}
+
+void FakeNapiReset(void)
+{
+    /* a finalizer may make values, so the list is walked by index */
+    for (size_t i = 0; i < g_values.size(); ++i) {
+        Finalize(g_values[i]);
+    }
+    for (FakeValue *value : g_values) {
+        delete value;
+    }
+    for (FakeRef *ref : g_refs) {
+        delete ref;
+    }
+    g_values.clear();
+    g_refs.clear();
+    g_envStates.clear();
+    g_openedScopes = 0;
+    g_liveScopes = 0;
+    g_fatalExceptions = 0;
+
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    for (FakeTsfn *tsfn : g_state.tsfns) {
+        delete tsfn;
+    }
+    for (FakeWork *work : g_state.works) {
+        delete work;
+    }
+    g_state.tsfns.clear();
+    g_state.calls.clear();
+    g_state.works.clear();
+    g_state.hooks.clear();
+    g_state.callCount = 0;
+    g_state.workCount = 0;
+    g_state.referenced = false;
+    g_state.released = false;
+    g_state.callFailure = false;
+}
+}
+
+napi_status napi_create_threadsafe_function(napi_env env, napi_value func, napi_value asyncResource,
+    napi_value asyncResourceName, size_t maxQueueSize, size_t initialThreadCount, void *threadFinalizeData,
+    napi_finalize threadFinalizeCb, void *context, napi_threadsafe_function_call_js callJsCb,
+    napi_threadsafe_function *result)
+{
+    (void)func;
+    (void)asyncResource;
+    (void)asyncResourceName;
+    (void)maxQueueSize;
+    (void)initialThreadCount;
+    (void)threadFinalizeData;
+    (void)threadFinalizeCb;
+    FakeTsfn *tsfn = new FakeTsfn { env, context, callJsCb };
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.tsfns.push_back(tsfn);
+    g_state.referenced = true;
+    g_state.released = false;
+    *result = reinterpret_cast<napi_threadsafe_function>(tsfn);
+    return napi_ok;
+}
+
+napi_status napi_call_threadsafe_function(napi_threadsafe_function func, void *data,
+    napi_threadsafe_function_call_mode isBlocking)
+{
+    (void)data;
+    (void)isBlocking;
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.callCount++;
+    g_state.cond.notify_all();
+    if (g_state.callFailure || g_state.released) {
+        return napi_generic_failure;
+    }
+    g_state.calls.push_back(reinterpret_cast<FakeTsfn *>(func));
+    return napi_ok;
+}
+
+napi_status napi_release_threadsafe_function(napi_threadsafe_function func,
+    napi_threadsafe_function_release_mode mode)
+{
+    (void)func;
+    (void)mode;
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.released = true;
+    g_state.calls.clear(); /* aborted, the queued calls are dropped */
+    return napi_ok;
+}
+
+napi_status napi_ref_threadsafe_function(napi_env env, napi_threadsafe_function func)
+{
+    (void)env;
+    (void)func;
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.referenced = true;
+    return napi_ok;
+}
+
+napi_status napi_unref_threadsafe_function(napi_env env, napi_threadsafe_function func)
+{
+    (void)env;
+    (void)func;
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.referenced = false;
+    return napi_ok;
+}
+
+napi_status napi_add_env_cleanup_hook(napi_env env, void (*fun)(void *arg), void *arg)
+{
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.hooks.push_back(FakeHook { env, fun, arg });
+    return napi_ok;
+}
+
+napi_status napi_create_async_work(napi_env env, napi_value asyncResource, napi_value asyncResourceName,
+    napi_async_execute_callback execute, napi_async_complete_callback complete, void *data, napi_async_work *result)
+{
+    (void)asyncResource;
+    (void)asyncResourceName;
+    FakeWork *work = new FakeWork { env, execute, complete, data };
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.workCount++;
+    *result = reinterpret_cast<napi_async_work>(work);
+    return napi_ok;
+}
+
+napi_status napi_queue_async_work(napi_env env, napi_async_work work)
+{
+    (void)env;
+    std::lock_guard<std::mutex> lock(g_state.mutex);
+    g_state.works.push_back(reinterpret_cast<FakeWork *>(work));
+    return napi_ok;
+}
+
+napi_status napi_delete_async_work(napi_env env, napi_async_work work)
+{
+    (void)env;
+    delete reinterpret_cast<FakeWork *>(work);
+    return napi_ok;
+}
+
+napi_status napi_get_undefined(napi_env env, napi_value *result)
+{
+    (void)env;
+    return SetResult(result, NewValue(napi_undefined));
+}
+
+napi_status napi_get_null(napi_env env, napi_value *result)
+{
+    (void)env;
+    return SetResult(result, NewValue(napi_null));
+}
+
+napi_status napi_get_boolean(napi_env env, bool value, napi_value *result)
+{
+    (void)env;
+    FakeValue *boolean = NewValue(napi_boolean);
+    boolean->boolean = value;
+    return SetResult(result, boolean);
+}
+
+napi_status napi_create_int32(napi_env env, int32_t value, napi_value *result)
+{
+    (void)env;
+    FakeValue *number = NewValue(napi_number);
+    number->number = value;
+    return SetResult(result, number);
+}
+
+napi_status napi_create_uint32(napi_env env, uint32_t value, napi_value *result)
+{
+    (void)env;
+    FakeValue *number = NewValue(napi_number);
+    number->number = value;
+    return SetResult(result, number);
+}
+
+napi_status napi_create_string_utf8(napi_env env, const char *str, size_t length, napi_value *result)
+{
+    (void)env;
+    if (str == nullptr) {
+        return napi_invalid_arg;
+    }
+    FakeValue *string = NewValue(napi_string);
+    string->str = (length == NAPI_AUTO_LENGTH) ? std::string(str) : std::string(str, length);
+    return SetResult(result, string);
+}
+
+napi_status napi_create_bigint_words(napi_env env, int sign_bit, size_t word_count, const uint64_t *words,
+    napi_value *result)
+{
+    (void)env;
+    if ((words == nullptr) && (word_count != 0)) {
+        return napi_invalid_arg;
+    }
+    FakeValue *bigint = NewValue(napi_bigint);
+    bigint->signBit = sign_bit;
+    bigint->words.assign(words, words + word_count);
+    return SetResult(result, bigint);
+}
+
+napi_status napi_create_object(napi_env env, napi_value *result)
+{
+    (void)env;
+    return SetResult(result, NewValue(napi_object));
+}
+
+napi_status napi_create_array(napi_env env, napi_value *result)
+{
+    (void)env;
+    FakeValue *array = NewValue(napi_object);
+    array->isArray = true;
+    return SetResult(result, array);
+}
+
+napi_status napi_create_function(napi_env env, const char *utf8name, size_t length, napi_callback cb, void *data,
+    napi_value *result)
+{
+    (void)env;
+    (void)utf8name;
+    (void)length;
+    if (cb == nullptr) {
+        return napi_invalid_arg;
+    }
+    FakeValue *function = NewValue(napi_function);
+    function->callback = cb;
+    function->callbackData = data;
+    return SetResult(result, function);
+}
+
+napi_status napi_create_error(napi_env env, napi_value code, napi_value msg, napi_value *result)
+{
+    (void)env;
+    if ((msg == nullptr) || (ToFake(msg)->type != napi_string)) {
+        return napi_string_expected;
+    }
+    FakeValue *error = NewValue(napi_object);
+    error->properties["message"] = ToFake(msg);
+    if (code != nullptr) {
+        error->properties["code"] = ToFake(code);
+    }
+    return SetResult(result, error);
+}
+
+napi_status napi_create_arraybuffer(napi_env env, size_t byte_length, void **data, napi_value *result)
+{
+    (void)env;
+    FakeValue *buffer = NewValue(napi_object);
+    buffer->isArrayBuffer = true;
+    buffer->bytes.resize(byte_length);
+    buffer->byteLength = byte_length;
+    if (data != nullptr) {
+        *data = buffer->bytes.data();
+    }
+    return SetResult(result, buffer);
+}
+
+napi_status napi_create_external_arraybuffer(napi_env env, void *external_data, size_t byte_length,
+    napi_finalize finalize_cb, void *finalize_hint, napi_value *result)
+{
+    FakeValue *buffer = NewValue(napi_object);
+    buffer->isArrayBuffer = true;
+    buffer->external = static_cast<uint8_t *>(external_data);
+    buffer->byteLength = byte_length;
+    buffer->finalizeEnv = env;
+    buffer->finalize = finalize_cb;
+    buffer->finalizeHint = finalize_hint;
+    return SetResult(result, buffer);
+}
+
+napi_status napi_create_typedarray(napi_env env, napi_typedarray_type type, size_t length, napi_value arraybuffer,
+    size_t byte_offset, napi_value *result)
+{
+    (void)env;
+    FakeValue *buffer = ToFake(arraybuffer);
+    if ((buffer == nullptr) || !buffer->isArrayBuffer || (byte_offset + length * GetElementSize(type) >
+        buffer->byteLength)) {
+        return napi_invalid_arg;
+    }
+    FakeValue *array = NewValue(napi_object);
+    array->isTypedArray = true;
+    array->arrayType = type;
+    array->arrayBuffer = buffer;
+    array->byteOffset = byte_offset;
+    array->length = length;
+    return SetResult(result, array);
+}
+
+napi_status napi_get_typedarray_info(napi_env env, napi_value typedarray, napi_typedarray_type *type, size_t *length,
+    void **data, napi_value *arraybuffer, size_t *byte_offset)
+{
+    (void)env;
+    FakeValue *array = ToFake(typedarray);
+    if ((array == nullptr) || !array->isTypedArray) {
+        return napi_invalid_arg;
+    }
+    if (type != nullptr) {
+        *type = array->arrayType;
+    }
+    if (length != nullptr) {
+        *length = array->length;
+    }
+    if (data != nullptr) {
+        *data = GetBufferData(array->arrayBuffer) + array->byteOffset;
+    }
+    if (arraybuffer != nullptr) {
+        *arraybuffer = ToNapi(array->arrayBuffer);
+    }
+    if (byte_offset != nullptr) {
+        *byte_offset = array->byteOffset;
+    }
+    return napi_ok;
+}
+
+napi_status napi_get_arraybuffer_info(napi_env env, napi_value arraybuffer, void **data, size_t *byte_length)
+{
+    (void)env;
+    FakeValue *buffer = ToFake(arraybuffer);
+    if ((buffer == nullptr) || !buffer->isArrayBuffer) {
+        return napi_invalid_arg;
+    }
+    if (data != nullptr) {
+        *data = GetBufferData(buffer);
+    }
+    if (byte_length != nullptr) {
+        *byte_length = buffer->byteLength;
+    }
+    return napi_ok;
+}
+
+napi_status napi_typeof(napi_env env, napi_value value, napi_valuetype *result)
+{
+    (void)env;
+    if ((value == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    *result = ToFake(value)->type;
+    return napi_ok;
+}
+
+napi_status napi_get_value_bool(napi_env env, napi_value value, bool *result)
+{
+    (void)env;
+    if ((value == nullptr) || (ToFake(value)->type != napi_boolean) || (result == nullptr)) {
+        return napi_boolean_expected;
+    }
+    *result = ToFake(value)->boolean;
+    return napi_ok;
+}
+
+napi_status napi_get_value_double(napi_env env, napi_value value, double *result)
+{
+    (void)env;
+    if ((value == nullptr) || (ToFake(value)->type != napi_number) || (result == nullptr)) {
+        return napi_number_expected;
+    }
+    *result = ToFake(value)->number;
+    return napi_ok;
+}
+
+napi_status napi_get_value_int32(napi_env env, napi_value value, int32_t *result)
+{
+    double number = 0;
+    napi_status status = napi_get_value_double(env, value, &number);
+    if ((status == napi_ok) && (result != nullptr)) {
+        *result = static_cast<int32_t>(number);
+    }
+    return status;
+}
+
+napi_status napi_get_value_uint32(napi_env env, napi_value value, uint32_t *result)
+{
+    double number = 0;
+    napi_status status = napi_get_value_double(env, value, &number);
+    if ((status == napi_ok) && (result != nullptr)) {
+        *result = static_cast<uint32_t>(number);
+    }
+    return status;
+}
+
+napi_status napi_get_value_string_utf8(napi_env env, napi_value value, char *buf, size_t bufsize, size_t *result)
+{
+    (void)env;
+    if ((value == nullptr) || (ToFake(value)->type != napi_string)) {
+        return napi_string_expected;
+    }
+    const std::string &str = ToFake(value)->str;
+    if (buf == nullptr) {
+        if (result == nullptr) {
+            return napi_invalid_arg;
+        }
+        *result = str.size();
+        return napi_ok;
+    }
+    size_t copied = (bufsize == 0) ? 0 : std::min(str.size(), bufsize - 1);
+    if (bufsize != 0) {
+        (void)memcpy(buf, str.data(), copied);
+        buf[copied] = '\0';
+    }
+    if (result != nullptr) {
+        *result = copied;
+    }
+    return napi_ok;
+}
+
+napi_status napi_get_value_bigint_words(napi_env env, napi_value value, int *sign_bit, size_t *word_count,
+    uint64_t *words)
+{
+    (void)env;
+    if ((value == nullptr) || (ToFake(value)->type != napi_bigint) || (word_count == nullptr)) {
+        return napi_invalid_arg;
+    }
+    const FakeValue *bigint = ToFake(value);
+    if (words == nullptr) {
+        *word_count = bigint->words.size();
+        return napi_ok;
+    }
+    size_t count = std::min(*word_count, bigint->words.size());
+    std::copy(bigint->words.begin(), bigint->words.begin() + count, words);
+    *word_count = count;
+    if (sign_bit != nullptr) {
+        *sign_bit = bigint->signBit;
+    }
+    return napi_ok;
+}
+
+napi_status napi_set_named_property(napi_env env, napi_value object, const char *utf8name, napi_value value)
+{
+    (void)env;
+    if ((object == nullptr) || (utf8name == nullptr) || (value == nullptr)) {
+        return napi_invalid_arg;
+    }
+    ToFake(object)->properties[utf8name] = ToFake(value);
+    return napi_ok;
+}
+
+napi_status napi_get_named_property(napi_env env, napi_value object, const char *utf8name, napi_value *result)
+{
+    if ((object == nullptr) || (utf8name == nullptr)) {
+        return napi_invalid_arg;
+    }
+    auto it = ToFake(object)->properties.find(utf8name);
+    if (it == ToFake(object)->properties.end()) {
+        return napi_get_undefined(env, result);
+    }
+    return SetResult(result, it->second);
+}
+
+napi_status napi_set_element(napi_env env, napi_value object, uint32_t index, napi_value value)
+{
+    (void)env;
+    if ((object == nullptr) || (value == nullptr)) {
+        return napi_invalid_arg;
+    }
+    std::vector<FakeValue *> &elements = ToFake(object)->elements;
+    if (index >= elements.size()) {
+        elements.resize(index + 1, nullptr);
+    }
+    elements[index] = ToFake(value);
+    return napi_ok;
+}
+
+napi_status napi_get_element(napi_env env, napi_value object, uint32_t index, napi_value *result)
+{
+    if (object == nullptr) {
+        return napi_invalid_arg;
+    }
+    const std::vector<FakeValue *> &elements = ToFake(object)->elements;
+    if ((index >= elements.size()) || (elements[index] == nullptr)) {
+        return napi_get_undefined(env, result);
+    }
+    return SetResult(result, elements[index]);
+}
+
+napi_status napi_is_array(napi_env env, napi_value value, bool *result)
+{
+    (void)env;
+    if ((value == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    *result = ToFake(value)->isArray;
+    return napi_ok;
+}
+
+napi_status napi_get_array_length(napi_env env, napi_value value, uint32_t *result)
+{
+    (void)env;
+    if ((value == nullptr) || !ToFake(value)->isArray || (result == nullptr)) {
+        return napi_array_expected;
+    }
+    *result = static_cast<uint32_t>(ToFake(value)->elements.size());
+    return napi_ok;
+}
+
+napi_status napi_define_properties(napi_env env, napi_value object, size_t property_count,
+    const napi_property_descriptor *properties)
+{
+    (void)env;
+    if ((object == nullptr) || ((properties == nullptr) && (property_count != 0))) {
+        return napi_invalid_arg;
+    }
+    SetProperties(ToFake(object), property_count, properties);
+    return napi_ok;
+}
+
+napi_status napi_define_class(napi_env env, const char *utf8name, size_t length, napi_callback constructor,
+    void *data, size_t property_count, const napi_property_descriptor *properties, napi_value *result)
+{
+    (void)env;
+    (void)utf8name;
+    (void)length;
+    if ((constructor == nullptr) || ((properties == nullptr) && (property_count != 0))) {
+        return napi_invalid_arg;
+    }
+    FakeValue *cls = NewValue(napi_function);
+    cls->callback = constructor;
+    cls->callbackData = data;
+    cls->descriptors.assign(properties, properties + property_count);
+    return SetResult(result, cls);
+}
+
+napi_status napi_new_instance(napi_env env, napi_value constructor, size_t argc, const napi_value *argv,
+    napi_value *result)
+{
+    FakeValue *cls = ToFake(constructor);
+    if ((cls == nullptr) || (cls->callback == nullptr) || (result == nullptr)) {
+        return napi_function_expected;
+    }
+    FakeValue *instance = NewValue(napi_object);
+    instance->constructor = cls;
+    SetProperties(instance, cls->descriptors.size(), cls->descriptors.data());
+    std::vector<napi_value> args(argv, argv + argc);
+    (void)CertframeworkNapiTest::FakeNapiCall(env, constructor, ToNapi(instance), args);
+    *result = ToNapi(instance);
+    return napi_ok;
+}
+
+napi_status napi_instanceof(napi_env env, napi_value object, napi_value constructor, bool *result)
+{
+    (void)env;
+    if ((object == nullptr) || (constructor == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    *result = (ToFake(object)->constructor == ToFake(constructor));
+    return napi_ok;
+}
+
+napi_status napi_get_cb_info(napi_env env, napi_callback_info cbinfo, size_t *argc, napi_value *argv,
+    napi_value *this_arg, void **data)
+{
+    const FakeCallbackInfo *info = reinterpret_cast<const FakeCallbackInfo *>(cbinfo);
+    if (info == nullptr) {
+        return napi_invalid_arg;
+    }
+    if (argc != nullptr) {
+        for (size_t i = 0; (argv != nullptr) && (i < *argc); ++i) {
+            if (i < info->args.size()) {
+                argv[i] = ToNapi(info->args[i]);
+            } else {
+                (void)napi_get_undefined(env, &argv[i]);
+            }
+        }
+        *argc = info->args.size();
+    }
+    if (this_arg != nullptr) {
+        *this_arg = ToNapi(info->thisVar);
+    }
+    if (data != nullptr) {
+        *data = info->data;
+    }
+    return napi_ok;
+}
+
+napi_status napi_call_function(napi_env env, napi_value recv, napi_value func, size_t argc, const napi_value *argv,
+    napi_value *result)
+{
+    if ((func == nullptr) || (ToFake(func)->callback == nullptr)) {
+        return napi_function_expected;
+    }
+    std::vector<napi_value> args(argv, argv + argc);
+    napi_value ret = CertframeworkNapiTest::FakeNapiCall(env, func, recv, args);
+    if (result != nullptr) {
+        *result = ret;
+    }
+    return napi_ok;
+}
+
+napi_status napi_create_reference(napi_env env, napi_value value, uint32_t initial_refcount, napi_ref *result)
+{
+    (void)env;
+    if ((value == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    FakeRef *ref = new FakeRef { ToFake(value), initial_refcount };
+    g_refs.push_back(ref);
+    *result = reinterpret_cast<napi_ref>(ref);
+    return napi_ok;
+}
+
+napi_status napi_get_reference_value(napi_env env, napi_ref ref, napi_value *result)
+{
+    (void)env;
+    if ((ref == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    *result = ToNapi(reinterpret_cast<FakeRef *>(ref)->value);
+    return napi_ok;
+}
+
+napi_status napi_delete_reference(napi_env env, napi_ref ref)
+{
+    (void)env;
+    auto it = std::find(g_refs.begin(), g_refs.end(), reinterpret_cast<FakeRef *>(ref));
+    if (it == g_refs.end()) {
+        return napi_invalid_arg;
+    }
+    delete *it;
+    g_refs.erase(it);
+    return napi_ok;
+}
+
+napi_status napi_wrap(napi_env env, napi_value js_object, void *native_object, napi_finalize finalize_cb,
+    void *finalize_hint, napi_ref *result)
+{
+    FakeValue *object = ToFake(js_object);
+    if ((object == nullptr) || (native_object == nullptr) || object->wrapped) {
+        return napi_invalid_arg;
+    }
+    object->wrapped = true;
+    object->native = native_object;
+    object->finalizeEnv = env;
+    object->finalize = finalize_cb;
+    object->finalizeHint = finalize_hint;
+    return (result == nullptr) ? napi_ok : napi_create_reference(env, js_object, 0, result);
+}
+
+napi_status napi_unwrap(napi_env env, napi_value js_object, void **result)
+{
+    (void)env;
+    if ((js_object == nullptr) || (result == nullptr)) {
+        return napi_invalid_arg;
+    }
+    *result = ToFake(js_object)->native;
+    return (*result == nullptr) ? napi_invalid_arg : napi_ok;
+}
+
+napi_status napi_coerce_to_native_binding_object(napi_env env, napi_value js_object,
+    napi_native_binding_detach_callback detach_cb, napi_native_binding_attach_callback attach_cb, void *native_object,
+    void *hint)
+{
+    (void)env;
+    FakeValue *object = ToFake(js_object);
+    if ((object == nullptr) || (detach_cb == nullptr) || (attach_cb == nullptr) || (native_object == nullptr)) {
+        return napi_invalid_arg;
+    }
+    object->detach = detach_cb;
+    object->attach = attach_cb;
+    object->bindingNative = native_object;
+    object->bindingHint = hint;
+    return napi_ok;
+}
+
+napi_status napi_adjust_external_memory(napi_env env, int64_t change_in_bytes, int64_t *adjusted_value)
+{
+    FakeEnvState &state = g_envStates[env];
+    state.externalMemory += change_in_bytes;
+    if (adjusted_value != nullptr) {
+        *adjusted_value = state.externalMemory;
+    }
+    return napi_ok;
+}
+
+napi_status napi_create_promise(napi_env env, napi_deferred *deferred, napi_value *promise)
+{
+    (void)env;
+    if ((deferred == nullptr) || (promise == nullptr)) {
+        return napi_invalid_arg;
+    }
+    FakeValue *value = NewValue(napi_object);
+    value->isPromise = true;
+    *deferred = reinterpret_cast<napi_deferred>(value);
+    *promise = ToNapi(value);
+    return napi_ok;
+}
+
+static napi_status SettlePromise(napi_deferred deferred, CertframeworkNapiTest::FakePromiseState state,
+    napi_value result)
+{
+    FakeValue *promise = reinterpret_cast<FakeValue *>(deferred);
+    if ((promise == nullptr) || (promise->promiseState != CertframeworkNapiTest::FAKE_PROMISE_PENDING)) {
+        return napi_invalid_arg;
+    }
+    promise->promiseState = state;
+    promise->promiseResult = ToFake(result);
+    return napi_ok;
+}
+
+napi_status napi_resolve_deferred(napi_env env, napi_deferred deferred, napi_value resolution)
+{
+    (void)env;
+    return SettlePromise(deferred, CertframeworkNapiTest::FAKE_PROMISE_RESOLVED, resolution);
+}
+
+napi_status napi_reject_deferred(napi_env env, napi_deferred deferred, napi_value rejection)
+{
+    (void)env;
+    return SettlePromise(deferred, CertframeworkNapiTest::FAKE_PROMISE_REJECTED, rejection);
+}
+
+napi_status napi_throw(napi_env env, napi_value error)
+{
+    if (error == nullptr) {
+        return napi_invalid_arg;
+    }
+    FakeEnvState &state = g_envStates[env];
+    if (state.exception != nullptr) {
+        return napi_pending_exception;
+    }
+    state.exception = ToFake(error);
+    return napi_ok;
+}
+
+napi_status napi_is_exception_pending(napi_env env, bool *result)
+{
+    if (result == nullptr) {
+        return napi_invalid_arg;
+    }
+    *result = (g_envStates[env].exception != nullptr);
+    return napi_ok;
+}
+
+napi_status napi_get_and_clear_last_exception(napi_env env, napi_value *result)
+{
+    FakeEnvState &state = g_envStates[env];
+    if (state.exception == nullptr) {
+        return napi_get_undefined(env, result);
+    }
+    napi_status status = SetResult(result, state.exception);
+    state.exception = nullptr;
+    return status;
+}
+
+napi_status napi_fatal_exception(napi_env env, napi_value err)
+{
+    (void)env;
+    if (err == nullptr) {
+        return napi_invalid_arg;
+    }
+    g_fatalExceptions++;
+    return napi_ok;
+}
+
+napi_status napi_open_handle_scope(napi_env env, napi_handle_scope *result)
+{
+    (void)env;
+    if (result == nullptr) {
+        return napi_invalid_arg;
+    }
+    g_openedScopes++;
+    g_liveScopes++;
+    *result = reinterpret_cast<napi_handle_scope>(static_cast<uintptr_t>(g_openedScopes));
+    return napi_ok;
+}
+
+napi_status napi_close_handle_scope(napi_env env, napi_handle_scope scope)
+{
+    (void)env;
+    if ((scope == nullptr) || (g_liveScopes == 0)) {
+        return napi_invalid_arg;
+    }
+    g_liveScopes--;
+    return napi_ok;
+}
+
+void napi_module_register(napi_module *mod)
+{
+    (void)mod;
+}
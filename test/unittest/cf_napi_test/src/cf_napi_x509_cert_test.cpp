@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <openssl/bio.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "cf_napi_fake.h"
+#include "cf_test_data.h"
+#include "napi_cert_defines.h"
+#include "napi_x509_certificate.h"
+
+using namespace testing::ext;
+using namespace OHOS::CertFramework;
+using namespace CertframeworkNapiTest;
+using namespace CertframeworkTestData;
+
+namespace {
+constexpr uint32_t WAIT_ROUNDS = 10000; /* 10 seconds of 1 ms rounds */
+
+class CfNapiX509CertTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+
+    napi_env env_ = nullptr;
+    napi_value exports_ = nullptr;
+};
+
+void CfNapiX509CertTest::SetUpTestCase(void)
+{
+}
+
+void CfNapiX509CertTest::TearDownTestCase(void)
+{
+}
+
+void CfNapiX509CertTest::SetUp()
+{
+    FakeNapiReset();
+    env_ = FakeNapiGetEnv(0);
+    napi_create_object(env_, &exports_);
+    NapiX509Certificate::DefineX509CertJSClass(env_, exports_);
+}
+
+void CfNapiX509CertTest::TearDown()
+{
+    FakeNapiRunCleanupHooks();
+    FakeNapiReset();
+}
+
+/* the PEM of the DER cert g_certData01 */
+std::vector<uint8_t> GetTestCertPem(void)
+{
+    std::vector<uint8_t> pem;
+    const unsigned char *in = g_certData01;
+    X509 *x509 = d2i_X509(nullptr, &in, sizeof(g_certData01));
+    BIO *bio = BIO_new(BIO_s_mem());
+    if ((x509 != nullptr) && (bio != nullptr) && (PEM_write_bio_X509(bio, x509) == 1)) {
+        char *data = nullptr;
+        long len = BIO_get_mem_data(bio, &data);
+        pem.assign(data, data + len);
+        pem.push_back('\0');
+    }
+    BIO_free(bio);
+    X509_free(x509);
+    return pem;
+}
+
+/* createX509Cert(encodingBlob) with a promise, run until it settles */
+napi_value CreateCert(napi_env env, napi_value exports, const uint8_t *data, size_t len, CfEncodingFormat format)
+{
+    napi_value buffer = nullptr;
+    void *bufferData = nullptr;
+    napi_create_arraybuffer(env, len, &bufferData, &buffer);
+    std::copy(data, data + len, static_cast<uint8_t *>(bufferData));
+    napi_value array = nullptr;
+    napi_create_typedarray(env, napi_uint8_array, len, buffer, 0, &array);
+    napi_value blob = nullptr;
+    napi_create_object(env, &blob);
+    napi_set_named_property(env, blob, CERT_TAG_DATA.c_str(), array);
+    napi_value formatValue = nullptr;
+    napi_create_uint32(env, format, &formatValue);
+    napi_set_named_property(env, blob, CERT_TAG_ENCODING_FORMAT.c_str(), formatValue);
+
+    napi_value promise = FakeNapiCallMethod(env, exports, "createX509Cert", { blob });
+    napi_value cert = nullptr;
+    for (uint32_t i = 0; (i < WAIT_ROUNDS) && (FakeNapiGetPromiseState(promise, &cert) == FAKE_PROMISE_PENDING);
+        ++i) {
+        if (FakeNapiRunLoop() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return (FakeNapiGetPromiseState(promise, &cert) == FAKE_PROMISE_RESOLVED) ? cert : nullptr;
+}
+
+/**
+ * @tc.name: CfNapiX509CertTest001
+ * @tc.desc: the PEM and the DER of the same cert report the same native size
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CertTest, CfNapiX509CertTest001, TestSize.Level0)
+{
+    std::vector<uint8_t> pem = GetTestCertPem();
+    ASSERT_FALSE(pem.empty());
+
+    napi_value pemCert = CreateCert(env_, exports_, pem.data(), pem.size(), CF_FORMAT_PEM);
+    ASSERT_NE(pemCert, nullptr);
+    int64_t pemSize = FakeNapiGetExternalMemory(env_);
+    napi_value derCert = CreateCert(env_, exports_, g_certData01, sizeof(g_certData01), CF_FORMAT_DER);
+    ASSERT_NE(derCert, nullptr);
+    int64_t derSize = FakeNapiGetExternalMemory(env_) - pemSize;
+
+    EXPECT_GT(pemSize, static_cast<int64_t>(sizeof(g_certData01)));
+    EXPECT_EQ(pemSize, derSize);
+    FakeNapiCollect(pemCert);
+    FakeNapiCollect(derCert);
+    EXPECT_EQ(FakeNapiGetExternalMemory(env_), 0);
+}
+
+int32_t GetVersion(napi_env env, napi_value cert)
+{
+    int32_t version = -1;
+    napi_value result = FakeNapiCallMethod(env, cert, "getVersion", {});
+    if (result != nullptr) {
+        napi_get_value_int32(env, result, &version);
+    }
+    return version;
+}
+
+/**
+ * @tc.name: CfNapiX509CertTest002
+ * @tc.desc: a cert attached by another worker shares the natives, which only the creating env reports
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CertTest, CfNapiX509CertTest002, TestSize.Level0)
+{
+    napi_value cert = CreateCert(env_, exports_, g_certData01, sizeof(g_certData01), CF_FORMAT_DER);
+    ASSERT_NE(cert, nullptr);
+    int64_t size = FakeNapiGetExternalMemory(env_);
+    int32_t version = GetVersion(env_, cert);
+    EXPECT_GT(version, 0);
+
+    napi_env worker = FakeNapiGetEnv(1);
+    void *detached = FakeNapiDetach(env_, cert);
+    ASSERT_NE(detached, nullptr);
+    napi_value attached = FakeNapiAttach(worker, cert, detached);
+    ASSERT_NE(attached, nullptr);
+    EXPECT_EQ(FakeNapiGetExternalMemory(worker), 0);
+    EXPECT_EQ(FakeNapiGetExternalMemory(env_), size);
+
+    /* the natives outlive the sender's wrapper */
+    FakeNapiCollect(cert);
+    EXPECT_EQ(FakeNapiGetExternalMemory(env_), 0);
+    EXPECT_EQ(GetVersion(worker, attached), version);
+    FakeNapiCollect(attached);
+    EXPECT_EQ(FakeNapiGetExternalMemory(worker), 0);
+}
+
+/**
+ * @tc.name: CfNapiX509CertTest003
+ * @tc.desc: a detached cert that is never attached is freed when the sending env is cleaned up
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CertTest, CfNapiX509CertTest003, TestSize.Level0)
+{
+    napi_value cert = CreateCert(env_, exports_, g_certData01, sizeof(g_certData01), CF_FORMAT_DER);
+    ASSERT_NE(cert, nullptr);
+    void *dropped = FakeNapiDetach(env_, cert);
+    void *received = FakeNapiDetach(env_, cert);
+    ASSERT_NE(dropped, nullptr);
+    ASSERT_NE(received, nullptr);
+    EXPECT_NE(dropped, received);
+
+    napi_env worker = FakeNapiGetEnv(1);
+    napi_value attached = FakeNapiAttach(worker, cert, received);
+    ASSERT_NE(attached, nullptr);
+    EXPECT_EQ(FakeNapiAttach(worker, cert, received), nullptr); /* a copy is attached once */
+
+    /* the leak check of the sanitizer builds catches a dropped copy that is not freed */
+    FakeNapiRunCleanupHooks();
+    EXPECT_EQ(FakeNapiAttach(worker, cert, dropped), nullptr);
+    EXPECT_GT(GetVersion(worker, attached), 0);
+}
+}
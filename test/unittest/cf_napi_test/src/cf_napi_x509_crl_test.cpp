@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <openssl/bio.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include "cf_memory.h"
+#include "cf_napi_fake.h"
+#include "cf_test_x509_common.h"
+#include "napi_cert_defines.h"
+#include "napi_cert_utils.h"
+#include "napi_x509_crl.h"
+#include "napi_x509_crl_entry.h"
+
+using namespace testing::ext;
+using namespace OHOS::CertFramework;
+using namespace CertframeworkNapiTest;
+using namespace CertframeworkX509Test;
+
+namespace {
+constexpr uint32_t ENTRY_COUNT = 16;
+constexpr uint32_t WAIT_ROUNDS = 10000; /* 10 seconds of 1 ms rounds */
+constexpr uint32_t LONGEST_SERIAL_LEN = 20; /* RFC 5280 limits serial numbers to 20 octets */
+constexpr size_t TOO_MANY_WORDS = MAX_SN_BYTE_CNT / sizeof(uint64_t) + 1;
+
+class CfNapiX509CrlTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+
+    napi_env env_ = nullptr;
+    napi_value exports_ = nullptr;
+};
+
+void CfNapiX509CrlTest::SetUpTestCase(void)
+{
+}
+
+void CfNapiX509CrlTest::TearDownTestCase(void)
+{
+}
+
+void CfNapiX509CrlTest::SetUp()
+{
+    FakeNapiReset();
+    env_ = FakeNapiGetEnv(0);
+    napi_create_object(env_, &exports_);
+    NapiX509Crl::DefineX509CrlJSClass(env_, exports_);
+    NapiX509CrlEntry::DefineX509CrlEntryJSClass(env_);
+}
+
+void CfNapiX509CrlTest::TearDown()
+{
+    FakeNapiRunCleanupHooks();
+    FakeNapiReset();
+}
+
+std::vector<TestRevokedEntry> GetTestEntries(void)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < ENTRY_COUNT; ++i) {
+        entries.push_back({ { 0x01, static_cast<uint8_t>(i) }, TEST_THIS_UPDATE, 0 });
+    }
+    std::vector<uint8_t> longest(LONGEST_SERIAL_LEN, 0xA5); /* 0xA5: any filler */
+    longest[0] = 0x7F; /* the highest positive first byte */
+    entries.push_back({ longest, TEST_THIS_UPDATE, 0 });
+    return entries;
+}
+
+/* the words of a bigint are little-endian, the serial bytes big-endian */
+napi_value MakeBigInt(napi_env env, const std::vector<uint8_t> &bytes, int signBit)
+{
+    std::vector<uint64_t> words((bytes.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        words[i / sizeof(uint64_t)] |= static_cast<uint64_t>(bytes[bytes.size() - 1 - i]) <<
+            (8 * (i % sizeof(uint64_t))); /* 8: bits of a byte */
+    }
+    napi_value result = nullptr;
+    napi_create_bigint_words(env, signBit, words.size(), words.data(), &result);
+    return result;
+}
+
+std::vector<uint8_t> GetBigIntBytes(napi_env env, napi_value value)
+{
+    size_t count = 0;
+    std::vector<uint8_t> bytes;
+    if (napi_get_value_bigint_words(env, value, nullptr, &count, nullptr) != napi_ok) {
+        return bytes;
+    }
+    std::vector<uint64_t> words(count, 0);
+    int signBit = 0;
+    (void)napi_get_value_bigint_words(env, value, &signBit, &count, words.data());
+    for (size_t i = count * sizeof(uint64_t); i > 0; --i) {
+        uint8_t byte = static_cast<uint8_t>(words[(i - 1) / sizeof(uint64_t)] >>
+            (8 * ((i - 1) % sizeof(uint64_t)))); /* 8: bits of a byte */
+        if (!bytes.empty() || (byte != 0)) {
+            bytes.push_back(byte);
+        }
+    }
+    return bytes;
+}
+
+/* the code of the business error thrown, 0 without one */
+uint32_t TakeErrorCode(napi_env env)
+{
+    bool pending = false;
+    napi_is_exception_pending(env, &pending);
+    if (!pending) {
+        return 0;
+    }
+    napi_value error = nullptr;
+    napi_value code = nullptr;
+    uint32_t value = 0;
+    napi_get_and_clear_last_exception(env, &error);
+    napi_get_named_property(env, error, CERT_TAG_ERR_CODE.c_str(), &code);
+    napi_get_value_uint32(env, code, &value);
+    return value;
+}
+
+/* createX509Crl(encodingBlob) with a promise, run until it settles */
+napi_value CreateCrl(napi_env env, napi_value exports, const CfEncodingBlob &der)
+{
+    napi_value buffer = nullptr;
+    void *data = nullptr;
+    napi_create_arraybuffer(env, der.len, &data, &buffer);
+    std::copy(der.data, der.data + der.len, static_cast<uint8_t *>(data));
+    napi_value array = nullptr;
+    napi_create_typedarray(env, napi_uint8_array, der.len, buffer, 0, &array);
+    napi_value blob = nullptr;
+    napi_create_object(env, &blob);
+    napi_set_named_property(env, blob, CERT_TAG_DATA.c_str(), array);
+    napi_value format = nullptr;
+    napi_create_uint32(env, der.encodingFormat, &format);
+    napi_set_named_property(env, blob, CERT_TAG_ENCODING_FORMAT.c_str(), format);
+
+    napi_value promise = FakeNapiCallMethod(env, exports, "createX509Crl", { blob });
+    napi_value crl = nullptr;
+    for (uint32_t i = 0; (i < WAIT_ROUNDS) && (FakeNapiGetPromiseState(promise, &crl) == FAKE_PROMISE_PENDING); ++i) {
+        if (FakeNapiRunLoop() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return (FakeNapiGetPromiseState(promise, &crl) == FAKE_PROMISE_RESOLVED) ? crl : nullptr;
+}
+
+napi_value CreateTestCrl(napi_env env, napi_value exports, const std::vector<TestRevokedEntry> &entries)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (BuildTestCrl(entries, &der, nullptr) != CF_SUCCESS) {
+        return nullptr;
+    }
+    napi_value crl = CreateCrl(env, exports, der);
+    CfFree(der.data);
+    return crl;
+}
+
+/* the PEM of a DER CRL */
+std::vector<uint8_t> GetCrlPem(const CfEncodingBlob &der)
+{
+    std::vector<uint8_t> pem;
+    const unsigned char *in = der.data;
+    X509_CRL *crl = d2i_X509_CRL(nullptr, &in, static_cast<long>(der.len));
+    BIO *bio = BIO_new(BIO_s_mem());
+    if ((crl != nullptr) && (bio != nullptr) && (PEM_write_bio_X509_CRL(bio, crl) == 1)) {
+        char *data = nullptr;
+        long len = BIO_get_mem_data(bio, &data);
+        pem.assign(data, data + len);
+        pem.push_back('\0');
+    }
+    BIO_free(bio);
+    X509_CRL_free(crl);
+    return pem;
+}
+
+/**
+ * @tc.name: CfNapiX509CrlTest001
+ * @tc.desc: getRevokedCertWithSerial finds the entry of a bigint serial, up to the longest serials
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CrlTest, CfNapiX509CrlTest001, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = GetTestEntries();
+    napi_value crl = CreateTestCrl(env_, exports_, entries);
+    ASSERT_NE(crl, nullptr);
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        napi_value serial = MakeBigInt(env_, entries[i].serial, 0);
+        napi_value entry = FakeNapiCallMethod(env_, crl, "getRevokedCertWithSerial", { serial });
+        ASSERT_NE(entry, nullptr) << "entry: " << i;
+        EXPECT_EQ(TakeErrorCode(env_), 0U) << "entry: " << i;
+        napi_value entrySerial = FakeNapiCallMethod(env_, entry, "getSerialNumber", {});
+        EXPECT_EQ(GetBigIntBytes(env_, entrySerial), entries[i].serial) << "entry: " << i;
+    }
+}
+
+/**
+ * @tc.name: CfNapiX509CrlTest002
+ * @tc.desc: getRevokedCertWithSerial throws for a serial that is not revoked, also by a CRL without entries
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CrlTest, CfNapiX509CrlTest002, TestSize.Level0)
+{
+    napi_value crl = CreateTestCrl(env_, exports_, GetTestEntries());
+    napi_value empty = CreateTestCrl(env_, exports_, {});
+    ASSERT_NE(crl, nullptr);
+    ASSERT_NE(empty, nullptr);
+    for (napi_value self : { crl, empty }) {
+        for (const std::vector<uint8_t> &serial : std::vector<std::vector<uint8_t>> { { 0x01, ENTRY_COUNT }, { 0x02 },
+            { 0x01 } }) {
+            EXPECT_EQ(FakeNapiCallMethod(env_, self, "getRevokedCertWithSerial", { MakeBigInt(env_, serial, 0) }),
+                nullptr);
+            EXPECT_EQ(TakeErrorCode(env_), static_cast<uint32_t>(JS_ERR_CERT_RUNTIME_ERROR));
+        }
+    }
+}
+
+/**
+ * @tc.name: CfNapiX509CrlTest003
+ * @tc.desc: getRevokedCertWithSerial rejects a negative or too long bigint, and arguments that are no bigint
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CrlTest, CfNapiX509CrlTest003, TestSize.Level0)
+{
+    napi_value crl = CreateTestCrl(env_, exports_, GetTestEntries());
+    ASSERT_NE(crl, nullptr);
+    napi_value negative = MakeBigInt(env_, { 0x01, 0x00 }, 1); /* -entry 0 */
+    napi_value tooLong = MakeBigInt(env_, std::vector<uint8_t>(TOO_MANY_WORDS * sizeof(uint64_t), 0x01), 0);
+    napi_value text = nullptr;
+    napi_create_string_utf8(env_, "256", NAPI_AUTO_LENGTH, &text);
+    for (napi_value serial : { negative, tooLong, text }) {
+        EXPECT_EQ(FakeNapiCallMethod(env_, crl, "getRevokedCertWithSerial", { serial }), nullptr);
+        EXPECT_EQ(TakeErrorCode(env_), static_cast<uint32_t>(JS_ERR_CERT_INVALID_PARAMS));
+    }
+    EXPECT_EQ(FakeNapiCallMethod(env_, crl, "getRevokedCertWithSerial", {}), nullptr);
+    EXPECT_EQ(TakeErrorCode(env_), static_cast<uint32_t>(JS_ERR_CERT_INVALID_PARAMS));
+}
+
+/**
+ * @tc.name: CfNapiX509CrlTest004
+ * @tc.desc: the PEM and the DER of the same CRL report the same native size
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CrlTest, CfNapiX509CrlTest004, TestSize.Level0)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    ASSERT_EQ(BuildTestCrl(GetTestEntries(), &der, nullptr), CF_SUCCESS);
+    std::vector<uint8_t> pem = GetCrlPem(der);
+    ASSERT_FALSE(pem.empty());
+
+    napi_value pemCrl = CreateCrl(env_, exports_, { pem.data(), pem.size(), CF_FORMAT_PEM });
+    ASSERT_NE(pemCrl, nullptr);
+    int64_t pemSize = FakeNapiGetExternalMemory(env_);
+    napi_value derCrl = CreateCrl(env_, exports_, der);
+    ASSERT_NE(derCrl, nullptr);
+    int64_t derSize = FakeNapiGetExternalMemory(env_) - pemSize;
+
+    EXPECT_GT(pemSize, static_cast<int64_t>(der.len));
+    EXPECT_EQ(pemSize, derSize);
+    CfFree(der.data);
+}
+
+/**
+ * @tc.name: CfNapiX509CrlTest005
+ * @tc.desc: a CRL attached by another worker shares the CRL, which only the creating env reports
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfNapiX509CrlTest, CfNapiX509CrlTest005, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = GetTestEntries();
+    napi_value crl = CreateTestCrl(env_, exports_, entries);
+    ASSERT_NE(crl, nullptr);
+    int64_t size = FakeNapiGetExternalMemory(env_);
+
+    napi_env worker = FakeNapiGetEnv(1);
+    void *dropped = FakeNapiDetach(env_, crl);
+    napi_value attached = FakeNapiAttach(worker, crl, FakeNapiDetach(env_, crl));
+    ASSERT_NE(dropped, nullptr);
+    ASSERT_NE(attached, nullptr);
+    EXPECT_EQ(FakeNapiGetExternalMemory(env_), size);
+
+    FakeNapiCollect(crl);
+    napi_value entry = FakeNapiCallMethod(worker, attached, "getRevokedCertWithSerial",
+        { MakeBigInt(worker, entries[0].serial, 0) });
+    ASSERT_NE(entry, nullptr);
+    /* the entry is the only native size the worker reports */
+    EXPECT_EQ(FakeNapiGetExternalMemory(worker), CertEstimateNativeSize(CERT_NATIVE_OBJ_CRL_ENTRY, 0));
+    FakeNapiRunCleanupHooks();
+    EXPECT_EQ(FakeNapiAttach(worker, crl, dropped), nullptr);
+}
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/x509_vfy.h>
+#include <openssl/x509v3.h>
+
+#include "cert_chain_validator.h"
+#include "cf_result.h"
+
+#include "cf_test_chain_common.h"
+#include "cf_test_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkChainTest;
+
+namespace {
+constexpr uint32_t TRUST_STORE_CACHE_MAX = 256; /* issuers a trust store caches before it is started afresh */
+
+TestChainCert g_root;
+TestChainCert g_inter;
+TestChainCert g_leaf;
+
+class CfCertChainValidatorTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfCertChainValidatorTest::SetUpTestCase(void)
+{
+    g_root = IssueTestChainCert("Test Root", nullptr, GetTestCaExtensions());
+    g_inter = IssueTestChainCert("Test Inter", &g_root, GetTestCaExtensions());
+    g_leaf = IssueTestChainCert("Test Leaf", &g_inter, {});
+}
+
+void CfCertChainValidatorTest::TearDownTestCase(void)
+{
+    FreeTestChainCert(g_leaf);
+    FreeTestChainCert(g_inter);
+    FreeTestChainCert(g_root);
+}
+
+void CfCertChainValidatorTest::SetUp()
+{
+}
+
+void CfCertChainValidatorTest::TearDown()
+{
+}
+
+static CfResult Validate(HcfCertChainValidator *validator, const std::vector<X509 *> &certs)
+{
+    std::vector<uint8_t> data = PackTestChainData(certs);
+    HcfCertChainData chainData = { data.data(), static_cast<uint32_t>(data.size()),
+        static_cast<uint8_t>(certs.size()), CF_FORMAT_DER };
+    return validator->validate(validator, &chainData);
+}
+
+static CfResult Validate(const std::vector<X509 *> &certs)
+{
+    HcfCertChainValidator *validator = nullptr;
+    CfResult ret = HcfCertChainValidatorCreate("PKIX", &validator);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    ret = Validate(validator, certs);
+    CfObjDestroy(validator);
+    return ret;
+}
+
+/* A new empty directory under TMPDIR, empty on failure. */
+static std::string MakeTrustDir(void)
+{
+    const char *tmpDir = getenv("TMPDIR");
+    std::string dirTemplate = std::string((tmpDir != nullptr) ? tmpDir : "/data/local/tmp") + "/cf_trust_XXXXXX";
+    return (mkdtemp(&dirTemplate[0]) != nullptr) ? dirTemplate : std::string();
+}
+
+/* Writes x509 as PEM to dir in the openssl rehash layout and returns the path of the file. */
+static std::string AddTrustCert(const std::string &dir, X509 *x509)
+{
+    char name[sizeof("/01234567.0")] = { 0 };
+    (void)snprintf(name, sizeof(name), "/%08lx.0", X509_NAME_hash(X509_get_subject_name(x509)));
+    std::string path = dir + name;
+    FILE *fp = fopen(path.c_str(), "w");
+    if (fp == nullptr) {
+        return std::string();
+    }
+    int ret = PEM_write_X509(fp, x509);
+    (void)fclose(fp);
+    return (ret == 1) ? path : std::string();
+}
+
+static void RemoveTrustDir(const std::string &dir, const std::vector<std::string> &files)
+{
+    for (const std::string &file : files) {
+        (void)unlink(file.c_str());
+    }
+    (void)rmdir(dir.c_str());
+}
+
+/* What X509_verify_cert alone gives for the chain, with the certs after the leaf trusted as the validator does. */
+static CfResult VerifyWithOpenssl(const std::vector<X509 *> &certs)
+{
+    X509_STORE *store = X509_STORE_new();
+    X509_STORE_CTX *ctx = X509_STORE_CTX_new();
+    int errCode = X509_V_ERR_UNSPECIFIED;
+    if ((store != nullptr) && (ctx != nullptr)) {
+        for (size_t i = 1; i < certs.size(); ++i) {
+            (void)X509_STORE_add_cert(store, certs[i]);
+        }
+        X509_STORE_set_flags(store, X509_V_FLAG_NO_CHECK_TIME);
+        if (X509_STORE_CTX_init(ctx, store, certs[0], nullptr) == 1) {
+            errCode = (X509_verify_cert(ctx) == 1) ? X509_V_OK : X509_STORE_CTX_get_error(ctx);
+        }
+    }
+    X509_STORE_CTX_free(ctx);
+    X509_STORE_free(store);
+    switch (errCode) {
+        case X509_V_OK:
+            return CF_SUCCESS;
+        case X509_V_ERR_CERT_SIGNATURE_FAILURE:
+            return CF_ERR_CERT_SIGNATURE_FAILURE;
+        case X509_V_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY:
+            return CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY;
+        case X509_V_ERR_KEYUSAGE_NO_CERTSIGN:
+            return CF_ERR_KEYUSAGE_NO_CERTSIGN;
+        default:
+            return CF_ERR_CRYPTO_OPERATION;
+    }
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest001
+ * @tc.desc: a valid chain from the leaf to the root passes the pre-flight and openssl
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest001, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    std::vector<X509 *> chain = { g_leaf.x509, g_inter.x509, g_root.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(chain), CF_SUCCESS);
+    EXPECT_EQ(Validate(chain), CF_SUCCESS);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest002
+ * @tc.desc: the pre-flight finds the issuers wherever they are after the leaf
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest002, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    std::vector<X509 *> chain = { g_leaf.x509, g_root.x509, g_inter.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(chain), CF_SUCCESS);
+    EXPECT_EQ(Validate(chain), CF_SUCCESS);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest003
+ * @tc.desc: a missing issuer of the leaf or of an intermediate fails as in openssl
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest003, TestSize.Level0)
+{
+    ASSERT_NE(g_leaf.x509, nullptr);
+    std::vector<X509 *> noInter = { g_leaf.x509, g_root.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(noInter), CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+    EXPECT_EQ(Validate(noInter), CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+
+    /* only the missing issuer of the leaf is reported as a local one */
+    std::vector<X509 *> noRoot = { g_leaf.x509, g_inter.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(noRoot), CF_ERR_CRYPTO_OPERATION);
+    EXPECT_EQ(Validate(noRoot), CF_ERR_CRYPTO_OPERATION);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest004
+ * @tc.desc: an intermediate that is not a CA fails as in openssl
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest004, TestSize.Level0)
+{
+    TestChainCert inter = IssueTestChainCert("Test NonCA Inter", &g_root,
+        { { NID_basic_constraints, "critical,CA:FALSE" } });
+    TestChainCert leaf = IssueTestChainCert("Test Leaf", &inter, {});
+    ASSERT_NE(leaf.x509, nullptr);
+
+    std::vector<X509 *> chain = { leaf.x509, inter.x509, g_root.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(chain), CF_ERR_CRYPTO_OPERATION);
+    EXPECT_EQ(Validate(chain), CF_ERR_CRYPTO_OPERATION);
+    FreeTestChainCert(leaf);
+    FreeTestChainCert(inter);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest005
+ * @tc.desc: an intermediate whose key usage lacks keyCertSign fails as in openssl
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest005, TestSize.Level0)
+{
+    TestChainCert inter = IssueTestChainCert("Test NoCertSign Inter", &g_root,
+        { { NID_basic_constraints, "critical,CA:TRUE" }, { NID_key_usage, "critical,digitalSignature" } });
+    TestChainCert leaf = IssueTestChainCert("Test Leaf", &inter, {});
+    ASSERT_NE(leaf.x509, nullptr);
+
+    std::vector<X509 *> chain = { leaf.x509, inter.x509, g_root.x509 };
+    /* openssl reports such an issuer as an invalid CA */
+    EXPECT_EQ(VerifyWithOpenssl(chain), CF_ERR_CRYPTO_OPERATION);
+    EXPECT_EQ(Validate(chain), CF_ERR_CRYPTO_OPERATION);
+    FreeTestChainCert(leaf);
+    FreeTestChainCert(inter);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest006
+ * @tc.desc: errors openssl finds after the pre-flight map to the same code, unmapped ones to CF_ERR_CRYPTO_OPERATION
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest006, TestSize.Level0)
+{
+    /* same names as the valid chain, another key, so only the signature of the leaf is wrong */
+    TestChainCert forger = IssueTestChainCert("Test Inter", &g_root, GetTestCaExtensions());
+    TestChainCert forged = IssueTestChainCert("Test Leaf", &forger, {});
+    ASSERT_NE(forged.x509, nullptr);
+    std::vector<X509 *> forgedChain = { forged.x509, g_inter.x509, g_root.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(forgedChain), CF_ERR_CERT_SIGNATURE_FAILURE);
+    EXPECT_EQ(Validate(forgedChain), CF_ERR_CERT_SIGNATURE_FAILURE);
+
+    /* the pre-flight does not check path lengths, X509_V_ERR_PATH_LENGTH_EXCEEDED is not in the map */
+    TestChainCert root = IssueTestChainCert("Test PathLen Root", nullptr,
+        { { NID_basic_constraints, "critical,CA:TRUE,pathlen:0" }, { NID_key_usage, "critical,keyCertSign" } });
+    TestChainCert inter = IssueTestChainCert("Test PathLen Inter", &root, GetTestCaExtensions());
+    TestChainCert leaf = IssueTestChainCert("Test Leaf", &inter, {});
+    ASSERT_NE(leaf.x509, nullptr);
+    std::vector<X509 *> longChain = { leaf.x509, inter.x509, root.x509 };
+    EXPECT_EQ(VerifyWithOpenssl(longChain), CF_ERR_CRYPTO_OPERATION);
+    EXPECT_EQ(Validate(longChain), CF_ERR_CRYPTO_OPERATION);
+
+    FreeTestChainCert(leaf);
+    FreeTestChainCert(inter);
+    FreeTestChainCert(root);
+    FreeTestChainCert(forged);
+    FreeTestChainCert(forger);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest007
+ * @tc.desc: with a trust store the anchors are looked up by subject hash, the chain may be the leaf alone
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest007, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Test Store Root", nullptr, GetTestCaExtensions());
+    TestChainCert leaf = IssueTestChainCert("Test Leaf", &root, {});
+    ASSERT_NE(leaf.x509, nullptr);
+    std::string dir = MakeTrustDir();
+    ASSERT_EQ(dir.empty(), false);
+    std::vector<std::string> files = { AddTrustCert(dir, root.x509), AddTrustCert(dir, g_root.x509) };
+    EXPECT_EQ(files[0].empty() || files[1].empty(), false);
+
+    HcfCertChainValidator *validator = nullptr;
+    ASSERT_EQ(HcfCertChainValidatorCreate("PKIX", &validator), CF_SUCCESS);
+    EXPECT_EQ(validator->setTrustStore(validator, dir.c_str()), CF_SUCCESS);
+    EXPECT_EQ(Validate(validator, { leaf.x509 }), CF_SUCCESS);
+    EXPECT_EQ(Validate(validator, { g_leaf.x509, g_inter.x509 }), CF_SUCCESS);
+    /* the certs after the leaf are no anchors any more */
+    EXPECT_EQ(Validate(validator, { g_leaf.x509 }), CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+
+    TestChainCert otherRoot = IssueTestChainCert("Test Other Root", nullptr, GetTestCaExtensions());
+    TestChainCert otherLeaf = IssueTestChainCert("Test Leaf", &otherRoot, {});
+    ASSERT_NE(otherLeaf.x509, nullptr);
+    EXPECT_EQ(Validate(validator, { otherLeaf.x509, otherRoot.x509 }), CF_ERR_CRYPTO_OPERATION);
+
+    CfObjDestroy(validator);
+    RemoveTrustDir(dir, files);
+    FreeTestChainCert(otherLeaf);
+    FreeTestChainCert(otherRoot);
+    FreeTestChainCert(leaf);
+    FreeTestChainCert(root);
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest008
+ * @tc.desc: a missing or invalid trust directory is rejected and leaves the validator without a store
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest008, TestSize.Level0)
+{
+    std::string dir = MakeTrustDir();
+    ASSERT_EQ(dir.empty(), false);
+    std::string file = AddTrustCert(dir, g_root.x509);
+    ASSERT_EQ(file.empty(), false);
+
+    HcfCertChainValidator *validator = nullptr;
+    ASSERT_EQ(HcfCertChainValidatorCreate("PKIX", &validator), CF_SUCCESS);
+    EXPECT_EQ(validator->setTrustStore(validator, nullptr), CF_INVALID_PARAMS);
+    EXPECT_EQ(validator->setTrustStore(validator, ""), CF_INVALID_PARAMS);
+    EXPECT_EQ(validator->setTrustStore(validator, (dir + "/missing").c_str()), CF_INVALID_PARAMS);
+    EXPECT_EQ(validator->setTrustStore(validator, file.c_str()), CF_INVALID_PARAMS);
+    EXPECT_EQ(validator->setTrustStore(nullptr, dir.c_str()), CF_INVALID_PARAMS);
+    /* a leaf alone has no anchor without a store */
+    EXPECT_EQ(Validate(validator, { g_root.x509 }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Validate(validator, { g_leaf.x509, g_inter.x509, g_root.x509 }), CF_SUCCESS);
+
+    CfObjDestroy(validator);
+    RemoveTrustDir(dir, { file });
+}
+
+/**
+ * @tc.name: CfCertChainValidatorTest009
+ * @tc.desc: the store keeps loaded anchors up to TRUST_STORE_CACHE_MAX and is started afresh beyond
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertChainValidatorTest, CfCertChainValidatorTest009, TestSize.Level0)
+{
+    std::string dir = MakeTrustDir();
+    ASSERT_EQ(dir.empty(), false);
+    std::vector<TestChainCert> roots;
+    std::vector<TestChainCert> leaves;
+    std::vector<std::string> files;
+    for (uint32_t i = 0; i <= TRUST_STORE_CACHE_MAX; ++i) {
+        /* the certs share the keys of the fixture, only the names of the roots differ */
+        roots.push_back(IssueTestChainCert("Test Store Root " + std::to_string(i), nullptr, GetTestCaExtensions(),
+            1, g_root.key));
+        leaves.push_back(IssueTestChainCert("Test Leaf", &roots.back(), {}, 1, g_leaf.key));
+        ASSERT_NE(leaves.back().x509, nullptr);
+        files.push_back(AddTrustCert(dir, roots.back().x509));
+    }
+    HcfCertChainValidator *validator = nullptr;
+    ASSERT_EQ(HcfCertChainValidatorCreate("PKIX", &validator), CF_SUCCESS);
+    ASSERT_EQ(validator->setTrustStore(validator, dir.c_str()), CF_SUCCESS);
+
+    /* a loaded anchor stays in the store after its file is gone */
+    EXPECT_EQ(Validate(validator, { leaves[0].x509 }), CF_SUCCESS);
+    (void)unlink(files[0].c_str());
+    EXPECT_EQ(Validate(validator, { leaves[0].x509 }), CF_SUCCESS);
+    for (uint32_t i = 1; i < TRUST_STORE_CACHE_MAX; ++i) {
+        EXPECT_EQ(Validate(validator, { leaves[i].x509 }), CF_SUCCESS);
+    }
+    EXPECT_EQ(Validate(validator, { leaves[0].x509 }), CF_SUCCESS);
+
+    /* one more anchor exceeds the limit, the fresh store reads the directory again */
+    EXPECT_EQ(Validate(validator, { leaves[TRUST_STORE_CACHE_MAX].x509 }), CF_SUCCESS);
+    EXPECT_EQ(Validate(validator, { leaves[0].x509 }), CF_ERR_UNABLE_TO_GET_ISSUER_CERT_LOCALLY);
+    EXPECT_EQ(Validate(validator, { leaves[1].x509 }), CF_SUCCESS);
+
+    CfObjDestroy(validator);
+    RemoveTrustDir(dir, files);
+    for (uint32_t i = 0; i <= TRUST_STORE_CACHE_MAX; ++i) {
+        FreeTestChainCert(leaves[i]);
+        FreeTestChainCert(roots[i]);
+    }
+}
+}
@@ -553,5 +553,180 @@ HWTEST_F(CfCertTest, CfCertTest027, TestSize.Level0)
         params, sizeof(params) / sizeof(CfParam), OP_TYPE_GET);
     EXPECT_EQ(ret, CF_SUCCESS);
 }
+
+/**
+ * @tc.name: CfCertTest028
+ * @tc.desc: get encoded in PEM format, and create a cert again from it
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertTest, CfCertTest028, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CERT_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_ITEM_ENCODED },
+        { .tag = CF_TAG_PARAM1_INT32, .int32Param = CF_FORMAT_PEM },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_CERT, &g_cert[DER_FORMAT_INDEX], params, sizeof(params) / sizeof(CfParam),
+        &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    const char *header = "-----BEGIN CERTIFICATE-----\n";
+    ASSERT_GT(resultParam->blob.size, strlen(header));
+    EXPECT_EQ(memcmp(resultParam->blob.data, header, strlen(header)), 0);
+
+    CfEncodingBlob pem = { resultParam->blob.data, resultParam->blob.size, CF_FORMAT_PEM };
+    CfParamSet *derParamSet = nullptr;
+    CfParam derParams[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CERT_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_ITEM_ENCODED },
+    };
+    ret = CommonTest(CF_OBJ_TYPE_CERT, &pem, derParams, sizeof(derParams) / sizeof(CfParam), &derParamSet);
+    CfFreeParamSet(&outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    ret = CfGetParam(derParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, sizeof(g_certData01));
+    EXPECT_EQ(memcmp(resultParam->blob.data, g_certData01, sizeof(g_certData01)), 0);
+    CfFreeParamSet(&derParamSet);
+}
+
+/**
+ * @tc.name: CfCertTest029
+ * @tc.desc: ->get: PEM format of CF_TAG_PARAM1_INT32 is only valid for CF_ITEM_ENCODED
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertTest, CfCertTest029, TestSize.Level0)
+{
+    CfParam params[] = { /* PEM format of CF_ITEM_TBS */
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CERT_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_ITEM_TBS },
+        { .tag = CF_TAG_PARAM1_INT32, .int32Param = CF_FORMAT_PEM },
+    };
+
+    int32_t ret = AbnormalTest(CF_OBJ_TYPE_CERT, &g_cert[DER_FORMAT_INDEX],
+        params, sizeof(params) / sizeof(CfParam), OP_TYPE_GET);
+    EXPECT_EQ(ret, CF_SUCCESS);
+}
+
+static int32_t GetItemOfObject(const CfObject *object, CfItemId id, CfParamSet **outParamSet)
+{
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CERT_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = id },
+    };
+    CfParamSet *inParamSet = nullptr;
+    int32_t ret = TestConstructParamSetIn(params, sizeof(params) / sizeof(CfParam), &inParamSet);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    ret = object->get(object, inParamSet, outParamSet);
+    CfFreeParamSet(&inParamSet);
+    return ret;
+}
+
+/**
+ * @tc.name: CfCertTest030
+ * @tc.desc: ->dup: the duplicate of a decoded cert outlives the original
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertTest, CfCertTest030, TestSize.Level0)
+{
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_CERT, &g_cert[DER_FORMAT_INDEX], &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParamSet *outParamSet = nullptr;
+    ret = GetItemOfObject(object, CF_ITEM_TBS, &outParamSet); /* decodes the cert */
+    EXPECT_EQ(ret, CF_SUCCESS);
+    CfFreeParamSet(&outParamSet);
+
+    CfObject *dupObject = nullptr;
+    ret = object->dup(object, &dupObject);
+    object->destroy(&object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    ret = GetItemOfObject(dupObject, CF_ITEM_TBS, &outParamSet);
+    EXPECT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(CompareResult(CF_ITEM_TBS, outParamSet, CF_FORMAT_DER), true);
+    CfFreeParamSet(&outParamSet);
+
+    ret = GetItemOfObject(dupObject, CF_ITEM_PUBLIC_KEY, &outParamSet);
+    EXPECT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(CompareResult(CF_ITEM_PUBLIC_KEY, outParamSet, CF_FORMAT_DER), true);
+    CfFreeParamSet(&outParamSet);
+    dupObject->destroy(&dupObject);
+}
+
+/**
+ * @tc.name: CfCertTest031
+ * @tc.desc: ->dup: the duplicate of a cert not decoded yet, and invalid params
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertTest, CfCertTest031, TestSize.Level0)
+{
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_CERT, &g_cert[PEM_FORMAT_INDEX], &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfObject *dupObject = nullptr;
+    EXPECT_NE(object->dup(nullptr, &dupObject), CF_SUCCESS);
+    EXPECT_NE(object->dup(object, nullptr), CF_SUCCESS);
+
+    ret = object->dup(object, &dupObject);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParamSet *outParamSet = nullptr;
+    ret = GetItemOfObject(dupObject, CF_ITEM_TBS, &outParamSet);
+    EXPECT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(CompareResult(CF_ITEM_TBS, outParamSet, CF_FORMAT_PEM), true);
+    CfFreeParamSet(&outParamSet);
+
+    ret = GetItemOfObject(object, CF_ITEM_TBS, &outParamSet);
+    EXPECT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(CompareResult(CF_ITEM_TBS, outParamSet, CF_FORMAT_PEM), true);
+    CfFreeParamSet(&outParamSet);
+    object->destroy(&object);
+    dupObject->destroy(&dupObject);
+}
+
+/**
+ * @tc.name: CfCertTest032
+ * @tc.desc: CfCreate: CF_FORMAT_AUTO detects DER and PEM input, garbage still fails
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCertTest, CfCertTest032, TestSize.Level0)
+{
+    const CfEncodingBlob autoCert[] = {
+        { g_cert[DER_FORMAT_INDEX].data, g_cert[DER_FORMAT_INDEX].len, CF_FORMAT_AUTO },
+        { g_cert[PEM_FORMAT_INDEX].data, g_cert[PEM_FORMAT_INDEX].len, CF_FORMAT_AUTO },
+    };
+    const enum CfEncodingFormat expectFormat[] = { CF_FORMAT_DER, CF_FORMAT_PEM };
+    for (uint32_t i = 0; i < sizeof(autoCert) / sizeof(autoCert[0]); ++i) {
+        CfObject *object = nullptr;
+        int32_t ret = CfCreate(CF_OBJ_TYPE_CERT, &autoCert[i], &object);
+        ASSERT_EQ(ret, CF_SUCCESS);
+
+        CfParamSet *outParamSet = nullptr;
+        ret = GetItemOfObject(object, CF_ITEM_TBS, &outParamSet);
+        EXPECT_EQ(ret, CF_SUCCESS);
+        EXPECT_EQ(CompareResult(CF_ITEM_TBS, outParamSet, expectFormat[i]), true);
+        CfFreeParamSet(&outParamSet);
+        object->destroy(&object);
+    }
+
+    CfEncodingBlob invalid = { const_cast<uint8_t *>(g_certData03), sizeof(g_certData03), CF_FORMAT_AUTO };
+    CfObject *object = nullptr;
+    EXPECT_NE(CfCreate(CF_OBJ_TYPE_CERT, &invalid, &object), CF_SUCCESS);
+}
 }
 
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "cf_api.h"
+#include "cf_param.h"
+#include "cf_result.h"
+#include "cf_type.h"
+
+#include "cf_test_common.h"
+#include "cf_test_data.h"
+#include "cf_test_sdk_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTestData;
+using namespace CertframeworkTest;
+using namespace CertframeworkSdkTest;
+
+namespace {
+constexpr uint32_t CSR01_TBS_OFFSET = 4; /* offsets of the fields in g_csrData01 */
+constexpr uint32_t CSR01_TBS_LEN = 237;
+constexpr uint32_t CSR01_SUBJECT_OFFSET = 10;
+constexpr uint32_t CSR01_SUBJECT_LEN = 48;
+constexpr uint32_t CSR01_PUBKEY_OFFSET = 58;
+constexpr uint32_t CSR01_PUBKEY_LEN = 91;
+constexpr uint32_t CSR01_ATTRS_OFFSET = 149;
+constexpr uint32_t CSR01_ATTRS_LEN = 92;
+constexpr uint32_t CSR01_EXTS_OFFSET = 193;
+constexpr uint32_t CSR01_EXTS_LEN = 48;
+constexpr uint8_t ASN1_TAG_SET = 0x31;
+constexpr int32_t CSR_VERSION_1 = 1;
+constexpr uint32_t CSR_BATCH_COUNT = 50; /* enough requests for the batch verify to use several threads */
+
+class CfCsrTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfCsrTest::SetUpTestCase(void)
+{
+}
+
+void CfCsrTest::TearDownTestCase(void)
+{
+}
+
+void CfCsrTest::SetUp()
+{
+}
+
+void CfCsrTest::TearDown()
+{
+}
+
+const static CfEncodingBlob g_csrDer = {
+    const_cast<uint8_t *>(g_csrData01), sizeof(g_csrData01), CF_FORMAT_DER
+};
+const static std::string g_csrPemBundle = std::string(g_csrData02) + std::string(g_csrData02);
+const static CfEncodingBlob g_csrPem = {
+    reinterpret_cast<uint8_t *>(const_cast<char *>(g_csrPemBundle.c_str())), g_csrPemBundle.size(), CF_FORMAT_PEM
+};
+
+/* the last byte of g_csrData01 is in the signature, changing it keeps the request parsable */
+static std::vector<uint8_t> GetTamperedCsr(void)
+{
+    std::vector<uint8_t> csr(g_csrData01, g_csrData01 + sizeof(g_csrData01));
+    csr.back() ^= 0x01;
+    return csr;
+}
+
+static int32_t GetCsrItem(const CfEncodingBlob *in, CfItemId id, CfParamSet **outParamSet)
+{
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CSR_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = id },
+    };
+    return CommonTest(CF_OBJ_TYPE_CSR, in, params, sizeof(params) / sizeof(CfParam), outParamSet);
+}
+
+static void ExpectCsr01Item(CfItemId id, uint32_t offset, uint32_t len)
+{
+    CfParamSet *outParamSet = nullptr;
+    int32_t ret = GetCsrItem(&g_csrDer, id, &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, len);
+    EXPECT_EQ(memcmp(resultParam->blob.data, g_csrData01 + offset, len), 0);
+    CfFreeParamSet(&outParamSet);
+}
+
+static bool CheckCsrSignature(const CfEncodingBlob *in)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_CHECK_TYPE, .int32Param = CF_CHECK_TYPE_CSR_SIGNATURE },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_CSR, in, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    if (ret != CF_SUCCESS) {
+        return false;
+    }
+
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BOOL, &resultParam);
+    bool valid = (ret == CF_SUCCESS) && resultParam->boolParam;
+    CfFreeParamSet(&outParamSet);
+    return valid;
+}
+
+/**
+ * @tc.name: CfCsrTest001
+ * @tc.desc: get count of a der request and of a pem bundle
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest001, TestSize.Level0)
+{
+    const CfEncodingBlob *inputs[] = { &g_csrDer, &g_csrPem };
+    const int32_t expectCounts[] = { 1, 2 };
+    for (uint32_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+        CfParamSet *outParamSet = nullptr;
+        CfParam params[] = {
+            { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CSR_COUNT },
+        };
+        int32_t ret = CommonTest(CF_OBJ_TYPE_CSR, inputs[i], params, sizeof(params) / sizeof(CfParam), &outParamSet);
+        ASSERT_EQ(ret, CF_SUCCESS);
+
+        CfParam *resultParam = nullptr;
+        ret = CfGetParam(outParamSet, CF_TAG_RESULT_INT, &resultParam);
+        ASSERT_EQ(ret, CF_SUCCESS);
+        EXPECT_EQ(resultParam->int32Param, expectCounts[i]);
+        CfFreeParamSet(&outParamSet);
+    }
+}
+
+/**
+ * @tc.name: CfCsrTest002
+ * @tc.desc: get tbs, subject and public key of the request
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest002, TestSize.Level0)
+{
+    ExpectCsr01Item(CF_ITEM_TBS, CSR01_TBS_OFFSET, CSR01_TBS_LEN);
+    ExpectCsr01Item(CF_ITEM_SUBJECT_NAME, CSR01_SUBJECT_OFFSET, CSR01_SUBJECT_LEN);
+    ExpectCsr01Item(CF_ITEM_PUBLIC_KEY, CSR01_PUBKEY_OFFSET, CSR01_PUBKEY_LEN);
+    ExpectCsr01Item(CF_ITEM_ENCODED, 0, sizeof(g_csrData01));
+}
+
+/**
+ * @tc.name: CfCsrTest003
+ * @tc.desc: get requested extensions and create an extension object from them
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest003, TestSize.Level0)
+{
+    ExpectCsr01Item(CF_ITEM_EXTENSIONS, CSR01_EXTS_OFFSET, CSR01_EXTS_LEN);
+
+    CfEncodingBlob exts = {
+        const_cast<uint8_t *>(g_csrData01 + CSR01_EXTS_OFFSET), CSR01_EXTS_LEN, CF_FORMAT_DER
+    };
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_EXTENSION, &exts, &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    object->destroy(&object);
+}
+
+/**
+ * @tc.name: CfCsrTest004
+ * @tc.desc: get attributes with the SET tag, and version
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest004, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    int32_t ret = GetCsrItem(&g_csrDer, CF_ITEM_ATTRIBUTES, &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, CSR01_ATTRS_LEN);
+    EXPECT_EQ(resultParam->blob.data[0], ASN1_TAG_SET);
+    EXPECT_EQ(memcmp(resultParam->blob.data + 1, g_csrData01 + CSR01_ATTRS_OFFSET + 1, CSR01_ATTRS_LEN - 1), 0);
+    CfFreeParamSet(&outParamSet);
+
+    ret = GetCsrItem(&g_csrDer, CF_ITEM_VERSION, &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, sizeof(int32_t));
+    EXPECT_EQ(*reinterpret_cast<int32_t *>(resultParam->blob.data), CSR_VERSION_1);
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfCsrTest005
+ * @tc.desc: get requested extensions: the request has none
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest005, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    int32_t ret = GetCsrItem(&g_csrPem, CF_ITEM_EXTENSIONS, &outParamSet);
+    EXPECT_EQ(ret, CF_NOT_EXIST);
+}
+
+/**
+ * @tc.name: CfCsrTest006
+ * @tc.desc: get item: invalid item id, request index out of range and negative
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest006, TestSize.Level0)
+{
+    const int32_t ids[] = { CF_ITEM_SERIAL_NUMBER, CF_ITEM_SUBJECT_NAME, CF_ITEM_SUBJECT_NAME };
+    const int32_t indexes[] = { 0, 2, -1 };
+    for (uint32_t i = 0; i < sizeof(ids) / sizeof(ids[0]); ++i) {
+        CfParam params[] = {
+            { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CSR_ITEM },
+            { .tag = CF_TAG_PARAM0_INT32, .int32Param = ids[i] },
+            { .tag = CF_TAG_PARAM1_INT32, .int32Param = indexes[i] },
+        };
+        int32_t ret = AbnormalTest(CF_OBJ_TYPE_CSR, &g_csrPem, params, sizeof(params) / sizeof(CfParam), OP_TYPE_GET);
+        EXPECT_EQ(ret, CF_SUCCESS);
+    }
+}
+
+/**
+ * @tc.name: CfCsrTest007
+ * @tc.desc: check signature of a valid and of a tampered request
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest007, TestSize.Level0)
+{
+    EXPECT_TRUE(CheckCsrSignature(&g_csrDer));
+    EXPECT_TRUE(CheckCsrSignature(&g_csrPem));
+
+    std::vector<uint8_t> tampered = GetTamperedCsr();
+    CfEncodingBlob in = { tampered.data(), tampered.size(), CF_FORMAT_DER };
+    EXPECT_FALSE(CheckCsrSignature(&in));
+}
+
+/**
+ * @tc.name: CfCsrTest008
+ * @tc.desc: check signatures of a batch with every third request tampered
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest008, TestSize.Level0)
+{
+    std::vector<uint8_t> tampered = GetTamperedCsr();
+    std::vector<uint8_t> bundle;
+    for (uint32_t i = 0; i < CSR_BATCH_COUNT; ++i) {
+        if ((i % 3) == 0) { /* 3: every third request */
+            bundle.insert(bundle.end(), tampered.begin(), tampered.end());
+        } else {
+            bundle.insert(bundle.end(), g_csrData01, g_csrData01 + sizeof(g_csrData01));
+        }
+    }
+
+    CfEncodingBlob in = { bundle.data(), bundle.size(), CF_FORMAT_AUTO };
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_CHECK_TYPE, .int32Param = CF_CHECK_TYPE_CSR_SIGNATURES },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_CSR, &in, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, CSR_BATCH_COUNT);
+    for (uint32_t i = 0; i < CSR_BATCH_COUNT; ++i) {
+        EXPECT_EQ(resultParam->blob.data[i], ((i % 3) == 0) ? 0 : 1); /* 3: every third request */
+    }
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfCsrTest009
+ * @tc.desc: CfCreate: der request with invalid data in the end, and a certificate
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfCsrTest, CfCsrTest009, TestSize.Level0)
+{
+    CfEncodingBlob truncated = { const_cast<uint8_t *>(g_csrData01), sizeof(g_csrData01) - 1, CF_FORMAT_DER };
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_CSR, &truncated, &object);
+    EXPECT_NE(ret, CF_SUCCESS);
+
+    CfEncodingBlob cert = { const_cast<uint8_t *>(g_certData01), sizeof(g_certData01), CF_FORMAT_DER };
+    ret = CfCreate(CF_OBJ_TYPE_CSR, &cert, &object);
+    EXPECT_NE(ret, CF_SUCCESS);
+}
+}
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+#include "cf_api.h"
+#include "cf_param.h"
+#include "cf_result.h"
+#include "cf_type.h"
+
+#include "cf_test_common.h"
+#include "cf_test_data.h"
+#include "cf_test_sdk_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTestData;
+using namespace CertframeworkTest;
+using namespace CertframeworkSdkTest;
+
+namespace {
+constexpr uint32_t CERT01_NAME_OFFSET = 36; /* issuer name equals to subject name in g_certData01 */
+constexpr uint32_t CERT01_NAME_LEN = 61;
+constexpr int32_t CERT_VERSION_3 = 3;
+constexpr int64_t CERT01_NOT_AFTER = 1940952004; /* 2031-07-04 17:20:04 UTC */
+constexpr int64_t CERT02_NOT_AFTER = 1693292103; /* 2023-08-29 06:55:03 UTC */
+
+class CfListTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfListTest::SetUpTestCase(void)
+{
+}
+
+void CfListTest::TearDownTestCase(void)
+{
+}
+
+void CfListTest::SetUp()
+{
+}
+
+void CfListTest::TearDown()
+{
+}
+
+const static CfEncodingBlob g_derList = {
+    const_cast<uint8_t *>(g_certData01), sizeof(g_certData01), CF_FORMAT_DER
+};
+const static std::string g_pemBundle = std::string(g_certData02) + std::string(g_certData02);
+const static CfEncodingBlob g_pemList = {
+    reinterpret_cast<uint8_t *>(const_cast<char *>(g_pemBundle.c_str())), g_pemBundle.size(), CF_FORMAT_PEM
+};
+
+const static CfBlob g_cert01Der = { sizeof(g_certData01), const_cast<uint8_t *>(g_certData01) };
+static uint8_t g_cert01Name[CERT01_NAME_LEN] = { 0 };
+static uint8_t g_cert01Serial[] = { 0x20, 0x06, 0x05, 0x16, 0x70, 0x02 };
+static uint8_t g_cert01SerialPadding[] = { 0x00, 0x20, 0x06, 0x05, 0x16, 0x70, 0x02 };
+static uint8_t g_cert01Ski[] = {
+    0xE0, 0x8C, 0x9B, 0xDB, 0x25, 0x49, 0xB3, 0xF1, 0x7C, 0x86,
+    0xD6, 0xB2, 0x42, 0x87, 0x0B, 0xD0, 0x6B, 0xA0, 0xD9, 0xE4
+};
+static uint8_t g_cert02Aki[] = {
+    0xD6, 0x10, 0x45, 0x08, 0x8F, 0xB0, 0x6F, 0x07, 0x79, 0xF3,
+    0x93, 0xB2, 0x6B, 0x15, 0x85, 0xA5, 0x63, 0x63, 0xB2, 0x0F
+};
+static char g_validDate[] = "20230101000000Z";
+static char g_expiredDate[] = "20320101000000Z";
+static char g_serverAuthOid[] = "1.3.6.1.5.5.7.3.1";
+const static CfBlob g_validDateBlob = { sizeof(g_validDate) - 1, reinterpret_cast<uint8_t *>(g_validDate) };
+const static CfBlob g_expiredDateBlob = { sizeof(g_expiredDate) - 1, reinterpret_cast<uint8_t *>(g_expiredDate) };
+const static CfBlob g_serverAuthOidBlob = { sizeof(g_serverAuthOid) - 1, reinterpret_cast<uint8_t *>(g_serverAuthOid) };
+
+static CfBlob GetCert01Name(void)
+{
+    for (uint32_t i = 0; i < CERT01_NAME_LEN; ++i) {
+        g_cert01Name[i] = g_certData01[CERT01_NAME_OFFSET + i];
+    }
+    return { CERT01_NAME_LEN, g_cert01Name };
+}
+
+/* count of the matched certs packed in the result of find and select */
+static uint32_t GetResultCount(const CfParamSet *out)
+{
+    CfParam *resultParam = nullptr;
+    if ((CfGetParam(out, CF_TAG_RESULT_BYTES, &resultParam) != CF_SUCCESS) ||
+        (resultParam->blob.size < sizeof(uint32_t))) {
+        return 0;
+    }
+    return *reinterpret_cast<uint32_t *>(resultParam->blob.data);
+}
+
+/* the cert at index of the result of find and select: uint32_t count, uint32_t offset[count + 1], DER bytes */
+static CfBlob GetResultCert(const CfParamSet *out, uint32_t index)
+{
+    CfParam *resultParam = nullptr;
+    if (CfGetParam(out, CF_TAG_RESULT_BYTES, &resultParam) != CF_SUCCESS) {
+        return { 0, nullptr };
+    }
+    const uint32_t *header = reinterpret_cast<uint32_t *>(resultParam->blob.data);
+    uint32_t count = header[0];
+    const uint32_t *offset = header + 1;
+    uint8_t *data = resultParam->blob.data + (count + 2) * sizeof(uint32_t); /* 2: the count and the end offset */
+    return { offset[index + 1] - offset[index], data + offset[index] };
+}
+
+static uint32_t GetColumnCount(const CfParamSet *out)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < out->paramsCnt; ++i) {
+        if (out->params[i].tag == CF_TAG_RESULT_BYTES) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static void FindTest(const CfEncodingBlob *in, CfListIndexType type, const CfBlob &key, uint32_t expectCount)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_FIND },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = type },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = key },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, in, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(GetResultCount(outParamSet), expectCount);
+
+    if (in == &g_derList) {
+        CfBlob cert = GetResultCert(outParamSet, 0);
+        EXPECT_EQ(CompareBlob(&cert, &g_cert01Der), true);
+    }
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfListTest001
+ * @tc.desc: find certs by subject name and issuer name
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest001, TestSize.Level0)
+{
+    FindTest(&g_derList, CF_LIST_INDEX_SUBJECT_NAME, GetCert01Name(), 1);
+    FindTest(&g_derList, CF_LIST_INDEX_ISSUER_NAME, GetCert01Name(), 1);
+}
+
+/**
+ * @tc.name: CfListTest002
+ * @tc.desc: find certs by serial number, with and without sign padding
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest002, TestSize.Level0)
+{
+    FindTest(&g_derList, CF_LIST_INDEX_SERIAL_NUMBER, { sizeof(g_cert01Serial), g_cert01Serial }, 1);
+    FindTest(&g_derList, CF_LIST_INDEX_SERIAL_NUMBER,
+        { sizeof(g_cert01SerialPadding), g_cert01SerialPadding }, 1);
+}
+
+/**
+ * @tc.name: CfListTest003
+ * @tc.desc: find certs by key identifiers, pem bundle holds the same cert twice
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest003, TestSize.Level0)
+{
+    FindTest(&g_derList, CF_LIST_INDEX_SUBJECT_KEY_ID, { sizeof(g_cert01Ski), g_cert01Ski }, 1);
+    FindTest(&g_pemList, CF_LIST_INDEX_AUTHORITY_KEY_ID, { sizeof(g_cert02Aki), g_cert02Aki }, 2);
+}
+
+/**
+ * @tc.name: CfListTest004
+ * @tc.desc: find certs: no cert matched
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest004, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_FIND },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_LIST_INDEX_AUTHORITY_KEY_ID },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = { sizeof(g_cert02Aki), g_cert02Aki } },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    EXPECT_EQ(ret, CF_NOT_EXIST);
+}
+
+/**
+ * @tc.name: CfListTest005
+ * @tc.desc: find certs: index type is invalid
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest005, TestSize.Level0)
+{
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_FIND },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_LIST_INDEX_AUTHORITY_KEY_ID + 1 },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = { sizeof(g_cert01Ski), g_cert01Ski } },
+    };
+    int32_t ret = AbnormalTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), OP_TYPE_GET);
+    EXPECT_EQ(ret, CF_SUCCESS);
+}
+
+/**
+ * @tc.name: CfListTest006
+ * @tc.desc: select certs issued by name and valid at date
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest006, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_SELECT },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = GetCert01Name() },
+        { .tag = CF_TAG_PARAM2_BUFFER, .blob = g_validDateBlob },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(GetResultCount(outParamSet), 1U);
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfListTest007
+ * @tc.desc: select certs: expired at date
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest007, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_SELECT },
+        { .tag = CF_TAG_PARAM2_BUFFER, .blob = g_expiredDateBlob },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    EXPECT_EQ(ret, CF_NOT_EXIST);
+}
+
+/**
+ * @tc.name: CfListTest008
+ * @tc.desc: select certs: no ext key usage in cert
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest008, TestSize.Level0)
+{
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_SELECT },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = g_serverAuthOidBlob },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    EXPECT_EQ(ret, CF_NOT_EXIST);
+}
+
+/**
+ * @tc.name: CfListTest009
+ * @tc.desc: CfCreate: der list with invalid data in the end
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest009, TestSize.Level0)
+{
+    CfEncodingBlob tainted = { const_cast<uint8_t *>(g_certData01), sizeof(g_certData01) - 1, CF_FORMAT_DER };
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_LIST, &tainted, &object);
+    EXPECT_NE(ret, CF_SUCCESS);
+}
+
+/**
+ * @tc.name: CfListTest010
+ * @tc.desc: get version, not after and serial number columns
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest010, TestSize.Level0)
+{
+    int32_t ids[] = { CF_ITEM_VERSION, CF_ITEM_NOT_AFTER, CF_ITEM_SERIAL_NUMBER };
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_ITEMS },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = { sizeof(ids), reinterpret_cast<uint8_t *>(ids) } },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(GetColumnCount(outParamSet), sizeof(ids) / sizeof(int32_t));
+
+    const CfBlob *version = &outParamSet->params[1].blob; /* params[0] is the result type */
+    ASSERT_EQ(version->size, sizeof(int32_t));
+    EXPECT_EQ(*reinterpret_cast<int32_t *>(version->data), CERT_VERSION_3);
+
+    const CfBlob *notAfter = &outParamSet->params[2].blob;
+    ASSERT_EQ(notAfter->size, sizeof(int64_t));
+    EXPECT_EQ(*reinterpret_cast<int64_t *>(notAfter->data), CERT01_NOT_AFTER);
+
+    const CfBlob *serial = &outParamSet->params[3].blob;
+    ASSERT_EQ(serial->size, 2 * sizeof(uint32_t) + sizeof(g_cert01Serial)); /* 2: offset count of one cert */
+    const uint32_t *offset = reinterpret_cast<uint32_t *>(serial->data);
+    EXPECT_EQ(offset[1], sizeof(g_cert01Serial));
+    CfBlob serialValue = { offset[1], serial->data + 2 * sizeof(uint32_t) };
+    CfBlob expectSerial = { sizeof(g_cert01Serial), g_cert01Serial };
+    EXPECT_EQ(CompareBlob(&serialValue, &expectSerial), true);
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfListTest011
+ * @tc.desc: get not after column of pem bundle
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest011, TestSize.Level0)
+{
+    int32_t ids[] = { CF_ITEM_NOT_AFTER };
+    CfParamSet *outParamSet = nullptr;
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_ITEMS },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = { sizeof(ids), reinterpret_cast<uint8_t *>(ids) } },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &g_pemList, params, sizeof(params) / sizeof(CfParam), &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParam *resultParam = nullptr;
+    ret = CfGetParam(outParamSet, CF_TAG_RESULT_BYTES, &resultParam);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(resultParam->blob.size, 2 * sizeof(int64_t)); /* 2: the bundle holds two certs */
+    const int64_t *notAfter = reinterpret_cast<int64_t *>(resultParam->blob.data);
+    EXPECT_EQ(notAfter[0], CERT02_NOT_AFTER);
+    EXPECT_EQ(notAfter[1], CERT02_NOT_AFTER);
+    CfFreeParamSet(&outParamSet);
+}
+
+/**
+ * @tc.name: CfListTest012
+ * @tc.desc: get items: item id is not supported
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest012, TestSize.Level0)
+{
+    int32_t ids[] = { CF_ITEM_VERSION, CF_ITEM_INVALID };
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_ITEMS },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = { sizeof(ids), reinterpret_cast<uint8_t *>(ids) } },
+    };
+    int32_t ret = AbnormalTest(CF_OBJ_TYPE_LIST, &g_derList, params, sizeof(params) / sizeof(CfParam), OP_TYPE_GET);
+    EXPECT_EQ(ret, CF_SUCCESS);
+}
+
+/**
+ * @tc.name: CfListTest013
+ * @tc.desc: find and select more certs than the param count of a param set
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest013, TestSize.Level0)
+{
+    constexpr uint32_t certCount = 64; /* more than CF_DEFAULT_PARAM_CNT */
+    std::string bundle;
+    for (uint32_t i = 0; i < certCount; ++i) {
+        bundle.append(reinterpret_cast<const char *>(g_certData01), sizeof(g_certData01));
+    }
+    CfEncodingBlob derBundle = {
+        reinterpret_cast<uint8_t *>(const_cast<char *>(bundle.data())), bundle.size(), CF_FORMAT_DER
+    };
+
+    CfParamSet *outParamSet = nullptr;
+    CfParam findParams[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_FIND },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_LIST_INDEX_SUBJECT_NAME },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = GetCert01Name() },
+    };
+    int32_t ret = CommonTest(CF_OBJ_TYPE_LIST, &derBundle, findParams, sizeof(findParams) / sizeof(CfParam),
+        &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(GetResultCount(outParamSet), certCount);
+    for (uint32_t i = 0; i < certCount; ++i) {
+        CfBlob cert = GetResultCert(outParamSet, i);
+        EXPECT_EQ(CompareBlob(&cert, &g_cert01Der), true) << "index: " << i;
+    }
+    CfFreeParamSet(&outParamSet);
+
+    CfParam selectParams[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_SELECT },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = GetCert01Name() },
+    };
+    ret = CommonTest(CF_OBJ_TYPE_LIST, &derBundle, selectParams, sizeof(selectParams) / sizeof(CfParam),
+        &outParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(GetResultCount(outParamSet), certCount);
+    CfBlob lastCert = GetResultCert(outParamSet, certCount - 1);
+    EXPECT_EQ(CompareBlob(&lastCert, &g_cert01Der), true);
+    CfFreeParamSet(&outParamSet);
+}
+
+static int32_t GetBytesTest(const CfObject *object, const CfParam *params, uint32_t cnt, CfBlob *out)
+{
+    CfParamSet *inParamSet = nullptr;
+    int32_t ret = TestConstructParamSetIn(params, cnt, &inParamSet);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    ret = object->getBytes(object, inParamSet, out);
+    CfFreeParamSet(&inParamSet);
+    return ret;
+}
+
+/**
+ * @tc.name: CfListTest014
+ * @tc.desc: get bytes of a list whose results are larger than a param set and the default malloc limit
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest014, TestSize.Level0)
+{
+    constexpr uint32_t largeLen = 6 * 1024 * 1024; /* more than CF_PARAM_SET_MAX_SIZE and the 5M malloc limit */
+    const uint32_t certCount = largeLen / sizeof(g_certData01) + 1;
+    std::string bundle;
+    bundle.reserve(certCount * sizeof(g_certData01));
+    for (uint32_t i = 0; i < certCount; ++i) {
+        bundle.append(reinterpret_cast<const char *>(g_certData01), sizeof(g_certData01));
+    }
+    CfEncodingBlob derBundle = {
+        reinterpret_cast<uint8_t *>(const_cast<char *>(bundle.data())), bundle.size(), CF_FORMAT_DER
+    };
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_LIST, &derBundle, &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    CfParam findParams[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_FIND },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_LIST_INDEX_ISSUER_NAME },
+        { .tag = CF_TAG_PARAM1_BUFFER, .blob = GetCert01Name() },
+    };
+    CfBlob certs = { 0, nullptr };
+    ret = GetBytesTest(object, findParams, sizeof(findParams) / sizeof(CfParam), &certs);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    EXPECT_GT(certs.size, largeLen);
+    const uint32_t *header = reinterpret_cast<uint32_t *>(certs.data);
+    ASSERT_EQ(header[0], certCount);
+    EXPECT_EQ(header[certCount + 1], certCount * sizeof(g_certData01)); /* the end offset */
+    CfBlobDataFree(&certs);
+
+    int32_t ids[] = { CF_ITEM_NOT_AFTER, CF_ITEM_ENCODED };
+    CfParam itemParams[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_LIST_ITEMS },
+        { .tag = CF_TAG_PARAM0_BUFFER, .blob = { sizeof(ids), reinterpret_cast<uint8_t *>(ids) } },
+    };
+    CfBlob columns = { 0, nullptr };
+    ret = GetBytesTest(object, itemParams, sizeof(itemParams) / sizeof(CfParam), &columns);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    header = reinterpret_cast<uint32_t *>(columns.data);
+    ASSERT_EQ(header[0], sizeof(ids) / sizeof(int32_t));
+    EXPECT_EQ(header[1], 0U);
+    EXPECT_EQ(header[2], certCount * sizeof(int64_t)); /* 2: end offset of the not after column */
+    const uint8_t *notAfterColumn = columns.data + 4 * sizeof(uint32_t); /* 4: the count and 3 offsets */
+    int64_t lastNotAfter = 0;
+    (void)memcpy(&lastNotAfter, notAfterColumn + (certCount - 1) * sizeof(int64_t), sizeof(int64_t));
+    EXPECT_EQ(lastNotAfter, CERT01_NOT_AFTER);
+    EXPECT_EQ(header[3] - header[2], (certCount + 1) * sizeof(uint32_t) + certCount * sizeof(g_certData01));
+    CfBlobDataFree(&columns);
+
+    CfParamSet *inParamSet = nullptr;
+    CfParamSet *outParamSet = nullptr;
+    ret = TestConstructParamSetIn(itemParams, sizeof(itemParams) / sizeof(CfParam), &inParamSet);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ret = object->get(object, inParamSet, &outParamSet); /* the columns do not fit in a param set */
+    EXPECT_NE(ret, CF_SUCCESS);
+    CfFreeParamSet(&inParamSet);
+    object->destroy(&object);
+}
+
+/**
+ * @tc.name: CfListTest015
+ * @tc.desc: get bytes: object type without bytes results and invalid get type
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfListTest, CfListTest015, TestSize.Level0)
+{
+    CfParam params[] = {
+        { .tag = CF_TAG_GET_TYPE, .int32Param = CF_GET_TYPE_CERT_ITEM },
+        { .tag = CF_TAG_PARAM0_INT32, .int32Param = CF_ITEM_ENCODED },
+    };
+    CfObject *object = nullptr;
+    int32_t ret = CfCreate(CF_OBJ_TYPE_CERT, &g_derList, &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    CfBlob out = { 0, nullptr };
+    ret = GetBytesTest(object, params, sizeof(params) / sizeof(CfParam), &out);
+    EXPECT_EQ(ret, CF_NOT_SUPPORT);
+    object->destroy(&object);
+
+    ret = CfCreate(CF_OBJ_TYPE_LIST, &g_derList, &object);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ret = GetBytesTest(object, params, sizeof(params) / sizeof(CfParam), &out);
+    EXPECT_EQ(ret, CF_NOT_SUPPORT);
+    ret = object->getBytes(object, nullptr, &out);
+    EXPECT_EQ(ret, CF_NULL_POINTER);
+    object->destroy(&object);
+}
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <openssl/bio.h>
+#include <openssl/pem.h>
+#include <openssl/pkcs7.h>
+#include <openssl/x509.h>
+
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "config.h"
+#include "pkcs7.h"
+#include "x509_certificate.h"
+#include "x509_crl.h"
+
+#include "cf_test_chain_common.h"
+#include "cf_test_common.h"
+#include "cf_test_x509_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkChainTest;
+using namespace CertframeworkX509Test;
+
+namespace {
+class CfPkcs7Test : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfPkcs7Test::SetUpTestCase(void)
+{
+}
+
+void CfPkcs7Test::TearDownTestCase(void)
+{
+}
+
+void CfPkcs7Test::SetUp()
+{
+}
+
+void CfPkcs7Test::TearDown()
+{
+}
+
+static X509_CRL *MakeCrl(const std::vector<TestRevokedEntry> &entries, std::vector<uint8_t> &der)
+{
+    CfEncodingBlob blob = { nullptr, 0, CF_FORMAT_DER };
+    if (BuildTestCrl(entries, &blob, nullptr) != CF_SUCCESS) {
+        return nullptr;
+    }
+    der.assign(blob.data, blob.data + blob.len);
+    CfFree(blob.data);
+    const unsigned char *tmp = der.data();
+    return d2i_X509_CRL(nullptr, &tmp, der.size());
+}
+
+/* DER of a SignedData ContentInfo carrying certs and crls, with no signers, as a certs-only bundle is. */
+static std::vector<uint8_t> EncodeSignedData(const std::vector<X509 *> &certs, const std::vector<X509_CRL *> &crls)
+{
+    std::vector<uint8_t> der;
+    PKCS7 *p7 = PKCS7_new();
+    if ((p7 == nullptr) || (PKCS7_set_type(p7, NID_pkcs7_signed) != 1) ||
+        (PKCS7_content_new(p7, NID_pkcs7_data) != 1)) {
+        PKCS7_free(p7);
+        return der;
+    }
+    for (X509 *x509 : certs) {
+        (void)PKCS7_add_certificate(p7, x509);
+    }
+    for (X509_CRL *crl : crls) {
+        (void)PKCS7_add_crl(p7, crl);
+    }
+    unsigned char *out = nullptr;
+    int len = i2d_PKCS7(p7, &out);
+    if (len > 0) {
+        der.assign(out, out + len);
+    }
+    OPENSSL_free(out);
+    PKCS7_free(p7);
+    return der;
+}
+
+static std::vector<uint8_t> EncodePem(const std::vector<uint8_t> &der)
+{
+    std::vector<uint8_t> pem;
+    const unsigned char *tmp = der.data();
+    PKCS7 *p7 = d2i_PKCS7(nullptr, &tmp, der.size());
+    BIO *bio = BIO_new(BIO_s_mem());
+    if ((p7 != nullptr) && (bio != nullptr) && (PEM_write_bio_PKCS7(bio, p7) == 1)) {
+        char *data = nullptr;
+        long len = BIO_get_mem_data(bio, &data);
+        pem.assign(data, data + len);
+    }
+    BIO_free(bio);
+    PKCS7_free(p7);
+    return pem;
+}
+
+static CfResult Parse(const std::vector<uint8_t> &data, CfEncodingFormat format, CfArray &certs, CfArray &crls)
+{
+    CfEncodingBlob in = { const_cast<uint8_t *>(data.data()), data.size(), format };
+    return HcfPkcs7ParseCerts(&in, &certs, &crls);
+}
+
+static void DestroyArray(CfArray &array)
+{
+    for (uint32_t i = 0; i < array.count; i++) {
+        CfObjDestroy(array.data[i].data);
+    }
+    CfFree(array.data);
+    array.data = nullptr;
+    array.count = 0;
+}
+
+static bool IsSameCertDer(const CfBlob &obj, X509 *x509)
+{
+    HcfX509Certificate *cert = reinterpret_cast<HcfX509Certificate *>(obj.data);
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (cert->base.getEncoded(&cert->base, &der) != CF_SUCCESS) {
+        return false;
+    }
+    std::vector<uint8_t> expected = EncodeTestChainCert(x509);
+    bool same = (der.len == expected.size()) && (memcmp(der.data, expected.data(), der.len) == 0);
+    CfFree(der.data);
+    return same;
+}
+
+static bool IsSameCrlDer(const CfBlob &obj, const std::vector<uint8_t> &expected)
+{
+    HcfX509Crl *crl = reinterpret_cast<HcfX509Crl *>(obj.data);
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (crl->getEncoded(crl, &der) != CF_SUCCESS) {
+        return false;
+    }
+    bool same = (der.len == expected.size()) && (memcmp(der.data, expected.data(), der.len) == 0);
+    CfFree(der.data);
+    return same;
+}
+
+/**
+ * @tc.name: CfPkcs7Test001
+ * @tc.desc: a bundle with certs and crls in DER and PEM gives every object in the order of the bundle
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfPkcs7Test, CfPkcs7Test001, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Pkcs7 Root", nullptr, GetTestCaExtensions());
+    TestChainCert leaf = IssueTestChainCert("Pkcs7 Leaf", &root, {}, 2); /* 2: serial */
+    ASSERT_NE(root.x509, nullptr);
+    ASSERT_NE(leaf.x509, nullptr);
+    std::vector<uint8_t> crlDer1;
+    std::vector<uint8_t> crlDer2;
+    X509_CRL *crl1 = MakeCrl({}, crlDer1);
+    X509_CRL *crl2 = MakeCrl({ { { 0x01 }, TEST_THIS_UPDATE, HCF_CRL_REASON_ABSENT } }, crlDer2);
+    ASSERT_NE(crl1, nullptr);
+    ASSERT_NE(crl2, nullptr);
+    std::vector<uint8_t> der = EncodeSignedData({ leaf.x509, root.x509 }, { crl1, crl2 });
+    ASSERT_FALSE(der.empty());
+
+    std::vector<std::pair<std::vector<uint8_t>, CfEncodingFormat>> inputs = {
+        { der, CF_FORMAT_DER }, { EncodePem(der), CF_FORMAT_PEM }
+    };
+    for (auto &input : inputs) {
+        CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+        CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+        ASSERT_EQ(Parse(input.first, input.second, certs, crls), CF_SUCCESS);
+        ASSERT_EQ(certs.count, 2); /* 2: leaf and root */
+        ASSERT_EQ(crls.count, 2); /* 2: both crls */
+        EXPECT_TRUE(IsSameCertDer(certs.data[0], leaf.x509));
+        EXPECT_TRUE(IsSameCertDer(certs.data[1], root.x509));
+        EXPECT_TRUE(IsSameCrlDer(crls.data[0], crlDer1));
+        EXPECT_TRUE(IsSameCrlDer(crls.data[1], crlDer2));
+        DestroyArray(certs);
+        DestroyArray(crls);
+    }
+    X509_CRL_free(crl1);
+    X509_CRL_free(crl2);
+    FreeTestChainCert(leaf);
+    FreeTestChainCert(root);
+}
+
+/**
+ * @tc.name: CfPkcs7Test002
+ * @tc.desc: an empty SignedData and one with only certs or only crls leave the other array empty
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfPkcs7Test, CfPkcs7Test002, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Pkcs7 Root", nullptr, GetTestCaExtensions());
+    ASSERT_NE(root.x509, nullptr);
+    std::vector<uint8_t> crlDer;
+    X509_CRL *crl = MakeCrl({}, crlDer);
+    ASSERT_NE(crl, nullptr);
+
+    CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+    CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+    std::vector<uint8_t> der = EncodeSignedData({}, {});
+    ASSERT_FALSE(der.empty());
+    ASSERT_EQ(Parse(der, CF_FORMAT_DER, certs, crls), CF_SUCCESS);
+    EXPECT_EQ(certs.count, 0);
+    EXPECT_EQ(certs.data, nullptr);
+    EXPECT_EQ(crls.count, 0);
+    EXPECT_EQ(crls.data, nullptr);
+
+    der = EncodeSignedData({ root.x509 }, {});
+    ASSERT_EQ(Parse(der, CF_FORMAT_DER, certs, crls), CF_SUCCESS);
+    EXPECT_EQ(certs.count, 1);
+    EXPECT_EQ(crls.count, 0);
+    DestroyArray(certs);
+    DestroyArray(crls);
+
+    der = EncodeSignedData({}, { crl });
+    ASSERT_EQ(Parse(der, CF_FORMAT_DER, certs, crls), CF_SUCCESS);
+    EXPECT_EQ(certs.count, 0);
+    EXPECT_EQ(crls.count, 1);
+    DestroyArray(certs);
+    DestroyArray(crls);
+    X509_CRL_free(crl);
+    FreeTestChainCert(root);
+}
+
+/**
+ * @tc.name: CfPkcs7Test003
+ * @tc.desc: a Data ContentInfo in DER and PEM is rejected as it is not SignedData
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfPkcs7Test, CfPkcs7Test003, TestSize.Level0)
+{
+    PKCS7 *p7 = PKCS7_new();
+    ASSERT_NE(p7, nullptr);
+    ASSERT_EQ(PKCS7_set_type(p7, NID_pkcs7_data), 1);
+    unsigned char *out = nullptr;
+    int len = i2d_PKCS7(p7, &out);
+    PKCS7_free(p7);
+    ASSERT_GT(len, 0);
+    std::vector<uint8_t> der(out, out + len);
+    OPENSSL_free(out);
+
+    std::vector<std::pair<std::vector<uint8_t>, CfEncodingFormat>> inputs = {
+        { der, CF_FORMAT_DER }, { EncodePem(der), CF_FORMAT_PEM }
+    };
+    for (auto &input : inputs) {
+        ASSERT_FALSE(input.first.empty());
+        CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+        CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+        EXPECT_EQ(Parse(input.first, input.second, certs, crls), CF_INVALID_PARAMS);
+        EXPECT_EQ(certs.count, 0);
+        EXPECT_EQ(crls.count, 0);
+    }
+}
+
+/**
+ * @tc.name: CfPkcs7Test004
+ * @tc.desc: truncated, oversized and malformed input and bad parameters are rejected
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfPkcs7Test, CfPkcs7Test004, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Pkcs7 Root", nullptr, GetTestCaExtensions());
+    ASSERT_NE(root.x509, nullptr);
+    std::vector<uint8_t> der = EncodeSignedData({ root.x509 }, {});
+    FreeTestChainCert(root);
+    ASSERT_FALSE(der.empty());
+    CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+    CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+
+    for (size_t len : { der.size() - 1, der.size() / 2, static_cast<size_t>(1) }) {
+        std::vector<uint8_t> truncated(der.begin(), der.begin() + len);
+        EXPECT_EQ(Parse(truncated, CF_FORMAT_DER, certs, crls), CF_INVALID_PARAMS);
+    }
+    std::vector<uint8_t> pem = EncodePem(der);
+    ASSERT_FALSE(pem.empty());
+    std::vector<uint8_t> truncatedPem(pem.begin(), pem.begin() + pem.size() / 2);
+    EXPECT_EQ(Parse(truncatedPem, CF_FORMAT_PEM, certs, crls), CF_INVALID_PARAMS);
+
+    /* a valid bundle followed by zeros up to one byte past the limit */
+    std::vector<uint8_t> oversized(der);
+    oversized.resize(HCF_MAX_PKCS7_LEN + 1, 0);
+    EXPECT_EQ(Parse(oversized, CF_FORMAT_DER, certs, crls), CF_INVALID_PARAMS);
+
+    std::vector<uint8_t> garbage(der.size(), 0x30);
+    EXPECT_EQ(Parse(garbage, CF_FORMAT_DER, certs, crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(certs.count, 0);
+    EXPECT_EQ(crls.count, 0);
+
+    CfEncodingBlob in = { der.data(), der.size(), CF_FORMAT_DER };
+    CfEncodingBlob empty = { der.data(), 0, CF_FORMAT_DER };
+    CfEncodingBlob noData = { nullptr, der.size(), CF_FORMAT_DER };
+    EXPECT_EQ(HcfPkcs7ParseCerts(nullptr, &certs, &crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfPkcs7ParseCerts(&empty, &certs, &crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfPkcs7ParseCerts(&noData, &certs, &crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfPkcs7ParseCerts(&in, nullptr, &crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfPkcs7ParseCerts(&in, &certs, nullptr), CF_INVALID_PARAMS);
+}
+
+/**
+ * @tc.name: CfPkcs7Test005
+ * @tc.desc: a bundle with more certs and crls than HCF_MAX_PKCS7_OBJ_NUM is rejected, one at the limit is not
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfPkcs7Test, CfPkcs7Test005, TestSize.Level0)
+{
+    TestChainCert root = IssueTestChainCert("Pkcs7 Root", nullptr, GetTestCaExtensions());
+    ASSERT_NE(root.x509, nullptr);
+    std::vector<uint8_t> crlDer;
+    X509_CRL *crl = MakeCrl({}, crlDer);
+    ASSERT_NE(crl, nullptr);
+    std::vector<X509 *> x509s(HCF_MAX_PKCS7_OBJ_NUM - 1, root.x509);
+
+    CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+    CfArray crls = { nullptr, CF_FORMAT_DER, 0 };
+    std::vector<uint8_t> der = EncodeSignedData(x509s, { crl });
+    ASSERT_FALSE(der.empty());
+    ASSERT_EQ(Parse(der, CF_FORMAT_DER, certs, crls), CF_SUCCESS);
+    EXPECT_EQ(certs.count + crls.count, HCF_MAX_PKCS7_OBJ_NUM);
+    DestroyArray(certs);
+    DestroyArray(crls);
+
+    der = EncodeSignedData(x509s, { crl, crl });
+    ASSERT_FALSE(der.empty());
+    EXPECT_EQ(Parse(der, CF_FORMAT_DER, certs, crls), CF_INVALID_PARAMS);
+    EXPECT_EQ(certs.count, 0);
+    EXPECT_EQ(crls.count, 0);
+    X509_CRL_free(crl);
+    FreeTestChainCert(root);
+}
+}
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "x509_cert_builder.h"
+#include "x509_certificate.h"
+
+#include "cf_test_common.h"
+#include "cf_test_x509_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkX509Test;
+
+namespace {
+constexpr uint32_t MAX_SERIAL_LEN = 20; /* RFC 5280, octets of the serial number INTEGER */
+constexpr uint32_t BATCH_COUNT = 3;
+constexpr int64_t TIME_MAX = 253402300799LL; /* 9999-12-31T23:59:59Z, the last encodable time */
+constexpr int64_t TIME_MIN = -62167219200LL; /* 0000-01-01T00:00:00Z */
+const uint8_t g_serial[] = { 0x01, 0x02, 0x03 };
+
+class CfX509CertBuilderTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfX509CertBuilderTest::SetUpTestCase(void)
+{
+}
+
+void CfX509CertBuilderTest::TearDownTestCase(void)
+{
+}
+
+void CfX509CertBuilderTest::SetUp()
+{
+}
+
+void CfX509CertBuilderTest::TearDown()
+{
+}
+
+/* DER of GeneralNames with one dNSName */
+static std::vector<uint8_t> EncodeTestSan(const std::string &dnsName)
+{
+    GENERAL_NAMES *names = sk_GENERAL_NAME_new_null();
+    GENERAL_NAME *name = GENERAL_NAME_new();
+    ASN1_IA5STRING *value = ASN1_IA5STRING_new();
+    std::vector<uint8_t> der;
+    if ((names != nullptr) && (name != nullptr) && (value != nullptr) &&
+        (ASN1_STRING_set(value, dnsName.c_str(), dnsName.size()) == 1)) {
+        GENERAL_NAME_set0_value(name, GEN_DNS, value);
+        value = nullptr;
+        if (sk_GENERAL_NAME_push(names, name) > 0) {
+            name = nullptr;
+            int len = i2d_GENERAL_NAMES(names, nullptr);
+            der.resize((len > 0) ? len : 0);
+            unsigned char *out = der.data();
+            (void)i2d_GENERAL_NAMES(names, &out);
+        }
+    }
+    ASN1_IA5STRING_free(value);
+    GENERAL_NAME_free(name);
+    GENERAL_NAMES_free(names);
+    return der;
+}
+
+/* DER of one Extension made from an openssl config value */
+static std::vector<uint8_t> EncodeTestExtension(int nid, const char *value)
+{
+    X509_EXTENSION *ext = X509V3_EXT_conf_nid(nullptr, nullptr, nid, value);
+    if (ext == nullptr) {
+        return {};
+    }
+    int len = i2d_X509_EXTENSION(ext, nullptr);
+    std::vector<uint8_t> der((len > 0) ? len : 0);
+    unsigned char *out = der.data();
+    (void)i2d_X509_EXTENSION(ext, &out);
+    X509_EXTENSION_free(ext);
+    return der;
+}
+
+static CfBlob ToBlob(std::vector<uint8_t> &data)
+{
+    return { static_cast<uint32_t>(data.size()), data.data() };
+}
+
+static HcfX509CertIssueParams GetTestIssueParams(void)
+{
+    return {
+        .serialNumber = { sizeof(g_serial), const_cast<uint8_t *>(g_serial) },
+        .notBefore = TEST_THIS_UPDATE,
+        .notAfter = TEST_NEXT_UPDATE,
+        .publicKey = *GetTestPublicKey(),
+    };
+}
+
+/* Parses the DER of cert again and checks its signature with the test key, nullptr if either fails. */
+static X509 *ReparseAndVerify(HcfX509Certificate *cert, HcfX509Certificate **parsedOut)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    if (cert->base.getEncoded(&cert->base, &der) != CF_SUCCESS) {
+        return nullptr;
+    }
+    X509 *x509 = nullptr;
+    if (HcfX509CertificateCreate(&der, parsedOut) == CF_SUCCESS) {
+        const unsigned char *tmp = der.data;
+        x509 = d2i_X509(nullptr, &tmp, der.len);
+    }
+    CfFree(der.data);
+    const unsigned char *keyDer = GetTestPublicKey()->data;
+    EVP_PKEY *key = d2i_PUBKEY(nullptr, &keyDer, GetTestPublicKey()->size);
+    if ((x509 != nullptr) && ((key == nullptr) || (X509_verify(x509, key) != 1))) {
+        X509_free(x509);
+        x509 = nullptr;
+    }
+    EVP_PKEY_free(key);
+    return x509;
+}
+
+static std::string GetString(HcfX509Certificate *cert, CfResult (*get)(HcfX509Certificate *, CfBlob *))
+{
+    CfBlob out = { 0, nullptr };
+    if (get(cert, &out) != CF_SUCCESS) {
+        return std::string();
+    }
+    std::string str(reinterpret_cast<char *>(out.data), out.size);
+    CfFree(out.data);
+    return str.c_str(); /* without the terminating zero */
+}
+
+static std::vector<uint8_t> EncodeName(const X509_NAME *name)
+{
+    int len = i2d_X509_NAME(name, nullptr);
+    std::vector<uint8_t> der((len > 0) ? len : 0);
+    unsigned char *out = der.data();
+    (void)i2d_X509_NAME(name, &out);
+    return der;
+}
+
+static CfResult Issue(const HcfX509CertTemplate &tmpl, const HcfX509CertIssueParams &params)
+{
+    HcfX509CertBuilder *builder = nullptr;
+    CfResult ret = HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder);
+    if (ret != CF_SUCCESS) {
+        return ret;
+    }
+    HcfX509Certificate *cert = nullptr;
+    ret = builder->issue(builder, &params, &cert);
+    CfObjDestroy(cert);
+    CfObjDestroy(builder);
+    return ret;
+}
+
+/**
+ * @tc.name: CfX509CertBuilderTest001
+ * @tc.desc: an issued certificate parses again, verifies with the issuer key and has the fields it was built with
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertBuilderTest, CfX509CertBuilderTest001, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    std::vector<uint8_t> subject = EncodeTestName("Test Leaf");
+    std::vector<uint8_t> san = EncodeTestSan("leaf.example.com");
+    std::vector<uint8_t> extensions = EncodeTestExtension(NID_basic_constraints, "critical,CA:TRUE,pathlen:2");
+    HcfX509CertTemplate tmpl = { ToBlob(issuer), ToBlob(subject), ToBlob(san), ToBlob(extensions) };
+    HcfX509CertBuilder *builder = nullptr;
+    ASSERT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_SUCCESS);
+    HcfX509CertIssueParams params = GetTestIssueParams();
+    HcfX509Certificate *cert = nullptr;
+    ASSERT_EQ(builder->issue(builder, &params, &cert), CF_SUCCESS);
+
+    HcfX509Certificate *parsed = nullptr;
+    X509 *x509 = ReparseAndVerify(cert, &parsed);
+    ASSERT_NE(x509, nullptr);
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(parsed->getVersion(parsed), 3); /* v3 */
+    CfBlob serial = { 0, nullptr };
+    ASSERT_EQ(parsed->getSerialNumber(parsed, &serial), CF_SUCCESS);
+    EXPECT_EQ(std::vector<uint8_t>(serial.data, serial.data + serial.size),
+        std::vector<uint8_t>(g_serial, g_serial + sizeof(g_serial)));
+    CfFree(serial.data);
+    EXPECT_EQ(EncodeName(X509_get_issuer_name(x509)), issuer);
+    EXPECT_EQ(EncodeName(X509_get_subject_name(x509)), subject);
+    EXPECT_EQ(GetString(parsed, parsed->getNotBeforeTime), "231114221320Z");
+    EXPECT_EQ(GetString(parsed, parsed->getNotAfterTime), "231214221320Z");
+    EXPECT_EQ(parsed->getBasicConstraints(parsed), 2); /* pathlen */
+    CfArray names = { nullptr, CF_FORMAT_DER, 0 };
+    ASSERT_EQ(parsed->getSubjectAltNames(parsed, &names), CF_SUCCESS);
+    EXPECT_EQ(names.count, 1);
+    CfArrayDataClearAndFree(&names);
+    EXPECT_EQ(X509_check_host(x509, "leaf.example.com", 0, 0, nullptr), 1);
+    /* the SAN is not critical while the subject is not empty */
+    int sanIndex = X509_get_ext_by_NID(x509, NID_subject_alt_name, -1);
+    ASSERT_GE(sanIndex, 0);
+    EXPECT_EQ(X509_EXTENSION_get_critical(X509_get_ext(x509, sanIndex)), 0);
+
+    X509_free(x509);
+    CfObjDestroy(parsed);
+    CfObjDestroy(cert);
+    CfObjDestroy(builder);
+}
+
+/**
+ * @tc.name: CfX509CertBuilderTest002
+ * @tc.desc: a batch issues every certificate in order, serials are encoded as positive minimal INTEGERs
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertBuilderTest, CfX509CertBuilderTest002, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    std::vector<uint8_t> subject = { 0x30, 0x00 }; /* the empty Name, the SAN becomes critical */
+    std::vector<uint8_t> san = EncodeTestSan("batch.example.com");
+    HcfX509CertTemplate tmpl = { ToBlob(issuer), ToBlob(subject), ToBlob(san), { 0, nullptr } };
+    HcfX509CertBuilder *builder = nullptr;
+    ASSERT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_SUCCESS);
+
+    std::vector<std::vector<uint8_t>> serials = { { 0x00, 0x00, 0x7F }, { 0x80 }, { 0x00 } };
+    /* the content octets of the INTEGER */
+    const std::vector<std::vector<uint8_t>> expectSerials = {
+        { 0x7F }, /* leading zeros dropped */
+        { 0x00, 0x80 }, /* a zero added to keep it positive */
+        { 0x00 },
+    };
+    HcfX509CertIssueParams paramsList[BATCH_COUNT];
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+        paramsList[i] = GetTestIssueParams();
+        paramsList[i].serialNumber = ToBlob(serials[i]);
+    }
+    CfArray certs = { nullptr, CF_FORMAT_DER, 0 };
+    ASSERT_EQ(builder->issueBatch(builder, paramsList, BATCH_COUNT, &certs), CF_SUCCESS);
+    ASSERT_EQ(certs.count, BATCH_COUNT);
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i) {
+        HcfX509Certificate *cert = reinterpret_cast<HcfX509Certificate *>(certs.data[i].data);
+        HcfX509Certificate *parsed = nullptr;
+        X509 *x509 = ReparseAndVerify(cert, &parsed);
+        ASSERT_NE(x509, nullptr);
+        CfBlob serial = { 0, nullptr };
+        EXPECT_EQ(parsed->getSerialNumber(parsed, &serial), CF_SUCCESS);
+        EXPECT_EQ(std::vector<uint8_t>(serial.data, serial.data + serial.size), expectSerials[i]);
+        CfFree(serial.data);
+        EXPECT_EQ(X509_NAME_entry_count(X509_get_subject_name(x509)), 0);
+        int sanIndex = X509_get_ext_by_NID(x509, NID_subject_alt_name, -1);
+        ASSERT_GE(sanIndex, 0);
+        EXPECT_EQ(X509_EXTENSION_get_critical(X509_get_ext(x509, sanIndex)), 1);
+        X509_free(x509);
+        CfObjDestroy(parsed);
+        CfObjDestroy(cert);
+    }
+    CfFree(certs.data);
+
+    /* nothing is returned when one of them fails */
+    paramsList[1].notAfter = paramsList[1].notBefore - 1;
+    certs = { nullptr, CF_FORMAT_DER, 0 };
+    EXPECT_EQ(builder->issueBatch(builder, paramsList, BATCH_COUNT, &certs), CF_INVALID_PARAMS);
+    EXPECT_EQ(certs.data, nullptr);
+    EXPECT_EQ(certs.count, 0);
+    CfObjDestroy(builder);
+}
+
+/**
+ * @tc.name: CfX509CertBuilderTest003
+ * @tc.desc: an oversized or empty serial, invalid times or a malformed public key are rejected
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertBuilderTest, CfX509CertBuilderTest003, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    std::vector<uint8_t> subject = EncodeTestName("Test Leaf");
+    HcfX509CertTemplate tmpl = { ToBlob(issuer), ToBlob(subject), { 0, nullptr }, { 0, nullptr } };
+    HcfX509CertIssueParams params = GetTestIssueParams();
+    EXPECT_EQ(Issue(tmpl, params), CF_SUCCESS);
+
+    std::vector<uint8_t> serial(MAX_SERIAL_LEN, 0x7F);
+    params.serialNumber = ToBlob(serial);
+    EXPECT_EQ(Issue(tmpl, params), CF_SUCCESS);
+    serial[0] = 0x80; /* 21 octets once a zero keeps it positive */
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    serial.assign(MAX_SERIAL_LEN + 1, 0x01);
+    params.serialNumber = ToBlob(serial);
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    params.serialNumber = { 0, nullptr };
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+
+    params = GetTestIssueParams();
+    params.notAfter = params.notBefore - 1;
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    params.notAfter = TIME_MAX + 1;
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    params.notBefore = TIME_MIN - 1;
+    params.notAfter = TIME_MAX;
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    params.notBefore = TIME_MIN; /* both limits themselves are encodable */
+    EXPECT_EQ(Issue(tmpl, params), CF_SUCCESS);
+
+    params = GetTestIssueParams();
+    std::vector<uint8_t> garbage = { 0x04, 0x02, 0x01, 0x02 };
+    params.publicKey = ToBlob(garbage);
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+    std::vector<uint8_t> notKey = { 0x30, 0x03, 0x02, 0x01, 0x01 }; /* a SEQUENCE, not a SubjectPublicKeyInfo */
+    params.publicKey = ToBlob(notKey);
+    EXPECT_EQ(Issue(tmpl, params), CF_INVALID_PARAMS);
+}
+
+/**
+ * @tc.name: CfX509CertBuilderTest004
+ * @tc.desc: malformed names, subjectAltNames, extensions or signing keys are rejected
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertBuilderTest, CfX509CertBuilderTest004, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    std::vector<uint8_t> subject = EncodeTestName("Test Leaf");
+    std::vector<uint8_t> truncated(issuer.begin(), issuer.end() - 1);
+    std::vector<uint8_t> twoNames = issuer;
+    twoNames.insert(twoNames.end(), subject.begin(), subject.end());
+    std::vector<uint8_t> garbage = { 0x04, 0x02, 0x01, 0x02 };
+    HcfX509CertBuilder *builder = nullptr;
+
+    HcfX509CertTemplate tmpl = { ToBlob(truncated), ToBlob(subject), { 0, nullptr }, { 0, nullptr } };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    tmpl = { ToBlob(issuer), ToBlob(twoNames), { 0, nullptr }, { 0, nullptr } };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    tmpl = { { 0, nullptr }, ToBlob(subject), { 0, nullptr }, { 0, nullptr } };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    tmpl = { ToBlob(issuer), ToBlob(subject), ToBlob(garbage), { 0, nullptr } };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    tmpl = { ToBlob(issuer), ToBlob(subject), { 0, nullptr }, ToBlob(garbage) };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    std::vector<uint8_t> extension = EncodeTestExtension(NID_basic_constraints, "critical,CA:FALSE");
+    extension.pop_back();
+    tmpl = { ToBlob(issuer), ToBlob(subject), { 0, nullptr }, ToBlob(extension) };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    EXPECT_EQ(builder, nullptr);
+
+    /* SEQUENCEs of the wrong content pass the framing check and fail once the cert is decoded */
+    std::vector<uint8_t> notExtension = { 0x30, 0x03, 0x02, 0x01, 0x01 };
+    tmpl = { ToBlob(issuer), ToBlob(subject), { 0, nullptr }, ToBlob(notExtension) };
+    EXPECT_EQ(Issue(tmpl, GetTestIssueParams()), CF_INVALID_PARAMS);
+
+    tmpl = { ToBlob(issuer), ToBlob(subject), { 0, nullptr }, { 0, nullptr } };
+    CfBlob badKey = { static_cast<uint32_t>(garbage.size()), garbage.data() };
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, &badKey, &builder), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfX509CertBuilderCreate(&tmpl, nullptr, &builder), CF_INVALID_PARAMS);
+    EXPECT_EQ(HcfX509CertBuilderCreate(nullptr, GetTestSigningKey(), &builder), CF_INVALID_PARAMS);
+    EXPECT_EQ(builder, nullptr);
+}
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <openssl/sha.h>
+
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "x509_certificate.h"
+
+#include "cf_test_common.h"
+#include "cf_test_data.h"
+#include "cf_test_x509_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkTestData;
+using namespace CertframeworkX509Test;
+
+namespace {
+constexpr uint32_t THREAD_COUNT = 8;
+constexpr uint32_t ROUND_COUNT = 100;
+
+class CfX509CertTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfX509CertTest::SetUpTestCase(void)
+{
+}
+
+void CfX509CertTest::TearDownTestCase(void)
+{
+}
+
+void CfX509CertTest::SetUp()
+{
+}
+
+void CfX509CertTest::TearDown()
+{
+}
+
+static HcfX509Certificate *CreateDerCert(void)
+{
+    CfEncodingBlob der = { const_cast<uint8_t *>(g_certData01), sizeof(g_certData01), CF_FORMAT_DER };
+    HcfX509Certificate *cert = nullptr;
+    (void)HcfX509CertificateCreate(&der, &cert);
+    return cert;
+}
+
+static HcfX509Certificate *CreatePemCert(void)
+{
+    CfEncodingBlob pem = { reinterpret_cast<uint8_t *>(g_certData02), sizeof(g_certData02), CF_FORMAT_PEM };
+    HcfX509Certificate *cert = nullptr;
+    (void)HcfX509CertificateCreate(&pem, &cert);
+    return cert;
+}
+
+static bool CertEquals(HcfX509Certificate *cert, HcfX509Certificate *other)
+{
+    bool out = false;
+    EXPECT_EQ(cert->equals(cert, other, &out), CF_SUCCESS);
+    return out;
+}
+
+static uint32_t CertHashCode(HcfX509Certificate *cert)
+{
+    uint32_t hash = 0;
+    EXPECT_EQ(cert->hashCode(cert, &hash), CF_SUCCESS);
+    return hash;
+}
+
+/**
+ * @tc.name: CfX509CertTest001
+ * @tc.desc: certificates of the same DER are equal and hash the same, other certificates are not equal
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertTest, CfX509CertTest001, TestSize.Level0)
+{
+    HcfX509Certificate *cert = CreateDerCert();
+    HcfX509Certificate *same = CreateDerCert();
+    HcfX509Certificate *other = CreatePemCert();
+    ASSERT_NE(cert, nullptr);
+    ASSERT_NE(same, nullptr);
+    ASSERT_NE(other, nullptr);
+
+    EXPECT_EQ(CertEquals(cert, cert), true);
+    EXPECT_EQ(CertEquals(cert, same), true);
+    EXPECT_EQ(CertEquals(same, cert), true);
+    EXPECT_EQ(CertHashCode(cert), CertHashCode(same));
+    EXPECT_EQ(CertEquals(cert, other), false);
+    EXPECT_EQ(CertEquals(other, cert), false);
+    EXPECT_NE(CertHashCode(cert), CertHashCode(other));
+
+    CfObjDestroy(cert);
+    CfObjDestroy(same);
+    CfObjDestroy(other);
+}
+
+/**
+ * @tc.name: CfX509CertTest002
+ * @tc.desc: a duplicate is equal to its certificate and hashes the same, also once the certificate is destroyed
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertTest, CfX509CertTest002, TestSize.Level0)
+{
+    HcfX509Certificate *cert = CreateDerCert();
+    HcfX509Certificate *same = CreateDerCert();
+    ASSERT_NE(cert, nullptr);
+    ASSERT_NE(same, nullptr);
+    HcfX509Certificate *dupCert = nullptr;
+    ASSERT_EQ(cert->dup(cert, &dupCert), CF_SUCCESS);
+
+    EXPECT_EQ(CertEquals(cert, dupCert), true);
+    EXPECT_EQ(CertEquals(dupCert, cert), true);
+    EXPECT_EQ(CertHashCode(dupCert), CertHashCode(cert));
+    CfObjDestroy(cert);
+    EXPECT_EQ(CertEquals(dupCert, same), true);
+    EXPECT_EQ(CertHashCode(dupCert), CertHashCode(same));
+
+    CfObjDestroy(dupCert);
+    CfObjDestroy(same);
+}
+
+/**
+ * @tc.name: CfX509CertTest003
+ * @tc.desc: the hash is the first four bytes of the SHA-256 of the DER read big-endian, the same on every call
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertTest, CfX509CertTest003, TestSize.Level0)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH] = { 0 };
+    (void)SHA256(g_certData01, sizeof(g_certData01), digest);
+    uint32_t expect = (static_cast<uint32_t>(digest[0]) << 24) | (static_cast<uint32_t>(digest[1]) << 16) |
+        (static_cast<uint32_t>(digest[2]) << 8) | digest[3]; /* 2, 3: bytes, 24, 16, 8: shift */
+
+    HcfX509Certificate *cert = CreateDerCert();
+    ASSERT_NE(cert, nullptr);
+    for (uint32_t i = 0; i < ROUND_COUNT; ++i) {
+        EXPECT_EQ(CertHashCode(cert), expect);
+    }
+    CfObjDestroy(cert);
+}
+
+/**
+ * @tc.name: CfX509CertTest004
+ * @tc.desc: threads computing the digest of new certificates for the first time at once get the same results
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertTest, CfX509CertTest004, TestSize.Level0)
+{
+    HcfX509Certificate *reference = CreateDerCert();
+    ASSERT_NE(reference, nullptr);
+    uint32_t expect = CertHashCode(reference);
+    for (uint32_t round = 0; round < ROUND_COUNT; ++round) {
+        HcfX509Certificate *cert = CreateDerCert();
+        HcfX509Certificate *same = CreateDerCert();
+        ASSERT_NE(cert, nullptr);
+        ASSERT_NE(same, nullptr);
+        std::atomic<uint32_t> failures { 0 };
+        RunTestThreads(THREAD_COUNT, [&](uint32_t index) {
+            uint32_t hash = 0;
+            bool equal = false;
+            HcfX509Certificate *self = ((index % 2) == 0) ? cert : same; /* 2: half of the threads per object */
+            if ((self->hashCode(self, &hash) != CF_SUCCESS) || (hash != expect) ||
+                (self->equals(self, (self == cert) ? same : cert, &equal) != CF_SUCCESS) || !equal) {
+                failures++;
+            }
+        });
+        EXPECT_EQ(failures, 0) << "round: " << round;
+        CfObjDestroy(cert);
+        CfObjDestroy(same);
+    }
+    CfObjDestroy(reference);
+}
+
+/**
+ * @tc.name: CfX509CertTest005
+ * @tc.desc: equals and hashCode with invalid params
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CertTest, CfX509CertTest005, TestSize.Level0)
+{
+    HcfX509Certificate *cert = CreateDerCert();
+    ASSERT_NE(cert, nullptr);
+    bool equal = false;
+    uint32_t hash = 0;
+    EXPECT_EQ(cert->equals(cert, nullptr, &equal), CF_INVALID_PARAMS);
+    EXPECT_EQ(cert->equals(cert, cert, nullptr), CF_INVALID_PARAMS);
+    EXPECT_EQ(cert->equals(nullptr, cert, &equal), CF_INVALID_PARAMS);
+    EXPECT_EQ(cert->hashCode(cert, nullptr), CF_INVALID_PARAMS);
+    EXPECT_EQ(cert->hashCode(nullptr, &hash), CF_INVALID_PARAMS);
+
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl({}, nullptr, &crl), CF_SUCCESS);
+    EXPECT_EQ(cert->equals(cert, reinterpret_cast<HcfX509Certificate *>(crl), &equal), CF_INVALID_PARAMS);
+    CfObjDestroy(crl);
+    CfObjDestroy(cert);
+}
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "config.h"
+#include "x509_crl.h"
+#include "x509_crl_builder.h"
+
+#include "cf_test_common.h"
+#include "cf_test_x509_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkX509Test;
+
+namespace {
+constexpr int64_t REVOKED_DATE = TEST_THIS_UPDATE - 86400; /* one day before this update */
+constexpr uint8_t REASON_UNUSED = 7; /* not assigned by RFC 5280 */
+constexpr uint8_t REASON_MAX = 10; /* aACompromise */
+constexpr uint32_t LARGE_CRL_LEN = 5 * 1024 * 1024;
+constexpr uint32_t LARGE_ENTRY_COUNT = 160000; /* about 36 bytes each with a reason */
+
+class CfX509CrlBuilderTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfX509CrlBuilderTest::SetUpTestCase(void)
+{
+}
+
+void CfX509CrlBuilderTest::TearDownTestCase(void)
+{
+}
+
+void CfX509CrlBuilderTest::SetUp()
+{
+}
+
+void CfX509CrlBuilderTest::TearDown()
+{
+}
+
+static CfResult Build(const std::vector<TestRevokedEntry> &entries, const HcfX509CrlBuildParams *params)
+{
+    TestCrlColumns columns(entries);
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    CfResult ret = HcfX509CrlBuild(params, columns.Get(), GetTestSigningKey(), &der, &crl);
+    CfFree(der.data);
+    CfObjDestroy(crl);
+    return ret;
+}
+
+static CfResult Build(const std::vector<TestRevokedEntry> &entries)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    HcfX509CrlBuildParams params = { { static_cast<uint32_t>(issuer.size()), issuer.data() }, TEST_THIS_UPDATE,
+        TEST_NEXT_UPDATE, { 0, nullptr }, { 0, nullptr } };
+    return Build(entries, &params);
+}
+
+/* Parses der with openssl and checks its signature with the test key, nullptr if either fails. */
+static X509_CRL *ParseAndVerify(const CfEncodingBlob &der)
+{
+    const unsigned char *tmp = der.data;
+    X509_CRL *crl = d2i_X509_CRL(nullptr, &tmp, der.len);
+    const unsigned char *keyDer = GetTestPublicKey()->data;
+    EVP_PKEY *key = d2i_PUBKEY(nullptr, &keyDer, GetTestPublicKey()->size);
+    if ((crl != nullptr) && ((key == nullptr) || (X509_CRL_verify(crl, key) != 1))) {
+        X509_CRL_free(crl);
+        crl = nullptr;
+    }
+    EVP_PKEY_free(key);
+    return crl;
+}
+
+/* The DER of the object equals the DER the builder returned. */
+static bool IsSameDer(HcfX509Crl *crl, const CfEncodingBlob &der)
+{
+    CfEncodingBlob encoded = { nullptr, 0, CF_FORMAT_DER };
+    if (crl->getEncoded(crl, &encoded) != CF_SUCCESS) {
+        return false;
+    }
+    bool same = (encoded.len == der.len) && (memcmp(encoded.data, der.data, der.len) == 0);
+    CfFree(encoded.data);
+    return same;
+}
+
+static std::vector<uint8_t> GetRevokedSerial(X509_CRL *crl, int i)
+{
+    const ASN1_INTEGER *serial = X509_REVOKED_get0_serialNumber(sk_X509_REVOKED_value(X509_CRL_get_REVOKED(crl), i));
+    return std::vector<uint8_t>(ASN1_STRING_get0_data(serial), ASN1_STRING_get0_data(serial) + ASN1_STRING_length(serial));
+}
+
+static int GetRevokedReason(X509_CRL *crl, int i)
+{
+    X509_REVOKED *revoked = sk_X509_REVOKED_value(X509_CRL_get_REVOKED(crl), i);
+    ASN1_ENUMERATED *reason =
+        static_cast<ASN1_ENUMERATED *>(X509_REVOKED_get_ext_d2i(revoked, NID_crl_reason, nullptr, nullptr));
+    if (reason == nullptr) {
+        return HCF_CRL_REASON_ABSENT;
+    }
+    int code = static_cast<int>(ASN1_ENUMERATED_get(reason));
+    ASN1_ENUMERATED_free(reason);
+    return code;
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest001
+ * @tc.desc: unsorted entries are written in ascending serial order, the DER verifies and equals the returned object
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest001, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = {
+        { { 0x30 }, REVOKED_DATE + 3, 1 }, /* 1: keyCompromise */
+        { { 0x00, 0x00, 0x10 }, REVOKED_DATE + 1, HCF_CRL_REASON_ABSENT },
+        { { 0x01, 0x00 }, REVOKED_DATE + 4, 0 }, /* 0: unspecified */
+        { { 0x20 }, REVOKED_DATE + 2, 6 }, /* 6: certificateHold */
+    };
+    const std::vector<std::vector<uint8_t>> expectSerials = { { 0x10 }, { 0x20 }, { 0x30 }, { 0x01, 0x00 } };
+    const int expectReasons[] = { HCF_CRL_REASON_ABSENT, 6, 1, 0 };
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, &der, &crl), CF_SUCCESS);
+    ASSERT_NE(crl, nullptr);
+    EXPECT_EQ(IsSameDer(crl, der), true);
+
+    X509_CRL *parsed = ParseAndVerify(der);
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(X509_CRL_get_version(parsed), 1); /* v2 */
+    ASSERT_EQ(sk_X509_REVOKED_num(X509_CRL_get_REVOKED(parsed)), static_cast<int>(entries.size()));
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+        EXPECT_EQ(GetRevokedSerial(parsed, i), expectSerials[i]) << "row: " << i;
+        EXPECT_EQ(GetRevokedReason(parsed, i), expectReasons[i]) << "row: " << i;
+    }
+    X509_CRL_free(parsed);
+
+    HcfX509CrlColumns columns = { 0 };
+    ASSERT_EQ(crl->getRevokedColumns(crl, &columns), CF_SUCCESS);
+    ASSERT_EQ(columns.count, entries.size());
+    const uint32_t *offsets = reinterpret_cast<const uint32_t *>(columns.serialOffsets.data);
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        EXPECT_EQ(std::vector<uint8_t>(columns.serials.data + offsets[i], columns.serials.data + offsets[i + 1]),
+            expectSerials[i]) << "row: " << i;
+    }
+    HcfX509CrlColumnsFree(&columns);
+    CfFree(der.data);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest002
+ * @tc.desc: serials that are the same once leading zeros are dropped are rejected, in or out of order
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest002, TestSize.Level0)
+{
+    EXPECT_EQ(Build({ { { 0x05 }, REVOKED_DATE, 1 }, { { 0x00, 0x05 }, REVOKED_DATE, 1 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x09 }, REVOKED_DATE, 1 }, { { 0x00, 0x05 }, REVOKED_DATE, 1 },
+        { { 0x00, 0x00, 0x05 }, REVOKED_DATE, 1 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x05 }, REVOKED_DATE, 1 }, { { 0x05 }, REVOKED_DATE + 1, 2 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x00 }, REVOKED_DATE, 1 }, { { 0x00, 0x00 }, REVOKED_DATE, 1 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x05 }, REVOKED_DATE, 1 }, { { 0x05, 0x00 }, REVOKED_DATE, 1 } }), CF_SUCCESS);
+
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    EXPECT_EQ(BuildTestCrl({ { { 0x05 }, REVOKED_DATE, 1 }, { { 0x00, 0x05 }, REVOKED_DATE, 1 } }, &der, &crl),
+        CF_INVALID_PARAMS);
+    EXPECT_EQ(der.data, nullptr);
+    EXPECT_EQ(crl, nullptr);
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest003
+ * @tc.desc: reason 7 and reasons above 10 are rejected, the others are written as reason code extensions
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest003, TestSize.Level0)
+{
+    EXPECT_EQ(Build({ { { 0x01 }, REVOKED_DATE, REASON_UNUSED } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x01 }, REVOKED_DATE, REASON_MAX + 1 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x01 }, REVOKED_DATE, HCF_CRL_REASON_ABSENT - 1 } }), CF_INVALID_PARAMS);
+
+    std::vector<TestRevokedEntry> entries;
+    for (uint8_t reason = 0; reason <= REASON_MAX; ++reason) {
+        if (reason != REASON_UNUSED) {
+            entries.push_back({ { static_cast<uint8_t>(reason + 1) }, REVOKED_DATE, reason });
+        }
+    }
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    ASSERT_EQ(BuildTestCrl(entries, &der, nullptr), CF_SUCCESS);
+    X509_CRL *parsed = ParseAndVerify(der);
+    ASSERT_NE(parsed, nullptr);
+    ASSERT_EQ(sk_X509_REVOKED_num(X509_CRL_get_REVOKED(parsed)), static_cast<int>(entries.size()));
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+        EXPECT_EQ(GetRevokedReason(parsed, i), entries[i].reason) << "row: " << i;
+    }
+    X509_CRL_free(parsed);
+    CfFree(der.data);
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest004
+ * @tc.desc: columns whose offsets, sizes or count do not match, and invalid serials, dates or params are rejected
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest004, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    HcfX509CrlBuildParams params = { { static_cast<uint32_t>(issuer.size()), issuer.data() }, TEST_THIS_UPDATE,
+        TEST_NEXT_UPDATE, { 0, nullptr }, { 0, nullptr } };
+    std::vector<TestRevokedEntry> entries = { { { 0x01 }, REVOKED_DATE, 1 }, { { 0x02, 0x03 }, REVOKED_DATE, 1 } };
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509CrlColumns *columns = nullptr;
+    {
+        TestCrlColumns test(entries);
+        columns = test.Get();
+        ASSERT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_SUCCESS);
+        CfFree(der.data);
+        der.data = nullptr;
+
+        uint32_t *offsets = reinterpret_cast<uint32_t *>(columns->serialOffsets.data);
+        offsets[1] = offsets[0]; /* an empty serial */
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+        offsets[1] = 1;
+        offsets[2] = columns->serials.size + 1; /* past the serials */
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+        offsets[2] = columns->serials.size;
+
+        columns->count = entries.size() + 1; /* more rows than the columns hold */
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+        columns->count = HCF_MAX_CRL_BUILD_ENTRY_NUM + 1;
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+        columns->count = entries.size();
+        columns->reasons.size--;
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+        columns->reasons.size++;
+        columns->revocationDates.data = nullptr;
+        EXPECT_EQ(HcfX509CrlBuild(&params, columns, GetTestSigningKey(), &der, nullptr), CF_INVALID_PARAMS);
+    }
+    EXPECT_EQ(der.data, nullptr);
+
+    std::vector<uint8_t> longSerial(21, 0x01); /* 21: one octet more than RFC 5280 allows */
+    EXPECT_EQ(Build({ { longSerial, REVOKED_DATE, 1 } }), CF_INVALID_PARAMS);
+    EXPECT_EQ(Build({ { { 0x01 }, 253402300800LL, 1 } }), CF_INVALID_PARAMS); /* after 9999-12-31T23:59:59Z */
+
+    params.nextUpdate = params.thisUpdate - 1;
+    EXPECT_EQ(Build(entries, &params), CF_INVALID_PARAMS);
+    params.nextUpdate = TEST_NEXT_UPDATE;
+    std::vector<uint8_t> crlNumber(21, 0x01);
+    params.crlNumber = { static_cast<uint32_t>(crlNumber.size()), crlNumber.data() };
+    EXPECT_EQ(Build(entries, &params), CF_INVALID_PARAMS);
+    params.crlNumber = { 0, nullptr };
+    params.issuer.size--;
+    EXPECT_EQ(Build(entries, &params), CF_INVALID_PARAMS);
+    params.issuer.size++;
+    std::vector<uint8_t> garbage = { 0x04, 0x02, 0x01, 0x02 };
+    params.extensions = { static_cast<uint32_t>(garbage.size()), garbage.data() };
+    EXPECT_EQ(Build(entries, &params), CF_INVALID_PARAMS);
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest005
+ * @tc.desc: an empty revoked list builds a CRL without revokedCertificates, with its CRL number
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest005, TestSize.Level0)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    uint8_t crlNumber[] = { 0x00, 0x01, 0x00 }; /* 256, the leading zero is dropped */
+    HcfX509CrlBuildParams params = { { static_cast<uint32_t>(issuer.size()), issuer.data() }, TEST_THIS_UPDATE,
+        TEST_NEXT_UPDATE, { sizeof(crlNumber), crlNumber }, { 0, nullptr } };
+    HcfX509CrlColumns columns = { 0 };
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(HcfX509CrlBuild(&params, &columns, GetTestSigningKey(), &der, &crl), CF_SUCCESS);
+    EXPECT_EQ(IsSameDer(crl, der), true);
+
+    X509_CRL *parsed = ParseAndVerify(der);
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(X509_CRL_get_REVOKED(parsed), nullptr); /* revokedCertificates is left out */
+    ASN1_INTEGER *number =
+        static_cast<ASN1_INTEGER *>(X509_CRL_get_ext_d2i(parsed, NID_crl_number, nullptr, nullptr));
+    ASSERT_NE(number, nullptr);
+    EXPECT_EQ(ASN1_INTEGER_get(number), 256);
+    ASN1_INTEGER_free(number);
+    X509_CRL_free(parsed);
+
+    HcfX509CrlColumns revoked = { 0 };
+    ASSERT_EQ(crl->getRevokedColumns(crl, &revoked), CF_SUCCESS);
+    EXPECT_EQ(revoked.count, 0U);
+    HcfX509CrlColumnsFree(&revoked);
+    CfFree(der.data);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlBuilderTest006
+ * @tc.desc: a revoked list above 5 MB builds, and its DER round trips against the returned object
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlBuilderTest, CfX509CrlBuilderTest006, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < LARGE_ENTRY_COUNT; ++i) {
+        /* 24, 16, 8: shifts to the bytes of n, which descends so the builder sorts the rows */
+        uint32_t n = LARGE_ENTRY_COUNT - i;
+        entries.push_back({ { 0x01, static_cast<uint8_t>(n >> 24), static_cast<uint8_t>(n >> 16),
+            static_cast<uint8_t>(n >> 8), static_cast<uint8_t>(n) }, REVOKED_DATE, 1 });
+    }
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, &der, &crl), CF_SUCCESS);
+    EXPECT_GT(der.len, LARGE_CRL_LEN);
+    EXPECT_EQ(IsSameDer(crl, der), true);
+    CfBlob tbs = { 0, nullptr };
+    EXPECT_EQ(crl->getTbsInfo(crl, &tbs), CF_SUCCESS);
+    EXPECT_GT(tbs.size, LARGE_CRL_LEN);
+    CfFree(tbs.data);
+
+    X509_CRL *parsed = ParseAndVerify(der);
+    ASSERT_NE(parsed, nullptr);
+    EXPECT_EQ(sk_X509_REVOKED_num(X509_CRL_get_REVOKED(parsed)), static_cast<int>(LARGE_ENTRY_COUNT));
+    X509_CRL_free(parsed);
+
+    HcfX509CrlColumns columns = { 0 };
+    ASSERT_EQ(crl->getRevokedColumns(crl, &columns), CF_SUCCESS);
+    ASSERT_EQ(columns.count, LARGE_ENTRY_COUNT);
+    const uint32_t *offsets = reinterpret_cast<const uint32_t *>(columns.serialOffsets.data);
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        const std::vector<uint8_t> &expect = entries[LARGE_ENTRY_COUNT - 1 - i].serial;
+        if ((offsets[i + 1] - offsets[i] != expect.size()) ||
+            (memcmp(columns.serials.data + offsets[i], expect.data(), expect.size()) != 0)) {
+            ADD_FAILURE() << "row: " << i;
+            break;
+        }
+    }
+    HcfX509CrlColumnsFree(&columns);
+    CfFree(der.data);
+    CfObjDestroy(crl);
+}
+}
@@ -0,0 +1,858 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include <openssl/x509.h>
+
+#include "cf_memory.h"
+#include "cf_result.h"
+#include "x509_crl.h"
+
+#include "cf_test_common.h"
+#include "cf_test_x509_common.h"
+
+using namespace testing::ext;
+using namespace CertframeworkTest;
+using namespace CertframeworkX509Test;
+
+namespace {
+constexpr uint32_t MANY_ENTRY_COUNT = 300; /* serials of two bytes after the leading 0x01 */
+constexpr int64_t REVOKED_DATE = TEST_THIS_UPDATE - 86400; /* one day before this update */
+constexpr uint32_t THREAD_COUNT = 4;
+constexpr uint32_t ENTRY_COUNT = 16;
+constexpr uint32_t ROUND_COUNT = 100;
+constexpr uint32_t LARGE_ENTRY_COUNT = 400000; /* a CfBlob array of more than 327k entries passes 5 MB */
+constexpr uint32_t LONGEST_SERIAL_LEN = 20; /* RFC 5280 limits serial numbers to 20 octets */
+
+class CfX509CrlTest : public testing::Test {
+public:
+    static void SetUpTestCase(void);
+
+    static void TearDownTestCase(void);
+
+    void SetUp();
+
+    void TearDown();
+};
+
+void CfX509CrlTest::SetUpTestCase(void)
+{
+}
+
+void CfX509CrlTest::TearDownTestCase(void)
+{
+}
+
+void CfX509CrlTest::SetUp()
+{
+}
+
+void CfX509CrlTest::TearDown()
+{
+}
+
+static std::vector<TestRevokedEntry> GetSequentialEntries(uint32_t count)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < count; ++i) {
+        /* without reason extensions the CRL stays below HCF_MAX_BUFFER_LEN, which HcfX509CrlCreate accepts */
+        entries.push_back({ { 0x01, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i) }, /* 8: high byte */
+            REVOKED_DATE + i, HCF_CRL_REASON_ABSENT });
+    }
+    return entries;
+}
+
+static CfBlob GetColumnSerial(const HcfX509CrlColumns *columns, uint32_t i)
+{
+    const uint32_t *offsets = reinterpret_cast<const uint32_t *>(columns->serialOffsets.data);
+    return { offsets[i + 1] - offsets[i], columns->serials.data + offsets[i] };
+}
+
+static int64_t GetColumnDate(const HcfX509CrlColumns *columns, uint32_t i)
+{
+    int64_t date = 0;
+    (void)memcpy(&date, columns->revocationDates.data + i * sizeof(int64_t), sizeof(int64_t));
+    return date;
+}
+
+/**
+ * @tc.name: CfX509CrlTest001
+ * @tc.desc: get revoked columns, the rows come in serial order with their dates and reasons
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest001, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = {
+        { { 0x30 }, REVOKED_DATE + 3, HCF_CRL_REASON_ABSENT },
+        { { 0x10 }, REVOKED_DATE + 1, 1 }, /* 1: keyCompromise */
+        { { 0x81, 0x02 }, REVOKED_DATE + 2, 4 }, /* 4: superseded */
+    };
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, nullptr, &crl), CF_SUCCESS);
+
+    HcfX509CrlColumns columns = { 0 };
+    CfResult ret = crl->getRevokedColumns(crl, &columns);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(columns.count, entries.size());
+    ASSERT_EQ(columns.serialOffsets.size, (entries.size() + 1) * sizeof(uint32_t));
+    ASSERT_EQ(columns.revocationDates.size, entries.size() * sizeof(int64_t));
+    ASSERT_EQ(columns.reasons.size, entries.size());
+
+    const uint32_t order[] = { 1, 0, 2 }; /* ascending serials: 0x10, 0x30, 0x8102 */
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        const TestRevokedEntry &expect = entries[order[i]];
+        CfBlob serial = GetColumnSerial(&columns, i);
+        CfBlob expectSerial = { static_cast<uint32_t>(expect.serial.size()), const_cast<uint8_t *>(expect.serial.data()) };
+        EXPECT_EQ(CompareBlob(&serial, &expectSerial), true) << "row: " << i;
+        EXPECT_EQ(GetColumnDate(&columns, i), expect.revocationDate) << "row: " << i;
+        EXPECT_EQ(columns.reasons.data[i], expect.reason) << "row: " << i;
+    }
+    HcfX509CrlColumnsFree(&columns);
+    EXPECT_EQ(columns.serialOffsets.data, nullptr);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest002
+ * @tc.desc: get revoked columns of a CRL without revoked entries, zero rows instead of an error
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest002, TestSize.Level0)
+{
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl({}, nullptr, &crl), CF_SUCCESS);
+
+    HcfX509CrlColumns columns = { 0 };
+    CfResult ret = crl->getRevokedColumns(crl, &columns);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(columns.count, 0U);
+    HcfX509CrlColumnsFree(&columns);
+
+    CfArray entries = { nullptr, CF_FORMAT_DER, 0 };
+    ret = crl->getRevokedCerts(crl, &entries);
+    EXPECT_NE(ret, CF_SUCCESS);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest003
+ * @tc.desc: get revoked columns and revoked certs of a CRL parsed from DER with more than 256 entries
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest003, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = GetSequentialEntries(MANY_ENTRY_COUNT);
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    ASSERT_EQ(BuildTestCrl(entries, &der, nullptr), CF_SUCCESS);
+    HcfX509Crl *crl = nullptr;
+    CfResult ret = HcfX509CrlCreate(&der, &crl);
+    CfFree(der.data);
+    ASSERT_EQ(ret, CF_SUCCESS);
+
+    HcfX509CrlColumns columns = { 0 };
+    ret = crl->getRevokedColumns(crl, &columns);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(columns.count, MANY_ENTRY_COUNT);
+    for (uint32_t i = 0; i < columns.count; ++i) {
+        CfBlob serial = GetColumnSerial(&columns, i);
+        CfBlob expectSerial = { static_cast<uint32_t>(entries[i].serial.size()), entries[i].serial.data() };
+        EXPECT_EQ(CompareBlob(&serial, &expectSerial), true) << "row: " << i;
+        EXPECT_EQ(GetColumnDate(&columns, i), entries[i].revocationDate) << "row: " << i;
+        EXPECT_EQ(columns.reasons.data[i], entries[i].reason) << "row: " << i;
+    }
+    HcfX509CrlColumnsFree(&columns);
+
+    CfArray revoked = { nullptr, CF_FORMAT_DER, 0 };
+    ret = crl->getRevokedCerts(crl, &revoked);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    EXPECT_EQ(revoked.count, MANY_ENTRY_COUNT);
+    for (uint32_t i = 0; i < revoked.count; ++i) {
+        CfObjDestroy(reinterpret_cast<HcfX509CrlEntry *>(revoked.data[i].data));
+    }
+    CfFree(revoked.data);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest004
+ * @tc.desc: get revoked columns: invalid params
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest004, TestSize.Level0)
+{
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(1), nullptr, &crl), CF_SUCCESS);
+
+    HcfX509CrlColumns columns = { 0 };
+    EXPECT_EQ(crl->getRevokedColumns(nullptr, &columns), CF_INVALID_PARAMS);
+    EXPECT_EQ(crl->getRevokedColumns(crl, nullptr), CF_INVALID_PARAMS);
+    HcfX509CrlColumnsFree(nullptr);
+    HcfX509CrlColumnsFree(&columns); /* nothing allocated */
+    CfObjDestroy(crl);
+}
+
+static HcfX509CrlEntry *GetEntry(const CfArray *entries, uint32_t i)
+{
+    return reinterpret_cast<HcfX509CrlEntry *>(entries->data[i].data);
+}
+
+/**
+ * @tc.name: CfX509CrlTest005
+ * @tc.desc: entries of getRevokedCerts are still usable after the CRL is destroyed, and share its issuer
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest005, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> expect = GetSequentialEntries(ENTRY_COUNT);
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(expect, nullptr, &crl), CF_SUCCESS);
+
+    CfArray entries = { nullptr, CF_FORMAT_DER, 0 };
+    CfResult ret = crl->getRevokedCerts(crl, &entries);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    ASSERT_EQ(entries.count, ENTRY_COUNT);
+    CfBlob crlIssuer = { 0, nullptr };
+    ret = crl->getIssuerName(crl, &crlIssuer);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    CfObjDestroy(crl); /* the entries keep the parsed CRL alive */
+
+    for (uint32_t i = 0; i < entries.count; ++i) {
+        HcfX509CrlEntry *entry = GetEntry(&entries, i);
+        CfBlob serial = { 0, nullptr };
+        ASSERT_EQ(entry->getSerialNumber(entry, &serial), CF_SUCCESS);
+        CfBlob expectSerial = { static_cast<uint32_t>(expect[i].serial.size()), expect[i].serial.data() };
+        EXPECT_EQ(CompareBlob(&serial, &expectSerial), true) << "entry: " << i;
+        CfFree(serial.data);
+
+        CfBlob issuer = { 0, nullptr };
+        ASSERT_EQ(entry->getCertIssuer(entry, &issuer), CF_SUCCESS);
+        EXPECT_EQ(CompareBlob(&issuer, &crlIssuer), true) << "entry: " << i;
+        CfFree(issuer.data);
+
+        CfEncodingBlob encoded = { nullptr, 0, CF_FORMAT_DER };
+        EXPECT_EQ(entry->getEncoded(entry, &encoded), CF_SUCCESS) << "entry: " << i;
+        CfFree(encoded.data);
+    }
+    CfFree(crlIssuer.data);
+
+    for (uint32_t i = entries.count; i > 0; --i) {
+        CfObjDestroy(GetEntry(&entries, i - 1)); /* the last one frees the slab */
+    }
+    CfFree(entries.data);
+}
+
+/**
+ * @tc.name: CfX509CrlTest006
+ * @tc.desc: entries of two getRevokedCerts calls and the CRL are destroyed from several threads at once
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest006, TestSize.Level0)
+{
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), nullptr, &crl), CF_SUCCESS);
+
+    for (uint32_t round = 0; round < PERFORMANCE_COUNT / THREAD_COUNT; ++round) {
+        HcfX509Crl *dupCrl = nullptr;
+        ASSERT_EQ(crl->dup(crl, &dupCrl), CF_SUCCESS);
+        CfArray first = { nullptr, CF_FORMAT_DER, 0 };
+        CfArray second = { nullptr, CF_FORMAT_DER, 0 };
+        ASSERT_EQ(dupCrl->getRevokedCerts(dupCrl, &first), CF_SUCCESS);
+        ASSERT_EQ(dupCrl->getRevokedCerts(dupCrl, &second), CF_SUCCESS);
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < THREAD_COUNT; ++t) {
+            threads.emplace_back([&first, &second, t]() {
+                for (uint32_t i = t; i < ENTRY_COUNT; i += THREAD_COUNT) {
+                    CfBlob serial = { 0, nullptr };
+                    (void)GetEntry(&first, i)->getSerialNumber(GetEntry(&first, i), &serial);
+                    CfFree(serial.data);
+                    CfObjDestroy(GetEntry(&first, i));
+                    CfObjDestroy(GetEntry(&second, i));
+                }
+            });
+        }
+        CfObjDestroy(dupCrl);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        CfFree(first.data);
+        CfFree(second.data);
+    }
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest007
+ * @tc.desc: an entry found by serial outlives the CRL, the leading zeros of the serial are ignored
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest007, TestSize.Level0)
+{
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), nullptr, &crl), CF_SUCCESS);
+    CfBlob crlIssuer = { 0, nullptr };
+    ASSERT_EQ(crl->getIssuerName(crl, &crlIssuer), CF_SUCCESS);
+
+    uint8_t serialData[] = { 0x00, 0x01, 0x00, 0x02 }; /* entry 2 */
+    CfBlob serial = { sizeof(serialData), serialData };
+    HcfX509CrlEntry *entry = nullptr;
+    CfResult ret = crl->getRevokedCertWithSerial(crl, &serial, &entry);
+    ASSERT_EQ(ret, CF_SUCCESS);
+    CfObjDestroy(crl);
+
+    CfBlob issuer = { 0, nullptr };
+    ASSERT_EQ(entry->getCertIssuer(entry, &issuer), CF_SUCCESS);
+    EXPECT_EQ(CompareBlob(&issuer, &crlIssuer), true);
+    CfFree(issuer.data);
+    CfFree(crlIssuer.data);
+
+    CfBlob date = { 0, nullptr };
+    EXPECT_EQ(entry->getRevocationDate(entry, &date), CF_SUCCESS);
+    CfFree(date.data);
+    CfObjDestroy(entry);
+}
+
+static HcfX509Crl *CreateCrl(const CfEncodingBlob *der)
+{
+    HcfX509Crl *crl = nullptr;
+    (void)HcfX509CrlCreate(der, &crl);
+    return crl;
+}
+
+static bool CrlEquals(HcfX509Crl *crl, HcfX509Crl *other)
+{
+    bool out = false;
+    EXPECT_EQ(crl->equals(crl, other, &out), CF_SUCCESS);
+    return out;
+}
+
+static uint32_t CrlHashCode(HcfX509Crl *crl)
+{
+    uint32_t hash = 0;
+    EXPECT_EQ(crl->hashCode(crl, &hash), CF_SUCCESS);
+    return hash;
+}
+
+/**
+ * @tc.name: CfX509CrlTest008
+ * @tc.desc: CRLs of the same DER and duplicates are equal and hash the same, other CRLs are not equal
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest008, TestSize.Level0)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), &der, nullptr), CF_SUCCESS);
+    HcfX509Crl *crl = CreateCrl(&der);
+    HcfX509Crl *same = CreateCrl(&der);
+    HcfX509Crl *other = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT + 1), nullptr, &other), CF_SUCCESS);
+    ASSERT_NE(crl, nullptr);
+    ASSERT_NE(same, nullptr);
+
+    EXPECT_EQ(CrlEquals(crl, crl), true);
+    EXPECT_EQ(CrlEquals(crl, same), true);
+    EXPECT_EQ(CrlEquals(same, crl), true);
+    EXPECT_EQ(CrlHashCode(crl), CrlHashCode(same));
+    EXPECT_EQ(CrlEquals(crl, other), false);
+    EXPECT_EQ(CrlEquals(other, crl), false);
+    EXPECT_NE(CrlHashCode(crl), CrlHashCode(other));
+
+    HcfX509Crl *dupCrl = nullptr;
+    ASSERT_EQ(crl->dup(crl, &dupCrl), CF_SUCCESS);
+    EXPECT_EQ(CrlEquals(dupCrl, crl), true);
+    EXPECT_EQ(CrlHashCode(dupCrl), CrlHashCode(crl));
+    CfObjDestroy(crl);
+    EXPECT_EQ(CrlEquals(dupCrl, same), true);
+
+    bool equal = false;
+    EXPECT_EQ(same->equals(same, nullptr, &equal), CF_INVALID_PARAMS);
+    EXPECT_EQ(same->hashCode(same, nullptr), CF_INVALID_PARAMS);
+    CfObjDestroy(dupCrl);
+    CfObjDestroy(same);
+    CfObjDestroy(other);
+    CfFree(der.data);
+}
+
+/**
+ * @tc.name: CfX509CrlTest009
+ * @tc.desc: the hash is the first four bytes of the SHA-256 of the DER read big-endian, the same on every call
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest009, TestSize.Level0)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), &der, &crl), CF_SUCCESS);
+    uint8_t digest[SHA256_DIGEST_LENGTH] = { 0 };
+    (void)SHA256(der.data, der.len, digest);
+    uint32_t expect = (static_cast<uint32_t>(digest[0]) << 24) | (static_cast<uint32_t>(digest[1]) << 16) |
+        (static_cast<uint32_t>(digest[2]) << 8) | digest[3]; /* 2, 3: bytes, 24, 16, 8: shift */
+    for (uint32_t i = 0; i < ROUND_COUNT; ++i) {
+        EXPECT_EQ(CrlHashCode(crl), expect);
+    }
+    CfObjDestroy(crl);
+    CfFree(der.data);
+}
+
+/**
+ * @tc.name: CfX509CrlTest010
+ * @tc.desc: threads computing the digest of new CRLs for the first time at once get the same results
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest010, TestSize.Level0)
+{
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    HcfX509Crl *reference = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), &der, &reference), CF_SUCCESS);
+    uint32_t expect = CrlHashCode(reference);
+    for (uint32_t round = 0; round < ROUND_COUNT; ++round) {
+        HcfX509Crl *crl = CreateCrl(&der);
+        HcfX509Crl *same = CreateCrl(&der);
+        ASSERT_NE(crl, nullptr);
+        ASSERT_NE(same, nullptr);
+        std::atomic<uint32_t> failures { 0 };
+        RunTestThreads(THREAD_COUNT * 2, [&](uint32_t index) { /* 2: half of the threads per object */
+            uint32_t hash = 0;
+            bool equal = false;
+            HcfX509Crl *self = ((index % 2) == 0) ? crl : same;
+            if ((self->hashCode(self, &hash) != CF_SUCCESS) || (hash != expect) ||
+                (self->equals(self, (self == crl) ? same : crl, &equal) != CF_SUCCESS) || !equal) {
+                failures++;
+            }
+        });
+        EXPECT_EQ(failures, 0) << "round: " << round;
+        CfObjDestroy(crl);
+        CfObjDestroy(same);
+    }
+    CfObjDestroy(reference);
+    CfFree(der.data);
+}
+
+/* A CRL of issuer made with openssl, which unlike the builder takes negative and repeated serials. */
+static HcfX509Crl *CreateCrlWithSerials(const std::string &issuer, const std::vector<int64_t> &serials)
+{
+    std::vector<uint8_t> issuerDer = EncodeTestName(issuer);
+    const unsigned char *tmp = issuerDer.data();
+    X509_NAME *name = d2i_X509_NAME(nullptr, &tmp, issuerDer.size());
+    const unsigned char *keyDer = GetTestSigningKey()->data;
+    EVP_PKEY *key = d2i_AutoPrivateKey(nullptr, &keyDer, GetTestSigningKey()->size);
+    ASN1_TIME *date = ASN1_TIME_set(nullptr, TEST_THIS_UPDATE);
+    X509_CRL *x509Crl = X509_CRL_new();
+    bool ok = (name != nullptr) && (key != nullptr) && (date != nullptr) && (x509Crl != nullptr) &&
+        (X509_CRL_set_version(x509Crl, 1) == 1) && (X509_CRL_set_issuer_name(x509Crl, name) == 1) &&
+        (X509_CRL_set1_lastUpdate(x509Crl, date) == 1);
+    for (int64_t value : serials) {
+        X509_REVOKED *revoked = X509_REVOKED_new();
+        ASN1_INTEGER *serial = ASN1_INTEGER_new();
+        ok = ok && (revoked != nullptr) && (serial != nullptr) && (ASN1_INTEGER_set_int64(serial, value) == 1) &&
+            (X509_REVOKED_set_serialNumber(revoked, serial) == 1) &&
+            (X509_REVOKED_set_revocationDate(revoked, date) == 1) && (X509_CRL_add0_revoked(x509Crl, revoked) == 1);
+        if (!ok) {
+            X509_REVOKED_free(revoked);
+        }
+        ASN1_INTEGER_free(serial);
+    }
+    unsigned char *der = nullptr;
+    int len = (ok && (X509_CRL_sign(x509Crl, key, EVP_sha256()) > 0)) ? i2d_X509_CRL(x509Crl, &der) : 0;
+    HcfX509Crl *crl = nullptr;
+    if (len > 0) {
+        CfEncodingBlob blob = { der, static_cast<size_t>(len), CF_FORMAT_DER };
+        (void)HcfX509CrlCreate(&blob, &crl);
+    }
+    OPENSSL_free(der);
+    X509_CRL_free(x509Crl);
+    ASN1_TIME_free(date);
+    EVP_PKEY_free(key);
+    X509_NAME_free(name);
+    return crl;
+}
+
+static std::vector<std::vector<uint8_t>> ToSerials(const CfBlobArray &array)
+{
+    std::vector<std::vector<uint8_t>> serials;
+    for (uint32_t i = 0; i < array.count; ++i) {
+        serials.emplace_back(array.data[i].data, array.data[i].data + array.data[i].size);
+    }
+    return serials;
+}
+
+/* Diffs the CRLs of the two serial lists, and frees the result. */
+static CfResult Diff(const std::vector<int64_t> &older, const std::vector<int64_t> &newer,
+    std::vector<std::vector<uint8_t>> &added, std::vector<std::vector<uint8_t>> &removed)
+{
+    HcfX509Crl *oldCrl = CreateCrlWithSerials("Test CA", older);
+    HcfX509Crl *newCrl = CreateCrlWithSerials("Test CA", newer);
+    CfResult ret = CF_ERR_CRYPTO_OPERATION;
+    if ((oldCrl != nullptr) && (newCrl != nullptr)) {
+        CfBlobArray addedOut = { nullptr, 0 };
+        CfBlobArray removedOut = { nullptr, 0 };
+        ret = oldCrl->getRevokedDiff(oldCrl, newCrl, &addedOut, &removedOut);
+        added = ToSerials(addedOut);
+        removed = ToSerials(removedOut);
+        CfFree(addedOut.data);
+        CfFree(removedOut.data);
+    }
+    CfObjDestroy(oldCrl);
+    CfObjDestroy(newCrl);
+    return ret;
+}
+
+/**
+ * @tc.name: CfX509CrlTest011
+ * @tc.desc: the revoked diff of serials only added, only removed, and both, in ascending order
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest011, TestSize.Level0)
+{
+    std::vector<std::vector<uint8_t>> added;
+    std::vector<std::vector<uint8_t>> removed;
+    ASSERT_EQ(Diff({ 1, 3 }, { 4, 3, 2, 1 }, added, removed), CF_SUCCESS);
+    EXPECT_EQ(added, (std::vector<std::vector<uint8_t>> { { 0x02 }, { 0x04 } }));
+    EXPECT_TRUE(removed.empty());
+
+    ASSERT_EQ(Diff({ 3, 1, 2 }, { 2 }, added, removed), CF_SUCCESS);
+    EXPECT_TRUE(added.empty());
+    EXPECT_EQ(removed, (std::vector<std::vector<uint8_t>> { { 0x01 }, { 0x03 } }));
+
+    ASSERT_EQ(Diff({ 1, 2, 300 }, { 2, 3, 0x1234 }, added, removed), CF_SUCCESS);
+    EXPECT_EQ(added, (std::vector<std::vector<uint8_t>> { { 0x03 }, { 0x12, 0x34 } }));
+    EXPECT_EQ(removed, (std::vector<std::vector<uint8_t>> { { 0x01 }, { 0x01, 0x2C } })); /* 300 */
+
+    ASSERT_EQ(Diff({ 1, 2 }, { 2, 1 }, added, removed), CF_SUCCESS);
+    EXPECT_TRUE(added.empty());
+    EXPECT_TRUE(removed.empty());
+}
+
+/**
+ * @tc.name: CfX509CrlTest012
+ * @tc.desc: the diff gives the signed DER INTEGER content of each serial, as the serial getter of an entry does
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest012, TestSize.Level0)
+{
+    std::vector<int64_t> newer = { 5, -129, -256, -128, 0, -0x8000 };
+    std::vector<std::vector<uint8_t>> added;
+    std::vector<std::vector<uint8_t>> removed;
+    ASSERT_EQ(Diff({ -5, 128 }, newer, added, removed), CF_SUCCESS);
+    /* ascending: -32768, -256, -129, -128, 0, 5 */
+    EXPECT_EQ(added, (std::vector<std::vector<uint8_t>> {
+        { 0x80, 0x00 }, { 0xFF, 0x00 }, { 0xFF, 0x7F }, { 0x80 }, { 0x00 }, { 0x05 } }));
+    EXPECT_EQ(removed, (std::vector<std::vector<uint8_t>> { { 0xFB }, { 0x00, 0x80 } })); /* -5, 128 */
+
+    HcfX509Crl *crl = CreateCrlWithSerials("Test CA", newer);
+    ASSERT_NE(crl, nullptr);
+    CfArray entries = { nullptr, CF_FORMAT_DER, 0 };
+    ASSERT_EQ(crl->getRevokedCerts(crl, &entries), CF_SUCCESS);
+    for (uint32_t i = 0; i < entries.count; ++i) {
+        CfBlob serial = { 0, nullptr };
+        ASSERT_EQ(GetEntry(&entries, i)->getSerialNumber(GetEntry(&entries, i), &serial), CF_SUCCESS);
+        std::vector<uint8_t> bytes(serial.data, serial.data + serial.size);
+        EXPECT_NE(std::find(added.begin(), added.end(), bytes), added.end()) << "entry: " << i;
+        CfFree(serial.data);
+        CfObjDestroy(GetEntry(&entries, i));
+    }
+    CfFree(entries.data);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest013
+ * @tc.desc: a serial listed more than once in a CRL is reported once
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest013, TestSize.Level0)
+{
+    std::vector<std::vector<uint8_t>> added;
+    std::vector<std::vector<uint8_t>> removed;
+    ASSERT_EQ(Diff({ 1, 2, 1, 4, 4 }, { 3, 2, 2, 3, 4 }, added, removed), CF_SUCCESS);
+    EXPECT_EQ(added, (std::vector<std::vector<uint8_t>> { { 0x03 } }));
+    EXPECT_EQ(removed, (std::vector<std::vector<uint8_t>> { { 0x01 } }));
+}
+
+/**
+ * @tc.name: CfX509CrlTest014
+ * @tc.desc: the diff with one or both CRLs empty, and with a CRL of another issuer, which is rejected
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest014, TestSize.Level0)
+{
+    std::vector<std::vector<uint8_t>> added;
+    std::vector<std::vector<uint8_t>> removed;
+    ASSERT_EQ(Diff({}, { 2, 1 }, added, removed), CF_SUCCESS);
+    EXPECT_EQ(added, (std::vector<std::vector<uint8_t>> { { 0x01 }, { 0x02 } }));
+    EXPECT_TRUE(removed.empty());
+    ASSERT_EQ(Diff({ 1 }, {}, added, removed), CF_SUCCESS);
+    EXPECT_TRUE(added.empty());
+    EXPECT_EQ(removed, (std::vector<std::vector<uint8_t>> { { 0x01 } }));
+
+    HcfX509Crl *crl = CreateCrlWithSerials("Test CA", {});
+    HcfX509Crl *empty = CreateCrlWithSerials("Test CA", {});
+    HcfX509Crl *other = CreateCrlWithSerials("Other CA", { 1 });
+    ASSERT_NE(crl, nullptr);
+    ASSERT_NE(empty, nullptr);
+    ASSERT_NE(other, nullptr);
+    CfBlobArray addedOut = { nullptr, 0 };
+    CfBlobArray removedOut = { nullptr, 0 };
+    ASSERT_EQ(crl->getRevokedDiff(crl, empty, &addedOut, &removedOut), CF_SUCCESS);
+    EXPECT_EQ(addedOut.data, nullptr);
+    EXPECT_EQ(addedOut.count, 0U);
+    EXPECT_EQ(removedOut.data, nullptr);
+    EXPECT_EQ(removedOut.count, 0U);
+    EXPECT_EQ(crl->getRevokedDiff(crl, other, &addedOut, &removedOut), CF_INVALID_PARAMS);
+    EXPECT_EQ(other->getRevokedDiff(other, crl, &addedOut, &removedOut), CF_INVALID_PARAMS);
+    EXPECT_EQ(crl->getRevokedDiff(crl, nullptr, &addedOut, &removedOut), CF_INVALID_PARAMS);
+    EXPECT_EQ(crl->getRevokedDiff(crl, empty, nullptr, &removedOut), CF_INVALID_PARAMS);
+    CfObjDestroy(crl);
+    CfObjDestroy(empty);
+    CfObjDestroy(other);
+}
+
+/**
+ * @tc.name: CfX509CrlTest015
+ * @tc.desc: the diff of a built CRL with more entries than one HcfMalloc allocation holds
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest015, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < LARGE_ENTRY_COUNT; ++i) {
+        entries.push_back({ { 0x01, static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 8), /* 16, 8: bytes */
+            static_cast<uint8_t>(i) }, REVOKED_DATE, HCF_CRL_REASON_ABSENT });
+    }
+    HcfX509Crl *crl = nullptr;
+    HcfX509Crl *empty = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, nullptr, &crl), CF_SUCCESS);
+    ASSERT_EQ(BuildTestCrl({}, nullptr, &empty), CF_SUCCESS);
+
+    CfBlobArray added = { nullptr, 0 };
+    CfBlobArray removed = { nullptr, 0 };
+    ASSERT_EQ(empty->getRevokedDiff(empty, crl, &added, &removed), CF_SUCCESS);
+    ASSERT_EQ(added.count, LARGE_ENTRY_COUNT);
+    EXPECT_EQ(removed.count, 0U);
+    for (uint32_t i = 0; i < added.count; ++i) {
+        CfBlob expect = { static_cast<uint32_t>(entries[i].serial.size()), entries[i].serial.data() };
+        ASSERT_EQ(CompareBlob(&added.data[i], &expect), true) << "serial: " << i;
+    }
+    CfFree(added.data);
+    CfFree(removed.data);
+    CfObjDestroy(crl);
+    CfObjDestroy(empty);
+}
+
+/* Looks the serial up in the CRL, and gives the serial of the entry found. */
+static CfResult FindSerial(HcfX509Crl *crl, const std::vector<uint8_t> &serial, std::vector<uint8_t> &found)
+{
+    CfBlob key = { static_cast<uint32_t>(serial.size()), const_cast<uint8_t *>(serial.data()) };
+    HcfX509CrlEntry *entry = nullptr;
+    CfResult ret = crl->getRevokedCertWithSerial(crl, &key, &entry);
+    found.clear();
+    if (ret == CF_SUCCESS) {
+        CfBlob entrySerial = { 0, nullptr };
+        ret = entry->getSerialNumber(entry, &entrySerial);
+        if (ret == CF_SUCCESS) {
+            found.assign(entrySerial.data, entrySerial.data + entrySerial.size);
+        }
+        CfFree(entrySerial.data);
+        CfObjDestroy(entry);
+    }
+    return ret;
+}
+
+/**
+ * @tc.name: CfX509CrlTest016
+ * @tc.desc: serials that are not revoked are not found, nor is any serial in a CRL without entries
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest016, TestSize.Level0)
+{
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(GetSequentialEntries(ENTRY_COUNT), nullptr, &crl), CF_SUCCESS);
+    std::vector<uint8_t> found;
+    EXPECT_EQ(FindSerial(crl, { 0x01, 0x00, 0x05 }, found), CF_SUCCESS);
+    EXPECT_EQ(found, (std::vector<uint8_t> { 0x01, 0x00, 0x05 }));
+    EXPECT_EQ(FindSerial(crl, { 0x01, 0x00, ENTRY_COUNT }, found), CF_NOT_EXIST); /* past the last entry */
+    EXPECT_EQ(FindSerial(crl, { 0x00, 0xFF }, found), CF_NOT_EXIST); /* before the first entry */
+    EXPECT_EQ(FindSerial(crl, { 0x01, 0x00 }, found), CF_NOT_EXIST); /* a prefix of an entry */
+    EXPECT_EQ(FindSerial(crl, { 0x01, 0x00, 0x05, 0x00 }, found), CF_NOT_EXIST); /* an entry with a byte more */
+    EXPECT_EQ(FindSerial(crl, { 0x00 }, found), CF_NOT_EXIST);
+    CfObjDestroy(crl);
+
+    HcfX509Crl *built = nullptr;
+    ASSERT_EQ(BuildTestCrl({}, nullptr, &built), CF_SUCCESS);
+    HcfX509Crl *parsed = CreateCrlWithSerials("Test CA", {});
+    ASSERT_NE(parsed, nullptr);
+    for (HcfX509Crl *empty : { built, parsed }) {
+        EXPECT_EQ(FindSerial(empty, { 0x01 }, found), CF_NOT_EXIST);
+        EXPECT_EQ(FindSerial(empty, { 0x00 }, found), CF_NOT_EXIST);
+        HcfX509CrlEntry *entry = nullptr;
+        EXPECT_EQ(empty->getRevokedCertWithSerial(empty, nullptr, &entry), CF_INVALID_PARAMS);
+    }
+    CfObjDestroy(built);
+    CfObjDestroy(parsed);
+}
+
+/**
+ * @tc.name: CfX509CrlTest017
+ * @tc.desc: the serial looked up is non-negative, it never finds an entry of a negative serial
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest017, TestSize.Level0)
+{
+    HcfX509Crl *crl = CreateCrlWithSerials("Test CA", { -5, 5, -256, 0x80, -0x80 });
+    ASSERT_NE(crl, nullptr);
+    std::vector<uint8_t> found;
+    EXPECT_EQ(FindSerial(crl, { 0x05 }, found), CF_SUCCESS);
+    EXPECT_EQ(found, (std::vector<uint8_t> { 0x05 }));
+    EXPECT_EQ(FindSerial(crl, { 0x80 }, found), CF_SUCCESS);
+    EXPECT_EQ(found, (std::vector<uint8_t> { 0x00, 0x80 }));
+    EXPECT_EQ(FindSerial(crl, { 0xFB }, found), CF_NOT_EXIST); /* the content bytes of -5 */
+    EXPECT_EQ(FindSerial(crl, { 0x01, 0x00 }, found), CF_NOT_EXIST); /* the magnitude of -256 */
+    CfObjDestroy(crl);
+
+    crl = CreateCrlWithSerials("Test CA", { -5, -256 });
+    ASSERT_NE(crl, nullptr);
+    EXPECT_EQ(FindSerial(crl, { 0x05 }, found), CF_NOT_EXIST);
+    EXPECT_EQ(FindSerial(crl, { 0xFB }, found), CF_NOT_EXIST);
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest018
+ * @tc.desc: serials of the longest length are found with or without a leading zero
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest018, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < ENTRY_COUNT; ++i) {
+        std::vector<uint8_t> serial(LONGEST_SERIAL_LEN, 0xA5); /* 0xA5: any filler */
+        serial[0] = 0x7F; /* the highest positive first byte */
+        serial[LONGEST_SERIAL_LEN - 1] = static_cast<uint8_t>(i * 2); /* 2: leave gaps between the serials */
+        entries.push_back({ serial, REVOKED_DATE, HCF_CRL_REASON_ABSENT });
+    }
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, nullptr, &crl), CF_SUCCESS);
+
+    std::vector<uint8_t> found;
+    for (uint32_t i = 0; i < ENTRY_COUNT; ++i) {
+        EXPECT_EQ(FindSerial(crl, entries[i].serial, found), CF_SUCCESS) << "entry: " << i;
+        EXPECT_EQ(found, entries[i].serial) << "entry: " << i;
+        std::vector<uint8_t> padded = entries[i].serial;
+        padded.insert(padded.begin(), 0x00);
+        EXPECT_EQ(FindSerial(crl, padded, found), CF_SUCCESS) << "entry: " << i;
+        std::vector<uint8_t> missing = entries[i].serial;
+        missing[LONGEST_SERIAL_LEN - 1]++;
+        EXPECT_EQ(FindSerial(crl, missing, found), CF_NOT_EXIST) << "entry: " << i;
+    }
+    CfObjDestroy(crl);
+}
+
+/**
+ * @tc.name: CfX509CrlTest019
+ * @tc.desc: the first lookups by serial race on a CRL and on a duplicate made before them
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest019, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries = GetSequentialEntries(ENTRY_COUNT);
+    for (uint32_t round = 0; round < ROUND_COUNT; ++round) {
+        HcfX509Crl *crl = nullptr;
+        ASSERT_EQ(BuildTestCrl(entries, nullptr, &crl), CF_SUCCESS);
+        HcfX509Crl *dupCrl = nullptr;
+        ASSERT_EQ(crl->dup(crl, &dupCrl), CF_SUCCESS);
+        std::atomic<uint32_t> failures(0);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < THREAD_COUNT; ++t) {
+            HcfX509Crl *self = ((t % 2) == 0) ? crl : dupCrl; /* 2: half of the threads on each */
+            threads.emplace_back([self, &entries, &failures, t]() {
+                std::vector<uint8_t> found;
+                for (uint32_t i = t; i < ENTRY_COUNT; i += THREAD_COUNT) {
+                    if ((FindSerial(self, entries[i].serial, found) != CF_SUCCESS) || (found != entries[i].serial)) {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(failures, 0U) << "round: " << round;
+        CfObjDestroy(crl);
+        CfObjDestroy(dupCrl);
+    }
+}
+
+/**
+ * @tc.name: CfX509CrlTest020
+ * @tc.desc: get revoked certs of a built CRL whose entry array passes 5 MB, every entry listed in serial order
+ * @tc.type: FUNC
+ * @tc.require: AR000HS2RB /SR000HS2Q1
+ */
+HWTEST_F(CfX509CrlTest, CfX509CrlTest020, TestSize.Level0)
+{
+    std::vector<TestRevokedEntry> entries;
+    for (uint32_t i = 0; i < LARGE_ENTRY_COUNT; ++i) {
+        entries.push_back({ { 0x01, static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 8), /* 16, 8: bytes */
+            static_cast<uint8_t>(i) }, REVOKED_DATE, HCF_CRL_REASON_ABSENT });
+    }
+    HcfX509Crl *crl = nullptr;
+    ASSERT_EQ(BuildTestCrl(entries, nullptr, &crl), CF_SUCCESS);
+
+    CfArray revoked = { nullptr, CF_FORMAT_DER, 0 };
+    ASSERT_EQ(crl->getRevokedCerts(crl, &revoked), CF_SUCCESS);
+    CfObjDestroy(crl); /* the entries keep what they need of the CRL */
+    ASSERT_EQ(revoked.count, LARGE_ENTRY_COUNT);
+    for (uint32_t i = 0; i < revoked.count; ++i) {
+        HcfX509CrlEntry *entry = GetEntry(&revoked, i);
+        CfBlob serial = { 0, nullptr };
+        ASSERT_EQ(entry->getSerialNumber(entry, &serial), CF_SUCCESS) << "entry: " << i;
+        CfBlob expect = { static_cast<uint32_t>(entries[i].serial.size()), entries[i].serial.data() };
+        EXPECT_EQ(CompareBlob(&serial, &expect), true) << "entry: " << i;
+        CfFree(serial.data);
+    }
+    for (uint32_t i = 0; i < revoked.count; ++i) {
+        CfObjDestroy(GetEntry(&revoked, i));
+    }
+    CfFree(revoked.data);
+}
+}
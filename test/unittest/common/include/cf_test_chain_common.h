@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_TEST_CHAIN_COMMON_H
+#define CF_TEST_CHAIN_COMMON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+namespace CertframeworkChainTest {
+/* NID and openssl config value of each extension, e.g. { NID_basic_constraints, "critical,CA:TRUE" } */
+using TestExtensions = std::vector<std::pair<int, std::string>>;
+
+const TestExtensions &GetTestCaExtensions(void);
+
+/* A cert made with openssl and its private key, both freed by FreeTestChainCert. */
+struct TestChainCert {
+    X509 *x509 = nullptr;
+    EVP_PKEY *key = nullptr;
+};
+
+/*
+ * Issues a cert of subject signed by issuer, self signed when issuer is nullptr. key is the key of the cert, a new
+ * P-256 key when it is nullptr. The cert is valid from 2023 to 2033, x509 is nullptr on failure.
+ */
+TestChainCert IssueTestChainCert(const std::string &subject, const TestChainCert *issuer,
+    const TestExtensions &extensions, long serial = 1, EVP_PKEY *key = nullptr);
+
+void FreeTestChainCert(TestChainCert &cert);
+
+std::vector<uint8_t> EncodeTestChainCert(X509 *x509);
+
+/* The DER of certs laid out as HcfCertChainData data, a 2-byte length before each cert. */
+std::vector<uint8_t> PackTestChainData(const std::vector<X509 *> &certs);
+}
+
+#endif /* CF_TEST_CHAIN_COMMON_H */
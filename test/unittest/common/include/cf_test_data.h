@@ -404,6 +404,47 @@ static const uint8_t g_extensionTaintedData[] = { /* Tainted extension data: g_e
     0x9B, 0xDB, 0x25, 0x49, 0xB3, 0xF1, 0x7C, 0x86, 0xD6, 0xB2, 0x42, 0x87, 0x0B, 0xD0, 0x6B, 0xA0,
     0xD9, 0xE4, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66
 };
+
+/* g_csrData01
+    Subject: CN = csr01.example.com, O = Example
+    Attributes:
+        challengePassword: password01
+        Requested Extensions:
+            X509v3 Subject Alternative Name: DNS:csr01.example.com
+            X509v3 Key Usage: critical, Digital Signature
+*/
+static const uint8_t g_csrData01[] = { /* Der format, ecdsa-with-SHA256 */
+    0x30, 0x82, 0x01, 0x42, 0x30, 0x81, 0xEA, 0x02, 0x01, 0x00, 0x30, 0x2E, 0x31, 0x1A, 0x30, 0x18,
+    0x06, 0x03, 0x55, 0x04, 0x03, 0x0C, 0x11, 0x63, 0x73, 0x72, 0x30, 0x31, 0x2E, 0x65, 0x78, 0x61,
+    0x6D, 0x70, 0x6C, 0x65, 0x2E, 0x63, 0x6F, 0x6D, 0x31, 0x10, 0x30, 0x0E, 0x06, 0x03, 0x55, 0x04,
+    0x0A, 0x0C, 0x07, 0x45, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07,
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01,
+    0x07, 0x03, 0x42, 0x00, 0x04, 0xC2, 0x9E, 0xEB, 0x60, 0x6B, 0x66, 0x18, 0x15, 0xFE, 0x80, 0x22,
+    0xB8, 0x48, 0x6F, 0xE6, 0x3E, 0x41, 0x0B, 0xA6, 0x94, 0x9D, 0xFD, 0xAA, 0x50, 0x60, 0x3C, 0x31,
+    0x3B, 0xF8, 0x27, 0xA6, 0xDA, 0xD1, 0x35, 0x54, 0x23, 0xBB, 0xCD, 0xF9, 0x8E, 0xAA, 0x7D, 0x1F,
+    0xD5, 0xE0, 0x2E, 0xE0, 0x6E, 0xF5, 0x9D, 0xE7, 0x12, 0xA3, 0x87, 0xC2, 0xD9, 0x9E, 0x9A, 0x36,
+    0x67, 0x1B, 0x10, 0x19, 0xEF, 0xA0, 0x5A, 0x30, 0x19, 0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7,
+    0x0D, 0x01, 0x09, 0x07, 0x31, 0x0C, 0x0C, 0x0A, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6F, 0x72, 0x64,
+    0x30, 0x31, 0x30, 0x3D, 0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x09, 0x0E, 0x31,
+    0x30, 0x30, 0x2E, 0x30, 0x1C, 0x06, 0x03, 0x55, 0x1D, 0x11, 0x04, 0x15, 0x30, 0x13, 0x82, 0x11,
+    0x63, 0x73, 0x72, 0x30, 0x31, 0x2E, 0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x2E, 0x63, 0x6F,
+    0x6D, 0x30, 0x0E, 0x06, 0x03, 0x55, 0x1D, 0x0F, 0x01, 0x01, 0xFF, 0x04, 0x04, 0x03, 0x02, 0x07,
+    0x80, 0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02, 0x03, 0x47, 0x00,
+    0x30, 0x44, 0x02, 0x20, 0x2A, 0x01, 0xAA, 0x54, 0x8F, 0x17, 0x97, 0x39, 0x01, 0x40, 0xD3, 0xA6,
+    0xF8, 0x49, 0xBD, 0x48, 0xB5, 0x75, 0x5A, 0x24, 0xEB, 0xB5, 0x06, 0xFE, 0x57, 0x16, 0xEE, 0x4A,
+    0xB3, 0xB5, 0xF4, 0x6C, 0x02, 0x20, 0x74, 0x2F, 0xA2, 0x28, 0x1A, 0x69, 0x21, 0xA9, 0x39, 0x12,
+    0xCF, 0x14, 0x0E, 0x35, 0x0C, 0x3F, 0x08, 0x00, 0x12, 0xBB, 0xCD, 0x4C, 0x64, 0x86, 0x4F, 0xC4,
+    0x32, 0x12, 0xFE, 0x5F, 0xBF, 0x24,
+};
+
+static char g_csrData02[] = /* Pem format, no attributes, the same key as g_csrData01 */
+"-----BEGIN CERTIFICATE REQUEST-----\r\n"
+"MIHJMHICAQAwEDEOMAwGA1UEAwwFY3NyMDIwWTATBgcqhkjOPQIBBggqhkjOPQMB\r\n"
+"BwNCAATCnutga2YYFf6AIrhIb+Y+QQumlJ39qlBgPDE7+Cem2tE1VCO7zfmOqn0f\r\n"
+"1eAu4G71necSo4fC2Z6aNmcbEBnvoAAwCgYIKoZIzj0EAwIDRwAwRAIgP5nWYG5H\r\n"
+"WQUD6pf9BsBJm4pNprK07XJ8NfGs3bft93ICIFu3pVwv0Rj4e8GHcuZmhsd3YYrV\r\n"
+"gxGemEQ7PMokGiQD\r\n"
+"-----END CERTIFICATE REQUEST-----\r\n";
 }
 
 #endif /* CF_TEST_DATA_H */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CF_TEST_X509_COMMON_H
+#define CF_TEST_X509_COMMON_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "cf_blob.h"
+#include "cf_result.h"
+#include "x509_crl.h"
+
+namespace CertframeworkX509Test {
+constexpr int64_t TEST_THIS_UPDATE = 1700000000; /* 2023-11-14 22:13:20 UTC */
+constexpr int64_t TEST_NEXT_UPDATE = TEST_THIS_UPDATE + 30 * 86400; /* 30 days later */
+
+struct TestRevokedEntry {
+    std::vector<uint8_t> serial;
+    int64_t revocationDate;
+    uint8_t reason;
+};
+
+/* Owns the buffers of revoked entries laid out as HcfX509CrlColumns, the view is valid while the object lives. */
+class TestCrlColumns {
+public:
+    explicit TestCrlColumns(const std::vector<TestRevokedEntry> &entries);
+    const HcfX509CrlColumns *Get(void) const;
+    HcfX509CrlColumns *Get(void);
+
+private:
+    std::vector<uint32_t> offsets_;
+    std::vector<uint8_t> serials_;
+    std::vector<int64_t> dates_;
+    std::vector<uint8_t> reasons_;
+    HcfX509CrlColumns columns_;
+};
+
+/* DER of a P-256 private key and of its SubjectPublicKeyInfo, the same pair for the whole test process */
+const CfBlob *GetTestSigningKey(void);
+const CfBlob *GetTestPublicKey(void);
+
+/* DER of a Name with one commonName */
+std::vector<uint8_t> EncodeTestName(const std::string &commonName);
+
+/* Build a CRL of the issuer "Test CA" signed with the test key, derOut and crlOut may be nullptr. */
+CfResult BuildTestCrl(const std::vector<TestRevokedEntry> &entries, CfEncodingBlob *derOut, HcfX509Crl **crlOut);
+
+/* Runs func(index) on count threads released at the same moment, and joins them. */
+void RunTestThreads(uint32_t count, const std::function<void(uint32_t)> &func);
+}
+
+#endif /* CF_TEST_X509_COMMON_H */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_test_chain_common.h"
+
+#include <openssl/ec.h>
+#include <openssl/x509v3.h>
+
+namespace CertframeworkChainTest {
+constexpr int64_t TEST_NOT_BEFORE = 1700000000; /* 2023-11-14 22:13:20 UTC */
+constexpr int64_t TEST_NOT_AFTER = TEST_NOT_BEFORE + 10 * 365 * 86400; /* about 10 years later */
+
+const TestExtensions &GetTestCaExtensions(void)
+{
+    static const TestExtensions caExtensions = {
+        { NID_basic_constraints, "critical,CA:TRUE" },
+        { NID_key_usage, "critical,keyCertSign,cRLSign" },
+    };
+    return caExtensions;
+}
+
+static EVP_PKEY *GenerateTestChainKey(void)
+{
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (ctx == nullptr) {
+        return nullptr;
+    }
+    EVP_PKEY *key = nullptr;
+    if ((EVP_PKEY_keygen_init(ctx) != 1) ||
+        (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1) != 1) ||
+        (EVP_PKEY_keygen(ctx, &key) != 1)) {
+        key = nullptr;
+    }
+    EVP_PKEY_CTX_free(ctx);
+    return key;
+}
+
+static bool SetTestChainName(X509 *x509, const std::string &subject, const TestChainCert *issuer)
+{
+    X509_NAME *name = X509_get_subject_name(x509);
+    if (X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_UTF8,
+        reinterpret_cast<const unsigned char *>(subject.c_str()), -1, -1, 0) != 1) {
+        return false;
+    }
+    X509_NAME *issuerName = (issuer == nullptr) ? name : X509_get_subject_name(issuer->x509);
+    return X509_set_issuer_name(x509, issuerName) == 1;
+}
+
+static bool AddTestChainExtensions(X509 *x509, X509 *issuer, const TestExtensions &extensions)
+{
+    X509V3_CTX ctx;
+    X509V3_set_ctx_nodb(&ctx);
+    X509V3_set_ctx(&ctx, issuer, x509, nullptr, nullptr, 0);
+    for (const std::pair<int, std::string> &extension : extensions) {
+        X509_EXTENSION *ext = X509V3_EXT_conf_nid(nullptr, &ctx, extension.first, extension.second.c_str());
+        if (ext == nullptr) {
+            return false;
+        }
+        int ret = X509_add_ext(x509, ext, -1);
+        X509_EXTENSION_free(ext);
+        if (ret != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool FillTestChainCert(X509 *x509, const std::string &subject, const TestChainCert *issuer,
+    const TestExtensions &extensions, long serial, EVP_PKEY *key)
+{
+    if ((X509_set_version(x509, 2) != 1) || (ASN1_INTEGER_set(X509_get_serialNumber(x509), serial) != 1) ||
+        (ASN1_TIME_set(X509_getm_notBefore(x509), TEST_NOT_BEFORE) == nullptr) ||
+        (ASN1_TIME_set(X509_getm_notAfter(x509), TEST_NOT_AFTER) == nullptr) ||
+        (X509_set_pubkey(x509, key) != 1) || !SetTestChainName(x509, subject, issuer)) {
+        return false;
+    }
+    X509 *issuerCert = (issuer == nullptr) ? x509 : issuer->x509;
+    EVP_PKEY *signingKey = (issuer == nullptr) ? key : issuer->key;
+    return AddTestChainExtensions(x509, issuerCert, extensions) && (X509_sign(x509, signingKey, EVP_sha256()) > 0);
+}
+
+TestChainCert IssueTestChainCert(const std::string &subject, const TestChainCert *issuer,
+    const TestExtensions &extensions, long serial, EVP_PKEY *key)
+{
+    TestChainCert cert;
+    if (key != nullptr) {
+        cert.key = (EVP_PKEY_up_ref(key) == 1) ? key : nullptr;
+    } else {
+        cert.key = GenerateTestChainKey();
+    }
+    cert.x509 = X509_new();
+    if ((cert.key == nullptr) || (cert.x509 == nullptr) ||
+        !FillTestChainCert(cert.x509, subject, issuer, extensions, serial, cert.key)) {
+        X509_free(cert.x509);
+        cert.x509 = nullptr;
+    }
+    return cert;
+}
+
+void FreeTestChainCert(TestChainCert &cert)
+{
+    X509_free(cert.x509);
+    cert.x509 = nullptr;
+    EVP_PKEY_free(cert.key);
+    cert.key = nullptr;
+}
+
+std::vector<uint8_t> EncodeTestChainCert(X509 *x509)
+{
+    int len = i2d_X509(x509, nullptr);
+    if (len <= 0) {
+        return {};
+    }
+    std::vector<uint8_t> der(len);
+    unsigned char *out = der.data();
+    (void)i2d_X509(x509, &out);
+    return der;
+}
+
+std::vector<uint8_t> PackTestChainData(const std::vector<X509 *> &certs)
+{
+    std::vector<uint8_t> data;
+    for (X509 *x509 : certs) {
+        std::vector<uint8_t> der = EncodeTestChainCert(x509);
+        uint16_t len = static_cast<uint16_t>(der.size()); /* host order, as the validator reads it */
+        const uint8_t *lenBytes = reinterpret_cast<const uint8_t *>(&len);
+        data.insert(data.end(), lenBytes, lenBytes + sizeof(len));
+        data.insert(data.end(), der.begin(), der.end());
+    }
+    return data;
+}
+}
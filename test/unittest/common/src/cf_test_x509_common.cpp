@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cf_test_x509_common.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "cf_memory.h"
+#include "x509_crl_builder.h"
+
+namespace CertframeworkX509Test {
+TestCrlColumns::TestCrlColumns(const std::vector<TestRevokedEntry> &entries)
+{
+    offsets_.push_back(0);
+    for (const TestRevokedEntry &entry : entries) {
+        serials_.insert(serials_.end(), entry.serial.begin(), entry.serial.end());
+        offsets_.push_back(static_cast<uint32_t>(serials_.size()));
+        dates_.push_back(entry.revocationDate);
+        reasons_.push_back(entry.reason);
+    }
+    columns_.count = static_cast<uint32_t>(entries.size());
+    columns_.serialOffsets = { static_cast<uint32_t>(offsets_.size() * sizeof(uint32_t)),
+        reinterpret_cast<uint8_t *>(offsets_.data()) };
+    columns_.serials = { static_cast<uint32_t>(serials_.size()), serials_.data() };
+    columns_.revocationDates = { static_cast<uint32_t>(dates_.size() * sizeof(int64_t)),
+        reinterpret_cast<uint8_t *>(dates_.data()) };
+    columns_.reasons = { static_cast<uint32_t>(reasons_.size()), reasons_.data() };
+}
+
+const HcfX509CrlColumns *TestCrlColumns::Get(void) const
+{
+    return &columns_;
+}
+
+HcfX509CrlColumns *TestCrlColumns::Get(void)
+{
+    return &columns_;
+}
+
+struct TestKeyPair {
+    std::vector<uint8_t> privateKey;
+    std::vector<uint8_t> publicKey;
+    CfBlob privateBlob;
+    CfBlob publicBlob;
+};
+
+static std::vector<uint8_t> EncodeKey(EVP_PKEY *key, bool isPublic)
+{
+    int len = isPublic ? i2d_PUBKEY(key, nullptr) : i2d_PrivateKey(key, nullptr);
+    if (len <= 0) {
+        return {};
+    }
+    std::vector<uint8_t> der(len);
+    unsigned char *out = der.data();
+    (void)(isPublic ? i2d_PUBKEY(key, &out) : i2d_PrivateKey(key, &out));
+    return der;
+}
+
+static EVP_PKEY *GenerateEcKey(void)
+{
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (ctx == nullptr) {
+        return nullptr;
+    }
+    EVP_PKEY *key = nullptr;
+    if ((EVP_PKEY_keygen_init(ctx) != 1) ||
+        (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1) != 1) ||
+        (EVP_PKEY_keygen(ctx, &key) != 1)) {
+        key = nullptr;
+    }
+    EVP_PKEY_CTX_free(ctx);
+    return key;
+}
+
+static const TestKeyPair &GetTestKeyPair(void)
+{
+    static TestKeyPair keyPair;
+    static std::once_flag flag;
+    std::call_once(flag, []() {
+        EVP_PKEY *key = GenerateEcKey();
+        if (key != nullptr) {
+            keyPair.privateKey = EncodeKey(key, false);
+            keyPair.publicKey = EncodeKey(key, true);
+            EVP_PKEY_free(key);
+        }
+        keyPair.privateBlob = { static_cast<uint32_t>(keyPair.privateKey.size()), keyPair.privateKey.data() };
+        keyPair.publicBlob = { static_cast<uint32_t>(keyPair.publicKey.size()), keyPair.publicKey.data() };
+    });
+    return keyPair;
+}
+
+const CfBlob *GetTestSigningKey(void)
+{
+    return &GetTestKeyPair().privateBlob;
+}
+
+const CfBlob *GetTestPublicKey(void)
+{
+    return &GetTestKeyPair().publicBlob;
+}
+
+std::vector<uint8_t> EncodeTestName(const std::string &commonName)
+{
+    X509_NAME *name = X509_NAME_new();
+    if (name == nullptr) {
+        return {};
+    }
+    std::vector<uint8_t> der;
+    if (X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_UTF8,
+        reinterpret_cast<const unsigned char *>(commonName.c_str()), -1, -1, 0) == 1) {
+        int len = i2d_X509_NAME(name, nullptr);
+        if (len > 0) {
+            der.resize(len);
+            unsigned char *out = der.data();
+            (void)i2d_X509_NAME(name, &out);
+        }
+    }
+    X509_NAME_free(name);
+    return der;
+}
+
+CfResult BuildTestCrl(const std::vector<TestRevokedEntry> &entries, CfEncodingBlob *derOut, HcfX509Crl **crlOut)
+{
+    std::vector<uint8_t> issuer = EncodeTestName("Test CA");
+    HcfX509CrlBuildParams params = {
+        .issuer = { static_cast<uint32_t>(issuer.size()), issuer.data() },
+        .thisUpdate = TEST_THIS_UPDATE,
+        .nextUpdate = TEST_NEXT_UPDATE,
+        .crlNumber = { 0, nullptr },
+        .extensions = { 0, nullptr },
+    };
+    TestCrlColumns columns(entries);
+    CfEncodingBlob der = { nullptr, 0, CF_FORMAT_DER };
+    CfResult ret = HcfX509CrlBuild(&params, columns.Get(), GetTestSigningKey(), &der, crlOut);
+    if ((ret == CF_SUCCESS) && (derOut != nullptr)) {
+        *derOut = der;
+    } else {
+        CfFree(der.data);
+    }
+    return ret;
+}
+
+void RunTestThreads(uint32_t count, const std::function<void(uint32_t)> &func)
+{
+    std::atomic<bool> start { false };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < count; ++i) {
+        threads.emplace_back([&start, &func, i]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            func(i);
+        });
+    }
+    start = true;
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+}